@@ -23,7 +23,10 @@ include(build-flags.pri)
 #QMAKE_TARGET_COPYRIGHT = copyright Tarsnap Backup Inc.
 
 SOURCES +=						\
+	lib/core/ByteScan.cpp				\
 	lib/core/ConsoleLog.cpp				\
+	lib/core/ConsoleLogWriter.cpp			\
+	lib/core/LogRing.cpp				\
 	lib/core/TSettings.cpp				\
 	lib/util/optparse.c				\
 	lib/util/optparse_helper.c			\
@@ -42,26 +45,48 @@ SOURCES +=						\
 	src/app-cmdline.cpp				\
 	src/app-gui.cpp					\
 	src/app-setup.cpp				\
+	src/archivediff.cpp				\
+	src/archivediffmodel.cpp			\
+	src/archivedifftask.cpp				\
+	src/archivelisting.cpp				\
+	src/archivelistmodel.cpp			\
 	src/backenddata.cpp				\
 	src/backuptask.cpp				\
 	src/basetask.cpp				\
+	src/changetracker.cpp				\
+	src/checkstatetree.cpp				\
 	src/cmdlinetask.cpp				\
-	src/customfilesystemmodel.cpp			\
+	src/consolelogmodel.cpp				\
 	src/dir-utils.cpp				\
+	src/direnumeratortask.cpp			\
 	src/dirinfotask.cpp				\
+	src/filehistorytask.cpp				\
+	src/filepickermodel.cpp				\
 	src/filetablemodel.cpp				\
+	src/filetableproxymodel.cpp			\
+	src/filetablesorttask.cpp			\
+	src/filetree.cpp				\
+	src/filetreemodel.cpp				\
+	src/filetreetask.cpp				\
+	src/fingerprinttask.cpp				\
 	src/humanbytes.cpp				\
 	src/init-shared.cpp				\
+	src/joblistmodel.cpp				\
 	src/jobrunner.cpp				\
+	src/listingtask.cpp				\
 	src/main.cpp					\
+	src/nameindex.cpp				\
 	src/notification.cpp				\
 	src/parsearchivelistingtask.cpp			\
 	src/persistentmodel/archive.cpp			\
+	src/persistentmodel/filehistory.cpp		\
 	src/persistentmodel/job.cpp			\
 	src/persistentmodel/journal.cpp			\
+	src/persistentmodel/listingstore.cpp		\
 	src/persistentmodel/persistentobject.cpp	\
 	src/persistentmodel/persistentstore.cpp		\
 	src/persistentmodel/upgrade-store.cpp		\
+	src/prefixtrie.cpp				\
 	src/scheduling.cpp				\
 	src/setupwizard/setupwizard.cpp			\
 	src/setupwizard/setupwizard_cli.cpp		\
@@ -76,9 +101,11 @@ SOURCES +=						\
 	src/tasks/tasks-tarsnap.cpp			\
 	src/tasks/tasks-utils.cpp			\
 	src/translator.cpp				\
+	src/updatecoalescer.cpp				\
 	src/widgets/aboutdialog.cpp			\
+	src/widgets/archivediffdialog.cpp		\
+	src/widgets/archivelistdelegate.cpp		\
 	src/widgets/archivelistwidget.cpp		\
-	src/widgets/archivelistwidgetitem.cpp		\
 	src/widgets/archivestabwidget.cpp		\
 	src/widgets/archivewidget.cpp			\
 	src/widgets/backuplistwidget.cpp		\
@@ -88,11 +115,12 @@ SOURCES +=						\
 	src/widgets/consolelogdialog.cpp		\
 	src/widgets/elidedannotatedlabel.cpp		\
 	src/widgets/elidedclickablelabel.cpp		\
+	src/widgets/filehistorydialog.cpp		\
 	src/widgets/filepickerdialog.cpp		\
 	src/widgets/filepickerwidget.cpp		\
 	src/widgets/helpwidget.cpp			\
+	src/widgets/joblistdelegate.cpp			\
 	src/widgets/joblistwidget.cpp			\
-	src/widgets/joblistwidgetitem.cpp		\
 	src/widgets/jobstabwidget.cpp			\
 	src/widgets/jobwidget.cpp			\
 	src/widgets/mainwindow.cpp			\
@@ -105,8 +133,11 @@ SOURCES +=						\
 	src/widgets/tarsnapaccountdialog.cpp
 
 HEADERS +=						\
+	lib/core/ByteScan.h				\
 	lib/core/ConsoleLog.h				\
+	lib/core/ConsoleLogWriter.h			\
 	lib/core/LogEntry.h				\
+	lib/core/LogRing.h				\
 	lib/core/TSettings.h				\
 	lib/core/warnings-disable.h			\
 	lib/util/optparse.h				\
@@ -126,35 +157,64 @@ HEADERS +=						\
 	src/app-cmdline.h				\
 	src/app-gui.h					\
 	src/app-setup.h					\
+	src/archivediff.h				\
+	src/archivediffmodel.h				\
+	src/archivedifftask.h				\
+	src/archivelisting.h				\
+	src/archivelistmodel.h				\
 	src/backenddata.h				\
 	src/backuptask.h				\
 	src/basetask.h					\
+	src/changetracker.h				\
+	src/checkstatetree.h				\
 	src/compat.h					\
 	src/cmdlinetask.h				\
-	src/customfilesystemmodel.h			\
+	src/consolelogmodel.h				\
 	src/debug.h					\
 	src/dir-utils.h					\
+	src/direnumeratortask.h				\
 	src/dirinfotask.h				\
+	src/filehistorytask.h				\
+	src/filepickermodel.h				\
 	src/filetablemodel.h				\
+	src/filetableproxymodel.h			\
+	src/filetablesorttask.h				\
+	src/filetree.h					\
+	src/filetreemodel.h				\
+	src/filetreetask.h				\
+	src/fingerprinttask.h				\
 	src/humanbytes.h				\
 	src/init-shared.h				\
+	src/joblistmodel.h				\
 	src/jobrunner.h					\
+	src/listingtask.h				\
+	src/messages/archivediffptr.h			\
 	src/messages/archivefilestat.h			\
+	src/messages/archivelistingptr.h		\
 	src/messages/archiveptr.h			\
 	src/messages/archiverestoreoptions.h		\
 	src/messages/backuptaskdataptr.h		\
+	src/messages/changeset.h			\
+	src/messages/filepickerentry.h			\
+	src/messages/filetreeptr.h			\
+	src/messages/fileversion.h			\
 	src/messages/jobptr.h				\
 	src/messages/notification_info.h		\
 	src/messages/tarsnaperror.h			\
+	src/messages/taskoutput.h			\
 	src/messages/taskstatus.h			\
+	src/nameindex.h					\
 	src/notification.h				\
 	src/parsearchivelistingtask.h			\
 	src/persistentmodel/archive.h			\
+	src/persistentmodel/filehistory.h		\
 	src/persistentmodel/job.h			\
 	src/persistentmodel/journal.h			\
+	src/persistentmodel/listingstore.h		\
 	src/persistentmodel/persistentobject.h		\
 	src/persistentmodel/persistentstore.h		\
 	src/persistentmodel/upgrade-store.h		\
+	src/prefixtrie.h				\
 	src/scheduling.h				\
 	src/setupwizard/setupwizard.h			\
 	src/setupwizard/setupwizard_cli.h		\
@@ -170,9 +230,11 @@ HEADERS +=						\
 	src/tasks/tasks-tarsnap.h			\
 	src/tasks/tasks-utils.h				\
 	src/translator.h				\
+	src/updatecoalescer.h				\
 	src/widgets/aboutdialog.h			\
+	src/widgets/archivediffdialog.h			\
+	src/widgets/archivelistdelegate.h		\
 	src/widgets/archivelistwidget.h			\
-	src/widgets/archivelistwidgetitem.h		\
 	src/widgets/archivestabwidget.h			\
 	src/widgets/archivewidget.h			\
 	src/widgets/backuplistwidget.h			\
@@ -182,11 +244,12 @@ HEADERS +=						\
 	src/widgets/consolelogdialog.h			\
 	src/widgets/elidedannotatedlabel.h		\
 	src/widgets/elidedclickablelabel.h		\
+	src/widgets/filehistorydialog.h			\
 	src/widgets/filepickerdialog.h			\
 	src/widgets/filepickerwidget.h			\
 	src/widgets/helpwidget.h			\
+	src/widgets/joblistdelegate.h			\
 	src/widgets/joblistwidget.h			\
-	src/widgets/joblistwidgetitem.h			\
 	src/widgets/jobstabwidget.h			\
 	src/widgets/jobwidget.h				\
 	src/widgets/mainwindow.h			\
@@ -207,16 +270,16 @@ INCLUDEPATH +=						\
 
 FORMS +=						\
 	forms/aboutdialog.ui				\
-	forms/archivelistwidgetitem.ui			\
+	forms/archivediffdialog.ui			\
 	forms/archivestabwidget.ui			\
 	forms/archivewidget.ui				\
 	forms/backuplistwidgetitem.ui			\
 	forms/backuptabwidget.ui			\
 	forms/consolelogdialog.ui			\
+	forms/filehistorydialog.ui			\
 	forms/filepickerdialog.ui			\
 	forms/filepickerwidget.ui			\
 	forms/helpwidget.ui				\
-	forms/joblistwidgetitem.ui			\
 	forms/jobstabwidget.ui				\
 	forms/jobwidget.ui				\
 	forms/logindialog.ui				\
@@ -278,17 +341,27 @@ UNIT_TESTS =						\
 	tests/settingswidget				\
 	tests/backuptabwidget				\
 	tests/archivestabwidget				\
+	tests/archivelisting				\
+	tests/parsers					\
 	tests/helpwidget				\
 	tests/persistent				\
 	tests/setupwizard				\
 	tests/taskmanager				\
-	tests/customfilesystemmodel			\
+	tests/filepickermodel				\
 	tests/small-widgets				\
 	tests/lib-widgets				\
 	tests/consolelog				\
 	tests/task					\
 	tests/core
 
+BUILD_ONLY_TESTS =						\
+	tests/bench-archivediff				\
+	tests/bench-archivelist				\
+	tests/bench-consolelog				\
+	tests/bench-filepickermodel			\
+	tests/bench-parsers				\
+	tests/bench-updates
+
 OPTIONAL_BUILD_ONLY_TESTS = tests/cli
 
 osx {
@@ -343,6 +416,16 @@ test.commands =		@echo "Compiling tests...";			\
 			done
 test.depends = test_home_prep
 
+# Benchmarks are compiled by "make test", but only run by "make bench".
+bench.commands =	for D in $${BUILD_ONLY_TESTS}; do		\
+				(cd \$\${D} && \${MAKE} -s && \${MAKE} test -s); \
+				err=\$\$?;				\
+				if \[ \$\${err} -gt "0" \]; then	\
+					exit \$\${err};			\
+				fi;					\
+			done
+bench.depends = test_home_prep
+
 # Prep the optional tests
 optional_buildtests = $$OPTIONAL_BUILD_ONLY_TESTS
 for(D, optional_buildtests) {
@@ -367,10 +450,12 @@ optional_buildtest.commands =	@echo "Compiling optional tests...";	\
 			done;						\
 
 # Yes, this also does distclean
-test_clean.commands =	for D in $${UNIT_TESTS} $${OPTIONAL_BUILD_ONLY_TESTS}; do	\
+test_clean.commands =	for D in $${UNIT_TESTS} $${BUILD_ONLY_TESTS}		\
+				$${OPTIONAL_BUILD_ONLY_TESTS}; do	\
 				(cd \$\${D} && \${QMAKE} &&		\
 				    \${MAKE} distclean);		\
 			done
 clean.depends += test_clean
 
-QMAKE_EXTRA_TARGETS += test test_clean clean test_home_prep optional_buildtest
+QMAKE_EXTRA_TARGETS += test bench test_clean clean test_home_prep	\
+			optional_buildtest
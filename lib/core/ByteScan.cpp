@@ -0,0 +1,405 @@
+#include "ByteScan.h"
+
+WARNINGS_DISABLE
+#include <QAtomicPointer>
+#include <QLatin1String>
+WARNINGS_ENABLE
+
+#include <string.h>
+
+// SSE2 is always available on x86-64; the AVX2 functions are compiled
+// with a function attribute, so the rest of the program does not require
+// AVX2.
+#if defined(__GNUC__)                                                          \
+    && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define BYTESCAN_X86 1
+#include <immintrin.h>
+#define BYTESCAN_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace
+{
+
+struct Functions
+{
+    ByteScan::Implementation impl;
+    const char *(*findByte)(const char *pos, const char *end, char c);
+    int (*countByte)(const char *pos, const char *end, char c);
+    const char *(*findBlank)(const char *pos, const char *end);
+    const char *(*skipBlanks)(const char *pos, const char *end);
+};
+
+/*
+ * Scalar versions.  These are also used for the last few bytes of the
+ * buffer by the SIMD versions.
+ */
+
+const char *findByteScalar(const char *pos, const char *end, char c)
+{
+    // memchr() is usually optimized by the C library.
+    if(pos >= end)
+        return (end);
+    const char *found = static_cast<const char *>(
+        memchr(pos, c, static_cast<size_t>(end - pos)));
+    return ((found != nullptr) ? found : end);
+}
+
+int countByteScalar(const char *pos, const char *end, char c)
+{
+    int count = 0;
+    for(; pos < end; pos++)
+        count += (*pos == c);
+    return (count);
+}
+
+const char *findBlankScalar(const char *pos, const char *end)
+{
+    while((pos < end) && !ByteScan::isBlank(*pos))
+        pos++;
+    return (pos);
+}
+
+const char *skipBlanksScalar(const char *pos, const char *end)
+{
+    while((pos < end) && ByteScan::isBlank(*pos))
+        pos++;
+    return (pos);
+}
+
+const Functions scalarFunctions = {ByteScan::Scalar, findByteScalar,
+                                   countByteScalar, findBlankScalar,
+                                   skipBlanksScalar};
+
+#ifdef BYTESCAN_X86
+
+/*
+ * SSE2 versions; 16 bytes at a time.
+ */
+
+inline int blankMaskSSE2(__m128i v)
+{
+    // A blank is ' ', or (v - '\t') <= 4 as an unsigned byte.
+    const __m128i space   = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    const __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8('\t'));
+    const __m128i control =
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted);
+    return (_mm_movemask_epi8(_mm_or_si128(space, control)));
+}
+
+const char *findByteSSE2(const char *pos, const char *end, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    while(end - pos >= 16)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        if(mask != 0)
+            return (pos + __builtin_ctz(static_cast<unsigned>(mask)));
+        pos += 16;
+    }
+    return (findByteScalar(pos, end, c));
+}
+
+int countByteSSE2(const char *pos, const char *end, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    int           count  = 0;
+    while(end - pos >= 16)
+    {
+        const __m128i v =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle));
+        count += __builtin_popcount(static_cast<unsigned>(mask));
+        pos += 16;
+    }
+    return (count + countByteScalar(pos, end, c));
+}
+
+const char *findBlankSSE2(const char *pos, const char *end)
+{
+    while(end - pos >= 16)
+    {
+        const int mask = blankMaskSSE2(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)));
+        if(mask != 0)
+            return (pos + __builtin_ctz(static_cast<unsigned>(mask)));
+        pos += 16;
+    }
+    return (findBlankScalar(pos, end));
+}
+
+const char *skipBlanksSSE2(const char *pos, const char *end)
+{
+    while(end - pos >= 16)
+    {
+        const int mask = ~blankMaskSSE2(_mm_loadu_si128(
+                             reinterpret_cast<const __m128i *>(pos)))
+                         & 0xFFFF;
+        if(mask != 0)
+            return (pos + __builtin_ctz(static_cast<unsigned>(mask)));
+        pos += 16;
+    }
+    return (skipBlanksScalar(pos, end));
+}
+
+const Functions sse2Functions = {ByteScan::SSE2, findByteSSE2, countByteSSE2,
+                                 findBlankSSE2, skipBlanksSSE2};
+
+/*
+ * AVX2 versions; 32 bytes at a time.
+ */
+
+BYTESCAN_AVX2_TARGET inline unsigned blankMaskAVX2(__m256i v)
+{
+    const __m256i space   = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    const __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8('\t'));
+    const __m256i control =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)),
+                          shifted);
+    return (static_cast<unsigned>(
+        _mm256_movemask_epi8(_mm256_or_si256(space, control))));
+}
+
+BYTESCAN_AVX2_TARGET const char *findByteAVX2(const char *pos,
+                                              const char *end, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    while(end - pos >= 32)
+    {
+        const __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        const unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        if(mask != 0)
+            return (pos + __builtin_ctz(mask));
+        pos += 32;
+    }
+    return (findByteSSE2(pos, end, c));
+}
+
+BYTESCAN_AVX2_TARGET int countByteAVX2(const char *pos, const char *end,
+                                       char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    int           count  = 0;
+    while(end - pos >= 32)
+    {
+        const __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+        const unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        count += __builtin_popcount(mask);
+        pos += 32;
+    }
+    return (count + countByteSSE2(pos, end, c));
+}
+
+BYTESCAN_AVX2_TARGET const char *findBlankAVX2(const char *pos,
+                                               const char *end)
+{
+    while(end - pos >= 32)
+    {
+        const unsigned mask = blankMaskAVX2(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos)));
+        if(mask != 0)
+            return (pos + __builtin_ctz(mask));
+        pos += 32;
+    }
+    return (findBlankSSE2(pos, end));
+}
+
+BYTESCAN_AVX2_TARGET const char *skipBlanksAVX2(const char *pos,
+                                                const char *end)
+{
+    while(end - pos >= 32)
+    {
+        const unsigned mask = ~blankMaskAVX2(_mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(pos)));
+        if(mask != 0)
+            return (pos + __builtin_ctz(mask));
+        pos += 32;
+    }
+    return (skipBlanksSSE2(pos, end));
+}
+
+const Functions avx2Functions = {ByteScan::AVX2, findByteAVX2, countByteAVX2,
+                                 findBlankAVX2, skipBlanksAVX2};
+
+#endif /* BYTESCAN_X86 */
+
+const Functions *functionsFor(ByteScan::Implementation impl)
+{
+    // Bail (if applicable).
+    if(!ByteScan::isSupported(impl))
+        return (nullptr);
+
+    switch(impl)
+    {
+#ifdef BYTESCAN_X86
+    case ByteScan::AVX2:
+        return (&avx2Functions);
+    case ByteScan::SSE2:
+        return (&sse2Functions);
+#endif
+    default:
+        return (&scalarFunctions);
+    }
+}
+
+const Functions *detectFunctions()
+{
+    if(ByteScan::isSupported(ByteScan::AVX2))
+        return (functionsFor(ByteScan::AVX2));
+    if(ByteScan::isSupported(ByteScan::SSE2))
+        return (functionsFor(ByteScan::SSE2));
+    return (&scalarFunctions);
+}
+
+QAtomicPointer<const Functions> &currentFunctions()
+{
+    static QAtomicPointer<const Functions> functions(detectFunctions());
+    return (functions);
+}
+
+inline const Functions *current()
+{
+    return (currentFunctions().loadAcquire());
+}
+
+} // namespace
+
+ByteScan::Implementation ByteScan::implementation()
+{
+    return (current()->impl);
+}
+
+bool ByteScan::isSupported(Implementation impl)
+{
+    switch(impl)
+    {
+    case Scalar:
+        return (true);
+#ifdef BYTESCAN_X86
+    case SSE2:
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("sse2"));
+    case AVX2:
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("avx2"));
+#endif
+    default:
+        return (false);
+    }
+}
+
+bool ByteScan::setImplementation(Implementation impl)
+{
+    const Functions *functions = functionsFor(impl);
+    if(functions == nullptr)
+        return (false);
+    currentFunctions().storeRelease(functions);
+    return (true);
+}
+
+QString ByteScan::implementationName(Implementation impl)
+{
+    switch(impl)
+    {
+    case SSE2:
+        return (QLatin1String("SSE2"));
+    case AVX2:
+        return (QLatin1String("AVX2"));
+    default:
+        return (QLatin1String("scalar"));
+    }
+}
+
+const char *ByteScan::findByte(const char *pos, const char *end, char c)
+{
+    return (current()->findByte(pos, end, c));
+}
+
+int ByteScan::countByte(const char *pos, const char *end, char c)
+{
+    return (current()->countByte(pos, end, c));
+}
+
+const char *ByteScan::findBlank(const char *pos, const char *end)
+{
+    return (current()->findBlank(pos, end));
+}
+
+const char *ByteScan::skipBlanks(const char *pos, const char *end)
+{
+    return (current()->skipBlanks(pos, end));
+}
+
+bool ByteScan::nextLine(const char *&pos, const char *end, Range &line)
+{
+    const Functions *functions = current();
+    while(pos < end)
+    {
+        const char *nl = functions->findByte(pos, end, '\n');
+        line.begin     = pos;
+        line.end       = nl;
+        pos            = (nl < end) ? nl + 1 : end;
+        if(line.end > line.begin)
+            return (true);
+    }
+    return (false);
+}
+
+QVector<ByteScan::Range> ByteScan::splitLines(const QByteArray &text)
+{
+    QVector<Range> lines;
+    const char    *pos = text.constData();
+    const char    *end = pos + text.size();
+    Range          line;
+    while(nextLine(pos, end, line))
+        lines.append(line);
+    return (lines);
+}
+
+int ByteScan::splitFields(const char *pos, const char *end, Range *fields,
+                          int count)
+{
+    const Functions *functions = current();
+    int              found     = 0;
+    while(found < count)
+    {
+        pos = functions->skipBlanks(pos, end);
+        if(pos == end)
+            break;
+        fields[found].begin = pos;
+        pos                 = functions->findBlank(pos, end);
+        fields[found].end   = pos;
+        found++;
+    }
+    return (found);
+}
+
+bool ByteScan::parseNumber(const char *pos, const char *end, quint64 &value)
+{
+    // Bail (if applicable).
+    value = 0;
+    if(pos >= end)
+        return (false);
+
+    bool overflow = false;
+    for(; pos < end; pos++)
+    {
+        const unsigned digit = static_cast<unsigned char>(*pos - '0');
+        if(digit > 9)
+        {
+            value = 0;
+            return (false);
+        }
+        if(value > (Q_UINT64_C(18446744073709551615) - digit) / 10)
+            overflow = true;
+        value = value * 10 + digit;
+    }
+    if(overflow)
+        value = 0;
+    return (true);
+}
@@ -0,0 +1,102 @@
+#ifndef BYTESCAN_H
+#define BYTESCAN_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+/*!
+ * \ingroup misc
+ * \brief The ByteScan functions search byte buffers for newlines, tabs, and
+ * blank-separated fields; they are used to parse the output of the tarsnap
+ * CLI without converting it to QString first.
+ *
+ * On x86 there are SSE2 and AVX2 versions which compare 16 or 32 bytes at a
+ * time; the fastest version which is supported by the CPU is chosen the
+ * first time that any function is called.  Other platforms use the scalar
+ * versions.
+ *
+ * "Blank" means any of <tt>' ', '\\t', '\\n', '\\v', '\\f', '\\r'</tt> (i.e.
+ * QRegExp's \c \\s for ASCII text).  Every range is [begin, end); functions
+ * which search return \c end if nothing was found.
+ */
+class ByteScan
+{
+public:
+    //! An implementation of the search functions.
+    enum Implementation
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    //! A range of bytes within a larger buffer.
+    struct Range
+    {
+        const char *begin;
+        const char *end;
+
+        //! Returns the number of bytes.
+        int size() const { return (static_cast<int>(end - begin)); }
+        //! Returns a QByteArray which refers to the buffer (without copying
+        //! it), so it must not outlive the buffer.
+        QByteArray bytes() const
+        {
+            return (QByteArray::fromRawData(begin, size()));
+        }
+        //! Decodes the range as UTF-8.
+        QString toString() const { return (QString::fromUtf8(begin, size())); }
+    };
+
+    //! Returns the implementation which is being used.
+    static Implementation implementation();
+    //! Returns whether the CPU supports \c impl.
+    static bool isSupported(Implementation impl);
+    //! Uses \c impl (if it is supported) instead of the automatic choice;
+    //! intended for tests and benchmarks.
+    static bool setImplementation(Implementation impl);
+    //! Returns the name of \c impl.
+    static QString implementationName(Implementation impl);
+
+    //! Returns whether \c c is a blank.
+    static bool isBlank(char c)
+    {
+        // ' ', or '\t' to '\r'.
+        const unsigned char u = static_cast<unsigned char>(c);
+        return ((u == ' ') || (static_cast<unsigned char>(u - '\t') <= 4));
+    }
+
+    //! Returns the first \c c in [pos, end).
+    static const char *findByte(const char *pos, const char *end, char c);
+    //! Returns the number of times that \c c occurs in [pos, end).
+    static int countByte(const char *pos, const char *end, char c);
+    //! Returns the first blank in [pos, end).
+    static const char *findBlank(const char *pos, const char *end);
+    //! Returns the first non-blank in [pos, end).
+    static const char *skipBlanks(const char *pos, const char *end);
+
+    //! Finds the next non-empty line at or after \c pos (without the
+    //! newline), and moves \c pos to the start of the following line.
+    //! Returns false if there are no more lines.
+    static bool nextLine(const char *&pos, const char *end, Range &line);
+    //! Returns the non-empty lines of \c text; equivalent to
+    //! <tt>split('\\n', SKIP_EMPTY_PARTS)</tt>.  The ranges refer to \c text.
+    static QVector<Range> splitLines(const QByteArray &text);
+    //! Splits [pos, end) into (at most) \c count blank-separated fields,
+    //! and returns the number of fields which were found.  Anything after
+    //! the last field is not examined.
+    static int splitFields(const char *pos, const char *end, Range *fields,
+                           int count);
+
+    //! Parses a decimal number.  Returns false if [pos, end) is empty or
+    //! contains anything other than digits.  Like QByteArray::toULongLong(),
+    //! \c value is 0 if the number is too large.
+    static bool parseNumber(const char *pos, const char *end, quint64 &value);
+};
+
+#endif /* !BYTESCAN_H */
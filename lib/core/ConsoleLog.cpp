@@ -1,10 +1,6 @@
 #include "ConsoleLog.h"
 
-WARNINGS_DISABLE
-#include <QDebug>
-#include <QFile>
-#include <QIODevice>
-WARNINGS_ENABLE
+#include "ConsoleLogWriter.h"
 
 ConsoleLog *global_log = nullptr;
 
@@ -23,30 +19,28 @@ void ConsoleLog::destroy()
     global_log = nullptr;
 }
 
-ConsoleLog::ConsoleLog() : _writeToFile(false)
+ConsoleLog::ConsoleLog() : _writeToFile(0), _writer(new ConsoleLogWriter())
 {
 }
 
+ConsoleLog::~ConsoleLog()
+{
+    // This writes any remaining messages.
+    delete _writer;
+}
+
 void ConsoleLog::saveLogMessage(const QString &msg)
 {
-    if(!_writeToFile)
+    if(_writeToFile.loadAcquire() == 0)
         return;
 
-    QFile logFile(_filename);
-    if(!logFile.open(QIODevice::Append | QIODevice::Text)
-       && !logFile.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        qDebug() << "Error saving Console Log message: cannot open log file "
-                        + logFile.fileName();
-        return;
-    }
-    logFile.write(QByteArray(msg.toLatin1()));
-    logFile.close();
+    _writer->enqueue(msg.toLatin1());
 }
 
 void ConsoleLog::setFilename(const QString &filename)
 {
     _filename = filename;
+    _writer->setFilename(filename);
 }
 
 QString ConsoleLog::getLogFile()
@@ -56,5 +50,17 @@ QString ConsoleLog::getLogFile()
 
 void ConsoleLog::setWriteToFile(bool writeToFile)
 {
-    _writeToFile = writeToFile;
+    // The thread is only needed once we write something.
+    if(writeToFile && !_writer->isRunning())
+        _writer->start(QThread::LowPriority);
+    _writeToFile.storeRelease(writeToFile ? 1 : 0);
+
+    // Finish writing everything from before.
+    if(!writeToFile)
+        _writer->flush();
+}
+
+void ConsoleLog::flush()
+{
+    _writer->flush();
 }
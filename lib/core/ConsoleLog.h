@@ -4,6 +4,7 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QAtomicInt>
 #include <QByteArray>
 #include <QChar>
 #include <QLatin1String>
@@ -12,6 +13,9 @@ WARNINGS_DISABLE
 #include <QStringRef>
 WARNINGS_ENABLE
 
+/* Forward declaration(s). */
+class ConsoleLogWriter;
+
 /* Set up global ConsoleLog. */
 class ConsoleLog;
 extern ConsoleLog *global_log;
@@ -21,6 +25,9 @@ extern ConsoleLog *global_log;
  * \ingroup background-tasks
  * \brief The ConsoleLog is a QObject which will emit a message, and can
  * save messages to a log file if desired.
+ *
+ * Saving is done by a ConsoleLogWriter thread, so logging from any thread
+ * does not wait for the disk.
  */
 class ConsoleLog : public QObject
 {
@@ -28,6 +35,7 @@ class ConsoleLog : public QObject
 
 public:
     ConsoleLog();
+    ~ConsoleLog() override;
 
     //! Initialize the global ConsoleLog object.
     static void initializeConsoleLog();
@@ -45,6 +53,9 @@ public:
     //! Write log messages to a file.
     void setWriteToFile(bool writeToFile);
 
+    //! Blocks until all messages so far have been written to the file.
+    void flush();
+
     //! Saves and emits a message.
     //! @{
     inline ConsoleLog &operator<<(QChar t)
@@ -164,8 +175,9 @@ signals:
 private:
     void saveLogMessage(const QString &msg);
 
-    QString _filename;
-    bool    _writeToFile;
+    QString           _filename;
+    QAtomicInt        _writeToFile;
+    ConsoleLogWriter *_writer;
 };
 
 #endif /* CONSOLELOG_H */
@@ -0,0 +1,221 @@
+#include "ConsoleLogWriter.h"
+
+WARNINGS_DISABLE
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIODevice>
+#include <QLatin1String>
+#include <QMutexLocker>
+WARNINGS_ENABLE
+
+ConsoleLogWriter::ConsoleLogWriter(QObject *parent)
+    : QThread(parent),
+      _tail(new Node),
+      _queuedBytes(0),
+      _stopRequested(0),
+      _flushRequests(0),
+      _flushesDone(0),
+      _file(nullptr)
+{
+    // The queue always contains a "stub" node.
+    _tail->next.storeRelease(nullptr);
+    _head.storeRelease(_tail);
+}
+
+ConsoleLogWriter::~ConsoleLogWriter()
+{
+    stop();
+
+    // Anything left over was queued after stopping.
+    QByteArray data;
+    while(pop(data))
+    {
+    }
+    delete _tail;
+    delete _file;
+}
+
+void ConsoleLogWriter::setFilename(const QString &filename)
+{
+    flush();
+
+    QMutexLocker locker(&_mutex);
+    _filename = filename;
+}
+
+void ConsoleLogWriter::enqueue(const QByteArray &data)
+{
+    Node *node = new Node;
+    node->data = data;
+    node->next.storeRelease(nullptr);
+
+    // Link the node after the previous head.
+    Node *prev = _head.fetchAndStoreAcqRel(node);
+    prev->next.storeRelease(node);
+
+    // Normally the thread picks this up by itself; only wake it once per
+    // CONSOLELOG_FLUSH_BYTES.
+    const int size   = data.size();
+    const int queued = _queuedBytes.fetchAndAddRelaxed(size) + size;
+    if((queued >= CONSOLELOG_FLUSH_BYTES)
+       && (queued - size < CONSOLELOG_FLUSH_BYTES))
+    {
+        QMutexLocker locker(&_mutex);
+        _wake.wakeAll();
+    }
+}
+
+void ConsoleLogWriter::flush()
+{
+    // Bail (if applicable).
+    if(!isRunning() || (QThread::currentThread() == this))
+        return;
+
+    QMutexLocker  locker(&_mutex);
+    const quint64 request = ++_flushRequests;
+    _wake.wakeAll();
+    while(isRunning() && (_flushesDone < request))
+        _flushed.wait(&_mutex, CONSOLELOG_FLUSH_MS);
+}
+
+void ConsoleLogWriter::stop()
+{
+    // Bail (if applicable).
+    if(!isRunning())
+        return;
+
+    _stopRequested.storeRelease(1);
+    _mutex.lock();
+    _wake.wakeAll();
+    _mutex.unlock();
+    wait();
+}
+
+bool ConsoleLogWriter::pop(QByteArray &data)
+{
+    Node *tail = _tail;
+    Node *next = tail->next.loadAcquire();
+    if(next == nullptr)
+        return (false);
+
+    // The next node becomes the new stub.
+    data = next->data;
+    next->data.clear();
+    _tail = next;
+    delete tail;
+    return (true);
+}
+
+void ConsoleLogWriter::run()
+{
+    QElapsedTimer sinceWrite;
+    sinceWrite.start();
+
+    QByteArray data;
+    while(true)
+    {
+        _mutex.lock();
+        const QString filename      = _filename;
+        const quint64 flushRequests = _flushRequests;
+        const bool    flushing      = (flushRequests != _flushesDone);
+        _mutex.unlock();
+        const bool stopping = (_stopRequested.loadAcquire() != 0);
+
+        // Take everything which has been queued so far.
+        int taken = 0;
+        while(pop(data))
+        {
+            _buffer.append(data);
+            taken += data.size();
+        }
+        if(taken > 0)
+            _queuedBytes.fetchAndAddRelaxed(-taken);
+
+        if(!_buffer.isEmpty()
+           && (stopping || flushing
+               || (_buffer.size() >= CONSOLELOG_FLUSH_BYTES)
+               || (sinceWrite.elapsed() >= CONSOLELOG_FLUSH_MS)))
+        {
+            writeBuffer(filename);
+            sinceWrite.restart();
+        }
+
+        _mutex.lock();
+        if(flushing)
+        {
+            _flushesDone = flushRequests;
+            _flushed.wakeAll();
+        }
+        if(!stopping && (_flushRequests == _flushesDone)
+           && (_stopRequested.loadAcquire() == 0))
+            _wake.wait(&_mutex, CONSOLELOG_FLUSH_MS);
+        _mutex.unlock();
+
+        if(stopping)
+            break;
+    }
+
+    // Release anybody who is still waiting.
+    _mutex.lock();
+    _flushesDone = _flushRequests;
+    _flushed.wakeAll();
+    _mutex.unlock();
+
+    delete _file;
+    _file = nullptr;
+}
+
+void ConsoleLogWriter::writeBuffer(const QString &filename)
+{
+    // (Re)open the file (if applicable).
+    if((_file == nullptr) || (filename != _openFilename))
+    {
+        delete _file;
+        _file         = new QFile(filename);
+        _openFilename = filename;
+        if(!_file->open(QIODevice::Append | QIODevice::Text)
+           && !_file->open(QIODevice::WriteOnly | QIODevice::Text))
+        {
+            qDebug() << "Error saving Console Log message: cannot open log file"
+                     << filename;
+            delete _file;
+            _file = nullptr;
+            _buffer.clear();
+            return;
+        }
+    }
+
+    if(_file->size() + _buffer.size() > CONSOLELOG_MAX_FILE_SIZE)
+    {
+        rotate();
+        if(_file == nullptr)
+        {
+            _buffer.clear();
+            return;
+        }
+    }
+
+    _file->write(_buffer);
+    _file->flush();
+    _buffer.clear();
+}
+
+void ConsoleLogWriter::rotate()
+{
+    // Keep one old file.
+    _file->close();
+    const QString oldFilename = _openFilename + QLatin1String(".1");
+    QFile::remove(oldFilename);
+    if(!QFile::rename(_openFilename, oldFilename))
+        qDebug() << "Error rotating Console Log file" << _openFilename;
+
+    if(!_file->open(QIODevice::WriteOnly | QIODevice::Truncate
+                    | QIODevice::Text))
+    {
+        qDebug() << "Error saving Console Log message: cannot open log file"
+                 << _openFilename;
+        delete _file;
+        _file = nullptr;
+    }
+}
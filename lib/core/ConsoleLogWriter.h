@@ -0,0 +1,95 @@
+#ifndef CONSOLELOGWRITER_H
+#define CONSOLELOGWRITER_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class QFile;
+
+//! Write the buffer once it holds this many bytes.
+#define CONSOLELOG_FLUSH_BYTES (64 * 1024)
+//! Write the buffer at least this often (in ms).
+#define CONSOLELOG_FLUSH_MS 500
+//! Rotate the log file (to FILENAME.1) once it reaches this size.
+#define CONSOLELOG_MAX_FILE_SIZE (10 * 1024 * 1024)
+
+/*!
+ * \ingroup background-tasks
+ * \brief The ConsoleLogWriter is a QThread which appends messages to the
+ * log file.
+ *
+ * Messages are passed through a lock-free multiple-producer single-consumer
+ * queue, so enqueue() does not take any locks or perform any system calls
+ * (other than waking the thread when a lot of data is waiting).  The thread
+ * keeps the file open, writes in large chunks, and rotates the file when it
+ * becomes too large.
+ */
+class ConsoleLogWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit ConsoleLogWriter(QObject *parent = nullptr);
+    ~ConsoleLogWriter() override;
+
+    //! Sets the log filename; messages which were already queued are
+    //! written to the previous file.
+    void setFilename(const QString &filename);
+
+    //! Queues a message; safe to call from any thread.
+    void enqueue(const QByteArray &data);
+
+    //! Blocks until every message queued so far has been written.  Must not
+    //! be called from the writer thread.
+    void flush();
+
+    //! Writes any remaining messages, then stops the thread.
+    void stop();
+
+protected:
+    //! Writes messages until stop() is called.
+    void run() override;
+
+private:
+    struct Node
+    {
+        QAtomicPointer<Node> next;
+        QByteArray           data;
+    };
+
+    // Queue: producers push at _head, the writer pops at _tail.
+    QAtomicPointer<Node> _head;
+    Node                *_tail;
+    QAtomicInt           _queuedBytes;
+    QAtomicInt           _stopRequested;
+
+    // Protected by _mutex.
+    QMutex         _mutex;
+    QWaitCondition _wake;
+    QWaitCondition _flushed;
+    QString        _filename;
+    quint64        _flushRequests;
+    quint64        _flushesDone;
+
+    // Only used by the writer thread.
+    QFile     *_file;
+    QString    _openFilename;
+    QByteArray _buffer;
+
+    bool pop(QByteArray &data);
+    void writeBuffer(const QString &filename);
+    void rotate();
+};
+
+#endif /* !CONSOLELOGWRITER_H */
@@ -7,15 +7,27 @@ WARNINGS_DISABLE
 #include <QDateTime>
 #include <QMetaObject>
 #include <QString>
+#include <QUuid>
 WARNINGS_ENABLE
 
 //! Info to add to the log.
 struct LogEntry
 {
+    //! Constructor.
+    LogEntry() {}
+    //! Constructor.
+    LogEntry(const QDateTime &timestamp_, const QString &message_,
+             const QUuid &task_ = QUuid())
+        : timestamp(timestamp_), message(message_), task(task_)
+    {
+    }
+
     //! Time of the entry.
     QDateTime timestamp;
     //! Text to add.
     QString message;
+    //! Task which produced the entry (if any).
+    QUuid task;
 };
 
 Q_DECLARE_METATYPE(LogEntry)
@@ -0,0 +1,72 @@
+#include "LogRing.h"
+
+LogRing::LogRing(int capacity)
+    : _capacity(qMax(1, capacity)), _size(0), _end(0)
+{
+}
+
+int LogRing::capacity() const
+{
+    return (_capacity);
+}
+
+int LogRing::size() const
+{
+    return (_size);
+}
+
+bool LogRing::isFull() const
+{
+    return (_size == _capacity);
+}
+
+quint64 LogRing::firstSeq() const
+{
+    return (_end - static_cast<quint64>(_size));
+}
+
+quint64 LogRing::endSeq() const
+{
+    return (_end);
+}
+
+const LogEntry &LogRing::at(quint64 seq) const
+{
+    Q_ASSERT((seq >= firstSeq()) && (seq < _end));
+    return (_entries.at(static_cast<int>(seq % _capacity)));
+}
+
+quint64 LogRing::append(const LogEntry &entry)
+{
+    const int slot = static_cast<int>(_end % _capacity);
+
+    // The storage grows until it reaches the capacity, then slots are reused.
+    if(slot == _entries.size())
+        _entries.append(entry);
+    else
+        _entries[slot] = entry;
+
+    if(_size < _capacity)
+        _size++;
+    return (_end++);
+}
+
+void LogRing::dropOldest()
+{
+    // Bail (if applicable).
+    if(_size == 0)
+        return;
+
+    // Release the memory held by the entry, but keep the slot.
+    const int slot = static_cast<int>(firstSeq() % _capacity);
+    _entries[slot] = LogEntry();
+    _size--;
+}
+
+void LogRing::clear()
+{
+    _entries.clear();
+    _size = 0;
+    // Keep the slots aligned with the sequence numbers.
+    _end += static_cast<quint64>(_capacity) - (_end % _capacity);
+}
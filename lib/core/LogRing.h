@@ -0,0 +1,56 @@
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "LogEntry.h"
+
+/*!
+ * \ingroup misc
+ * \brief The LogRing is a fixed-capacity ring buffer of LogEntry records.
+ *
+ * Every entry receives a sequence number when it is appended; sequence
+ * numbers keep increasing, so they remain valid identifiers after older
+ * entries have been dropped.
+ */
+class LogRing
+{
+public:
+    //! Constructor.
+    explicit LogRing(int capacity);
+
+    //! Returns the maximum number of entries.
+    int capacity() const;
+    //! Returns the number of entries.
+    int size() const;
+    //! Returns whether the ring holds capacity() entries.
+    bool isFull() const;
+
+    //! Returns the sequence number of the oldest entry.
+    quint64 firstSeq() const;
+    //! Returns the sequence number which the next entry will receive.
+    quint64 endSeq() const;
+    //! Returns the entry with sequence number \c seq, which must be in
+    //! [firstSeq(), endSeq()).
+    const LogEntry &at(quint64 seq) const;
+
+    //! Appends an entry (dropping the oldest entry if the ring is full), and
+    //! returns its sequence number.
+    quint64 append(const LogEntry &entry);
+    //! Drops the oldest entry.
+    void dropOldest();
+    //! Removes all entries; sequence numbers are not reused.
+    void clear();
+
+private:
+    QVector<LogEntry> _entries;
+    int               _capacity;
+    int               _size;
+    quint64           _end;
+};
+
+#endif /* !LOGRING_H */
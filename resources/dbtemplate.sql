@@ -9,7 +9,7 @@ BEGIN TRANSACTION;
 CREATE TABLE `version` (
 	`version`	INTEGER NOT NULL
 );
-INSERT INTO version VALUES (4);
+INSERT INTO version VALUES (7);
 CREATE TABLE `jobs` (
 	`name`	TEXT NOT NULL,
 	`urls`	TEXT,
@@ -24,6 +24,7 @@ CREATE TABLE `jobs` (
 	`settingShowHidden`			INTEGER,
 	`settingShowSystem`			INTEGER,
 	`settingHideSymlinks`		INTEGER,
+	`lastBackupFingerprint`		TEXT,
 	PRIMARY KEY(name)
 );
 CREATE TABLE `archives` (
@@ -38,6 +39,8 @@ CREATE TABLE `archives` (
 	`command`	TEXT,
 	`contents`	TEXT,
 	`jobRef`	TEXT,
+	`listingBase`	TEXT,
+	`listingIds`	BLOB,
 	PRIMARY KEY(name),
 	FOREIGN KEY(jobRef) REFERENCES jobs(name)
 );
@@ -45,4 +48,25 @@ CREATE TABLE `journal` (
 	`timestamp`	INTEGER NOT NULL,
 	`log`	TEXT
 );
+CREATE TABLE `filePaths` (
+	`id`	INTEGER PRIMARY KEY,
+	`path`	TEXT NOT NULL UNIQUE
+);
+CREATE TABLE `fileLines` (
+	`lineRef`	INTEGER PRIMARY KEY,
+	`pathRef`	INTEGER,
+	FOREIGN KEY(lineRef) REFERENCES listingLines(id),
+	FOREIGN KEY(pathRef) REFERENCES filePaths(id)
+);
+CREATE INDEX `fileLinesPath` ON `fileLines` (`pathRef`);
+CREATE TABLE `listingLines` (
+	`id`	INTEGER PRIMARY KEY,
+	`hash`	BLOB NOT NULL UNIQUE,
+	`line`	BLOB NOT NULL
+);
+CREATE INDEX `archivesListingBase` ON `archives` (`listingBase`);
+CREATE TRIGGER `listingLinesDelete` AFTER DELETE ON `listingLines`
+BEGIN
+	DELETE FROM fileLines WHERE lineRef = old.id;
+END;
 COMMIT;
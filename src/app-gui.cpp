@@ -20,6 +20,7 @@ WARNINGS_ENABLE
 #include "persistentmodel/journal.h"
 #include "taskmanager.h"
 #include "translator.h"
+#include "updatecoalescer.h"
 #include "widgets/mainwindow.h"
 
 AppGui::AppGui(int &argc, char **argv, struct optparse *opt)
@@ -180,26 +181,37 @@ void AppGui::showMainWindow()
     _mainWindow = new MainWindow();
     Q_ASSERT(_mainWindow != nullptr);
 
+    // The number of tasks and the status message can change many times per
+    // frame (e.g. while fetching the stats of many archives), so only the
+    // latest values reach the MainWindow.
+    UpdateCoalescer *updates = new UpdateCoalescer(_mainWindow);
+    connect(_taskManager, &TaskManager::numTasks, updates,
+            &UpdateCoalescer::setNumTasks, Qt::QueuedConnection);
+    connect(_taskManager, &TaskManager::message, updates,
+            &UpdateCoalescer::setMessage, Qt::QueuedConnection);
+    connect(updates, &UpdateCoalescer::numTasks, _mainWindow,
+            &MainWindow::updateNumTasks);
+    connect(updates, &UpdateCoalescer::message, _mainWindow,
+            &MainWindow::updateStatusMessage);
+
     connect(_mainWindow, &MainWindow::tarsnapVersionRequested, _taskManager,
             &TaskManager::tarsnapVersionFind, Qt::QueuedConnection);
     connect(_taskManager, &TaskManager::tarsnapVersionFound, _mainWindow,
             &MainWindow::tarsnapVersionResponse, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::backupNow, _taskManager,
             &TaskManager::backupNow, Qt::QueuedConnection);
+    connect(_mainWindow, &MainWindow::estimateUpload, _taskManager,
+            &TaskManager::estimateUpload, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::getArchives, _taskManager,
             &TaskManager::getArchives, Qt::QueuedConnection);
-    connect(_taskManager, &TaskManager::archiveList, _mainWindow,
-            &MainWindow::archiveList, Qt::QueuedConnection);
-    connect(_taskManager, &TaskManager::archiveAdded, _mainWindow,
-            &MainWindow::addArchive, Qt::QueuedConnection);
+    connect(_taskManager, &TaskManager::archiveChanges, _mainWindow,
+            &MainWindow::archiveChanges, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::deleteArchives, _taskManager,
             &TaskManager::deleteArchives, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::loadArchiveStats, _taskManager,
             &TaskManager::getArchiveStats, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::loadArchiveContents, _taskManager,
             &TaskManager::getArchiveContents, Qt::QueuedConnection);
-    connect(_taskManager, &TaskManager::numTasks, _mainWindow,
-            &MainWindow::updateNumTasks, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::getOverallStats, _taskManager,
             &TaskManager::getOverallStats, Qt::QueuedConnection);
     connect(_taskManager, &TaskManager::overallStats, _mainWindow,
@@ -214,8 +226,8 @@ void AppGui::showMainWindow()
             Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::stopTasks, _taskManager,
             &TaskManager::stopTasks, Qt::QueuedConnection);
-    connect(_taskManager, &TaskManager::jobList, _mainWindow,
-            &MainWindow::jobList, Qt::QueuedConnection);
+    connect(_taskManager, &TaskManager::jobChanges, _mainWindow,
+            &MainWindow::jobChanges, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::deleteJob, _taskManager,
             &TaskManager::deleteJob, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::jobAdded, _taskManager,
@@ -224,8 +236,6 @@ void AppGui::showMainWindow()
             &TaskManager::getKeyId, Qt::QueuedConnection);
     connect(_taskManager, &TaskManager::keyId, _mainWindow,
             &MainWindow::saveKeyId, Qt::QueuedConnection);
-    connect(_taskManager, &TaskManager::message, _mainWindow,
-            &MainWindow::updateStatusMessage, Qt::QueuedConnection);
     connect(_taskManager, &TaskManager::error, _mainWindow,
             &MainWindow::tarsnapError, Qt::QueuedConnection);
     connect(_notification, &Notification::activated, _mainWindow,
@@ -234,7 +244,7 @@ void AppGui::showMainWindow()
             &MainWindow::handle_notification_clicked, Qt::QueuedConnection);
     connect(_journal, &Journal::journal, _mainWindow, &MainWindow::setJournal,
             Qt::QueuedConnection);
-    connect(_journal, &Journal::logEntry, _mainWindow,
+    connect(_journal, &Journal::logEntries, _mainWindow,
             &MainWindow::appendToJournalLog, Qt::QueuedConnection);
     connect(_mainWindow, &MainWindow::clearJournal, _journal, &Journal::purge,
             Qt::QueuedConnection);
@@ -242,6 +252,10 @@ void AppGui::showMainWindow()
             &TaskManager::findMatchingArchives, Qt::QueuedConnection);
     connect(_taskManager, &TaskManager::matchingArchives, _mainWindow,
             &MainWindow::matchingArchives, Qt::QueuedConnection);
+    connect(_mainWindow, &MainWindow::findFileVersions, _taskManager,
+            &TaskManager::findFileVersions, Qt::QueuedConnection);
+    connect(_taskManager, &TaskManager::fileVersions, _mainWindow,
+            &MainWindow::fileVersions, Qt::QueuedConnection);
 
     connect(_mainWindow, &MainWindow::taskRequested, _taskManager,
             &TaskManager::queueGuiTask, Qt::QueuedConnection);
@@ -0,0 +1,180 @@
+#include "archivediff.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+#include <cstring>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+
+#include "archivelisting.h"
+
+// Orders paths by their bytes, like memcmp().
+static int comparePaths(const char *a, int aSize, const char *b, int bSize)
+{
+    const int result =
+        std::memcmp(a, b, static_cast<size_t>(qMin(aSize, bSize)));
+    if(result != 0)
+        return (result);
+    return (aSize - bSize);
+}
+
+ArchiveDiff::ArchiveDiff(const ArchiveListingPtr &from,
+                         const ArchiveListingPtr &to)
+    : _from(from),
+      _to(to),
+      _addedCount(0),
+      _removedCount(0),
+      _modifiedCount(0),
+      _sizeDelta(0)
+{
+    QVector<Path> fromPaths;
+    QVector<Path> toPaths;
+    if(_from)
+        fromPaths = sortedPaths(*_from);
+    if(_to)
+        toPaths = sortedPaths(*_to);
+
+    // Merge the sorted paths; a path which is in both listings only
+    // changed if its line did.
+    int i = 0;
+    int j = 0;
+    while((i < fromPaths.size()) || (j < toPaths.size()))
+    {
+        int order;
+        if(i == fromPaths.size())
+            order = 1;
+        else if(j == toPaths.size())
+            order = -1;
+        else
+            order = comparePaths(fromPaths.at(i).data, fromPaths.at(i).size,
+                                 toPaths.at(j).data, toPaths.at(j).size);
+
+        if(order < 0)
+        {
+            addEntry(fromPaths.at(i++).row, -1);
+        }
+        else if(order > 0)
+        {
+            addEntry(-1, toPaths.at(j++).row);
+        }
+        else
+        {
+            const int fromRow = fromPaths.at(i++).row;
+            const int toRow   = toPaths.at(j++).row;
+            if(_from->line(fromRow) != _to->line(toRow))
+                addEntry(fromRow, toRow);
+        }
+    }
+    _entries.squeeze();
+}
+
+int ArchiveDiff::count() const
+{
+    return (_entries.size());
+}
+
+ArchiveDiff::Change ArchiveDiff::change(int i) const
+{
+    const Entry &entry = _entries.at(i);
+    if(entry.fromRow == -1)
+        return (ADDED);
+    if(entry.toRow == -1)
+        return (REMOVED);
+    return (MODIFIED);
+}
+
+QString ArchiveDiff::path(int i) const
+{
+    const Entry &entry = _entries.at(i);
+    if(entry.toRow != -1)
+        return (QString::fromUtf8(_to->path(entry.toRow)));
+    return (QString::fromUtf8(_from->path(entry.fromRow)));
+}
+
+int ArchiveDiff::fromRow(int i) const
+{
+    return (_entries.at(i).fromRow);
+}
+
+int ArchiveDiff::toRow(int i) const
+{
+    return (_entries.at(i).toRow);
+}
+
+quint64 ArchiveDiff::fromSize(int i) const
+{
+    return (_entries.at(i).fromSize);
+}
+
+quint64 ArchiveDiff::toSize(int i) const
+{
+    return (_entries.at(i).toSize);
+}
+
+int ArchiveDiff::addedCount() const
+{
+    return (_addedCount);
+}
+
+int ArchiveDiff::removedCount() const
+{
+    return (_removedCount);
+}
+
+int ArchiveDiff::modifiedCount() const
+{
+    return (_modifiedCount);
+}
+
+qint64 ArchiveDiff::sizeDelta() const
+{
+    return (_sizeDelta);
+}
+
+ArchiveListingPtr ArchiveDiff::from() const
+{
+    return (_from);
+}
+
+ArchiveListingPtr ArchiveDiff::to() const
+{
+    return (_to);
+}
+
+QVector<ArchiveDiff::Path>
+ArchiveDiff::sortedPaths(const ArchiveListing &listing)
+{
+    // The paths refer to the listing, which is kept by the ArchiveDiff.
+    QVector<Path> paths(listing.count());
+    for(int row = 0; row < paths.size(); row++)
+    {
+        const QByteArray path = listing.path(row);
+        paths[row].data       = path.constData();
+        paths[row].size       = path.size();
+        paths[row].row        = row;
+    }
+    std::sort(paths.begin(), paths.end(), [](const Path &a, const Path &b) {
+        return (comparePaths(a.data, a.size, b.data, b.size) < 0);
+    });
+    return (paths);
+}
+
+void ArchiveDiff::addEntry(int fromRow, int toRow)
+{
+    Entry entry;
+    entry.fromRow  = fromRow;
+    entry.toRow    = toRow;
+    entry.fromSize = (fromRow == -1) ? 0 : _from->stat(fromRow).size;
+    entry.toSize   = (toRow == -1) ? 0 : _to->stat(toRow).size;
+    _entries.append(entry);
+
+    if(fromRow == -1)
+        _addedCount++;
+    else if(toRow == -1)
+        _removedCount++;
+    else
+        _modifiedCount++;
+    _sizeDelta += static_cast<qint64>(entry.toSize)
+                  - static_cast<qint64>(entry.fromSize);
+}
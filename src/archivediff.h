@@ -0,0 +1,105 @@
+#ifndef ARCHIVEDIFF_H
+#define ARCHIVEDIFF_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/archivediffptr.h"
+#include "messages/archivelistingptr.h"
+
+/* Forward declaration(s). */
+class ArchiveListing;
+
+Q_DECLARE_METATYPE(ArchiveDiffPtr)
+
+/*!
+ * \ingroup data
+ * \brief The ArchiveDiff lists the files which were added, removed, or
+ * modified between two ArchiveListings.
+ *
+ * The lines of each listing are sorted by path (comparing the bytes of the
+ * paths in the listings, without copying them), and the two sorted lists
+ * are merged in a single pass.  Besides the listings themselves, this
+ * needs a few integers per line, and only the changed files are kept.  A
+ * file is modified if any field of its line changed.
+ */
+class ArchiveDiff
+{
+public:
+    //! How a file changed.
+    enum Change
+    {
+        ADDED,
+        REMOVED,
+        MODIFIED
+    };
+
+    //! Constructor; compares every line of \c from and \c to.
+    ArchiveDiff(const ArchiveListingPtr &from, const ArchiveListingPtr &to);
+
+    //! Returns the number of changed files.
+    int count() const;
+    //! Returns how the \c i-th file changed.
+    Change change(int i) const;
+    //! Returns the path of the \c i-th file.
+    QString path(int i) const;
+    //! Returns the line of the older listing for the \c i-th file, or -1
+    //! if it was added.
+    int fromRow(int i) const;
+    //! Returns the line of the newer listing for the \c i-th file, or -1
+    //! if it was removed.
+    int toRow(int i) const;
+    //! Returns the size of the \c i-th file in the older listing (or 0).
+    quint64 fromSize(int i) const;
+    //! Returns the size of the \c i-th file in the newer listing (or 0).
+    quint64 toSize(int i) const;
+
+    //! Returns the number of files which were added.
+    int addedCount() const;
+    //! Returns the number of files which were removed.
+    int removedCount() const;
+    //! Returns the number of files which were modified.
+    int modifiedCount() const;
+    //! Returns the sum of the size changes of every file.
+    qint64 sizeDelta() const;
+
+    //! Returns the older listing.
+    ArchiveListingPtr from() const;
+    //! Returns the newer listing.
+    ArchiveListingPtr to() const;
+
+private:
+    struct Entry
+    {
+        int     fromRow;
+        int     toRow;
+        quint64 fromSize;
+        quint64 toSize;
+    };
+
+    struct Path
+    {
+        const char *data;
+        int         size;
+        int         row;
+    };
+
+    ArchiveListingPtr _from;
+    ArchiveListingPtr _to;
+    QVector<Entry>    _entries;
+    int               _addedCount;
+    int               _removedCount;
+    int               _modifiedCount;
+    qint64            _sizeDelta;
+
+    static QVector<Path> sortedPaths(const ArchiveListing &listing);
+    void                 addEntry(int fromRow, int toRow);
+};
+
+#endif /* !ARCHIVEDIFF_H */
@@ -0,0 +1,158 @@
+#include "archivediffmodel.h"
+
+#include "archivediff.h"
+#include "archivedifftask.h"
+#include "humanbytes.h"
+#include "persistentmodel/archive.h"
+#include "tasks/tasks-utils.h"
+
+ArchiveDiffModel::ArchiveDiffModel(QObject *parent)
+    : QAbstractTableModel(parent), _task(nullptr)
+{
+}
+
+ArchiveDiffModel::~ArchiveDiffModel()
+{
+    stopTask();
+}
+
+int ArchiveDiffModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid() || !_diff)
+        return (0);
+    return (_diff->count());
+}
+
+int ArchiveDiffModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    return (SIZE_CHANGE + 1);
+}
+
+QVariant ArchiveDiffModel::data(const QModelIndex &index, int role) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || !_diff || (index.row() >= _diff->count()))
+        return (QVariant());
+
+    const int                 row    = index.row();
+    const ArchiveDiff::Change change = _diff->change(row);
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        switch(index.column())
+        {
+        case PATH:
+            return (_diff->path(row));
+        case CHANGE:
+            if(change == ArchiveDiff::ADDED)
+                return (tr("Added"));
+            else if(change == ArchiveDiff::REMOVED)
+                return (tr("Removed"));
+            else
+                return (tr("Modified"));
+        case SIZE:
+            if(change == ArchiveDiff::REMOVED)
+                return (humanBytes(_diff->fromSize(row)));
+            return (humanBytes(_diff->toSize(row)));
+        case SIZE_CHANGE:
+            if(_diff->toSize(row) >= _diff->fromSize(row))
+                return (QString("+")
+                        + humanBytes(_diff->toSize(row)
+                                     - _diff->fromSize(row)));
+            return (QString("-")
+                    + humanBytes(_diff->fromSize(row) - _diff->toSize(row)));
+        }
+        break;
+    case Qt::ToolTipRole:
+        if(index.column() == PATH)
+            return (_diff->path(row));
+        break;
+    case Qt::TextAlignmentRole:
+        if((index.column() == SIZE) || (index.column() == SIZE_CHANGE))
+            return (static_cast<int>(Qt::AlignRight | Qt::AlignVCenter));
+        break;
+    }
+    return (QVariant());
+}
+
+QVariant ArchiveDiffModel::headerData(int section, Qt::Orientation orientation,
+                                      int role) const
+{
+    if((role != Qt::DisplayRole) || (orientation != Qt::Horizontal))
+        return (QVariant());
+
+    switch(section)
+    {
+    case PATH:
+        return (tr("PATH"));
+    case CHANGE:
+        return (tr("CHANGE"));
+    case SIZE:
+        return (tr("SIZE"));
+    case SIZE_CHANGE:
+        return (tr("SIZE CHANGE"));
+    }
+    return (QVariant());
+}
+
+void ArchiveDiffModel::setArchives(const ArchivePtr &from,
+                                   const ArchivePtr &to)
+{
+    // Discard the previous comparison.
+    stopTask();
+    beginResetModel();
+    _diff.clear();
+    endResetModel();
+
+    // Bail (if applicable).
+    if(!from || !to)
+        return;
+
+    ArchiveDiffTask *task =
+        new ArchiveDiffTask(from->name(), to->name(), makeSpillDir());
+    connect(task, &ArchiveDiffTask::result, this,
+            [this, task](ArchiveDiffPtr diff) { setDiff(task, diff); },
+            Qt::QueuedConnection);
+    // The task is deleted by the TaskQueuer once it is done or canceled.
+    const auto forget = [this, task]() {
+        if(_task == task)
+            _task = nullptr;
+    };
+    connect(task, &BaseTask::dequeue, this, forget, Qt::QueuedConnection);
+    connect(task, &BaseTask::canceled, this, forget, Qt::QueuedConnection);
+
+    _task = task;
+    emit taskRequested(task);
+}
+
+ArchiveDiffPtr ArchiveDiffModel::diff() const
+{
+    return (_diff);
+}
+
+void ArchiveDiffModel::setDiff(ArchiveDiffTask      *task,
+                               const ArchiveDiffPtr &diff)
+{
+    // Bail (if applicable).
+    if(task != _task)
+        return;
+
+    beginResetModel();
+    _diff = diff;
+    endResetModel();
+
+    emit ready();
+}
+
+void ArchiveDiffModel::stopTask()
+{
+    // Bail (if applicable).
+    if(!_task)
+        return;
+
+    disconnect(_task, nullptr, this, nullptr);
+    emit cancelTaskRequested(_task, _task->uuid());
+    _task = nullptr;
+}
@@ -0,0 +1,82 @@
+#ifndef ARCHIVEDIFFMODEL_H
+#define ARCHIVEDIFFMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractTableModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QUuid>
+#include <QVariant>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/archivediffptr.h"
+#include "messages/archiveptr.h"
+
+/* Forward declaration(s). */
+class ArchiveDiffTask;
+class BaseTask;
+
+/*!
+ * \ingroup data
+ * \brief The ArchiveDiffModel is a QAbstractTableModel which shows the
+ * files which changed between two archives.
+ *
+ * The \ref ArchiveDiff is computed by an \ref ArchiveDiffTask in the
+ * background; the files are sorted by path.
+ */
+class ArchiveDiffModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    //! The columns of the table.
+    enum DiffColumns
+    {
+        PATH,
+        CHANGE,
+        SIZE,
+        SIZE_CHANGE
+    };
+
+    //! Constructor.
+    explicit ArchiveDiffModel(QObject *parent = nullptr);
+    ~ArchiveDiffModel() override;
+
+    //! Returns the number of changed files.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the number of columns (4).
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the path, change, size, or size change of a file.
+    QVariant data(const QModelIndex &index,
+                  int                role = Qt::DisplayRole) const override;
+    //! Returns the text for a header field.
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    //! Starts comparing the contents of \c from and \c to, which must have
+    //! been fetched.
+    void setArchives(const ArchivePtr &from, const ArchivePtr &to);
+    //! Returns the comparison, or a null ArchiveDiffPtr if it is still
+    //! running.
+    ArchiveDiffPtr diff() const;
+
+signals:
+    //! The changed files are shown.
+    void ready();
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
+private:
+    ArchiveDiffPtr   _diff;
+    ArchiveDiffTask *_task;
+
+    void setDiff(ArchiveDiffTask *task, const ArchiveDiffPtr &diff);
+    void stopTask();
+};
+
+#endif /* !ARCHIVEDIFFMODEL_H */
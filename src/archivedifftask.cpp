@@ -0,0 +1,85 @@
+#include "archivedifftask.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+#include <iterator>
+
+#include <QByteArray>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/taskoutput.h"
+
+#include "archivediff.h"
+#include "archivelisting.h"
+#include "persistentmodel/listingstore.h"
+#include "persistentmodel/persistentstore.h"
+
+ArchiveDiffTask::ArchiveDiffTask(const QString &from, const QString &to,
+                                 const QString &dirname)
+    : _from(from), _to(to), _dirname(dirname)
+{
+}
+
+void ArchiveDiffTask::run()
+{
+    QByteArray fromLines;
+    QByteArray toLines;
+    {
+        // Queries from this thread need a connection of their own.
+        StoreConnection       connection;
+        const QVector<qint64> fromIds = ListingStore::lineIds(_from);
+        const QVector<qint64> toIds   = ListingStore::lineIds(_to);
+
+        // Without ids (e.g. an empty listing), compare the whole contents.
+        if(fromIds.isEmpty() || toIds.isEmpty())
+        {
+            fromLines = ListingStore::load(_from);
+            toLines   = ListingStore::load(_to);
+        }
+        else
+        {
+            QVector<qint64> removed;
+            QVector<qint64> added;
+            std::set_difference(fromIds.begin(), fromIds.end(),
+                                toIds.begin(), toIds.end(),
+                                std::back_inserter(removed));
+            std::set_difference(toIds.begin(), toIds.end(), fromIds.begin(),
+                                fromIds.end(), std::back_inserter(added));
+            fromLines = ListingStore::lines(removed);
+            toLines   = ListingStore::lines(added);
+        }
+    }
+
+    // Keep the text in files, so that only the indexes use memory.
+    ArchiveListingPtr from(
+        new ArchiveListing(ArchiveListing::mapText(fromLines, _dirname)));
+    fromLines.clear();
+    ArchiveListingPtr to(
+        new ArchiveListing(ArchiveListing::mapText(toLines, _dirname)));
+    toLines.clear();
+
+    // Bail if requested.
+    if(static_cast<int>(_stopRequested) == 1)
+    {
+        emit canceled();
+        emit dequeue();
+        return;
+    }
+
+    ArchiveDiffPtr diff(new ArchiveDiff(from, to));
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+        emit canceled();
+    else
+        emit result(diff);
+
+    // We're finished.
+    emit dequeue();
+}
+
+void ArchiveDiffTask::stop()
+{
+    _stopRequested = 1;
+}
@@ -0,0 +1,56 @@
+#ifndef ARCHIVEDIFFTASK_H
+#define ARCHIVEDIFFTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+WARNINGS_ENABLE
+
+#include "messages/archivediffptr.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The ArchiveDiffTask compares the contents of two archives.
+ *
+ * Lines which are in both archives are the same files with the same
+ * metadata, so only the other lines are read from the \ref ListingStore.
+ * They are copied into memory-mapped temporary files and compared by an
+ * \ref ArchiveDiff.
+ */
+class ArchiveDiffTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    //! \param from the name of the older archive.
+    //! \param to the name of the newer archive.
+    //! \param dirname directory for the temporary files; if empty, the
+    //! lines are kept in memory.
+    ArchiveDiffTask(const QString &from, const QString &to,
+                    const QString &dirname);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task.
+    void stop() override;
+
+signals:
+    //! The changed files.
+    void result(ArchiveDiffPtr diff);
+
+private:
+    QString _from;
+    QString _to;
+    QString _dirname;
+
+    QAtomicInt _stopRequested;
+};
+
+#endif /* !ARCHIVEDIFFTASK_H */
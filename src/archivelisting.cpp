@@ -0,0 +1,138 @@
+#include "archivelisting.h"
+
+WARNINGS_DISABLE
+#include <QDir>
+#include <QTemporaryFile>
+WARNINGS_ENABLE
+
+#include "ByteScan.h"
+
+// Number of whitespace-separated fields before the filename: mode, links,
+// user, group, size, and three for the date.
+#define NUM_FIELDS 8
+
+// Returns the start of the filename in [start, end), or nullptr if the line
+// is not in the expected format.  If fields is not nullptr, it receives the
+// fields before the filename.
+static const char *findName(const char *start, const char *end,
+                            ByteScan::Range *fields = nullptr)
+{
+    ByteScan::Range unused[NUM_FIELDS];
+    if(fields == nullptr)
+        fields = unused;
+
+    // Bail (if applicable).  The mode must be at the start of the line.
+    if((start == end) || ByteScan::isBlank(*start))
+        return (nullptr);
+    if(ByteScan::splitFields(start, end, fields, NUM_FIELDS) < NUM_FIELDS)
+        return (nullptr);
+
+    // The filename is everything after the date.
+    const char *name = ByteScan::skipBlanks(fields[NUM_FIELDS - 1].end, end);
+    if(name == end)
+        return (nullptr);
+    return (name);
+}
+
+ArchiveListing::ArchiveListing(const TaskOutput &listing) : _listing(listing)
+{
+    const QByteArray text  = _listing.bytes();
+    const char      *start = text.constData();
+    const char      *end   = start + text.size();
+
+    // Counting the newlines first avoids reallocating the index.
+    _lineStarts.reserve(ByteScan::countByte(start, end, '\n') + 1);
+
+    // Lines which are not in the expected format are skipped.
+    const char     *pos = start;
+    ByteScan::Range line;
+    while(ByteScan::nextLine(pos, end, line))
+    {
+        if(findName(line.begin, line.end) != nullptr)
+            _lineStarts.append(static_cast<int>(line.begin - start));
+    }
+    _lineStarts.squeeze();
+}
+
+TaskOutput ArchiveListing::mapText(const QByteArray &text,
+                                   const QString    &dirname)
+{
+    // Bail (if applicable).
+    if(dirname.isEmpty() || text.isEmpty())
+        return (TaskOutput(text));
+
+    QTemporaryFile *file =
+        new QTemporaryFile(QDir(dirname).filePath("tarsnap-listing-XXXXXX"));
+    if(!file->open() || (file->write(text) != text.size()))
+    {
+        delete file;
+        return (TaskOutput(text));
+    }
+    return (TaskOutput(file));
+}
+
+int ArchiveListing::count() const
+{
+    return (_lineStarts.size());
+}
+
+QByteArray ArchiveListing::line(int row) const
+{
+    const QByteArray text  = _listing.bytes();
+    const char      *start = text.constData() + _lineStarts.at(row);
+    const char      *end   = text.constData() + text.size();
+    end                    = ByteScan::findByte(start, end, '\n');
+    return (QByteArray::fromRawData(start, static_cast<int>(end - start)));
+}
+
+FileStat ArchiveListing::stat(int row) const
+{
+    FileStat stat;
+    stat.size  = 0;
+    stat.links = 0;
+    parseLine(line(row), stat);
+    return (stat);
+}
+
+QByteArray ArchiveListing::path(int row) const
+{
+    const QByteArray bytes = line(row);
+    const char      *start = bytes.constData();
+    const char      *end   = start + bytes.size();
+    const char      *pos   = findName(start, end);
+    QByteArray       name =
+        QByteArray::fromRawData(pos, static_cast<int>(end - pos));
+
+    // A symlink is listed as "name -> target".
+    if(*start == 'l')
+    {
+        const int arrow = name.indexOf(" -> ");
+        if(arrow != -1)
+            name = QByteArray::fromRawData(pos, arrow);
+    }
+    return (name);
+}
+
+bool ArchiveListing::parseLine(const QByteArray &line, FileStat &stat)
+{
+    const char *start = line.constData();
+    const char *end   = start + line.size();
+
+    // Split the fields.
+    ByteScan::Range fields[NUM_FIELDS];
+    const char     *name = findName(start, end, fields);
+    if(name == nullptr)
+        return (false);
+
+    stat.mode  = fields[0].toString();
+    stat.user  = fields[2].toString();
+    stat.group = fields[3].toString();
+    ByteScan::parseNumber(fields[1].begin, fields[1].end, stat.links);
+    ByteScan::parseNumber(fields[4].begin, fields[4].end, stat.size);
+    // The date keeps its original spacing.
+    stat.modified = QString::fromUtf8(
+        fields[5].begin, static_cast<int>(fields[7].end - fields[5].begin));
+    // Like the fields, the filename keeps any trailing whitespace.
+    stat.name = QString::fromUtf8(name, static_cast<int>(end - name));
+    return (true);
+}
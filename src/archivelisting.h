@@ -0,0 +1,62 @@
+#ifndef ARCHIVELISTING_H
+#define ARCHIVELISTING_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
+#include "messages/taskoutput.h"
+
+Q_DECLARE_METATYPE(ArchiveListingPtr)
+
+/*!
+ * \ingroup data
+ * \brief The ArchiveListing is the output of <tt>tarsnap -tv</tt> plus an
+ * index of the start of each line.  Lines which are not in the expected
+ * format (such as empty lines) are not included.
+ *
+ * The text itself is normally a memory-mapped file (see TaskOutput), so the
+ * memory use is proportional to the number of lines rather than to the
+ * size of the listing.  Lines are only parsed when they are requested.
+ */
+class ArchiveListing
+{
+public:
+    //! Constructor; indexes the lines of \c listing.
+    explicit ArchiveListing(const TaskOutput &listing);
+
+    //! Returns a TaskOutput holding \c text, in a temporary file in
+    //! \c dirname if possible (or in memory otherwise).
+    static TaskOutput mapText(const QByteArray &text, const QString &dirname);
+
+    //! Returns the number of lines.
+    int count() const;
+    //! Returns a line (without the newline).  The QByteArray refers to the
+    //! listing, so it must not outlive this object.
+    QByteArray line(int row) const;
+    //! Parses a line.
+    FileStat stat(int row) const;
+    //! Returns the filename of a line (for a symlink, without its target)
+    //! without parsing the other fields.  Like \ref line, it refers to
+    //! the listing.
+    QByteArray path(int row) const;
+
+    //! Parses a line of <tt>tarsnap -tv</tt> output.  Returns false if the
+    //! line does not have the expected fields.
+    static bool parseLine(const QByteArray &line, FileStat &stat);
+
+private:
+    TaskOutput _listing;
+    // A TaskOutput holds at most INT_MAX bytes (see TaskOutput::isTooLarge),
+    // so the offsets fit in an int.
+    QVector<int> _lineStarts;
+};
+
+#endif /* !ARCHIVELISTING_H */
@@ -0,0 +1,589 @@
+#include "archivelistmodel.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+
+#include <QDateTime>
+#include <QLatin1String>
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+#include "debug.h"
+#include "humanbytes.h"
+#include "persistentmodel/archive.h"
+#include "persistentmodel/job.h"
+
+#define FIELD_WIDTH 6
+
+// Reset the rows when a batch changes more than 1/4 of them.
+#define MAX_ROW_UPDATES_DIVISOR 4
+
+static bool cmp_timestamp(const ArchivePtr &a, const ArchivePtr &b)
+{
+    return (a->timestamp() > b->timestamp());
+}
+
+ArchiveListModel::ArchiveListModel(QObject *parent)
+    : QAbstractListModel(parent), _version(0)
+{
+    // Set up filtering archive names.
+    _filter.setCaseSensitivity(Qt::CaseInsensitive);
+    _filter.setPatternSyntax(QRegExp::Wildcard);
+}
+
+int ArchiveListModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    return (_rows.size());
+}
+
+QVariant ArchiveListModel::data(const QModelIndex &index, int role) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || (index.row() >= _rows.size()))
+        return (QVariant());
+
+    const ArchivePtr &archive = _rows.at(index.row());
+    switch(role)
+    {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return (archive->name());
+    case ArchiveRole:
+        return (QVariant::fromValue(archive));
+    case NamePartsRole:
+        return (nameParts(archive));
+    case DetailRole:
+    {
+        // Display a message about upcoming deletion (if applicable),
+        // or else the date & size.
+        if(archive->deleteScheduled())
+            return (tr("(scheduled for deletion)"));
+        QString detail(
+            archive->timestamp().toString(Qt::DefaultLocaleShortDate));
+        if(archive->sizeTotal() != 0)
+            detail.prepend(humanBytes(archive->sizeTotal(), FIELD_WIDTH)
+                           + "  ");
+        return (detail);
+    }
+    case StatsRole:
+        return (archive->archiveStats());
+    case DeleteScheduledRole:
+        return (archive->deleteScheduled());
+    case ShowingDetailsRole:
+        return (archive == _showingDetails);
+    default:
+        return (QVariant());
+    }
+}
+
+ArchivePtr ArchiveListModel::archive(int row) const
+{
+    return (_rows.value(row));
+}
+
+int ArchiveListModel::rowOf(const Archive *archive) const
+{
+    return (indexOf(_rows, archive));
+}
+
+bool ArchiveListModel::contains(const Archive *archive) const
+{
+    return (_members.contains(archive));
+}
+
+int ArchiveListModel::count() const
+{
+    return (_archives.size());
+}
+
+ArchivePtr ArchiveListModel::findArchiveByName(const QString &archiveName) const
+{
+    for(const ArchivePtr &archive : _archives)
+    {
+        if(archive->name() == archiveName)
+            return (archive);
+    }
+
+    // We couldn't find the name.
+    return (ArchivePtr());
+}
+
+ArchivePtr ArchiveListModel::previousArchive(const ArchivePtr &archive) const
+{
+    // Bail (if applicable).
+    if(!archive || archive->jobRef().isEmpty())
+        return (ArchivePtr());
+
+    // The older archives are after it.
+    const int index = indexOf(_archives, archive.data());
+    if(index == -1)
+        return (ArchivePtr());
+    for(int i = index + 1; i < _archives.size(); i++)
+    {
+        if(_archives.at(i)->jobRef() == archive->jobRef())
+            return (_archives.at(i));
+    }
+    return (ArchivePtr());
+}
+
+void ArchiveListModel::setArchives(QList<ArchivePtr> archives)
+{
+    // Sort archive list.
+    std::stable_sort(archives.begin(), archives.end(), cmp_timestamp);
+
+    beginResetModel();
+    for(const ArchivePtr &archive : _archives)
+        unwatch(archive);
+    _archives.clear();
+    _members.clear();
+    _index.clear();
+    _archives.reserve(archives.size());
+    for(const ArchivePtr &archive : archives)
+    {
+        // Bail (if applicable).
+        if(!archive)
+        {
+            DEBUG << "Null ArchivePtr passed.";
+            continue;
+        }
+        if(_members.contains(archive.data()))
+            continue;
+        _archives.append(archive);
+        watch(archive);
+    }
+    if(_showingDetails && !_members.contains(_showingDetails.data()))
+        _showingDetails.clear();
+    rebuildRows(_archives);
+    endResetModel();
+
+    notifyCount();
+}
+
+void ArchiveListModel::addArchive(const ArchivePtr &archive)
+{
+    addArchives(QList<ArchivePtr>() << archive);
+}
+
+void ArchiveListModel::addArchives(const QList<ArchivePtr> &archives)
+{
+    if(insertArchives(archives))
+        notifyCount();
+}
+
+void ArchiveListModel::removeArchive(const ArchivePtr &archive)
+{
+    removeArchives(QList<ArchivePtr>() << archive);
+}
+
+void ArchiveListModel::removeArchives(const QList<ArchivePtr> &archives)
+{
+    if(eraseArchives(archives))
+        notifyCount();
+}
+
+void ArchiveListModel::applyChanges(const ArchiveChanges &changes)
+{
+    // Bail (if applicable).
+    if(!changes.isNewerThan(_version))
+        return;
+    _version = changes.version;
+
+    // Remove the archives which are gone; a snapshot keeps the archives
+    // which are in it.
+    QList<ArchivePtr> removed;
+    if(changes.reset)
+    {
+        for(const ArchivePtr &archive : _archives)
+        {
+            if(!changes.added.contains(archive))
+                removed.append(archive);
+        }
+    }
+    else
+    {
+        removed = changes.removed.values();
+    }
+    bool changed = eraseArchives(removed);
+
+    // Add the new archives; the model might already have some of them.
+    // Updated archives notify the model themselves.
+    changed = insertArchives(changes.added.values()) || changed;
+
+    // Notify once for the whole set.
+    if(changed)
+        notifyCount();
+}
+
+void ArchiveListModel::setFilter(const QString &regex)
+{
+    // Bail (if applicable).
+    if(regex == _filter.pattern())
+        return;
+
+    // Typing more characters can only hide archives, so only the rows
+    // need to be checked.  An invalid pattern (e.g. an unclosed "[")
+    // matches nothing, so it does not count.
+    const bool narrowing = !_filter.pattern().isEmpty() && _filter.isValid()
+                           && regex.startsWith(_filter.pattern());
+    const QVector<ArchivePtr> archives = narrowing ? _rows : _archives;
+
+    beginResetModel();
+    _filter.setPattern(regex);
+    rebuildRows(archives);
+    endResetModel();
+
+    notifyCount();
+}
+
+ArchivePtr ArchiveListModel::showingDetails() const
+{
+    return (_showingDetails);
+}
+
+void ArchiveListModel::setShowingDetails(const ArchivePtr &archive)
+{
+    // Bail (if applicable).
+    if(archive == _showingDetails)
+        return;
+
+    const ArchivePtr previous = _showingDetails;
+    _showingDetails           = archive;
+
+    // Only the two affected rows need to be repainted.
+    const QVector<int> roles({ShowingDetailsRole});
+    for(const ArchivePtr &changed : {previous, archive})
+    {
+        if(!changed)
+            continue;
+        const int row = rowOf(changed.data());
+        if(row != -1)
+            emit dataChanged(index(row), index(row), roles);
+    }
+}
+
+void ArchiveListModel::refresh()
+{
+    if(!_rows.isEmpty())
+        emit dataChanged(index(0), index(_rows.size() - 1));
+}
+
+void ArchiveListModel::archiveChanged()
+{
+    const Archive *archive = qobject_cast<Archive *>(sender());
+    // Bail (if applicable).
+    if(!archive || !_members.contains(archive))
+        return;
+
+    const int row = rowOf(archive);
+    if(row != -1)
+        emit dataChanged(index(row), index(row));
+}
+
+void ArchiveListModel::archivePurged()
+{
+    const Archive *archive = qobject_cast<Archive *>(sender());
+    // Bail (if applicable).
+    if(!archive || !_members.contains(archive))
+        return;
+
+    // Keep a reference while the archive is removed from the list.
+    const ArchivePtr purged = _archives.at(indexOf(_archives, archive));
+    removeArchive(purged);
+}
+
+bool ArchiveListModel::insertArchives(const QList<ArchivePtr> &archives)
+{
+    // Skip archives which are already in the model.
+    QVector<ArchivePtr> added;
+    added.reserve(archives.size());
+    for(const ArchivePtr &archive : archives)
+    {
+        if(!archive)
+        {
+            DEBUG << "Null ArchivePtr passed.";
+            continue;
+        }
+        if(_members.contains(archive.data()))
+            continue;
+        watch(archive);
+        added.append(archive);
+    }
+
+    // Bail (if applicable).
+    if(added.isEmpty())
+        return (false);
+
+    // Sort the new archives, and merge them into the list in one pass.
+    std::stable_sort(added.begin(), added.end(), cmp_timestamp);
+    _archives = merged(_archives, added);
+
+    // Check them against the name filter.
+    QVector<ArchivePtr> rows;
+    for(const ArchivePtr &archive : added)
+    {
+        if(matches(archive))
+            rows.append(archive);
+    }
+    mergeRows(rows);
+    return (true);
+}
+
+bool ArchiveListModel::eraseArchives(const QList<ArchivePtr> &archives)
+{
+    QVector<ArchivePtr>   erased;
+    QSet<const Archive *> erasedSet;
+    for(const ArchivePtr &archive : archives)
+    {
+        if(!archive || !_members.contains(archive.data()))
+            continue;
+        unwatch(archive);
+        erased.append(archive);
+        erasedSet.insert(archive.data());
+    }
+
+    // Bail (if applicable).
+    if(erased.isEmpty())
+        return (false);
+
+    const auto isErased = [&erasedSet](const ArchivePtr &archive) {
+        return (erasedSet.contains(archive.data()));
+    };
+    QSet<const QObject *> erasedObjects;
+    erasedObjects.reserve(erasedSet.size());
+    for(const Archive *archive : erasedSet)
+        erasedObjects.insert(archive);
+    _index.remove(erasedObjects);
+
+    // Removing a row moves all the following rows, so many rows are removed
+    // in a single pass instead.
+    if(erased.size() > _rows.size() / MAX_ROW_UPDATES_DIVISOR)
+    {
+        beginResetModel();
+        _rows.erase(std::remove_if(_rows.begin(), _rows.end(), isErased),
+                    _rows.end());
+        endResetModel();
+    }
+    else
+    {
+        // Find the rows by timestamp, and remove each run of adjacent rows
+        // at once.  Starting from the end means that the rows which are
+        // still to be removed do not move.
+        QVector<int> rows;
+        rows.reserve(erased.size());
+        for(const ArchivePtr &archive : erased)
+        {
+            const int row = indexOf(_rows, archive.data());
+            if(row != -1)
+                rows.append(row);
+        }
+        std::sort(rows.begin(), rows.end());
+        int to = rows.size();
+        while(to > 0)
+        {
+            int from = to - 1;
+            while((from > 0) && (rows.at(from - 1) == rows.at(from) - 1))
+                from--;
+            beginRemoveRows(QModelIndex(), rows.at(from), rows.at(to - 1));
+            _rows.remove(rows.at(from), to - from);
+            endRemoveRows();
+            to = from;
+        }
+    }
+    _archives.erase(
+        std::remove_if(_archives.begin(), _archives.end(), isErased),
+        _archives.end());
+    if(_showingDetails && erasedSet.contains(_showingDetails.data()))
+        _showingDetails.clear();
+    return (true);
+}
+
+void ArchiveListModel::mergeRows(const QVector<ArchivePtr> &rows)
+{
+    // Bail (if applicable).
+    if(rows.isEmpty())
+        return;
+
+    // Inserting a run of rows moves all the following rows, so many rows
+    // are merged in a single pass instead.
+    if(rows.size() > _rows.size() / MAX_ROW_UPDATES_DIVISOR)
+    {
+        beginResetModel();
+        _rows = merged(_rows, rows);
+        endResetModel();
+        return;
+    }
+
+    // Insert each run of rows which go to the same position at once.
+    int from = 0;
+    while(from < rows.size())
+    {
+        const int pos = insertionIndex(_rows, rows.at(from));
+        int       to  = from + 1;
+        while((to < rows.size())
+              && ((pos == _rows.size())
+                  || cmp_timestamp(rows.at(to), _rows.at(pos))))
+        {
+            to++;
+        }
+        beginInsertRows(QModelIndex(), pos, pos + to - from - 1);
+        _rows.insert(pos, to - from, ArchivePtr());
+        std::copy(rows.constBegin() + from, rows.constBegin() + to,
+                  _rows.begin() + pos);
+        endInsertRows();
+        from = to;
+    }
+}
+
+bool ArchiveListModel::matches(const ArchivePtr &archive) const
+{
+    return (archive->name().contains(_filter));
+}
+
+void ArchiveListModel::watch(const ArchivePtr &archive)
+{
+    _members.insert(archive.data());
+    _index.insert(archive.data(), archive->name());
+
+    // Connections for any modifications: being scheduled for deletion,
+    // and being scheduled to be saved (i.e. the initial upload).
+    connect(archive.data(), &Archive::changed, this,
+            &ArchiveListModel::archiveChanged, Qt::QueuedConnection);
+    connect(archive.data(), &Archive::purged, this,
+            &ArchiveListModel::archivePurged, Qt::QueuedConnection);
+}
+
+void ArchiveListModel::unwatch(const ArchivePtr &archive)
+{
+    // The caller removes the archive from the _index, since that is
+    // faster for many archives at once.
+    _members.remove(archive.data());
+    disconnect(archive.data(), &Archive::changed, this,
+               &ArchiveListModel::archiveChanged);
+    disconnect(archive.data(), &Archive::purged, this,
+               &ArchiveListModel::archivePurged);
+}
+
+void ArchiveListModel::rebuildRows(const QVector<ArchivePtr> &archives)
+{
+    // An empty filter matches every archive.
+    if(_filter.pattern().isEmpty())
+    {
+        _rows = archives;
+        return;
+    }
+
+    // Only check the archives whose name might match (if the filter has
+    // enough literal characters to look them up).
+    QSet<const QObject *> candidates;
+    const bool indexed = _index.candidates(_filter.pattern(), &candidates);
+
+    QVector<ArchivePtr> rows;
+    for(const ArchivePtr &archive : archives)
+    {
+        if(indexed && !candidates.contains(archive.data()))
+            continue;
+        if(matches(archive))
+            rows.append(archive);
+    }
+    _rows = rows;
+}
+
+void ArchiveListModel::notifyCount()
+{
+    emit countChanged(_archives.size(), _rows.size());
+}
+
+int ArchiveListModel::indexOf(const QVector<ArchivePtr> &list,
+                              const Archive             *archive)
+{
+    // Look among the archives with the same timestamp.
+    const QDateTime timestamp = archive->timestamp();
+    auto            it        = std::lower_bound(
+        list.constBegin(), list.constEnd(), timestamp,
+        [](const ArchivePtr &a, const QDateTime &t) {
+            return (a->timestamp() > t);
+        });
+    for(; (it != list.constEnd()) && ((*it)->timestamp() == timestamp); ++it)
+    {
+        if(it->data() == archive)
+            return (static_cast<int>(it - list.constBegin()));
+    }
+
+    // The timestamp might have changed since the archive was added.
+    for(int i = 0; i < list.size(); i++)
+    {
+        if(list.at(i).data() == archive)
+            return (i);
+    }
+    return (-1);
+}
+
+QVector<ArchivePtr> ArchiveListModel::merged(const QVector<ArchivePtr> &a,
+                                             const QVector<ArchivePtr> &b)
+{
+    // std::merge() is stable, so b goes after any archives of a with the
+    // same timestamp.
+    QVector<ArchivePtr> result(a.size() + b.size());
+    std::merge(a.constBegin(), a.constEnd(), b.constBegin(), b.constEnd(),
+               result.begin(), cmp_timestamp);
+    return (result);
+}
+
+int ArchiveListModel::insertionIndex(const QVector<ArchivePtr> &list,
+                                     const ArchivePtr          &archive)
+{
+    // After any archives with the same timestamp.
+    auto it = std::upper_bound(list.constBegin(), list.constEnd(),
+                               archive->timestamp(),
+                               [](const QDateTime &t, const ArchivePtr &a) {
+                                   return (t > a->timestamp());
+                               });
+    return (static_cast<int>(it - list.constBegin()));
+}
+
+QStringList ArchiveListModel::nameParts(const ArchivePtr &archive)
+{
+    // For non-Job Archives, the name is a single part.
+    // For Archives that were created due to a Job, the name is split
+    // in three parts:
+    //     Job_JOBNAME_DATE
+    // For example,
+    //     Job_documents_2020-04-21_14-35-59
+    QStringList parts({QString(), QString(), QString()});
+
+    // Split off the Job_ prefix (if applicable).
+    QString baseName = archive->name();
+    if(!archive->jobRef().isEmpty()
+       && archive->name().startsWith(JOB_NAME_PREFIX))
+    {
+        parts[0] = JOB_NAME_PREFIX;
+        baseName.remove(0, JOB_NAME_PREFIX.size());
+    }
+    // Split off the date suffix (if applicable).
+    if(baseName.size() > ARCHIVE_TIMESTAMP_FORMAT.size())
+    {
+        QString truncated;
+        if(baseName.endsWith(QLatin1String(".part")))
+        {
+            truncated = QLatin1String(".part");
+            baseName.chop(truncated.size());
+        }
+        QString   timestamp = baseName.right(ARCHIVE_TIMESTAMP_FORMAT.size());
+        QDateTime validate =
+            QDateTime::fromString(timestamp, ARCHIVE_TIMESTAMP_FORMAT);
+        if(validate.isValid())
+        {
+            baseName.chop(timestamp.size());
+            parts[2] = timestamp + truncated;
+        }
+        else
+        {
+            baseName.append(truncated);
+        }
+    }
+    // The archive "base" name (i.e. without "Job_" or the date).
+    parts[1] = baseName;
+    return (parts);
+}
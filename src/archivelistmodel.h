@@ -0,0 +1,163 @@
+#ifndef ARCHIVELISTMODEL_H
+#define ARCHIVELISTMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractListModel>
+#include <QList>
+#include <QModelIndex>
+#include <QObject>
+#include <QRegExp>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/archiveptr.h"
+#include "messages/changeset.h"
+
+#include "nameindex.h"
+
+/* Forward declaration(s). */
+class Archive;
+
+/*!
+ * \ingroup data
+ * \brief The ArchiveListModel is a QAbstractListModel which lists
+ * archives, newest first.
+ *
+ * The model only keeps an ArchivePtr per archive; names, dates, and sizes
+ * are formatted when a view asks for them, so the cost of a row does not
+ * depend on the length of the list.  The archives are kept sorted by
+ * timestamp, so finding or inserting an archive is a binary search.  The
+ * rows can be restricted to archives whose name matches a filter; \ref
+ * count() includes the archives which are filtered out.  A \ref NameIndex
+ * of the names narrows down which archives are checked against the
+ * filter.
+ */
+class ArchiveListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    //! Data roles (in addition to Qt::DisplayRole and Qt::ToolTipRole,
+    //! which give the archive name).
+    enum Role
+    {
+        //! The ArchivePtr.
+        ArchiveRole = Qt::UserRole + 1,
+        //! The name as a QStringList of 3 parts: the "Job_" prefix, the
+        //! base name, and the timestamp suffix (each possibly empty).
+        NamePartsRole,
+        //! The size and date, or a note about the upcoming deletion.
+        DetailRole,
+        //! The archive statistics.
+        StatsRole,
+        //! Whether the archive is scheduled for deletion.
+        DeleteScheduledRole,
+        //! Whether details about the archive are being shown.
+        ShowingDetailsRole
+    };
+
+    //! Constructor.
+    explicit ArchiveListModel(QObject *parent = nullptr);
+
+    //! Returns the number of (matching) archives.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the data for one of the \ref Role values, or the name.
+    QVariant data(const QModelIndex &index,
+                  int                role = Qt::DisplayRole) const override;
+
+    //! Returns the archive shown in a row.
+    ArchivePtr archive(int row) const;
+    //! Returns the row of the archive, or -1 if it is not shown.
+    int rowOf(const Archive *archive) const;
+    //! Returns whether the archive is in the model (even if it is filtered
+    //! out).
+    bool contains(const Archive *archive) const;
+    //! Returns the number of archives, including those which are filtered
+    //! out.
+    int count() const;
+    //! Returns the (first) archive with this name, or a null ArchivePtr.
+    ArchivePtr findArchiveByName(const QString &archiveName) const;
+    //! Returns the most recent archive of the same Job which is older than
+    //! \c archive (even if it is filtered out), or a null ArchivePtr.
+    ArchivePtr previousArchive(const ArchivePtr &archive) const;
+
+    //! Replaces the archives.
+    void setArchives(QList<ArchivePtr> archives);
+    //! Adds an archive (unless it is already in the model).
+    void addArchive(const ArchivePtr &archive);
+    //! Adds archives (except those already in the model), with a single
+    //! \ref countChanged() signal.
+    void addArchives(const QList<ArchivePtr> &archives);
+    //! Removes an archive.
+    void removeArchive(const ArchivePtr &archive);
+    //! Removes archives, with a single \ref countChanged() signal.
+    void removeArchives(const QList<ArchivePtr> &archives);
+    //! Updates the archives with the changes (or snapshot) from the
+    //! \ref BackendData, with a single \ref countChanged() signal.  Sets
+    //! which are not newer than the model are ignored.
+    void applyChanges(const ArchiveChanges &changes);
+
+    //! Only show archives whose name matches \c regex (a case-insensitive
+    //! wildcard pattern).  If \c regex extends the previous filter, only
+    //! the archives which are shown are checked.
+    void setFilter(const QString &regex);
+
+    //! Returns the archive whose details are being shown.
+    ArchivePtr showingDetails() const;
+    //! Marks \c archive as the one whose details are being shown; a null
+    //! ArchivePtr clears the mark.
+    void setShowingDetails(const ArchivePtr &archive);
+
+    //! Notifies views that every row changed (e.g. the size format).
+    void refresh();
+
+signals:
+    //! The total and visible (not filtered out) number of archives
+    //! changed.
+    void countChanged(int countTotal, int countVisible);
+
+private slots:
+    void archiveChanged();
+    void archivePurged();
+
+private:
+    // All archives, and the ones which match the filter, newest first.
+    QVector<ArchivePtr>   _archives;
+    QVector<ArchivePtr>   _rows;
+    QSet<const Archive *> _members;
+    NameIndex             _index;
+
+    QRegExp    _filter;
+    ArchivePtr _showingDetails;
+    // The version of the last change set.
+    quint64 _version;
+
+    // Update the archives and rows, without notifying about the count;
+    // return whether anything changed.
+    bool insertArchives(const QList<ArchivePtr> &archives);
+    bool eraseArchives(const QList<ArchivePtr> &archives);
+    void mergeRows(const QVector<ArchivePtr> &rows);
+
+    bool matches(const ArchivePtr &archive) const;
+    void watch(const ArchivePtr &archive);
+    void unwatch(const ArchivePtr &archive);
+    void rebuildRows(const QVector<ArchivePtr> &archives);
+    void notifyCount();
+
+    static int indexOf(const QVector<ArchivePtr> &list,
+                       const Archive             *archive);
+    static QVector<ArchivePtr> merged(const QVector<ArchivePtr> &a,
+                                      const QVector<ArchivePtr> &b);
+    static int insertionIndex(const QVector<ArchivePtr> &list,
+                              const ArchivePtr          &archive);
+    static QStringList nameParts(const ArchivePtr &archive);
+};
+
+#endif /* !ARCHIVELISTMODEL_H */
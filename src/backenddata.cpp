@@ -19,6 +19,10 @@ WARNINGS_ENABLE
 #include "tasks/tasks-tarsnap.h"
 
 BackendData::BackendData()
+    : _archivesVersion(0),
+      _jobsVersion(0),
+      _archiveLists(0),
+      _archiveListFailed(false)
 {
 }
 
@@ -37,18 +41,73 @@ quint64 BackendData::numArchives()
     return (static_cast<quint64>(_archiveMap.count()));
 }
 
-bool BackendData::loadArchives()
+template <class Ptr>
+static ChangeSet<Ptr> takeChanges(ChangeSet<Ptr> &pending, quint64 &version)
+{
+    ChangeSet<Ptr> changes;
+    changes.fromVersion = version;
+    changes.version     = version;
+
+    // Bail (if applicable).
+    if(pending.isEmpty())
+        return (changes);
+
+    changes.added   = pending.added;
+    changes.removed = pending.removed;
+    changes.updated = pending.updated;
+    changes.version = ++version;
+    pending         = ChangeSet<Ptr>();
+    return (changes);
+}
+
+template <class Ptr>
+static ChangeSet<Ptr> snapshot(const QMap<QString, Ptr> &items,
+                               ChangeSet<Ptr> &pending, quint64 &version)
+{
+    // The snapshot includes any pending changes.
+    ChangeSet<Ptr> changes = takeChanges(pending, version);
+    changes.reset          = true;
+    changes.added.clear();
+    changes.removed.clear();
+    changes.updated.clear();
+    for(const Ptr &item : items)
+        changes.added.insert(item);
+    return (changes);
+}
+
+ArchiveChanges BackendData::takeArchiveChanges()
 {
-    _archiveMap.clear();
+    return (takeChanges(_archiveChanges, _archivesVersion));
+}
 
+ArchiveChanges BackendData::archiveSnapshot()
+{
+    return (snapshot(_archiveMap, _archiveChanges, _archivesVersion));
+}
+
+JobChanges BackendData::takeJobChanges()
+{
+    return (takeChanges(_jobChanges, _jobsVersion));
+}
+
+JobChanges BackendData::jobSnapshot()
+{
+    return (snapshot(_jobMap, _jobChanges, _jobsVersion));
+}
+
+bool BackendData::loadArchives()
+{
     // Get data from the store.
     if(!global_store->initialized())
     {
         DEBUG << "PersistentStore was not initialized properly.";
         return (false);
     }
+    // Archives which the ListingStore keeps after they were removed have
+    // names starting with a newline.
     QSqlQuery query = global_store->createQuery();
-    if(!query.prepare(QLatin1String("select name from archives")))
+    if(!query.prepare(QLatin1String("select name from archives"
+                                    " where substr(name, 1, 1) != char(10)")))
     {
         DEBUG << query.lastError().text();
         return (false);
@@ -59,15 +118,39 @@ bool BackendData::loadArchives()
         return (false);
     }
 
-    // Process data from the store.
-    const int index = query.record().indexOf("name");
+    // Process data from the store, keeping the Archive objects which are
+    // already loaded.
+    const int     index = query.record().indexOf("name");
+    QSet<QString> names;
+    QSet<QString> jobRefs;
     while(query.next())
     {
+        const QString name = query.value(index).toString();
+        names.insert(name);
+        if(_archiveMap.contains(name))
+            continue;
         ArchivePtr archive(new Archive);
-        archive->setName(query.value(index).toString());
+        archive->setName(name);
         archive->load();
-        _archiveMap[archive->name()] = archive;
+        insertArchive(archive);
+        jobRefs.insert(archive->jobRef());
+    }
+
+    // Forget archives which are no longer in the store.
+    QList<ArchivePtr> removedArchives;
+    for(const ArchivePtr &archive : _archiveMap)
+    {
+        if(!names.contains(archive->name()))
+            removedArchives.append(archive);
+    }
+    for(const ArchivePtr &archive : removedArchives)
+    {
+        removeArchive(archive);
+        jobRefs.insert(archive->jobRef());
     }
+
+    // Only reload the jobs whose archives have changed.
+    reloadJobArchives(jobRefs);
     return (true);
 }
 
@@ -76,12 +159,15 @@ QList<ArchivePtr> BackendData::findMatchingArchives(const QString &jobPrefix)
     const QString prefix = jobPrefix + QChar('_');
 
     // Get all archives beginning with the relevant prefix who do
-    // not already belong to a job.
-    QList<ArchivePtr> matching;
-    for(const ArchivePtr &archive : _archiveMap)
+    // not already belong to a job.  They are next to each other in the map.
+    const QMap<QString, ArchivePtr> &archives = _archiveMap;
+    QList<ArchivePtr>                matching;
+    for(QMap<QString, ArchivePtr>::const_iterator i =
+            archives.lowerBound(prefix);
+        (i != archives.constEnd()) && i.key().startsWith(prefix); ++i)
     {
-        if(archive->name().startsWith(prefix) && archive->jobRef().isEmpty())
-            matching << archive;
+        if(i.value()->jobRef().isEmpty())
+            matching << i.value();
     }
     return (matching);
 }
@@ -102,7 +188,7 @@ ArchivePtr BackendData::newArchive(const BackupTaskDataPtr &backupTaskData,
     }
 
     // Lose milliseconds precision by converting to Unix timestamp and back.
-    // So that a subsequent comparison in getArchiveListFinished won't fail.
+    // So that a subsequent comparison in addArchivesFromList won't fail.
     archive->setTimestamp(
         QDateTime::fromTime_t(backupTaskData->timestamp().toTime_t()));
 
@@ -115,26 +201,35 @@ ArchivePtr BackendData::newArchive(const BackupTaskDataPtr &backupTaskData,
 
     // Save data and add to the map.
     archive->save();
-    _archiveMap.insert(archive->name(), archive);
+    ArchivePtr previous = _archiveMap.value(archive->name());
+    if(previous)
+        removeArchive(previous);
+    insertArchive(archive);
+    // It might not be in a list which is in progress.
+    if(_archiveLists > 0)
+        _listedArchives.insert(archive->name());
 
     // Ensure that the archive is attached to the job (if applicable).
-    if(!archive->jobRef().isEmpty())
+    reloadJobArchives(QSet<QString>() << archive->jobRef());
+    return (archive);
+}
+
+void BackendData::beginArchivesFromList()
+{
+    if(_archiveLists == 0)
     {
-        for(const JobPtr &job : _jobMap)
-        {
-            if(job->objectKey() == archive->jobRef())
-                emit job->loadArchives();
-        }
+        _listedArchives.clear();
+        _archiveListFailed = false;
     }
-    return (archive);
+    _archiveLists++;
 }
 
-QList<ArchivePtr> BackendData::setArchivesFromList(
+QList<ArchivePtr> BackendData::addArchivesFromList(
     const QList<struct archive_list_data> &metadatas)
 {
     QList<ArchivePtr> newArchives;
+    QSet<QString>     jobRefs;
 
-    QMap<QString, ArchivePtr> nextArchiveMap;
     for(const struct archive_list_data &metadata : metadatas)
     {
         ArchivePtr archive =
@@ -143,6 +238,8 @@ QList<ArchivePtr> BackendData::setArchivesFromList(
            && (archive->timestamp() != metadata.timestamp))
         {
             // There is a different archive with the same name on the remote
+            removeArchive(archive);
+            jobRefs.insert(archive->jobRef());
             archive->purge();
             archive.clear();
             archive = ArchivePtr::create();
@@ -154,44 +251,162 @@ QList<ArchivePtr> BackendData::setArchivesFromList(
             archive->setTimestamp(metadata.timestamp);
             archive->setCommand(metadata.command);
             // Automagically set Job ownership
-            for(const JobPtr &job : _jobMap)
-            {
-                if(archive->name().startsWith(job->archivePrefix()))
-                    archive->setJobRef(job->objectKey());
-            }
+            const QString jobRef = jobRefForArchive(archive->name());
+            if(!jobRef.isNull())
+                archive->setJobRef(jobRef);
             archive->save();
             newArchives.append(archive);
+            jobRefs.insert(archive->jobRef());
         }
-        nextArchiveMap.insert(archive->name(), archive);
-        _archiveMap.remove(archive->name());
-    }
-    // Purge archives left in old _archiveMap (not mirrored by the remote)
-    for(const ArchivePtr &archive : _archiveMap)
-    {
-        archive->purge();
+        if(!_archiveMap.contains(archive->name()))
+            insertArchive(archive);
+        _listedArchives.insert(archive->name());
     }
-    _archiveMap.clear();
-    _archiveMap = nextArchiveMap;
-    for(const JobPtr &job : _jobMap)
+
+    // Only reload the jobs whose archives have changed.
+    reloadJobArchives(jobRefs);
+    return (newArchives);
+}
+
+QList<ArchivePtr> BackendData::endArchivesFromList(bool complete)
+{
+    QList<ArchivePtr> removedArchives;
+
+    // Bail (if applicable).
+    if(_archiveLists == 0)
+        return (removedArchives);
+
+    if(!complete)
+        _archiveListFailed = true;
+    if(--_archiveLists > 0)
+        return (removedArchives);
+
+    // Purge archives which are not mirrored by the remote, unless a list
+    // might have been incomplete.
+    QSet<QString> jobRefs;
+    if(!_archiveListFailed)
     {
-        emit job->loadArchives();
+        for(const ArchivePtr &archive : _archiveMap)
+        {
+            if(!_listedArchives.contains(archive->name()))
+                removedArchives.append(archive);
+        }
+        for(const ArchivePtr &archive : removedArchives)
+        {
+            removeArchive(archive);
+            jobRefs.insert(archive->jobRef());
+            archive->purge();
+        }
     }
-    return (newArchives);
+    _listedArchives.clear();
+    reloadJobArchives(jobRefs);
+    return (removedArchives);
 }
 
 void BackendData::removeArchives(const QList<ArchivePtr> &archives)
 {
     for(const ArchivePtr &archive : archives)
     {
-        _archiveMap.remove(archive->name());
+        removeArchive(archive);
         archive->purge();
     }
 }
 
-bool BackendData::loadJobs()
+void BackendData::insertArchive(const ArchivePtr &archive)
+{
+    _archiveMap.insert(archive->name(), archive);
+    indexArchive(archive);
+    _archiveChanges.add(archive);
+    connect(archive.data(), &Archive::changed, this,
+            &BackendData::archiveChanged, Qt::UniqueConnection);
+}
+
+void BackendData::removeArchive(const ArchivePtr &archive)
 {
-    _jobMap.clear();
+    // Bail (if applicable).
+    if(_archiveMap.value(archive->name()) != archive)
+        return;
+
+    disconnect(archive.data(), &Archive::changed, this,
+               &BackendData::archiveChanged);
+    unindexArchive(archive->name());
+    _archiveMap.remove(archive->name());
+    _archiveChanges.remove(archive);
+}
+
+void BackendData::indexArchive(const ArchivePtr &archive)
+{
+    // Bail (if applicable).
+    if(archive->jobRef().isEmpty())
+        return;
+
+    _jobArchives[archive->jobRef()].insert(archive->name(), archive);
+    _archiveJobRefs.insert(archive->name(), archive->jobRef());
+}
 
+void BackendData::unindexArchive(const QString &name)
+{
+    const QString jobRef = _archiveJobRefs.take(name);
+
+    // Bail (if applicable).
+    if(jobRef.isEmpty())
+        return;
+
+    QHash<QString, QMap<QString, ArchivePtr>>::iterator archives =
+        _jobArchives.find(jobRef);
+    if(archives == _jobArchives.end())
+        return;
+    archives->remove(name);
+    if(archives->isEmpty())
+        _jobArchives.erase(archives);
+}
+
+void BackendData::archiveChanged()
+{
+    Archive *archive = qobject_cast<Archive *>(sender());
+
+    // Bail (if applicable).
+    if(archive == nullptr)
+        return;
+    ArchivePtr indexed = _archiveMap.value(archive->name());
+    if(indexed.data() != archive)
+        return;
+
+    _archiveChanges.update(indexed);
+
+    // Bail (if applicable).
+    if(_archiveJobRefs.value(archive->name()) == archive->jobRef())
+        return;
+
+    unindexArchive(archive->name());
+    indexArchive(indexed);
+}
+
+QString BackendData::jobRefForArchive(const QString &name) const
+{
+    const QString jobName = _jobPrefixes.longestPrefixValue(name);
+
+    // Bail (if applicable).
+    if(jobName.isNull())
+        return (QString());
+
+    JobPtr job = _jobMap.value(jobName);
+    return (job ? job->objectKey() : QString());
+}
+
+void BackendData::reloadJobArchives(const QSet<QString> &jobRefs)
+{
+    // Jobs are saved with their name as the objectKey.
+    for(const QString &jobRef : jobRefs)
+    {
+        JobPtr job = _jobMap.value(jobRef);
+        if(job && (job->objectKey() == jobRef))
+            emit job->loadArchives();
+    }
+}
+
+bool BackendData::loadJobs()
+{
     // Get data from the store.
     if(!global_store->initialized())
     {
@@ -210,16 +425,39 @@ bool BackendData::loadJobs()
         return (false);
     }
 
-    // Process data from the store.
-    const int index = query.record().indexOf("name");
+    // Process data from the store, keeping the Job objects which are
+    // already loaded.
+    const int     index = query.record().indexOf("name");
+    QSet<QString> names;
     while(query.next())
     {
+        const QString name = query.value(index).toString();
+        names.insert(name);
+        if(_jobMap.contains(name))
+            continue;
         JobPtr job(new Job);
-        job->setName(query.value(index).toString());
+        job->setName(name);
         connect(job.data(), &Job::loadArchives, this,
                 &BackendData::loadJobArchives);
         job->load();
         _jobMap[job->name()] = job;
+        _jobPrefixes.insert(job->archivePrefix(), job->name());
+        _jobChanges.add(job);
+    }
+
+    // Forget Jobs which are no longer in the store.
+    QList<JobPtr> removedJobs;
+    for(const JobPtr &job : _jobMap)
+    {
+        if(!names.contains(job->name()))
+            removedJobs.append(job);
+    }
+    for(const JobPtr &job : removedJobs)
+    {
+        job->stopChangeTracking();
+        _jobMap.remove(job->name());
+        _jobPrefixes.remove(job->archivePrefix());
+        _jobChanges.remove(job);
     }
     return (true);
 }
@@ -233,25 +471,40 @@ void BackendData::deleteJob(const JobPtr &job)
         archive->save();
     }
 
+    job->stopChangeTracking();
     job->purge();
-    _jobMap.remove(job->name());
+    JobPtr stored = _jobMap.take(job->name());
+    _jobPrefixes.remove(job->archivePrefix());
+    if(stored)
+        _jobChanges.remove(stored);
 }
 
 void BackendData::loadJobArchives()
 {
-    Job              *job = qobject_cast<Job *>(sender());
-    QList<ArchivePtr> archives;
-    for(const ArchivePtr &archive : _archiveMap)
-    {
-        if(archive->jobRef() == job->objectKey())
-            archives << archive;
-    }
-    job->setArchives(archives);
+    Job *job = qobject_cast<Job *>(sender());
+
+    // Bail (if applicable).
+    if(job == nullptr)
+        return;
+
+    // A Job which has not been saved does not own any archives.
+    job->setArchives(_jobArchives.value(job->objectKey()).values());
 }
 
 void BackendData::addJob(const JobPtr &job)
 {
+    JobPtr previous = _jobMap.value(job->name());
+    if(previous != job)
+    {
+        if(previous)
+        {
+            previous->stopChangeTracking();
+            _jobChanges.remove(previous);
+        }
+        _jobChanges.add(job);
+    }
     _jobMap[job->name()] = job;
+    _jobPrefixes.insert(job->archivePrefix(), job->name());
     connect(job.data(), &Job::loadArchives, this,
             &BackendData::loadJobArchives);
 }
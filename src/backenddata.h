@@ -4,16 +4,21 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QHash>
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QSet>
 #include <QString>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/backuptaskdataptr.h"
+#include "messages/changeset.h"
 #include "messages/jobptr.h"
 
+#include "prefixtrie.h"
+
 /* Forward declaration(s). */
 struct archive_list_data;
 
@@ -21,6 +26,13 @@ struct archive_list_data;
  * \ingroup background-tasks
  * \brief The BackendData is a QObject which manages the \ref Job and
  * \ref Archive data.
+ *
+ * The archives are also indexed by their Job, and the Jobs by their archive
+ * prefix, so that finding the archives of a Job (or the Job of a new
+ * archive) does not examine every archive (or Job).
+ *
+ * Changes to either collection are recorded until they are taken as a
+ * \ref ChangeSet, so that the GUI only needs to update what changed.
  */
 class BackendData : public QObject
 {
@@ -30,11 +42,11 @@ public:
     //! Constructor.
     BackendData();
 
-    //! Load the \ref Archive objects from the \ref PersistentStore.
-    //! \warning Not implemented!
+    //! Load the \ref Archive objects from the \ref PersistentStore.  Archives
+    //! which are already loaded keep their objects.
     bool loadArchives();
-    //! Load the \ref Job objects from the \ref PersistentStore.
-    //! \warning Not implemented!
+    //! Load the \ref Job objects from the \ref PersistentStore.  Jobs which
+    //! are already loaded keep their objects.
     bool loadJobs();
 
     //! Get the collection of \ref Archive objects.
@@ -45,6 +57,17 @@ public:
     //! Get the number of archives.
     quint64 numArchives();
 
+    //! Return (and forget) the archive changes since the last call.  The
+    //! version is only bumped if something changed.
+    ArchiveChanges takeArchiveChanges();
+    //! Return all archives as a snapshot, and forget any pending changes.
+    ArchiveChanges archiveSnapshot();
+    //! Return (and forget) the Job changes since the last call.  The
+    //! version is only bumped if something changed.
+    JobChanges takeJobChanges();
+    //! Return all Jobs as a snapshot, and forget any pending changes.
+    JobChanges jobSnapshot();
+
     //! Add a job to the Jobs list.
     void addJob(const JobPtr &job);
     //! Delete a Job, and potentially all associated Archives.
@@ -52,9 +75,17 @@ public:
 
     //! Remove the archives.
     void removeArchives(const QList<ArchivePtr> &archives);
-    //! Replace the stored archives with the list.
+    //! Start replacing the stored archives with a list which arrives in
+    //! several parts.  Listings may overlap; archives are only removed once
+    //! the last one has ended.
+    void beginArchivesFromList();
+    //! Add (or replace) the archives in part of a list, and return the new
+    //! ones.
     QList<ArchivePtr>
-    setArchivesFromList(const QList<struct archive_list_data> &metadatas);
+    addArchivesFromList(const QList<struct archive_list_data> &metadatas);
+    //! End a list.  If every overlapping list was \c complete, remove and
+    //! return the archives which were not in any of them.
+    QList<ArchivePtr> endArchivesFromList(bool complete);
 
     //! Create a new Archive based on the BackupTaskData.
     //! \param backupTaskData metadata about the archiving command.
@@ -69,10 +100,41 @@ private slots:
     //! Load the list of archives belonging to a specific Job (specified
     //! via Qt's `sender()` function call).
     void loadJobArchives();
+    //! Update the indexes after an Archive (specified via Qt's `sender()`
+    //! function call) was saved, since its Job might have changed.
+    void archiveChanged();
 
 private:
     QMap<QString, ArchivePtr> _archiveMap;
     QMap<QString, JobPtr>     _jobMap;
+
+    // Indexes: jobRef -> archives (by name), archive name -> indexed
+    // jobRef, and archive prefix -> Job name.
+    QHash<QString, QMap<QString, ArchivePtr>> _jobArchives;
+    QHash<QString, QString>                   _archiveJobRefs;
+    PrefixTrie                                _jobPrefixes;
+
+    // Add or remove an archive, including the indexes.
+    void insertArchive(const ArchivePtr &archive);
+    void removeArchive(const ArchivePtr &archive);
+    void indexArchive(const ArchivePtr &archive);
+    void unindexArchive(const QString &name);
+
+    // Returns the objectKey of the Job which owns archives with this name.
+    QString jobRefForArchive(const QString &name) const;
+    // Notify the Jobs that their archives have changed.
+    void reloadJobArchives(const QSet<QString> &jobRefs);
+
+    // Pending changes, and the versions that they apply to.
+    ArchiveChanges _archiveChanges;
+    JobChanges     _jobChanges;
+    quint64        _archivesVersion;
+    quint64        _jobsVersion;
+
+    // Lists of archives in progress.
+    int           _archiveLists;
+    bool          _archiveListFailed;
+    QSet<QString> _listedArchives;
 };
 
 #endif /* !BACKENDDATA_H */
@@ -287,6 +287,16 @@ void BackupTaskData::setCommand(const QString &command)
     _command = command;
 }
 
+QString BackupTaskData::jobFingerprint() const
+{
+    return (_jobFingerprint);
+}
+
+void BackupTaskData::setJobFingerprint(const QString &jobFingerprint)
+{
+    _jobFingerprint = jobFingerprint;
+}
+
 BackupTaskDataPtr BackupTaskData::createBackupTaskFromJob(const JobPtr &job)
 {
     BackupTaskDataPtr backup(new BackupTaskData);
@@ -93,6 +93,9 @@ public:
 
     QString command() const;
     void    setCommand(const QString &command);
+
+    QString jobFingerprint() const;
+    void    setJobFingerprint(const QString &jobFingerprint);
     //! @}
 
 private:
@@ -114,6 +117,7 @@ private:
     QString    _output;
     ArchivePtr _archive;
     QString    _command;
+    QString    _jobFingerprint;
 };
 
 #endif // BACKUPTASK_H
@@ -0,0 +1,466 @@
+#include "changetracker.h"
+
+WARNINGS_DISABLE
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QSocketNotifier>
+WARNINGS_ENABLE
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "debug.h"
+
+#ifdef Q_OS_LINUX
+// We don't care about reads (IN_ACCESS, IN_OPEN, IN_CLOSE_NOWRITE).
+#define CHANGETRACKER_MASK                                                     \
+    (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE            \
+     | IN_DELETE_SELF | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO             \
+     | IN_DONT_FOLLOW)
+
+/*
+ * The number of inotify instances per user is limited (by
+ * fs.inotify.max_user_instances, usually 128), so all ChangeTrackers share
+ * one.  Watching the same directory twice gives the same watch descriptor,
+ * so the hub remembers which trackers use each one.  The watches of a user
+ * are limited too (by fs.inotify.max_user_watches), so the hub only uses a
+ * share of them.  The instance is closed when the last tracker stops
+ * watching.
+ */
+class InotifyHub
+{
+public:
+    //! Returns the shared instance (creating it if necessary), or nullptr.
+    static InotifyHub *acquire(ChangeTracker *tracker);
+    //! Closes the shared instance if no other tracker uses it.
+    static void release(ChangeTracker *tracker);
+
+    //! Returns the watch descriptor, or -1 (with errno set; ENOSPC if there
+    //! are too many watches).
+    int addWatch(ChangeTracker *tracker, const QString &path);
+    //! Removes the watch unless another tracker uses it.
+    void removeWatch(ChangeTracker *tracker, int wd);
+
+private:
+    static InotifyHub *_instance;
+
+    int                               _fd;
+    int                               _maxWatches;
+    QSocketNotifier                  *_notifier;
+    QSet<ChangeTracker *>             _trackers;
+    QHash<int, QSet<ChangeTracker *>> _users;
+
+    explicit InotifyHub(int fd);
+    ~InotifyHub();
+    void readEvents();
+};
+
+InotifyHub *InotifyHub::_instance = nullptr;
+
+InotifyHub::InotifyHub(int fd)
+    : _fd(fd),
+      _maxWatches(CHANGETRACKER_MAX_WATCHES),
+      _notifier(new QSocketNotifier(fd, QSocketNotifier::Read))
+{
+    // Leave most of the user's watches to other programs.
+    QFile limit("/proc/sys/fs/inotify/max_user_watches");
+    if(limit.open(QIODevice::ReadOnly))
+    {
+        bool      ok;
+        const int userWatches = limit.readAll().trimmed().toInt(&ok);
+        if(ok && (userWatches > 0))
+            _maxWatches =
+                qMin(_maxWatches, userWatches / CHANGETRACKER_WATCHES_SHARE);
+    }
+
+    QObject::connect(_notifier, &QSocketNotifier::activated, _notifier,
+                     [this]() { readEvents(); });
+}
+
+InotifyHub::~InotifyHub()
+{
+    delete _notifier;
+    // Closing the descriptor removes all of its watches.
+    close(_fd);
+}
+
+InotifyHub *InotifyHub::acquire(ChangeTracker *tracker)
+{
+    if(_instance == nullptr)
+    {
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(fd < 0)
+        {
+            DEBUG << "Cannot initialize inotify: " << strerror(errno);
+            return (nullptr);
+        }
+        _instance = new InotifyHub(fd);
+    }
+    _instance->_trackers.insert(tracker);
+    return (_instance);
+}
+
+void InotifyHub::release(ChangeTracker *tracker)
+{
+    // Bail (if applicable).
+    if(_instance == nullptr)
+        return;
+
+    _instance->_trackers.remove(tracker);
+    if(_instance->_trackers.isEmpty())
+    {
+        delete _instance;
+        _instance = nullptr;
+    }
+}
+
+int InotifyHub::addWatch(ChangeTracker *tracker, const QString &path)
+{
+    int wd = inotify_add_watch(_fd, QFile::encodeName(path).constData(),
+                               CHANGETRACKER_MASK);
+
+    // Bail (if applicable).
+    if(wd < 0)
+        return (wd);
+
+    // Directories which another tracker watches already are free.
+    if(!_users.contains(wd) && (_users.size() >= _maxWatches))
+    {
+        inotify_rm_watch(_fd, wd);
+        errno = ENOSPC;
+        return (-1);
+    }
+    _users[wd].insert(tracker);
+    return (wd);
+}
+
+void InotifyHub::removeWatch(ChangeTracker *tracker, int wd)
+{
+    QHash<int, QSet<ChangeTracker *>>::iterator it = _users.find(wd);
+
+    // Bail (if applicable).
+    if(it == _users.end())
+        return;
+
+    it.value().remove(tracker);
+    if(it.value().isEmpty())
+    {
+        inotify_rm_watch(_fd, wd);
+        _users.erase(it);
+    }
+}
+
+void InotifyHub::readEvents()
+{
+    alignas(struct inotify_event) char buf[16384];
+
+    while(true)
+    {
+        ssize_t len = read(_fd, buf, sizeof(buf));
+        if(len <= 0)
+            break;
+
+        for(char *ptr = buf; ptr < buf + len;)
+        {
+            const struct inotify_event *event =
+                reinterpret_cast<const struct inotify_event *>(ptr);
+            ptr += sizeof(struct inotify_event) + event->len;
+
+            // The kernel dropped some events, which might belong to anyone.
+            if(event->mask & IN_Q_OVERFLOW)
+            {
+                const QSet<ChangeTracker *> trackers = _trackers;
+                for(ChangeTracker *tracker : trackers)
+                    tracker->handleOverflow();
+                continue;
+            }
+
+            // The trackers might add or remove watches while handling this.
+            const QSet<ChangeTracker *> users = _users.value(event->wd);
+            const QString               name =
+                (event->len > 0) ? QFile::decodeName(event->name) : QString();
+            for(ChangeTracker *tracker : users)
+                tracker->handleEvent(event->wd, event->mask, name);
+
+            // The kernel has removed the watch.
+            if(event->mask & IN_IGNORED)
+                _users.remove(event->wd);
+        }
+    }
+}
+#endif
+
+ChangeTracker::ChangeTracker(QObject *parent)
+    : QObject(parent),
+      _hub(nullptr),
+      _lastDirtyWd(-1),
+      _overflowed(false)
+{
+    _scanTimer.setInterval(0);
+    connect(&_scanTimer, &QTimer::timeout, this, &ChangeTracker::scanBatch);
+    _coalesceTimer.setSingleShot(true);
+    _coalesceTimer.setInterval(CHANGETRACKER_COALESCE_MS);
+    connect(&_coalesceTimer, &QTimer::timeout, this, &ChangeTracker::changed);
+}
+
+ChangeTracker::~ChangeTracker()
+{
+    closeInotify();
+}
+
+void ChangeTracker::setRoots(const QStringList &roots)
+{
+    QStringList absRoots;
+    for(const QString &root : roots)
+        absRoots << QFileInfo(root).absoluteFilePath();
+
+    // Bail (if applicable).
+    if((_hub != nullptr) && (absRoots == _roots))
+        return;
+
+    clear();
+    _roots = absRoots;
+
+    // We don't know what happened before we started watching.
+    markAllDirty();
+
+#ifdef Q_OS_LINUX
+    _hub = InotifyHub::acquire(this);
+    if(_hub == nullptr)
+        return;
+
+    // Watch the roots right away; descend into them from the event loop.
+    for(const QString &root : _roots)
+        addWatch(root, true);
+#endif
+}
+
+void ChangeTracker::clear()
+{
+    closeInotify();
+    _roots.clear();
+    _scanQueue.clear();
+    _scanTimer.stop();
+    _coalesceTimer.stop();
+    _dirty.clear();
+    _lastDirtyWd = -1;
+    _overflowed  = false;
+}
+
+void ChangeTracker::closeInotify()
+{
+#ifdef Q_OS_LINUX
+    if(_hub != nullptr)
+    {
+        for(QHash<int, QString>::const_iterator it = _watches.constBegin();
+            it != _watches.constEnd(); ++it)
+            _hub->removeWatch(this, it.key());
+        InotifyHub::release(this);
+        _hub = nullptr;
+    }
+#endif
+    _watches.clear();
+}
+
+bool ChangeTracker::isTracking() const
+{
+    return ((_hub != nullptr) && !_overflowed && _scanQueue.isEmpty());
+}
+
+bool ChangeTracker::hasChanges() const
+{
+    return (!isTracking() || !_dirty.isEmpty());
+}
+
+QStringList ChangeTracker::changedPaths() const
+{
+    QStringList paths = _dirty.values();
+    paths.sort();
+    return (paths);
+}
+
+void ChangeTracker::resetChanges()
+{
+    // Directories which we haven't reached yet might have changed already.
+    if(!_scanQueue.isEmpty())
+        return;
+    _dirty.clear();
+    _lastDirtyWd = -1;
+}
+
+void ChangeTracker::markAllDirty()
+{
+    for(const QString &root : _roots)
+        markDirty(root);
+}
+
+void ChangeTracker::scanBatch()
+{
+    for(int i = 0; (i < CHANGETRACKER_SCAN_BATCH) && !_scanQueue.isEmpty();
+        i++)
+        addWatch(_scanQueue.dequeue(), true);
+
+    if(_scanQueue.isEmpty())
+        _scanTimer.stop();
+}
+
+bool ChangeTracker::addWatch(const QString &path, bool recursive)
+{
+#ifdef Q_OS_LINUX
+    if(_hub == nullptr)
+        return (false);
+
+    int wd = _hub->addWatch(this, path);
+    if(wd < 0)
+    {
+        // Out of watches; we can no longer vouch for this root.
+        if(errno == ENOSPC)
+        {
+            if(!_overflowed)
+                DEBUG << "Too many directories to watch below: "
+                      << rootOf(path);
+            _overflowed = true;
+            markDirty(rootOf(path));
+        }
+        // Otherwise it vanished or is unreadable; tarsnap would skip it too.
+        return (false);
+    }
+    _watches.insert(wd, path);
+
+    if(!recursive)
+        return (true);
+
+    // Queue subdirectories; symlinks are not followed.
+    QDir dir(path);
+    const QStringList subdirs =
+        dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::Hidden
+                      | QDir::System | QDir::NoSymLinks);
+    for(const QString &subdir : subdirs)
+        _scanQueue.enqueue(dir.filePath(subdir));
+    if(!_scanQueue.isEmpty() && !_scanTimer.isActive())
+        _scanTimer.start();
+    return (true);
+#else
+    Q_UNUSED(path)
+    Q_UNUSED(recursive)
+    return (false);
+#endif
+}
+
+void ChangeTracker::handleEvent(int wd, quint32 mask, const QString &name)
+{
+#ifdef Q_OS_LINUX
+    const QString dirPath = _watches.value(wd);
+
+    // Bail (if applicable).
+    if(dirPath.isEmpty())
+        return;
+
+    // The watched object itself is gone (or moved elsewhere).
+    if(mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+    {
+        if(!(mask & IN_IGNORED))
+            _hub->removeWatch(this, wd);
+        _watches.remove(wd);
+        if(_lastDirtyWd == wd)
+            _lastDirtyWd = -1;
+        // The parent directory sees this as well, unless it's a root.
+        if(_roots.contains(dirPath))
+        {
+            markDirty(dirPath);
+            if(!addWatch(dirPath, true))
+                _overflowed = true;
+        }
+        return;
+    }
+
+    // Start watching new subdirectories.
+    if((mask & IN_ISDIR) && (mask & (IN_CREATE | IN_MOVED_TO))
+       && !name.isEmpty())
+    {
+        _scanQueue.enqueue(dirPath + QChar('/') + name);
+        if(!_scanTimer.isActive())
+            _scanTimer.start();
+    }
+
+    // Event storms tend to hit the same directory repeatedly.
+    if(wd == _lastDirtyWd)
+        return;
+    markDirty(dirPath);
+    _lastDirtyWd = wd;
+#else
+    Q_UNUSED(wd)
+    Q_UNUSED(mask)
+    Q_UNUSED(name)
+#endif
+}
+
+void ChangeTracker::handleOverflow()
+{
+    // The lost events might include new subdirectories, so scan everything
+    // again; until that is done, isTracking() is false.
+    markAllDirty();
+    for(const QString &root : _roots)
+        addWatch(root, true);
+}
+
+void ChangeTracker::markDirty(const QString &path)
+{
+    if(!_coalesceTimer.isActive())
+        _coalesceTimer.start();
+
+    // Bail (if applicable).
+    if(isCoveredByDirty(path))
+        return;
+
+    // Remove entries which are covered by the new one.
+    const QString prefix = path + QChar('/');
+    for(QSet<QString>::iterator it = _dirty.begin(); it != _dirty.end();)
+    {
+        if(it->startsWith(prefix))
+            it = _dirty.erase(it);
+        else
+            ++it;
+    }
+    _dirty.insert(path);
+
+    // Keep memory bounded by collapsing everything to the roots.
+    if(_dirty.size() > CHANGETRACKER_MAX_DIRTY)
+    {
+        QSet<QString> collapsed;
+        for(const QString &dirty : _dirty)
+            collapsed.insert(rootOf(dirty));
+        _dirty = collapsed;
+        _lastDirtyWd = -1;
+    }
+}
+
+bool ChangeTracker::isCoveredByDirty(const QString &path) const
+{
+    QString ancestor = path;
+    while(true)
+    {
+        if(_dirty.contains(ancestor))
+            return (true);
+        int slash = ancestor.lastIndexOf(QChar('/'));
+        if(slash <= 0)
+            return (false);
+        ancestor.truncate(slash);
+    }
+}
+
+QString ChangeTracker::rootOf(const QString &path) const
+{
+    for(const QString &root : _roots)
+    {
+        if((path == root) || path.startsWith(root + QChar('/')))
+            return (root);
+    }
+    return (path);
+}
@@ -0,0 +1,108 @@
+#ifndef CHANGETRACKER_H
+#define CHANGETRACKER_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class InotifyHub;
+
+//! Maximum number of inotify watches used by all ChangeTrackers together.
+#define CHANGETRACKER_MAX_WATCHES 32768
+//! The ChangeTrackers use at most this fraction (1/n) of the user's
+//! inotify watches (fs.inotify.max_user_watches).
+#define CHANGETRACKER_WATCHES_SHARE 4
+//! Maximum number of dirty subtrees before collapsing them to their roots.
+#define CHANGETRACKER_MAX_DIRTY 1024
+//! Number of directories to add watches for in each scanning step.
+#define CHANGETRACKER_SCAN_BATCH 64
+//! Delay (in ms) used to coalesce filesystem events.
+#define CHANGETRACKER_COALESCE_MS 250
+
+/*!
+ * \ingroup misc
+ * \brief The ChangeTracker recursively watches a set of files and
+ * directories, and keeps track of which subtrees have changed.
+ *
+ * On Linux this uses inotify; all ChangeTrackers share one inotify
+ * instance, and the number of watches which they use together is capped
+ * (leaving most of the user's watches to other programs).  Directories
+ * are added in small batches from the event loop.  If the cap is reached,
+ * the affected roots are considered to be dirty until the next reset.  If
+ * the kernel event queue overflows, the roots are marked dirty and scanned
+ * again.  On other platforms the ChangeTracker cannot vouch for anything,
+ * so hasChanges() always returns true.
+ */
+class ChangeTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit ChangeTracker(QObject *parent = nullptr);
+    ~ChangeTracker() override;
+
+    //! Starts watching the given files and directories (recursively).
+    //! Any previous watches and dirty state are discarded, unless the
+    //! roots are the same as before.
+    void setRoots(const QStringList &roots);
+    //! Stops watching everything.
+    void clear();
+
+    //! Returns whether the tracker is watching every path below its roots.
+    bool isTracking() const;
+    //! Returns whether anything changed since the last resetChanges(), or
+    //! if we cannot tell.
+    bool hasChanges() const;
+    //! Returns the topmost changed paths; a changed directory covers all of
+    //! its descendants.
+    QStringList changedPaths() const;
+    //! Forgets all changes seen so far.
+    void resetChanges();
+    //! Marks every root as changed.
+    void markAllDirty();
+
+signals:
+    //! Something below one of the roots has changed.  Emitted at most once
+    //! every CHANGETRACKER_COALESCE_MS.
+    void changed();
+
+private slots:
+    void scanBatch();
+
+private:
+    friend class InotifyHub;
+
+    // Called by the InotifyHub.
+    void handleEvent(int wd, quint32 mask, const QString &name);
+    void handleOverflow();
+
+    bool addWatch(const QString &path, bool recursive);
+    void markDirty(const QString &path);
+    bool isCoveredByDirty(const QString &path) const;
+    QString rootOf(const QString &path) const;
+    void closeInotify();
+
+    QStringList _roots;
+
+    InotifyHub         *_hub;
+    QHash<int, QString> _watches;
+    QQueue<QString>     _scanQueue;
+    QTimer              _scanTimer;
+    QTimer              _coalesceTimer;
+
+    QSet<QString> _dirty;
+    int           _lastDirtyWd;
+    bool          _overflowed;
+};
+
+#endif /* !CHANGETRACKER_H */
@@ -0,0 +1,187 @@
+#include "checkstatetree.h"
+
+WARNINGS_DISABLE
+#include <QChar>
+WARNINGS_ENABLE
+
+CheckStateTree::CheckStateTree() : _root(new Node)
+{
+    _root->parent             = nullptr;
+    _root->checked            = false;
+    _root->checkedDescendants = 0;
+}
+
+CheckStateTree::~CheckStateTree()
+{
+    deleteChildren(_root);
+    delete _root;
+}
+
+Qt::CheckState CheckStateTree::state(const QString &path) const
+{
+    const Node *node            = _root;
+    bool        ancestorChecked = false;
+
+    int start = 0;
+    while(start < path.size())
+    {
+        int end = path.indexOf(QChar('/'), start);
+        if(end < 0)
+            end = path.size();
+        if(end > start)
+        {
+            if(node->checked)
+                ancestorChecked = true;
+            const Node *child =
+                node->children.value(path.mid(start, end - start), nullptr);
+            if(child == nullptr)
+                return (ancestorChecked ? Qt::PartiallyChecked
+                                        : Qt::Unchecked);
+            node = child;
+        }
+        start = end + 1;
+    }
+
+    if(node->checked)
+        return (Qt::Checked);
+    else if(ancestorChecked || (node->checkedDescendants > 0))
+        return (Qt::PartiallyChecked);
+    else
+        return (Qt::Unchecked);
+}
+
+void CheckStateTree::setChecked(const QString &path)
+{
+    Node *node = findNode(path, true);
+
+    // Bail (if applicable).
+    if(node->checked)
+        return;
+
+    // Uncheck all descendants.
+    if(node->checkedDescendants > 0)
+    {
+        addToAncestors(node, -node->checkedDescendants);
+        deleteChildren(node);
+        node->checkedDescendants = 0;
+    }
+
+    // There is at most one checked ancestor; it becomes partially checked.
+    for(Node *ancestor = node->parent; ancestor != nullptr;
+        ancestor       = ancestor->parent)
+    {
+        if(ancestor->checked)
+        {
+            ancestor->checked = false;
+            addToAncestors(ancestor, -1);
+            break;
+        }
+    }
+
+    node->checked = true;
+    addToAncestors(node, 1);
+}
+
+void CheckStateTree::setUnchecked(const QString &path)
+{
+    Node *node = findNode(path, false);
+
+    // Bail (if applicable).
+    if((node == nullptr) || !node->checked)
+        return;
+
+    node->checked = false;
+    addToAncestors(node, -1);
+    prune(node);
+}
+
+QStringList CheckStateTree::checkedPaths() const
+{
+    QStringList paths;
+    collectChecked(_root, paths);
+    return (paths);
+}
+
+void CheckStateTree::clear()
+{
+    deleteChildren(_root);
+    _root->checked            = false;
+    _root->checkedDescendants = 0;
+}
+
+CheckStateTree::Node *CheckStateTree::findNode(const QString &path,
+                                               bool           create)
+{
+    Node *node = _root;
+
+    int start = 0;
+    while(start < path.size())
+    {
+        int end = path.indexOf(QChar('/'), start);
+        if(end < 0)
+            end = path.size();
+        if(end > start)
+        {
+            const QString name  = path.mid(start, end - start);
+            Node         *child = node->children.value(name, nullptr);
+            if(child == nullptr)
+            {
+                if(!create)
+                    return (nullptr);
+                child                     = new Node;
+                child->parent             = node;
+                child->name               = name;
+                child->path               = path.left(end);
+                child->checked            = false;
+                child->checkedDescendants = 0;
+                node->children.insert(name, child);
+            }
+            node = child;
+        }
+        start = end + 1;
+    }
+
+    // This only happens for the filesystem root.
+    if((node == _root) && create)
+        _root->path = path;
+    return (node);
+}
+
+void CheckStateTree::prune(Node *node)
+{
+    while((node != _root) && !node->checked && node->children.isEmpty())
+    {
+        Node *parent = node->parent;
+        parent->children.remove(node->name);
+        delete node;
+        node = parent;
+    }
+}
+
+void CheckStateTree::addToAncestors(Node *node, int delta)
+{
+    for(Node *ancestor = node->parent; ancestor != nullptr;
+        ancestor       = ancestor->parent)
+        ancestor->checkedDescendants += delta;
+}
+
+void CheckStateTree::deleteChildren(Node *node)
+{
+    for(Node *child : node->children)
+    {
+        deleteChildren(child);
+        delete child;
+    }
+    node->children.clear();
+}
+
+void CheckStateTree::collectChecked(const Node *node, QStringList &paths) const
+{
+    if(node->checked)
+    {
+        paths << node->path;
+        return;
+    }
+    for(const Node *child : node->children)
+        collectChecked(child, paths);
+}
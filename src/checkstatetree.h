@@ -0,0 +1,75 @@
+#ifndef CHECKSTATETREE_H
+#define CHECKSTATETREE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <Qt>
+WARNINGS_ENABLE
+
+//! Role used in dataChanged() when the checked state of an item changes.
+#define SELECTION_CHANGED_ROLE Qt::UserRole + 100
+
+/*!
+ * \ingroup misc
+ * \brief The CheckStateTree is a trie of paths which keeps track of which
+ * files and directories are checked.
+ *
+ * Only checked paths (and their ancestors) are stored, so the memory use
+ * does not depend on the size of the directories.  Each node counts its
+ * checked descendants, which makes every query and update O(depth).  A
+ * checked path never has checked descendants.
+ */
+class CheckStateTree
+{
+public:
+    //! Constructor.
+    CheckStateTree();
+    ~CheckStateTree();
+
+    //! Returns Qt::Checked if the path is checked, Qt::PartiallyChecked if a
+    //! descendant or an ancestor is checked, and Qt::Unchecked otherwise.
+    Qt::CheckState state(const QString &path) const;
+
+    //! Checks the path.  Any checked descendants are unchecked, and a checked
+    //! ancestor becomes partially checked.
+    void setChecked(const QString &path);
+    //! Unchecks the path (if it was checked).
+    void setUnchecked(const QString &path);
+
+    //! Returns all checked paths.
+    QStringList checkedPaths() const;
+
+    //! Unchecks everything.
+    void clear();
+
+private:
+    Q_DISABLE_COPY(CheckStateTree)
+
+    struct Node
+    {
+        Node                  *parent;
+        QString                name;
+        QString                path;
+        QHash<QString, Node *> children;
+        bool                   checked;
+        int                    checkedDescendants;
+    };
+
+    Node *_root;
+
+    // Returns the node for the path, creating it if requested.
+    Node *findNode(const QString &path, bool create);
+    // Removes unused nodes, starting at node and moving upwards.
+    void prune(Node *node);
+    // Adds delta to the counts of all ancestors of the node.
+    void addToAncestors(Node *node, int delta);
+
+    void deleteChildren(Node *node);
+    void collectChecked(const Node *node, QStringList &paths) const;
+};
+
+#endif /* !CHECKSTATETREE_H */
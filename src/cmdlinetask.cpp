@@ -1,15 +1,17 @@
 #include "cmdlinetask.h"
 
 WARNINGS_DISABLE
-#include <QChar>
+#include <QDir>
 #include <QProcess>
 #include <QRegExp>
 #include <QStandardPaths>
+#include <QTemporaryFile>
 #include <QUuid>
 WARNINGS_ENABLE
 
 #include "ConsoleLog.h"
 
+#include <limits.h>
 #include <signal.h>
 
 #define DEFAULT_TIMEOUT_MS 5000
@@ -42,14 +44,20 @@ static QString quoteCommandLine(const QStringList &args)
 CmdlineTask::CmdlineTask()
     : _process(nullptr),
       _exitCode(EXIT_NO_MEANING),
+      _spillThreshold(CMDLINE_SPILL_THRESHOLD),
+      _spillFile(nullptr),
       _truncateLogOutput(false),
-      _monitorOutput(false)
+      _monitorOutput(false),
+      _streamStdOut(false),
+      _streamInterval(CMDLINE_STREAM_INTERVAL_MS)
 {
 }
 
 void CmdlineTask::run()
 {
     bool finishedStatus = false;
+    bool spillStdOut    = _stdOutFilename.isEmpty() && !_monitorOutput
+                       && !_spillDir.isEmpty() && !_streamStdOut;
 
     Q_ASSERT(_process == nullptr);
 
@@ -73,7 +81,7 @@ void CmdlineTask::run()
         LOG << "Not running task due to 'fake this task' request.\n";
         _fake = false;
         emit started(_data);
-        emit finished(_data, EXIT_FAKE_REQUEST, "", "");
+        emit finished(_data, EXIT_FAKE_REQUEST, TaskOutput(), TaskOutput());
         goto cleanup;
     }
 #endif
@@ -83,7 +91,7 @@ void CmdlineTask::run()
     if(QStandardPaths::findExecutable(_command).isEmpty())
     {
         LOG << QString("Command '%1' not found\n").arg(_command);
-        emit finished(_data, EXIT_CMD_NOT_FOUND, "", "");
+        emit finished(_data, EXIT_CMD_NOT_FOUND, TaskOutput(), TaskOutput());
         goto cleanup;
     }
 
@@ -93,6 +101,13 @@ void CmdlineTask::run()
         connect(_process, &QProcess::readyReadStandardOutput, this,
                 &CmdlineTask::gotStdout);
     }
+    else if(spillStdOut || _streamStdOut)
+    {
+        // Don't let QProcess buffer all of the output.
+        _streamTimer.invalidate();
+        connect(_process, &QProcess::readyReadStandardOutput, this,
+                &CmdlineTask::readStdout, Qt::DirectConnection);
+    }
 
     // Start the _process, and wait for confirmation of it starting.
     _process->start();
@@ -118,7 +133,7 @@ void CmdlineTask::run()
     finishedStatus = _process->waitForFinished(-1);
 
     // Cancel monitoring output
-    if(_monitorOutput)
+    if(_monitorOutput || spillStdOut || _streamStdOut)
     {
         disconnect(_process, &QProcess::readyReadStandardOutput, this, nullptr);
     }
@@ -139,6 +154,8 @@ void CmdlineTask::run()
 cleanup:
     delete _process;
     _process = nullptr;
+    delete _spillFile;
+    _spillFile = nullptr;
     emit dequeue();
 }
 
@@ -224,6 +241,18 @@ void CmdlineTask::setTruncateLogOutput(bool truncateLogOutput)
     _truncateLogOutput = truncateLogOutput;
 }
 
+void CmdlineTask::setStdOutSpillDir(const QString &dirname, int threshold)
+{
+    _spillDir       = dirname;
+    _spillThreshold = threshold;
+}
+
+void CmdlineTask::setStreamStdOut(int interval)
+{
+    _streamStdOut   = true;
+    _streamInterval = interval;
+}
+
 void CmdlineTask::setMonitorOutput()
 {
     _monitorOutput = true;
@@ -232,24 +261,146 @@ void CmdlineTask::setMonitorOutput()
 void CmdlineTask::readProcessOutput(QProcess *process)
 {
     if(_stdOutFilename.isEmpty())
-        _stdOut.append(process->readAllStandardOutput().trimmed());
+    {
+        if(_spillDir.isEmpty() && !_streamStdOut)
+            _stdOut.append(process->readAllStandardOutput().trimmed());
+        else
+            readStdout();
+        if(_streamStdOut)
+            streamLines(true);
+    }
     _stdErr.append(process->readAllStandardError().trimmed());
 }
 
+void CmdlineTask::readStdout()
+{
+    Q_ASSERT(_process != nullptr);
+    QByteArray data = _process->readAllStandardOutput();
+
+    // Bail (if applicable).
+    if(data.isEmpty())
+        return;
+
+    // _stdOut only holds the lines which have not been streamed yet.
+    if(_streamStdOut)
+    {
+        _stdOut.append(data);
+        streamLines(false);
+        return;
+    }
+
+    if(_spillFile == nullptr)
+    {
+        _stdOut.append(data);
+        if(_stdOut.size() > _spillThreshold)
+            startSpill();
+        return;
+    }
+
+    if(_spillFile->write(data) != data.size())
+    {
+        LOG << tr("Task %1: could not write to %2; keeping the output in"
+                  " memory.\n")
+                   .arg(_uuid.toString())
+                   .arg(_spillFile->fileName());
+        // Continue in memory.
+        _spillFile->seek(0);
+        _stdOut = _spillFile->readAll();
+        _stdOut.append(data);
+        delete _spillFile;
+        _spillFile      = nullptr;
+        _spillThreshold = INT_MAX;
+    }
+}
+
+void CmdlineTask::startSpill()
+{
+    _spillFile = new QTemporaryFile(
+        QDir(_spillDir).filePath("tarsnap-stdout-XXXXXX"));
+    if(!_spillFile->open() || (_spillFile->write(_stdOut) != _stdOut.size()))
+    {
+        LOG << tr("Task %1: could not create a temporary file in %2; keeping"
+                  " the output in memory.\n")
+                   .arg(_uuid.toString())
+                   .arg(_spillDir);
+        delete _spillFile;
+        _spillFile      = nullptr;
+        _spillThreshold = INT_MAX;
+        return;
+    }
+    _stdOut.clear();
+    _stdOut.squeeze();
+}
+
+void CmdlineTask::streamLines(bool last)
+{
+    // Bail (if applicable).
+    if(!last && _streamTimer.isValid()
+       && (_streamTimer.elapsed() < _streamInterval))
+    {
+        return;
+    }
+
+    // Keep an incomplete line until the rest of it arrives.
+    const int length = last ? _stdOut.size() : _stdOut.lastIndexOf('\n') + 1;
+    if(length == 0)
+        return;
+
+    emit stdOutLines(_data, _stdOut.left(length));
+    _stdOut.remove(0, length);
+    _streamTimer.start();
+}
+
+TaskOutput CmdlineTask::takeStdOut()
+{
+    // The output is in memory.
+    if(_spillFile == nullptr)
+    {
+        // Output read in several chunks has not been trimmed yet.
+        if(!_spillDir.isEmpty())
+            _stdOut = _stdOut.trimmed();
+        return (TaskOutput(_stdOut));
+    }
+
+    // The TaskOutput deletes the file when it is no longer needed.
+    TaskOutput output(_spillFile);
+    _spillFile = nullptr;
+    return (output);
+}
+
 QByteArray CmdlineTask::truncate_output(const QByteArray &stdOutArray)
 {
-    QString stdOut = QString(stdOutArray);
     // Find a good newline to which to truncate.
     int from = LOG_MAX_LENGTH
-               + qMin(stdOut.size() - LOG_MAX_LENGTH, LOG_MAX_SEARCH_NL);
-    int nextNL = stdOut.lastIndexOf(QChar('\n'), from);
+               + qMin(stdOutArray.size() - LOG_MAX_LENGTH, LOG_MAX_SEARCH_NL);
+    int nextNL = stdOutArray.lastIndexOf('\n', from);
     // Only keep the first part of the logfile.
-    stdOut.truncate(qMax(LOG_MAX_LENGTH, nextNL));
+    int        keep   = qMax(LOG_MAX_LENGTH, nextNL);
+    QByteArray stdOut = stdOutArray.left(keep);
     // Notify about truncation in log.
-    int num_truncated = _stdOut.mid(stdOut.size()).count('\n');
-    stdOut.append(tr("\n...\n-- %1 output lines truncated by Tarsnap GUI --\n")
-                      .arg(num_truncated));
-    return (stdOut.toUtf8());
+    int num_truncated = 0;
+    for(int i = keep; i < stdOutArray.size(); i++)
+    {
+        if(stdOutArray.at(i) == '\n')
+            num_truncated++;
+    }
+    stdOut.append(
+        tr("\n...\n-- %1 output lines truncated by Tarsnap GUI --\n")
+            .arg(num_truncated)
+            .toUtf8());
+    return (stdOut);
+}
+
+QString CmdlineTask::logOutput(const QByteArray &stdOut)
+{
+    // Truncate LOG output; only the part which is logged gets decoded.
+    QString output;
+    if(_truncateLogOutput && (stdOut.size() > LOG_MAX_LENGTH))
+        output = QString::fromUtf8(truncate_output(stdOut));
+    else
+        output = QString::fromUtf8(stdOut);
+    output.append(QString::fromUtf8(_stdErr));
+    return (output);
 }
 
 void CmdlineTask::processFinished(QProcess *process)
@@ -259,19 +410,24 @@ void CmdlineTask::processFinished(QProcess *process)
     case QProcess::NormalExit:
     {
         _exitCode = process->exitCode();
-        emit finished(_data, _exitCode, QString(_stdOut), QString(_stdErr));
 
-        // Truncate LOG output
-        QByteArray stdOut(_stdOut);
-        if(_truncateLogOutput && (stdOut.size() > LOG_MAX_LENGTH))
-            stdOut = truncate_output(stdOut);
+        // Fail, rather than passing on part of the output.
+        TaskOutput stdOut = takeStdOut();
+        if(stdOut.isTooLarge())
+        {
+            _exitCode = EXIT_OUTPUT_TOO_LARGE;
+            _stdErr.append(
+                tr("\nThe output is too large to be handled by Tarsnap GUI.")
+                    .toUtf8());
+        }
+        emit finished(_data, _exitCode, stdOut, TaskOutput(_stdErr));
 
         LOG << tr("Task %1 finished with exit code %2:\n[%3 %4]\n%5\n")
                    .arg(_uuid.toString())
                    .arg(_exitCode)
                    .arg(_command)
                    .arg(quoteCommandLine(_arguments))
-                   .arg(QString(stdOut + _stdErr));
+                   .arg(logOutput(stdOut.bytes()));
         break;
     }
     case QProcess::CrashExit:
@@ -285,6 +441,7 @@ void CmdlineTask::processFinished(QProcess *process)
 
 void CmdlineTask::processError(QProcess *process)
 {
+    TaskOutput stdOut = takeStdOut();
     LOG << tr("Task %1 finished with error %2 (%3) occured "
               "(exit code %4):\n[%5 %6]\n%7\n")
                .arg(_uuid.toString())
@@ -293,7 +450,7 @@ void CmdlineTask::processError(QProcess *process)
                .arg(_exitCode)
                .arg(_command)
                .arg(quoteCommandLine(_arguments))
-               .arg(QString(_stdOut + _stdErr).trimmed());
-    emit finished(_data, _exitCode, QString(_stdOut), QString(_stdErr));
+               .arg(logOutput(stdOut.bytes()).trimmed());
+    emit finished(_data, _exitCode, stdOut, TaskOutput(_stdErr));
     emit canceled();
 }
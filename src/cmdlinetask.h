@@ -5,16 +5,20 @@
 
 WARNINGS_DISABLE
 #include <QByteArray>
+#include <QElapsedTimer>
 #include <QObject>
 #include <QString>
 #include <QStringList>
 #include <QVariant>
 WARNINGS_ENABLE
 
+#include "messages/taskoutput.h"
+
 #include "basetask.h"
 
 /* Forward declaration(s). */
 class QProcess;
+class QTemporaryFile;
 
 /*
  * Normal exit codes are non-negative, but since we're just passing around
@@ -25,6 +29,14 @@ class QProcess;
 #define EXIT_DID_NOT_START (-3)
 #define EXIT_CMD_NOT_FOUND (-4)
 #define EXIT_FAKE_REQUEST (-5)
+#define EXIT_OUTPUT_TOO_LARGE (-6)
+
+//! Once stdout is larger than this, it continues in a temporary file (if
+//! enabled with \ref CmdlineTask::setStdOutSpillDir).
+#define CMDLINE_SPILL_THRESHOLD (16 * 1024 * 1024)
+
+//! Default minimum time between \ref CmdlineTask::stdOutLines signals.
+#define CMDLINE_STREAM_INTERVAL_MS 100
 
 /*!
  * \ingroup background-tasks
@@ -57,6 +69,14 @@ public:
 
     void setStdIn(const QString &stdIn);
     void setStdOutFile(const QString &fileName);
+    //! Keep stdout in memory until it reaches \c threshold bytes, then
+    //! continue in a temporary file in \c dirname (if not empty).
+    void setStdOutSpillDir(const QString &dirname,
+                           int            threshold = CMDLINE_SPILL_THRESHOLD);
+    //! Pass complete lines of stdout to \ref stdOutLines while the process
+    //! is running, at most once every \c interval ms (apart from the last
+    //! lines).  Takes precedence over \ref setStdOutSpillDir.
+    void setStreamStdOut(int interval = CMDLINE_STREAM_INTERVAL_MS);
 
     QVariant data() const;
     void     setData(const QVariant &data);
@@ -72,15 +92,23 @@ signals:
     //! this signal (which was enabled by \ref setMonitorOutput) will not be
     //! included in \ref finished.
     void outputStdout(const QString &msg);
-    //! Finished, crashed, or could not start running the QProcess.
-    void finished(QVariant data, int exitCode, const QString &stdOut,
-                  const QString &stdErr);
+    //! The process has printed \c lines to stdout; every line ends with a
+    //! newline, apart from (perhaps) the last one.  This signal is enabled
+    //! by \ref setStreamStdOut, and these lines will not be included in
+    //! \ref finished.
+    void stdOutLines(QVariant data, const QByteArray &lines);
+    //! Finished, crashed, or could not start running the QProcess.  The
+    //! output is shared with the task rather than copied, and is only
+    //! decoded if a receiver asks for a QString.
+    void finished(QVariant data, int exitCode, const TaskOutput &stdOut,
+                  const TaskOutput &stdErr);
 
 private slots:
     void readProcessOutput(QProcess *process);
     void processFinished(QProcess *process);
     void processError(QProcess *process);
     void gotStdout();
+    void readStdout();
 
 private:
     // Housekeeping.
@@ -96,16 +124,26 @@ private:
     int        _exitCode;
 
     // Influences standard output.
-    QString _stdOutFilename;
-    bool    _truncateLogOutput;
-    bool    _monitorOutput;
+    QString         _stdOutFilename;
+    QString         _spillDir;
+    int             _spillThreshold;
+    QTemporaryFile *_spillFile;
+    bool            _truncateLogOutput;
+    bool            _monitorOutput;
+    bool            _streamStdOut;
+    int             _streamInterval;
+    QElapsedTimer   _streamTimer;
 
     // Actual command.
     QString     _command;
     QStringList _arguments;
 
-    // Utility function.
+    // Utility functions.
     QByteArray truncate_output(const QByteArray &stdOut);
+    QString    logOutput(const QByteArray &stdOut);
+    void       startSpill();
+    void       streamLines(bool last);
+    TaskOutput takeStdOut();
 };
 
 #endif // !CMDLINETASK_H
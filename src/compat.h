@@ -9,4 +9,10 @@
 #define SKIP_EMPTY_PARTS QString::SkipEmptyParts
 #endif
 
+#if(QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
+#define TEXT_WIDTH(metrics, text) (metrics).horizontalAdvance(text)
+#else
+#define TEXT_WIDTH(metrics, text) (metrics).width(text)
+#endif
+
 #endif /* !COMPAT_H */
@@ -0,0 +1,181 @@
+#include "consolelogmodel.h"
+
+WARNINGS_DISABLE
+#include <QRegExp>
+#include <QStringList>
+#include <QUuid>
+WARNINGS_ENABLE
+
+#include "compat.h"
+
+// Compact the list of matches once this many have been dropped.
+#define MATCHES_COMPACT_THRESHOLD 4096
+
+ConsoleLogModel::ConsoleLogModel(QObject *parent, int capacity)
+    : QAbstractListModel(parent), _ring(capacity), _matchesStart(0)
+{
+}
+
+int ConsoleLogModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    if(isFiltering())
+        return (_matches.size() - _matchesStart);
+    return (_ring.size());
+}
+
+QVariant ConsoleLogModel::data(const QModelIndex &index, int role) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || (index.row() >= rowCount()))
+        return (QVariant());
+
+    const LogEntry &log = entry(index.row());
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        return (QString("[%1] %2")
+                    .arg(log.timestamp.toString(Qt::DefaultLocaleShortDate))
+                    .arg(log.message));
+    case Qt::ToolTipRole:
+        if(log.task.isNull())
+            return (QVariant());
+        return (tr("Task %1").arg(log.task.toString()));
+    default:
+        return (QVariant());
+    }
+}
+
+const LogEntry &ConsoleLogModel::entry(int row) const
+{
+    return (_ring.at(seqForRow(row)));
+}
+
+QString ConsoleLogModel::filter() const
+{
+    return (_filter);
+}
+
+void ConsoleLogModel::setFilter(const QString &filter)
+{
+    const QString trimmed = filter.trimmed();
+
+    // Bail (if applicable).
+    if(trimmed == _filter)
+        return;
+
+    beginResetModel();
+    _filter = trimmed;
+    _matches.clear();
+    _matchesStart = 0;
+    if(isFiltering())
+    {
+        for(quint64 seq = _ring.firstSeq(); seq < _ring.endSeq(); seq++)
+        {
+            if(matches(_ring.at(seq)))
+                _matches.append(seq);
+        }
+    }
+    endResetModel();
+}
+
+void ConsoleLogModel::clear()
+{
+    beginResetModel();
+    _ring.clear();
+    _matches.clear();
+    _matchesStart = 0;
+    endResetModel();
+}
+
+void ConsoleLogModel::appendMessage(const QDateTime &timestamp,
+                                    const QString   &text)
+{
+    // Messages from tasks contain the task's UUID (in braces).
+    static const QRegExp uuidRx(
+        "\\{[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-"
+        "[0-9a-fA-F]{12}\\}");
+    QRegExp rx(uuidRx);
+    QUuid   task;
+    if(rx.indexIn(text) != -1)
+        task = QUuid(rx.cap(0));
+
+    for(const QString &line : text.split('\n', SKIP_EMPTY_PARTS))
+        appendEntry(LogEntry(timestamp, line, task));
+}
+
+bool ConsoleLogModel::isFiltering() const
+{
+    return (!_filter.isEmpty());
+}
+
+bool ConsoleLogModel::matches(const LogEntry &entry) const
+{
+    return (entry.message.contains(_filter, Qt::CaseInsensitive)
+            || (!entry.task.isNull()
+                && entry.task.toString().contains(_filter,
+                                                  Qt::CaseInsensitive)));
+}
+
+quint64 ConsoleLogModel::seqForRow(int row) const
+{
+    if(isFiltering())
+        return (_matches.at(_matchesStart + row));
+    return (_ring.firstSeq() + static_cast<quint64>(row));
+}
+
+void ConsoleLogModel::appendEntry(const LogEntry &entry)
+{
+    // Make room for the new line.
+    if(_ring.isFull())
+        dropOldest();
+
+    if(!isFiltering())
+    {
+        const int row = _ring.size();
+        beginInsertRows(QModelIndex(), row, row);
+        _ring.append(entry);
+        endInsertRows();
+    }
+    else
+    {
+        const quint64 seq = _ring.append(entry);
+        if(matches(entry))
+        {
+            const int row = rowCount();
+            beginInsertRows(QModelIndex(), row, row);
+            _matches.append(seq);
+            endInsertRows();
+        }
+    }
+}
+
+void ConsoleLogModel::dropOldest()
+{
+    if(!isFiltering())
+    {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        _ring.dropOldest();
+        endRemoveRows();
+        return;
+    }
+
+    // Only remove a row if the oldest line is shown.
+    if((_matchesStart < _matches.size())
+       && (_matches.at(_matchesStart) == _ring.firstSeq()))
+    {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        _matchesStart++;
+        endRemoveRows();
+    }
+    _ring.dropOldest();
+
+    // This does not change any rows.
+    if((_matchesStart >= MATCHES_COMPACT_THRESHOLD)
+       && (_matchesStart * 2 >= _matches.size()))
+    {
+        _matches.remove(0, _matchesStart);
+        _matchesStart = 0;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef CONSOLELOGMODEL_H
+#define CONSOLELOGMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "LogRing.h"
+
+//! Maximum number of lines kept in the console log window.
+#define CONSOLELOG_RING_CAPACITY 50000
+
+/*!
+ * \ingroup data
+ * \brief The ConsoleLogModel is a QAbstractListModel which stores the most
+ * recent lines of the console log in a LogRing.
+ *
+ * Each line is a separate row, and remembers the task (if any) whose UUID
+ * was part of the message.  Once the ring is full, the oldest line is
+ * removed for every new line, so the memory use does not depend on the
+ * uptime.  The rows can be restricted to lines containing a filter string,
+ * which matches either the text or the task UUID.
+ */
+class ConsoleLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit ConsoleLogModel(QObject *parent  = nullptr,
+                             int      capacity = CONSOLELOG_RING_CAPACITY);
+
+    //! Returns the number of (matching) lines.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the line, or its task UUID as the Qt::ToolTipRole.
+    QVariant data(const QModelIndex &index,
+                  int                role = Qt::DisplayRole) const override;
+
+    //! Returns the entry shown in a row.
+    const LogEntry &entry(int row) const;
+
+    //! Returns the current filter.
+    QString filter() const;
+    //! Only show lines whose text or task UUID contain \c filter
+    //! (case-insensitive); an empty string shows every line.
+    void setFilter(const QString &filter);
+
+    //! Removes every line.
+    void clear();
+
+public slots:
+    //! Adds a (possibly multi-line) log message.
+    void appendMessage(const QDateTime &timestamp, const QString &text);
+
+private:
+    LogRing _ring;
+    QString _filter;
+    // Sequence numbers of the matching lines (if filtering), starting at
+    // _matchesStart.
+    QVector<quint64> _matches;
+    int              _matchesStart;
+
+    bool    isFiltering() const;
+    bool    matches(const LogEntry &entry) const;
+    quint64 seqForRow(int row) const;
+    void    appendEntry(const LogEntry &entry);
+    void    dropOldest();
+};
+
+#endif /* !CONSOLELOGMODEL_H */
@@ -0,0 +1,71 @@
+#include "direnumeratortask.h"
+
+WARNINGS_DISABLE
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+WARNINGS_ENABLE
+
+DirEnumeratorTask::DirEnumeratorTask(const QString &dirname)
+    : _dirname(dirname)
+{
+}
+
+void DirEnumeratorTask::run()
+{
+    QVector<FilePickerEntry> batch;
+    batch.reserve(DIRENUMERATOR_BATCH_SIZE);
+    QElapsedTimer timer;
+    timer.start();
+
+    // We want everything; the model does the filtering.
+    QDirIterator it(_dirname, QDir::AllEntries | QDir::NoDotAndDotDot
+                                  | QDir::Hidden | QDir::System);
+    while(it.hasNext() && (static_cast<int>(_stopRequested) == 0))
+    {
+        it.next();
+        batch.append(entryFromFileInfo(it.fileInfo()));
+
+        // Send what we have so far.
+        if((batch.size() >= DIRENUMERATOR_BATCH_SIZE)
+           || (timer.elapsed() >= DIRENUMERATOR_BATCH_MS))
+        {
+            emit entries(_dirname, batch);
+            batch.clear();
+            timer.restart();
+        }
+    }
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+    {
+        emit canceled();
+    }
+    else
+    {
+        if(!batch.isEmpty())
+            emit entries(_dirname, batch);
+        emit finished(_dirname);
+    }
+
+    // We're finished.
+    emit dequeue();
+}
+
+void DirEnumeratorTask::stop()
+{
+    _stopRequested = 1;
+}
+
+FilePickerEntry DirEnumeratorTask::entryFromFileInfo(const QFileInfo &info)
+{
+    FilePickerEntry entry;
+    entry.name      = info.fileName();
+    entry.modified  = info.lastModified();
+    entry.size      = info.size();
+    entry.isDir     = info.isDir();
+    entry.isSymLink = info.isSymLink();
+    entry.isHidden  = info.isHidden();
+    entry.isSystem  = !info.isDir() && !info.isFile() && !info.isSymLink();
+    return (entry);
+}
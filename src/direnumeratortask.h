@@ -0,0 +1,57 @@
+#ifndef DIRENUMERATORTASK_H
+#define DIRENUMERATORTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QObject>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/filepickerentry.h"
+
+#include "basetask.h"
+
+//! Maximum number of entries in each batch.
+#define DIRENUMERATOR_BATCH_SIZE 2000
+//! Maximum time (in ms) before a non-empty batch is sent.
+#define DIRENUMERATOR_BATCH_MS 100
+
+/*!
+ * \ingroup background-tasks
+ * \brief The DirEnumeratorTask lists the contents of a single directory,
+ * sending the entries in batches as they are read (i.e. unsorted).
+ */
+class DirEnumeratorTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit DirEnumeratorTask(const QString &dirname);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task.
+    void stop() override;
+
+    //! Returns the metadata of a single file.
+    static FilePickerEntry entryFromFileInfo(const QFileInfo &info);
+
+signals:
+    //! Some entries of the directory.
+    void entries(const QString &dirname, QVector<FilePickerEntry> batch);
+    //! All entries of the directory have been sent.
+    void finished(const QString &dirname);
+
+private:
+    QString _dirname;
+
+    QAtomicInt _stopRequested;
+};
+
+#endif /* !DIRENUMERATORTASK_H */
@@ -0,0 +1,44 @@
+#include "filehistorytask.h"
+
+#include "debug.h"
+
+#include "persistentmodel/filehistory.h"
+#include "persistentmodel/persistentstore.h"
+
+FileHistoryTask::FileHistoryTask() : _search(false), _limit(0)
+{
+}
+
+FileHistoryTask::FileHistoryTask(const QString &pattern, int limit)
+    : _search(true), _pattern(pattern), _limit(limit)
+{
+}
+
+void FileHistoryTask::run()
+{
+    // Queries from this thread need a connection of their own.
+    StoreConnection connection;
+
+    if(_search)
+    {
+        QVector<FileVersion> versions = FileHistory::find(_pattern, _limit);
+        if(static_cast<int>(_stopRequested) == 0)
+            emit result(_pattern, versions);
+    }
+    else if(!FileHistory::indexLines(&_stopRequested))
+    {
+        DEBUG << "Failed to index the file history.";
+    }
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+        emit canceled();
+
+    // We're finished.
+    emit dequeue();
+}
+
+void FileHistoryTask::stop()
+{
+    _stopRequested = 1;
+}
@@ -0,0 +1,53 @@
+#ifndef FILEHISTORYTASK_H
+#define FILEHISTORYTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/fileversion.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The FileHistoryTask indexes the new lines of the \ref ListingStore
+ * in the \ref FileHistory, or searches the FileHistory.
+ */
+class FileHistoryTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor for indexing the lines which are not in the FileHistory
+    //! yet.
+    FileHistoryTask();
+    //! Constructor for searching.
+    //! \param pattern the files to find, as for FileHistory::find().
+    //! \param limit the maximum number of versions.
+    FileHistoryTask(const QString &pattern, int limit);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task.
+    void stop() override;
+
+signals:
+    //! The versions of the files matching \c pattern (only when searching).
+    void result(const QString &pattern, QVector<FileVersion> versions);
+
+private:
+    bool    _search;
+    QString _pattern;
+    int     _limit;
+
+    QAtomicInt _stopRequested;
+};
+
+#endif /* !FILEHISTORYTASK_H */
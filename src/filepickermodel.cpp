@@ -0,0 +1,816 @@
+#include "filepickermodel.h"
+
+WARNINGS_DISABLE
+#include <QFileIconProvider>
+#include <QFileInfo>
+#include <QLocale>
+#include <QMetaObject>
+#include <QPersistentModelIndex>
+WARNINGS_ENABLE
+
+#include <algorithm>
+
+#include "compat.h"
+#include "direnumeratortask.h"
+#include "humanbytes.h"
+
+static QString entrySuffix(const QString &name)
+{
+    int dot = name.lastIndexOf(QChar('.'));
+    if(dot <= 0)
+        return (QString());
+    return (name.mid(dot + 1));
+}
+
+static QString childPath(const QString &dirname, const QString &name)
+{
+    if(dirname.endsWith(QChar('/')))
+        return (dirname + name);
+    return (dirname + QChar('/') + name);
+}
+
+FilePickerModel::FilePickerModel(QObject *parent)
+    : QAbstractItemModel(parent),
+      _root(new Node),
+      _filters(QDir::AllEntries | QDir::NoDotAndDotDot | QDir::AllDirs),
+      _sortColumn(NAME),
+      _sortOrder(Qt::AscendingOrder)
+{
+    qRegisterMetaType<QVector<FilePickerEntry>>("QVector<FilePickerEntry>");
+
+    QFileIconProvider iconProvider;
+    _dirIcon  = iconProvider.icon(QFileIconProvider::Folder);
+    _fileIcon = iconProvider.icon(QFileIconProvider::File);
+
+    _root->parent   = nullptr;
+    _root->entry    = FilePickerEntry();
+    _root->row      = -1;
+    _root->fetched  = true;
+    _root->complete = true;
+
+    // The top-level items are the filesystem roots ("/", or drives).
+    for(const QFileInfo &drive : QDir::drives())
+    {
+        FilePickerEntry entry = DirEnumeratorTask::entryFromFileInfo(drive);
+        entry.name            = drive.absoluteFilePath();
+        entry.isDir           = true;
+        entry.isHidden        = false;
+        Node *node            = newChild(_root, entry);
+        node->row             = _root->children.size();
+        _root->children.append(node);
+    }
+
+    connect(&_watcher, &QFileSystemWatcher::directoryChanged, this,
+            &FilePickerModel::directoryChanged);
+}
+
+FilePickerModel::~FilePickerModel()
+{
+    for(const QString &dirname : _tasks.keys())
+        stopReading(dirname);
+    deleteNode(_root);
+}
+
+FilePickerModel::Node *FilePickerModel::newChild(Node                  *parent,
+                                                 const FilePickerEntry &entry)
+{
+    Node *node     = new Node;
+    node->parent   = parent;
+    node->entry    = entry;
+    node->row      = -1;
+    node->fetched  = !entry.isDir;
+    node->complete = !entry.isDir;
+    parent->all.append(node);
+    parent->byName.insert(entry.name, node);
+    return (node);
+}
+
+void FilePickerModel::deleteNode(Node *node)
+{
+    for(Node *child : node->all)
+        deleteNode(child);
+    delete node;
+}
+
+void FilePickerModel::dropNode(Node *node)
+{
+    // Stop reading and watching the directory and everything inside it.
+    const QString path   = nodePath(node);
+    const QString prefix = childPath(path, QString());
+    for(const QString &dirname : _tasks.keys())
+    {
+        if((dirname == path) || dirname.startsWith(prefix))
+            stopReading(dirname);
+    }
+    for(const QString &dirname : _watcher.directories())
+    {
+        if((dirname == path) || dirname.startsWith(prefix))
+            _watcher.removePath(dirname);
+    }
+    deleteNode(node);
+}
+
+FilePickerModel::Node *
+FilePickerModel::nodeFromIndex(const QModelIndex &idx) const
+{
+    if(!idx.isValid())
+        return (_root);
+    return (static_cast<Node *>(idx.internalPointer()));
+}
+
+QModelIndex FilePickerModel::indexFromNode(Node *node, int column) const
+{
+    if((node == nullptr) || (node == _root) || (node->row < 0))
+        return (QModelIndex());
+    return (createIndex(node->row, column, node));
+}
+
+QModelIndex FilePickerModel::index(int row, int column,
+                                   const QModelIndex &parent) const
+{
+    if((row < 0) || (column < 0) || (column >= kColumnsCount)
+       || (parent.isValid() && (parent.column() != 0)))
+        return (QModelIndex());
+
+    Node *node = nodeFromIndex(parent);
+    if(row >= node->children.size())
+        return (QModelIndex());
+    return (createIndex(row, column, node->children.at(row)));
+}
+
+QModelIndex FilePickerModel::index(const QString &path, int column)
+{
+    Node *node = nodeForPath(path, true);
+    if((node == nullptr) || !isVisible(node))
+        return (QModelIndex());
+    return (createIndex(node->row, column, node));
+}
+
+QModelIndex FilePickerModel::parent(const QModelIndex &child) const
+{
+    if(!child.isValid())
+        return (QModelIndex());
+    return (indexFromNode(nodeFromIndex(child)->parent));
+}
+
+int FilePickerModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.column() > 0)
+        return (0);
+    return (nodeFromIndex(parent)->children.size());
+}
+
+int FilePickerModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return (kColumnsCount);
+}
+
+bool FilePickerModel::hasChildren(const QModelIndex &parent) const
+{
+    if(parent.column() > 0)
+        return (false);
+
+    const Node *node = nodeFromIndex(parent);
+    if(node == _root)
+        return (true);
+    if(!node->entry.isDir)
+        return (false);
+    // Until we know better, show the expand arrow.
+    if(node->complete)
+        return (!node->children.isEmpty());
+    return (true);
+}
+
+bool FilePickerModel::canFetchMore(const QModelIndex &parent) const
+{
+    const Node *node = nodeFromIndex(parent);
+    return (node->entry.isDir && !node->fetched);
+}
+
+void FilePickerModel::fetchMore(const QModelIndex &parent)
+{
+    Node *node = nodeFromIndex(parent);
+
+    // Bail (if applicable).
+    if(!node->entry.isDir || node->fetched)
+        return;
+
+    startReading(node);
+}
+
+void FilePickerModel::startReading(Node *node)
+{
+    node->fetched           = true;
+    node->complete          = false;
+    const QString      path = nodePath(node);
+    DirEnumeratorTask *task = new DirEnumeratorTask(path);
+
+    connect(task, &DirEnumeratorTask::entries, this,
+            &FilePickerModel::addEntries, Qt::QueuedConnection);
+    connect(task, &DirEnumeratorTask::finished, this,
+            &FilePickerModel::finishDirectory, Qt::QueuedConnection);
+    connect(task, &BaseTask::canceled, this,
+            [this, path, task]() { cancelDirectory(path, task); },
+            Qt::QueuedConnection);
+
+    _loadingDirs.insert(path, node);
+    _tasks.insert(path, task);
+
+    // The widgets which own this model connect to taskRequested() after
+    // creating it, so wait for the event loop before sending the tasks.
+    if(_pendingTasks.isEmpty())
+        QMetaObject::invokeMethod(this, "requestTasks", Qt::QueuedConnection);
+    _pendingTasks.append(task);
+}
+
+void FilePickerModel::requestTasks()
+{
+    const QList<DirEnumeratorTask *> tasks = _pendingTasks;
+    _pendingTasks.clear();
+
+    // Send the tasks to the TaskManager.
+    for(DirEnumeratorTask *task : tasks)
+        emit taskRequested(task);
+}
+
+void FilePickerModel::stopReading(const QString &path)
+{
+    DirEnumeratorTask *task = _tasks.take(path);
+    _loadingDirs.remove(path);
+    _refreshing.remove(path);
+    _changedDirs.remove(path);
+
+    // Bail (if applicable).
+    if(task == nullptr)
+        return;
+
+    // Tasks which have not been sent yet are still ours.
+    disconnect(task, nullptr, this, nullptr);
+    if(_pendingTasks.removeOne(task))
+        delete task;
+    else
+        emit cancelTaskRequested(task, task->uuid());
+}
+
+void FilePickerModel::cancelDirectory(const QString &dirname,
+                                      const BaseTask *task)
+{
+    // Bail (if applicable).
+    if(_tasks.value(dirname, nullptr) != task)
+        return;
+
+    _tasks.remove(dirname);
+    _refreshing.remove(dirname);
+    _changedDirs.remove(dirname);
+
+    // The directory can be fetched again.
+    Node *node = _loadingDirs.take(dirname);
+    if(node != nullptr)
+        node->fetched = false;
+}
+
+void FilePickerModel::directoryChanged(const QString &dirname)
+{
+    Node *node = nodeForPath(dirname, false);
+
+    // Bail (if applicable).  A directory which was removed disappears when
+    // its parent is read again.
+    if((node == nullptr) || !node->fetched || !QFileInfo(dirname).isDir())
+        return;
+
+    // The current read might have missed the change.
+    if(!node->complete)
+    {
+        _changedDirs.insert(dirname);
+        return;
+    }
+
+    // Read it again, and remove the entries which were not seen.
+    _refreshing.insert(dirname, QSet<QString>());
+    startReading(node);
+}
+
+void FilePickerModel::addEntries(const QString            &dirname,
+                                 QVector<FilePickerEntry> batch)
+{
+    Node *node = _loadingDirs.value(dirname, nullptr);
+
+    // Bail (if applicable).
+    if(node == nullptr)
+        return;
+
+    QHash<QString, QSet<QString>>::iterator seen = _refreshing.find(dirname);
+    QVector<Node *>                         visible;
+    for(const FilePickerEntry &entry : batch)
+    {
+        if(seen != _refreshing.end())
+            seen->insert(entry.name);
+
+        // Items added by index(path) (or an earlier read) are already here.
+        Node *child = node->byName.value(entry.name, nullptr);
+        if(child != nullptr)
+        {
+            child->entry = entry;
+            continue;
+        }
+        child = newChild(node, entry);
+        if(acceptsEntry(entry))
+            visible.append(child);
+    }
+
+    // Bail (if applicable).
+    if(visible.isEmpty())
+        return;
+
+    // Append the new rows; they are sorted once the directory is complete.
+    const bool notify = isVisible(node);
+    const int  first  = node->children.size();
+    if(notify)
+        beginInsertRows(indexFromNode(node), first,
+                        first + visible.size() - 1);
+    for(Node *child : visible)
+    {
+        child->row = node->children.size();
+        node->children.append(child);
+    }
+    if(notify)
+        endInsertRows();
+}
+
+void FilePickerModel::finishDirectory(const QString &dirname)
+{
+    Node *node = _loadingDirs.take(dirname);
+    _tasks.remove(dirname);
+
+    // Bail (if applicable).
+    if(node == nullptr)
+        return;
+
+    // Forget about entries which have been removed since the last read.
+    QVector<Node *> stale;
+    if(_refreshing.contains(dirname))
+    {
+        const QSet<QString> seen = _refreshing.take(dirname);
+        for(Node *child : node->all)
+        {
+            if(!seen.contains(child->entry.name))
+                stale.append(child);
+        }
+        for(Node *child : stale)
+        {
+            node->all.removeOne(child);
+            node->byName.remove(child->entry.name);
+        }
+    }
+    else if(!_watcher.directories().contains(dirname))
+    {
+        _watcher.addPath(dirname);
+    }
+
+    node->complete = true;
+    if(stale.isEmpty())
+        sortNode(node);
+    else
+        sortNode(node, QAbstractItemModel::NoLayoutChangeHint);
+    for(Node *child : stale)
+        dropNode(child);
+
+    // The directory changed while it was being read.
+    if(_changedDirs.remove(dirname))
+        directoryChanged(dirname);
+
+    // The expand arrow might need to go away.
+    if(node->children.isEmpty() && isVisible(node))
+    {
+        QModelIndex idx = indexFromNode(node);
+        emit        dataChanged(idx, idx);
+    }
+}
+
+FilePickerModel::Node *FilePickerModel::nodeForPath(const QString &path,
+                                                    bool           create)
+{
+    const QString clean = QDir::cleanPath(QDir::fromNativeSeparators(path));
+
+    // Find the filesystem root.
+    Node *node = nullptr;
+    for(Node *top : _root->all)
+    {
+        if(clean.startsWith(top->entry.name))
+        {
+            node = top;
+            break;
+        }
+    }
+    if(node == nullptr)
+        return (nullptr);
+
+    const QStringList names = clean.mid(node->entry.name.size())
+                                  .split(QChar('/'), SKIP_EMPTY_PARTS);
+    for(const QString &name : names)
+    {
+        Node *child = node->byName.value(name, nullptr);
+        if(child == nullptr)
+        {
+            if(!create)
+                return (nullptr);
+
+            // Add it ahead of the DirEnumeratorTask.
+            QFileInfo info(childPath(nodePath(node), name));
+            if(!info.exists() && !info.isSymLink())
+                return (nullptr);
+            child = newChild(node, DirEnumeratorTask::entryFromFileInfo(info));
+            if(acceptsEntry(child->entry))
+            {
+                const bool notify = isVisible(node);
+                const int  row    = node->children.size();
+                if(notify)
+                    beginInsertRows(indexFromNode(node), row, row);
+                child->row = row;
+                node->children.append(child);
+                if(notify)
+                    endInsertRows();
+            }
+        }
+        node = child;
+    }
+    return (node);
+}
+
+QString FilePickerModel::nodePath(const Node *node) const
+{
+    if((node == nullptr) || (node == _root))
+        return (QString());
+
+    // Paths are not stored in the nodes, to save memory.
+    QStringList names;
+    while(node->parent != _root)
+    {
+        names.prepend(node->entry.name);
+        node = node->parent;
+    }
+    return (node->entry.name + names.join(QChar('/')));
+}
+
+bool FilePickerModel::isVisible(const Node *node) const
+{
+    for(; node != _root; node = node->parent)
+    {
+        if(node->row < 0)
+            return (false);
+    }
+    return (true);
+}
+
+bool FilePickerModel::acceptsEntry(const FilePickerEntry &entry) const
+{
+    if(entry.isHidden && !(_filters & QDir::Hidden))
+        return (false);
+    if(entry.isSystem && !(_filters & QDir::System))
+        return (false);
+    if(entry.isSymLink && (_filters & QDir::NoSymLinks))
+        return (false);
+    if(!entry.isDir && !(_filters & QDir::Files))
+        return (false);
+    return (true);
+}
+
+bool FilePickerModel::matchesNameFilters(const Node *node) const
+{
+    // Directory names are unaffected.
+    if(_nameFilters.isEmpty() || node->entry.isDir)
+        return (true);
+
+    for(const QRegExp &rx : _nameFilters)
+    {
+        if(rx.exactMatch(node->entry.name))
+            return (true);
+    }
+    return (false);
+}
+
+bool FilePickerModel::lessThan(const Node *a, const Node *b) const
+{
+    const FilePickerEntry &ea = a->entry;
+    const FilePickerEntry &eb = b->entry;
+
+    // Directories always come first.
+    if(ea.isDir != eb.isDir)
+        return (ea.isDir);
+
+    int cmp = 0;
+    switch(_sortColumn)
+    {
+    case SIZE:
+        cmp = (ea.size < eb.size) ? -1 : (ea.size > eb.size) ? 1 : 0;
+        break;
+    case TYPE:
+        cmp = entrySuffix(ea.name).compare(entrySuffix(eb.name),
+                                           Qt::CaseInsensitive);
+        break;
+    case MODIFIED:
+        cmp = (ea.modified < eb.modified) ? -1
+                                          : (ea.modified > eb.modified) ? 1 : 0;
+        break;
+    default:
+        break;
+    }
+    if(cmp == 0)
+        cmp = ea.name.compare(eb.name, Qt::CaseInsensitive);
+    if(cmp == 0)
+        cmp = ea.name.compare(eb.name);
+
+    if(_sortOrder == Qt::AscendingOrder)
+        return (cmp < 0);
+    return (cmp > 0);
+}
+
+void FilePickerModel::sortNode(Node                                *node,
+                               QAbstractItemModel::LayoutChangeHint hint)
+{
+    std::stable_sort(node->all.begin(), node->all.end(),
+                     [this](const Node *a, const Node *b) {
+                         return (lessThan(a, b));
+                     });
+
+    // Nobody is looking at these rows.
+    if(!isVisible(node))
+    {
+        rebuildChildren(node);
+        return;
+    }
+
+    QList<QPersistentModelIndex> parents;
+    if(node != _root)
+        parents << QPersistentModelIndex(indexFromNode(node));
+    emit layoutAboutToBeChanged(parents, hint);
+    rebuildChildren(node);
+    updatePersistentIndexes();
+    emit layoutChanged(parents, hint);
+}
+
+void FilePickerModel::rebuildChildren(Node *node)
+{
+    // Rows which are no longer in the directory are hidden.
+    for(Node *child : node->children)
+        child->row = -1;
+    node->children.clear();
+    for(Node *child : node->all)
+    {
+        if(acceptsEntry(child->entry))
+        {
+            child->row = node->children.size();
+            node->children.append(child);
+        }
+        else
+        {
+            child->row = -1;
+        }
+    }
+}
+
+void FilePickerModel::refreshNode(Node *node, bool sort)
+{
+    if(sort && node->complete)
+        std::stable_sort(node->all.begin(), node->all.end(),
+                         [this](const Node *a, const Node *b) {
+                             return (lessThan(a, b));
+                         });
+    rebuildChildren(node);
+
+    // Only directories which have been read have anything to refresh.
+    for(Node *child : node->all)
+    {
+        if(!child->all.isEmpty())
+            refreshNode(child, sort);
+    }
+}
+
+void FilePickerModel::updatePersistentIndexes()
+{
+    const QModelIndexList from = persistentIndexList();
+    QModelIndexList       to;
+    to.reserve(from.size());
+    for(const QModelIndex &idx : from)
+    {
+        Node *node = static_cast<Node *>(idx.internalPointer());
+        if(isVisible(node))
+            to << createIndex(node->row, idx.column(), node);
+        else
+            to << QModelIndex();
+    }
+    changePersistentIndexList(from, to);
+}
+
+Qt::ItemFlags FilePickerModel::flags(const QModelIndex &idx) const
+{
+    if(!idx.isValid())
+        return (Qt::NoItemFlags);
+
+    const Node   *node  = nodeFromIndex(idx);
+    Qt::ItemFlags flags = Qt::ItemIsSelectable | Qt::ItemIsUserCheckable;
+    if(matchesNameFilters(node))
+        flags |= Qt::ItemIsEnabled;
+    if(!node->entry.isDir)
+        flags |= Qt::ItemNeverHasChildren;
+    return (flags);
+}
+
+QVariant FilePickerModel::data(const QModelIndex &idx, int role) const
+{
+    if(!idx.isValid())
+        return (QVariant());
+
+    const Node            *node  = nodeFromIndex(idx);
+    const FilePickerEntry &entry = node->entry;
+    switch(role)
+    {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        switch(idx.column())
+        {
+        case NAME:
+            return (entry.name);
+        case SIZE:
+            if(entry.isDir)
+                return (QString());
+            return (humanBytes(static_cast<quint64>(entry.size)));
+        case TYPE:
+        {
+            if(entry.isDir)
+                return (tr("Folder"));
+            const QString suffix = entrySuffix(entry.name);
+            if(suffix.isEmpty())
+                return (tr("File"));
+            return (tr("%1 File").arg(suffix.toUpper()));
+        }
+        case MODIFIED:
+            return (QLocale().toString(entry.modified, QLocale::ShortFormat));
+        default:
+            break;
+        }
+        break;
+    case Qt::DecorationRole:
+        if(idx.column() == NAME)
+            return (entry.isDir ? _dirIcon : _fileIcon);
+        break;
+    case Qt::TextAlignmentRole:
+        if(idx.column() == SIZE)
+            return (QVariant(Qt::AlignRight | Qt::AlignVCenter));
+        break;
+    case Qt::CheckStateRole:
+        if(idx.column() == NAME)
+            return (_checkStates.state(nodePath(node)));
+        break;
+    default:
+        break;
+    }
+    return (QVariant());
+}
+
+bool FilePickerModel::setData(const QModelIndex &idx, const QVariant &value,
+                              int role)
+{
+    // Bail (if applicable).
+    if((role != Qt::CheckStateRole) || !idx.isValid())
+        return (false);
+
+    const QString path = filePath(idx);
+    if(value == Qt::Checked)
+        _checkStates.setChecked(path);
+    else if(value == Qt::Unchecked)
+        _checkStates.setUnchecked(path);
+
+    QVector<int> selectionChangedRole;
+    selectionChangedRole << SELECTION_CHANGED_ROLE;
+    emit dataChanged(idx, idx, selectionChangedRole);
+    return (true);
+}
+
+QVariant FilePickerModel::headerData(int section, Qt::Orientation orientation,
+                                     int role) const
+{
+    if((orientation != Qt::Horizontal) || (role != Qt::DisplayRole))
+        return (QVariant());
+
+    switch(section)
+    {
+    case NAME:
+        return (tr("Name"));
+    case SIZE:
+        return (tr("Size"));
+    case TYPE:
+        return (tr("Type"));
+    case MODIFIED:
+        return (tr("Date Modified"));
+    default:
+        return (QVariant());
+    }
+}
+
+void FilePickerModel::sort(int column, Qt::SortOrder order)
+{
+    // Bail (if applicable).
+    if((column == _sortColumn) && (order == _sortOrder))
+        return;
+
+    _sortColumn = column;
+    _sortOrder  = order;
+
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(),
+                                QAbstractItemModel::VerticalSortHint);
+    refreshNode(_root, true);
+    updatePersistentIndexes();
+    emit layoutChanged(QList<QPersistentModelIndex>(),
+                       QAbstractItemModel::VerticalSortHint);
+}
+
+QString FilePickerModel::filePath(const QModelIndex &idx) const
+{
+    if(!idx.isValid())
+        return (QString());
+    return (nodePath(nodeFromIndex(idx)));
+}
+
+bool FilePickerModel::isDir(const QModelIndex &idx) const
+{
+    if(!idx.isValid())
+        return (false);
+    return (nodeFromIndex(idx)->entry.isDir);
+}
+
+bool FilePickerModel::isLoading(const QModelIndex &idx) const
+{
+    const Node *node = nodeFromIndex(idx);
+    return (node->fetched && !node->complete);
+}
+
+QDir::Filters FilePickerModel::filter() const
+{
+    return (_filters);
+}
+
+void FilePickerModel::setFilter(QDir::Filters filters)
+{
+    // Bail (if applicable).
+    if(filters == _filters)
+        return;
+
+    emit layoutAboutToBeChanged();
+    _filters = filters;
+    refreshNode(_root, false);
+    updatePersistentIndexes();
+    emit layoutChanged();
+}
+
+void FilePickerModel::setNameFilters(const QStringList &filters)
+{
+    _nameFilters.clear();
+    for(const QString &filter : filters)
+        _nameFilters << QRegExp(filter, Qt::CaseInsensitive, QRegExp::Wildcard);
+
+    // Only the flags change, but every loaded directory is affected.
+    emit layoutAboutToBeChanged();
+    emit layoutChanged();
+}
+
+QStringList FilePickerModel::checkedPaths() const
+{
+    return (_checkStates.checkedPaths());
+}
+
+void FilePickerModel::setPathChecked(const QString &path, bool checked)
+{
+    const QString clean = QDir::cleanPath(QDir::fromNativeSeparators(path));
+    if(checked)
+        _checkStates.setChecked(clean);
+    else
+        _checkStates.setUnchecked(clean);
+
+    // Notify listeners about the nearest item which is part of the model
+    // (the path might not have been read yet); its state changes as well.
+    QString dirname = clean;
+    Node   *node    = nodeForPath(dirname, false);
+    while((node == nullptr) && (dirname != QFileInfo(dirname).path()))
+    {
+        dirname = QFileInfo(dirname).path();
+        node    = nodeForPath(dirname, false);
+    }
+    while((node != nullptr) && !isVisible(node))
+        node = node->parent;
+
+    // Bail (if applicable).
+    if((node == nullptr) || (node == _root))
+        return;
+
+    QModelIndex  idx = indexFromNode(node);
+    QVector<int> selectionChangedRole;
+    selectionChangedRole << SELECTION_CHANGED_ROLE;
+    emit dataChanged(idx, idx, selectionChangedRole);
+}
+
+void FilePickerModel::reset()
+{
+    _checkStates.clear();
+}
@@ -0,0 +1,189 @@
+#ifndef FILEPICKERMODEL_H
+#define FILEPICKERMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractItemModel>
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QIcon>
+#include <QList>
+#include <QModelIndex>
+#include <QObject>
+#include <QRegExp>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+#include <QVariant>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/filepickerentry.h"
+
+#include "checkstatetree.h"
+
+/* Forward declaration(s). */
+class BaseTask;
+class DirEnumeratorTask;
+
+/*!
+ * \ingroup data
+ * \brief The FilePickerModel is a QAbstractItemModel of the local filesystem
+ * which keeps track of which files/directories have been (fully or
+ * partially) checked.
+ *
+ * Unlike QFileSystemModel, directories are read by a DirEnumeratorTask
+ * (sent to the TaskManager with taskRequested()), and the entries are added
+ * in batches (unsorted) as soon as they arrive.  Each directory is sorted
+ * once it has been read completely.  Directories which have been read are
+ * watched, and read again when they change.  The checked states are kept
+ * in a CheckStateTree.
+ */
+class FilePickerModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit FilePickerModel(QObject *parent = nullptr);
+    ~FilePickerModel() override;
+
+    //! Returns the index of the item; used internally by the Qt layer.
+    QModelIndex index(int row, int column,
+                      const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the index of a path (or an invalid index if it does not
+    //! exist, or is filtered out).  Missing items on the way are added.
+    QModelIndex index(const QString &path, int column = 0);
+    //! Returns the parent of the item; used internally by the Qt layer.
+    QModelIndex parent(const QModelIndex &child) const override;
+    //! Returns the number of items which have been read so far.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the number of columns.
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns whether the item is a directory which might have contents.
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns whether the directory has not been read yet.
+    bool canFetchMore(const QModelIndex &parent) const override;
+    //! Starts reading the directory in the background.
+    void fetchMore(const QModelIndex &parent) override;
+
+    //! Returns metadata; used internally by the Qt layer.
+    Qt::ItemFlags flags(const QModelIndex &idx) const override;
+    //! Returns the Qt::CheckState or other data; used internally by the Qt
+    //! layer.
+    QVariant data(const QModelIndex &idx, int role) const override;
+    //! Sets files or directories as being checked or unchecked.
+    /*!
+     * \param idx Indicates which file or directory's state to change.
+     * \param value Qt::Checked or Qt::Unchecked.
+     * \param role Must be Qt::CheckStateRole.
+     */
+    bool setData(const QModelIndex &idx, const QVariant &value,
+                 int role) override;
+    //! Returns the text for a header field.
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    //! Sorts every directory which has been read completely.  Other
+    //! directories are sorted when they are complete.
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    //! Returns the full path of the item.
+    QString filePath(const QModelIndex &idx) const;
+    //! Returns whether the item is a directory (or a link to one).
+    bool isDir(const QModelIndex &idx) const;
+    //! Returns whether the directory is being read.
+    bool isLoading(const QModelIndex &idx) const;
+
+    //! Returns the QDir filters; only QDir::Hidden, QDir::System,
+    //! QDir::NoSymLinks, and QDir::Files are used.
+    QDir::Filters filter() const;
+    //! Sets the QDir filters.
+    void setFilter(QDir::Filters filters);
+    //! Files which do not match any of these wildcards are disabled.
+    void setNameFilters(const QStringList &filters);
+
+    //! Returns a list of fully checked paths.
+    QStringList checkedPaths() const;
+    //! Sets a path to be checked or unchecked, even if it is not (yet)
+    //! part of the model.
+    void setPathChecked(const QString &path, bool checked);
+
+    //! Clears the list of fully and partially checked files and dirs.
+    void reset();
+
+signals:
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
+private slots:
+    void addEntries(const QString &dirname, QVector<FilePickerEntry> batch);
+    void finishDirectory(const QString &dirname);
+    void directoryChanged(const QString &dirname);
+    void requestTasks();
+
+private:
+    struct Node
+    {
+        Node                  *parent;
+        FilePickerEntry        entry;
+        QVector<Node *>        all;
+        QVector<Node *>        children;
+        QHash<QString, Node *> byName;
+        int                    row;
+        bool                   fetched;
+        bool                   complete;
+    };
+
+    enum Columns
+    {
+        NAME,
+        SIZE,
+        TYPE,
+        MODIFIED
+    };
+
+    const int kColumnsCount = 4;
+
+    Node                              *_root;
+    QHash<QString, Node *>             _loadingDirs;
+    QHash<QString, DirEnumeratorTask *> _tasks;
+    QList<DirEnumeratorTask *>         _pendingTasks;
+    QHash<QString, QSet<QString>>      _refreshing;
+    QSet<QString>                      _changedDirs;
+    QFileSystemWatcher                 _watcher;
+    CheckStateTree                     _checkStates;
+    QDir::Filters                      _filters;
+    QList<QRegExp>                     _nameFilters;
+    int                                _sortColumn;
+    Qt::SortOrder                      _sortOrder;
+    QIcon                              _dirIcon;
+    QIcon                              _fileIcon;
+
+    Node       *newChild(Node *parent, const FilePickerEntry &entry);
+    void        deleteNode(Node *node);
+    void        dropNode(Node *node);
+    Node       *nodeFromIndex(const QModelIndex &idx) const;
+    QModelIndex indexFromNode(Node *node, int column = 0) const;
+    Node       *nodeForPath(const QString &path, bool create);
+    QString     nodePath(const Node *node) const;
+    bool        isVisible(const Node *node) const;
+    bool        acceptsEntry(const FilePickerEntry &entry) const;
+    bool        matchesNameFilters(const Node *node) const;
+    bool        lessThan(const Node *a, const Node *b) const;
+    void        startReading(Node *node);
+    void        stopReading(const QString &path);
+    void        cancelDirectory(const QString &dirname, const BaseTask *task);
+    void        sortNode(Node *node, QAbstractItemModel::LayoutChangeHint hint
+                                     = QAbstractItemModel::VerticalSortHint);
+    void        rebuildChildren(Node *node);
+    void        refreshNode(Node *node, bool sort);
+    void        updatePersistentIndexes();
+};
+
+#endif /* !FILEPICKERMODEL_H */
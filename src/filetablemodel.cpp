@@ -3,24 +3,32 @@
 WARNINGS_DISABLE
 #include <QAbstractTableModel>
 #include <QVariant>
-#include <QVector>
 #include <Qt>
 WARNINGS_ENABLE
 
 #include "messages/archivefilestat.h"
 
+#include "archivelisting.h"
 #include "parsearchivelistingtask.h"
 #include "persistentmodel/archive.h"
+#include "tasks/tasks-utils.h"
+
+// Number of parsed rows to keep.
+#define ROW_CACHE_SIZE 4096
 
 FileTableModel::FileTableModel(QObject *parent)
-    : QAbstractTableModel(parent), _parseTask(nullptr)
+    : QAbstractTableModel(parent),
+      _rowCache(ROW_CACHE_SIZE),
+      _parseTask(nullptr)
 {
 }
 
 int FileTableModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
-    return (_files.count());
+    if(!_listing)
+        return (0);
+    return (_listing->count());
 }
 
 int FileTableModel::columnCount(const QModelIndex &parent) const
@@ -33,27 +41,47 @@ QVariant FileTableModel::data(const QModelIndex &index, int role) const
 {
     if(role == Qt::DisplayRole)
     {
+        const FileStat *file = fileStat(index.row());
+        if(file == nullptr)
+            return (QVariant());
+
         switch(index.column())
         {
         case TableColumns::FILE:
-            return (_files[index.row()].name);
+            return (file->name);
         case TableColumns::MODIFIED:
-            return (_files[index.row()].modified);
+            return (file->modified);
         case TableColumns::SIZE:
-            return (_files[index.row()].size);
+            return (file->size);
         case TableColumns::USER:
-            return (_files[index.row()].user);
+            return (file->user);
         case TableColumns::GROUP:
-            return (_files[index.row()].group);
+            return (file->group);
         case TableColumns::MODE:
-            return (_files[index.row()].mode);
+            return (file->mode);
         case TableColumns::LINKS:
-            return (_files[index.row()].links);
+            return (file->links);
         }
     }
     return (QVariant());
 }
 
+const FileStat *FileTableModel::fileStat(int row) const
+{
+    // Bail (if applicable).
+    if(!_listing || (row < 0) || (row >= _listing->count()))
+        return (nullptr);
+
+    // Parse the row (if necessary).
+    FileStat *file = _rowCache.object(row);
+    if(file == nullptr)
+    {
+        file = new FileStat(_listing->stat(row));
+        _rowCache.insert(row, file);
+    }
+    return (file);
+}
+
 QVariant FileTableModel::headerData(int section, Qt::Orientation orientation,
                                     int role) const
 {
@@ -91,33 +119,41 @@ void FileTableModel::setArchive(const ArchivePtr &archive)
     // Disable previous connection (if it exists).
     if(_parseTask)
         disconnect(_parseTask, &ParseArchiveListingTask::result, this,
-                   &FileTableModel::setFiles);
+                   &FileTableModel::setListing);
     reset();
     _archive = archive;
     if(_archive)
     {
-        // Prepare a background thread to parse the Archive's saved contents.
+        // Prepare a background thread to load and index the Archive's saved
+        // contents.
         ParseArchiveListingTask *parseTask =
-            new ParseArchiveListingTask(archive->contents());
+            new ParseArchiveListingTask(archive->name(), makeSpillDir());
         connect(parseTask, &ParseArchiveListingTask::result, this,
-                &FileTableModel::setFiles);
+                &FileTableModel::setListing);
         emit taskRequested(parseTask);
     }
 }
 
-void FileTableModel::setFiles(const QVector<FileStat> &files)
+void FileTableModel::setListing(const ArchiveListingPtr &listing)
 {
     // This indicates that our internal data is changing.
     beginResetModel();
-    _files = files;
+    _rowCache.clear();
+    _listing = listing;
     // We finished changing internal data; any views using this
     // model will refresh.
     endResetModel();
 }
 
+ArchiveListingPtr FileTableModel::listing() const
+{
+    return (_listing);
+}
+
 void FileTableModel::reset()
 {
     beginResetModel();
-    _files.clear();
+    _rowCache.clear();
+    _listing.clear();
     endResetModel();
 }
@@ -5,14 +5,15 @@
 
 WARNINGS_DISABLE
 #include <QAbstractTableModel>
+#include <QCache>
 #include <QModelIndex>
 #include <QObject>
 #include <QVariant>
-#include <QVector>
 #include <Qt>
 WARNINGS_ENABLE
 
 #include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
 #include "messages/archiveptr.h"
 
 /* Forward declaration(s). */
@@ -23,12 +24,27 @@ class ParseArchiveListingTask;
  * \ingroup data
  * \brief The FileTableModel is a QAbstractTableModel which stores
  * a list of files in an Archive.
+ *
+ * The files are kept in an ArchiveListing; each row is parsed when it is
+ * first requested, and a limited number of parsed rows are cached.
  */
 class FileTableModel : public QAbstractTableModel
 {
     Q_OBJECT
 
 public:
+    //! The columns of the table.
+    enum TableColumns
+    {
+        FILE,
+        MODIFIED,
+        SIZE,
+        USER,
+        GROUP,
+        MODE,
+        LINKS
+    };
+
     //! Constructor
     explicit FileTableModel(QObject *parent);
 
@@ -58,32 +74,27 @@ public:
     //! Clears the stored information about files.
     void reset();
 
+    //! Returns the list of files (if any).
+    ArchiveListingPtr listing() const;
+
 public slots:
     //! Sets the list of files to be stored in this object.
-    void setFiles(const QVector<FileStat> &files);
+    void setListing(const ArchiveListingPtr &listing);
 
 signals:
     //! We have a task to perform in the background.
     void taskRequested(BaseTask *task);
 
 private:
-    QVector<FileStat> _files;
-    ArchivePtr        _archive;
-
-    enum TableColumns
-    {
-        FILE,
-        MODIFIED,
-        SIZE,
-        USER,
-        GROUP,
-        MODE,
-        LINKS
-    };
+    ArchiveListingPtr             _listing;
+    mutable QCache<int, FileStat> _rowCache;
+    ArchivePtr                    _archive;
 
     const int kTableColumnsCount = 7;
 
     ParseArchiveListingTask *_parseTask;
+
+    const FileStat *fileStat(int row) const;
 };
 
 #endif // FILETABLEMODEL_H
@@ -0,0 +1,247 @@
+#include "filetableproxymodel.h"
+
+WARNINGS_DISABLE
+#include <QModelIndexList>
+WARNINGS_ENABLE
+
+#include "messages/archivelistingptr.h"
+
+#include "filetablemodel.h"
+#include "filetablesorttask.h"
+
+FileTableProxyModel::FileTableProxyModel(FileTableModel *source)
+    : QAbstractProxyModel(source),
+      _source(source),
+      _task(nullptr),
+      _sortColumn(-1),
+      _sortOrder(Qt::AscendingOrder),
+      _generation(0),
+      _shownGeneration(0)
+{
+    setSourceModel(_source);
+    connect(_source, &FileTableModel::modelAboutToBeReset, this,
+            &FileTableProxyModel::beginResetModel);
+    connect(_source, &FileTableModel::modelReset, this,
+            &FileTableProxyModel::sourceReset);
+    showAllRows();
+}
+
+FileTableProxyModel::~FileTableProxyModel()
+{
+    stopTask();
+}
+
+QModelIndex FileTableProxyModel::index(int row, int column,
+                                       const QModelIndex &parent) const
+{
+    // Bail (if applicable).
+    if(parent.isValid() || (row < 0) || (row >= _rows.size()) || (column < 0)
+       || (column >= columnCount()))
+        return (QModelIndex());
+
+    return (createIndex(row, column));
+}
+
+QModelIndex FileTableProxyModel::parent(const QModelIndex &child) const
+{
+    Q_UNUSED(child)
+    return (QModelIndex());
+}
+
+int FileTableProxyModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    return (_rows.size());
+}
+
+int FileTableProxyModel::columnCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    return (_source->columnCount());
+}
+
+QVariant FileTableProxyModel::headerData(int section,
+                                         Qt::Orientation orientation,
+                                         int role) const
+{
+    return (_source->headerData(section, orientation, role));
+}
+
+QModelIndex
+FileTableProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    // Bail (if applicable).
+    if(!proxyIndex.isValid() || (proxyIndex.row() >= _rows.size()))
+        return (QModelIndex());
+
+    return (_source->index(_rows.at(proxyIndex.row()), proxyIndex.column()));
+}
+
+QModelIndex
+FileTableProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    // Bail (if applicable).
+    if(!sourceIndex.isValid())
+        return (QModelIndex());
+
+    const int row = _positions.value(sourceIndex.row(), -1);
+    if(row == -1)
+        return (QModelIndex());
+    return (index(row, sourceIndex.column()));
+}
+
+void FileTableProxyModel::sort(int column, Qt::SortOrder order)
+{
+    // Bail (if applicable).
+    if((column == _sortColumn) && (order == _sortOrder))
+        return;
+
+    _sortColumn = column;
+    _sortOrder  = order;
+    startTask();
+}
+
+bool FileTableProxyModel::isBusy() const
+{
+    return (_shownGeneration != _generation);
+}
+
+void FileTableProxyModel::setFilterWildcard(const QString &pattern)
+{
+    // Bail (if applicable).
+    if(pattern == _filter)
+        return;
+
+    _filter = pattern;
+    startTask();
+}
+
+void FileTableProxyModel::sourceReset()
+{
+    // The rows refer to the previous listing.  Until the new listing has
+    // been filtered, no rows are shown; if it only needs to be sorted, it
+    // is shown in its own order meanwhile.
+    if(_filter.isEmpty())
+    {
+        showAllRows();
+    }
+    else
+    {
+        _rows.clear();
+        _positions.clear();
+    }
+    endResetModel();
+
+    if(!_filter.isEmpty() || (_sortColumn >= 0))
+    {
+        startTask();
+    }
+    else
+    {
+        // Any running task is for the previous listing.
+        _generation++;
+        _shownGeneration = _generation;
+    }
+}
+
+void FileTableProxyModel::setRows(quint64 generation, QVector<int> rows,
+                                  QVector<int> positions)
+{
+    // Bail (if applicable).
+    if(generation != _generation)
+        return;
+
+    if(rows.size() == _rows.size())
+    {
+        // Keep the selection when the rows are only rearranged.
+        emit layoutAboutToBeChanged();
+        const QModelIndexList before = persistentIndexList();
+        QModelIndexList       after;
+        for(const QModelIndex &index : before)
+        {
+            const int source = _rows.value(index.row(), -1);
+            const int row    = positions.value(source, -1);
+            after.append((row == -1) ? QModelIndex()
+                                     : createIndex(row, index.column()));
+        }
+        _rows      = rows;
+        _positions = positions;
+        changePersistentIndexList(before, after);
+        emit layoutChanged();
+    }
+    else
+    {
+        beginResetModel();
+        _rows      = rows;
+        _positions = positions;
+        endResetModel();
+    }
+    _shownGeneration = generation;
+    emit ready();
+}
+
+void FileTableProxyModel::startTask()
+{
+    // Discard the result of any previous sort or filter.
+    _generation++;
+    stopTask();
+
+    const ArchiveListingPtr listing = _source->listing();
+    if(!listing)
+    {
+        _shownGeneration = _generation;
+        return;
+    }
+
+    // Without a filter or a sort order, the rows are simply the listing.
+    if(_filter.isEmpty() && (_sortColumn < 0))
+    {
+        beginResetModel();
+        showAllRows();
+        endResetModel();
+        _shownGeneration = _generation;
+        emit ready();
+        return;
+    }
+
+    FileTableSortTask *task = new FileTableSortTask(listing, _filter,
+                                                    _sortColumn, _sortOrder,
+                                                    _generation);
+    connect(task, &FileTableSortTask::result, this,
+            &FileTableProxyModel::setRows, Qt::QueuedConnection);
+    // The task is deleted by the TaskQueuer once it is done or canceled.
+    const auto forget = [this, task]() {
+        if(_task == task)
+            _task = nullptr;
+    };
+    connect(task, &BaseTask::dequeue, this, forget, Qt::QueuedConnection);
+    connect(task, &BaseTask::canceled, this, forget, Qt::QueuedConnection);
+
+    _task = task;
+    emit taskRequested(task);
+}
+
+void FileTableProxyModel::stopTask()
+{
+    // Bail (if applicable).
+    if(!_task)
+        return;
+
+    disconnect(_task, nullptr, this, nullptr);
+    emit cancelTaskRequested(_task, _task->uuid());
+    _task = nullptr;
+}
+
+void FileTableProxyModel::showAllRows()
+{
+    const int count = _source->rowCount();
+    _rows.resize(count);
+    _positions.resize(count);
+    for(int i = 0; i < count; i++)
+    {
+        _rows[i]      = i;
+        _positions[i] = i;
+    }
+}
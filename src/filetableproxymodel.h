@@ -0,0 +1,107 @@
+#ifndef FILETABLEPROXYMODEL_H
+#define FILETABLEPROXYMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractProxyModel>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QUuid>
+#include <QVariant>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class BaseTask;
+class FileTableModel;
+class FileTableSortTask;
+
+/*!
+ * \ingroup data
+ * \brief The FileTableProxyModel is a QAbstractProxyModel which sorts and
+ * filters a \ref FileTableModel in the background.
+ *
+ * Unlike QSortFilterProxyModel, sorting or filtering does not block the
+ * event loop: a \ref FileTableSortTask computes the new order on a worker
+ * thread, and the previous rows are shown until the result replaces them
+ * all at once.  Results of a sort or filter which has been superseded are
+ * discarded.
+ */
+class FileTableProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit FileTableProxyModel(FileTableModel *source);
+    ~FileTableProxyModel() override;
+
+    //! Returns the index of a row and column.
+    QModelIndex index(int row, int column,
+                      const QModelIndex &parent = QModelIndex()) const override;
+    //! The table has no parents.
+    QModelIndex parent(const QModelIndex &child) const override;
+    //! Returns the number of (matching) files.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the number of columns of the source.
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the column titles of the source, or the row numbers.
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    //! Returns the source index of a row.
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    //! Returns the row of a source index (if it matches the filter).
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+    //! Starts sorting the files by \c column; -1 restores the order of the
+    //! listing.
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    //! Returns whether the rows are out of date, i.e. a sort or filter is
+    //! still running.
+    bool isBusy() const;
+
+public slots:
+    //! Starts filtering the filenames with a case-insensitive wildcard
+    //! pattern.
+    void setFilterWildcard(const QString &pattern);
+
+signals:
+    //! The rows have been replaced with the result of the latest sort or
+    //! filter.
+    void ready();
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
+private slots:
+    void sourceReset();
+    void setRows(quint64 generation, QVector<int> rows,
+                 QVector<int> positions);
+
+private:
+    FileTableModel    *_source;
+    FileTableSortTask *_task;
+
+    // The source row of each row, and the row of each source row.
+    QVector<int> _rows;
+    QVector<int> _positions;
+
+    QString       _filter;
+    int           _sortColumn;
+    Qt::SortOrder _sortOrder;
+    // Incremented by every sort or filter; only the latest result is used.
+    quint64 _generation;
+    quint64 _shownGeneration;
+
+    void startTask();
+    void stopTask();
+    void showAllRows();
+};
+
+#endif /* !FILETABLEPROXYMODEL_H */
@@ -0,0 +1,141 @@
+#include "filetablesorttask.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+#include <utility>
+
+#include <QRegExp>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+
+#include "archivelisting.h"
+#include "filetablemodel.h"
+
+// Check whether the task should stop after this many lines.
+#define STOP_CHECK_LINES 4096
+
+FileTableSortTask::FileTableSortTask(const ArchiveListingPtr &listing,
+                                     const QString &filter, int column,
+                                     Qt::SortOrder order, quint64 generation)
+    : _listing(listing),
+      _filter(filter),
+      _column(column),
+      _order(order),
+      _generation(generation)
+{
+}
+
+void FileTableSortTask::run()
+{
+    const int count = _listing ? _listing->count() : 0;
+    QRegExp   filter(_filter, Qt::CaseInsensitive, QRegExp::Wildcard);
+
+    // Only the sort column is kept.
+    QVector<int>     rows;
+    QVector<QString> text;
+    QVector<quint64> numbers;
+    rows.reserve(count);
+    for(int row = 0; row < count; row++)
+    {
+        // Bail if requested.
+        if(((row % STOP_CHECK_LINES) == 0)
+           && (static_cast<int>(_stopRequested) == 1))
+            break;
+
+        // Without a filter or a sort column, the lines are not parsed.
+        if(_filter.isEmpty() && (_column < 0))
+        {
+            rows.append(row);
+            continue;
+        }
+
+        const FileStat stat = _listing->stat(row);
+        if(!_filter.isEmpty() && !stat.name.contains(filter))
+            continue;
+        rows.append(row);
+        switch(_column)
+        {
+        case FileTableModel::FILE:
+            text.append(stat.name);
+            break;
+        case FileTableModel::MODIFIED:
+            text.append(stat.modified);
+            break;
+        case FileTableModel::SIZE:
+            numbers.append(stat.size);
+            break;
+        case FileTableModel::USER:
+            text.append(stat.user);
+            break;
+        case FileTableModel::GROUP:
+            text.append(stat.group);
+            break;
+        case FileTableModel::MODE:
+            text.append(stat.mode);
+            break;
+        case FileTableModel::LINKS:
+            numbers.append(stat.links);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+    {
+        emit canceled();
+    }
+    else
+    {
+        if(!text.isEmpty() || !numbers.isEmpty())
+            rows = sorted(rows, text, numbers);
+        QVector<int> positions(count, -1);
+        for(int i = 0; i < rows.size(); i++)
+            positions[rows.at(i)] = i;
+        emit result(_generation, rows, positions);
+    }
+
+    // We're finished.
+    emit dequeue();
+}
+
+void FileTableSortTask::stop()
+{
+    _stopRequested = 1;
+}
+
+QVector<int> FileTableSortTask::sorted(const QVector<int>     &rows,
+                                       const QVector<QString> &text,
+                                       const QVector<quint64> &numbers) const
+{
+    // Sort the positions in the key arrays, rather than the keys.
+    QVector<int> order(rows.size());
+    for(int i = 0; i < order.size(); i++)
+        order[i] = i;
+    const bool descending = (_order == Qt::DescendingOrder);
+    if(!numbers.isEmpty())
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [&numbers, descending](int a, int b) {
+                             if(descending)
+                                 std::swap(a, b);
+                             return (numbers.at(a) < numbers.at(b));
+                         });
+    }
+    else
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [&text, descending](int a, int b) {
+                             if(descending)
+                                 std::swap(a, b);
+                             return (text.at(a) < text.at(b));
+                         });
+    }
+
+    QVector<int> result(order.size());
+    for(int i = 0; i < order.size(); i++)
+        result[i] = rows.at(order.at(i));
+    return (result);
+}
@@ -0,0 +1,69 @@
+#ifndef FILETABLESORTTASK_H
+#define FILETABLESORTTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/archivelistingptr.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The FileTableSortTask finds which lines of an ArchiveListing match
+ * a filter, and sorts them by one column.
+ *
+ * Each line is parsed once; the values of the sort column are stored in a
+ * single array (strings or numbers), and the matching rows are sorted by
+ * their position in that array.
+ */
+class FileTableSortTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    //! \param listing the files.
+    //! \param filter case-insensitive wildcard pattern for the filenames;
+    //! an empty pattern matches every file.
+    //! \param column a \ref FileTableModel column, or -1 to keep the order
+    //! of the listing.
+    //! \param order the sort order.
+    //! \param generation returned with the \ref result.
+    FileTableSortTask(const ArchiveListingPtr &listing, const QString &filter,
+                      int column, Qt::SortOrder order, quint64 generation);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task.
+    void stop() override;
+
+signals:
+    //! The matching rows of the listing, in the order in which they
+    //! should be shown, and the position of each row of the listing in
+    //! that order (or -1 if it does not match).
+    void result(quint64 generation, QVector<int> rows,
+                QVector<int> positions);
+
+private:
+    ArchiveListingPtr _listing;
+    QString           _filter;
+    int               _column;
+    Qt::SortOrder     _order;
+    quint64           _generation;
+
+    QAtomicInt _stopRequested;
+
+    QVector<int> sorted(const QVector<int> &rows, const QVector<QString> &text,
+                        const QVector<quint64> &numbers) const;
+};
+
+#endif /* !FILETABLESORTTASK_H */
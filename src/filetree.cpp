@@ -0,0 +1,215 @@
+#include "filetree.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+
+#include <QLatin1String>
+#include <QStringList>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+
+#include "archivelisting.h"
+#include "compat.h"
+
+FileTree::FileTree(const ArchiveListing &listing)
+{
+    _nodes.reserve(listing.count() + 1);
+    addNode(-1, QString(), true);
+
+    // Only directories are looked up by path; most lines are in the same
+    // directory as the previous line.
+    QHash<QString, int> dirs;
+    dirs.insert(QString(), 0);
+    QString lastDir;
+    int     lastDirNode = 0;
+    for(int row = 0; row < listing.count(); row++)
+    {
+        const FileStat stat = listing.stat(row);
+
+        // A symlink is listed as "name -> target".
+        QString name = stat.name;
+        if(stat.mode.startsWith('l'))
+        {
+            const int arrow = name.indexOf(QLatin1String(" -> "));
+            if(arrow != -1)
+                name.truncate(arrow);
+        }
+        const bool isDir = stat.mode.startsWith('d') || name.endsWith('/');
+
+        // Skip empty and "." parts of the path.
+        if(_rootPrefix.isEmpty() && name.startsWith('/'))
+            _rootPrefix = QStringLiteral("/");
+        QStringList parts = name.split('/', SKIP_EMPTY_PARTS);
+        parts.removeAll(QLatin1String("."));
+        if(parts.isEmpty())
+            continue;
+        const QString path = parts.join('/');
+
+        int node;
+        if(isDir)
+        {
+            node = addDir(path, dirs);
+        }
+        else
+        {
+            const QString dir = path.left(qMax(path.lastIndexOf('/'), 0));
+            if(dir != lastDir)
+            {
+                lastDir     = dir;
+                lastDirNode = addDir(dir, dirs);
+            }
+            node                   = addNode(lastDirNode, parts.last(), false);
+            _nodes[node].fileCount = 1;
+        }
+
+        // Directories are normally listed with a size of 0.
+        _nodes[node].line = row;
+        _nodes[node].totalSize += stat.size;
+    }
+    finish();
+}
+
+int FileTree::count() const
+{
+    return (_nodes.size());
+}
+
+int FileTree::parent(int node) const
+{
+    return (_nodes.at(node).parent);
+}
+
+int FileTree::childCount(int node) const
+{
+    return (_nodes.at(node).childCount);
+}
+
+int FileTree::child(int node, int i) const
+{
+    return (_children.at(_nodes.at(node).firstChild + i));
+}
+
+int FileTree::indexInParent(int node) const
+{
+    return (_nodes.at(node).indexInParent);
+}
+
+QString FileTree::name(int node) const
+{
+    const Node &n = _nodes.at(node);
+    return (_names.mid(n.nameStart, n.nameLength));
+}
+
+QString FileTree::path(int node) const
+{
+    QStringList parts;
+    for(; node > 0; node = _nodes.at(node).parent)
+        parts.prepend(name(node));
+    return (_rootPrefix + parts.join('/'));
+}
+
+bool FileTree::isDir(int node) const
+{
+    return (_nodes.at(node).isDir);
+}
+
+int FileTree::line(int node) const
+{
+    return (_nodes.at(node).line);
+}
+
+quint64 FileTree::totalSize(int node) const
+{
+    return (_nodes.at(node).totalSize);
+}
+
+quint64 FileTree::fileCount(int node) const
+{
+    return (_nodes.at(node).fileCount);
+}
+
+int FileTree::addNode(int parent, const QString &name, bool isDir)
+{
+    Node node;
+    node.parent        = parent;
+    node.firstChild    = 0;
+    node.childCount    = 0;
+    node.indexInParent = 0;
+    node.line          = -1;
+    node.nameStart     = _names.size();
+    node.nameLength    = name.size();
+    node.isDir         = isDir;
+    node.totalSize     = 0;
+    node.fileCount     = 0;
+    _names.append(name);
+    _nodes.append(node);
+    return (_nodes.size() - 1);
+}
+
+int FileTree::addDir(const QString &path, QHash<QString, int> &dirs)
+{
+    auto it = dirs.constFind(path);
+    if(it != dirs.constEnd())
+        return (it.value());
+
+    // Add the parent directories first.
+    const int slash  = path.lastIndexOf('/');
+    const int parent = addDir(path.left(qMax(slash, 0)), dirs);
+    const int node   = addNode(parent, path.mid(slash + 1), true);
+    dirs.insert(path, node);
+    return (node);
+}
+
+void FileTree::finish()
+{
+    const int count = _nodes.size();
+
+    // Add up the subtrees; a parent always comes before its children.
+    for(int i = count - 1; i > 0; i--)
+    {
+        Node &parent = _nodes[_nodes.at(i).parent];
+        parent.totalSize += _nodes.at(i).totalSize;
+        parent.fileCount += _nodes.at(i).fileCount;
+    }
+
+    // Put the children of each node next to each other.
+    for(int i = 1; i < count; i++)
+        _nodes[_nodes.at(i).parent].childCount++;
+    int next = 0;
+    for(Node &node : _nodes)
+    {
+        node.firstChild = next;
+        next += node.childCount;
+        node.childCount = 0;
+    }
+    _children.resize(count - 1);
+    for(int i = 1; i < count; i++)
+    {
+        Node &parent = _nodes[_nodes.at(i).parent];
+        _children[parent.firstChild + parent.childCount++] = i;
+    }
+
+    // Sort the children: directories first, then by name.
+    const auto before = [this](int a, int b) {
+        if(_nodes.at(a).isDir != _nodes.at(b).isDir)
+            return (_nodes.at(a).isDir);
+        return (nameRef(a) < nameRef(b));
+    };
+    for(int i = 0; i < count; i++)
+    {
+        const auto first = _children.begin() + _nodes.at(i).firstChild;
+        std::sort(first, first + _nodes.at(i).childCount, before);
+        for(int j = 0; j < _nodes.at(i).childCount; j++)
+            _nodes[*(first + j)].indexInParent = j;
+    }
+    _names.squeeze();
+}
+
+QString FileTree::nameRef(int node) const
+{
+    // Refers to _names without copying it.
+    const Node &n = _nodes.at(node);
+    return (QString::fromRawData(_names.constData() + n.nameStart,
+                                 n.nameLength));
+}
@@ -0,0 +1,98 @@
+#ifndef FILETREE_H
+#define FILETREE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QHash>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/filetreeptr.h"
+
+/* Forward declaration(s). */
+class ArchiveListing;
+
+Q_DECLARE_METATYPE(FileTreePtr)
+
+/*!
+ * \ingroup data
+ * \brief The FileTree arranges the lines of an ArchiveListing by directory.
+ *
+ * Nodes are numbered, with the root (the archive itself) as node 0.  The
+ * names of all nodes are kept in a single string, and the children of each
+ * node are next to each other in a single array (directories first, then
+ * sorted by name), so a node costs a few integers.  Directories which are
+ * not in the listing themselves (i.e. only appear in the path of a file)
+ * are added.  The total size and number of files below each node are
+ * computed once, when the tree is built.
+ *
+ * Paths are split on '/', without any "." parts.  If the listing has
+ * absolute paths (i.e. the archive was created with <tt>tarsnap -P</tt>),
+ * \ref path keeps the leading '/'.
+ */
+class FileTree
+{
+public:
+    //! Constructor; parses every line of \c listing.
+    explicit FileTree(const ArchiveListing &listing);
+
+    //! Returns the number of nodes, including the root.
+    int count() const;
+
+    //! Returns the parent of a node, or -1 for the root.
+    int parent(int node) const;
+    //! Returns the number of children of a node.
+    int childCount(int node) const;
+    //! Returns the \c i-th child of a node.
+    int child(int node, int i) const;
+    //! Returns the position of a node among the children of its parent.
+    int indexInParent(int node) const;
+
+    //! Returns the name of a node (without the directory).
+    QString name(int node) const;
+    //! Returns the path of a node in the archive; this is not necessarily
+    //! the name in the listing (e.g. "./" is left out).
+    QString path(int node) const;
+    //! Returns whether a node is a directory.
+    bool isDir(int node) const;
+    //! Returns the line of the listing for a node, or -1 if the node was
+    //! only implied by the paths of other files.
+    int line(int node) const;
+    //! Returns the size of a node, plus the sizes of everything below it.
+    quint64 totalSize(int node) const;
+    //! Returns the number of files (i.e. not directories) at or below a
+    //! node.
+    quint64 fileCount(int node) const;
+
+private:
+    struct Node
+    {
+        int     parent;
+        int     firstChild;
+        int     childCount;
+        int     indexInParent;
+        int     line;
+        int     nameStart;
+        int     nameLength;
+        bool    isDir;
+        quint64 totalSize;
+        quint64 fileCount;
+    };
+
+    QVector<Node> _nodes;
+    // The children of each node, from Node::firstChild.
+    QVector<int> _children;
+    QString      _names;
+    // "/" if the paths are absolute.
+    QString _rootPrefix;
+
+    int     addNode(int parent, const QString &name, bool isDir);
+    int     addDir(const QString &path, QHash<QString, int> &dirs);
+    void    finish();
+    QString nameRef(int node) const;
+};
+
+#endif /* !FILETREE_H */
@@ -0,0 +1,238 @@
+#include "filetreemodel.h"
+
+#include "archivelisting.h"
+#include "filetree.h"
+#include "filetreetask.h"
+#include "humanbytes.h"
+
+FileTreeModel::FileTreeModel(QObject *parent)
+    : QAbstractItemModel(parent),
+      _task(nullptr),
+      _generation(0),
+      _dirIcon(":/icons/folder.png"),
+      _fileIcon(":/icons/file.png")
+{
+}
+
+FileTreeModel::~FileTreeModel()
+{
+    stopTask();
+}
+
+QModelIndex FileTreeModel::index(int row, int column,
+                                 const QModelIndex &parent) const
+{
+    // Bail (if applicable).
+    if(!_tree || (column < 0) || (column > FILES))
+        return (QModelIndex());
+
+    const int node = nodeFromIndex(parent);
+    if(!_fetched.testBit(node) || (row < 0)
+       || (row >= _tree->childCount(node)))
+        return (QModelIndex());
+
+    return (createIndex(row, column,
+                        static_cast<quintptr>(_tree->child(node, row))));
+}
+
+QModelIndex FileTreeModel::parent(const QModelIndex &child) const
+{
+    // Bail (if applicable).
+    if(!child.isValid() || !_tree)
+        return (QModelIndex());
+
+    // The root has no index.
+    const int parent = _tree->parent(nodeFromIndex(child));
+    if(parent <= 0)
+        return (QModelIndex());
+    return (createIndex(_tree->indexInParent(parent), 0,
+                        static_cast<quintptr>(parent)));
+}
+
+int FileTreeModel::rowCount(const QModelIndex &parent) const
+{
+    if(!_tree || (parent.column() > 0))
+        return (0);
+
+    const int node = nodeFromIndex(parent);
+    if(!_fetched.testBit(node))
+        return (0);
+    return (_tree->childCount(node));
+}
+
+int FileTreeModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return (FILES + 1);
+}
+
+bool FileTreeModel::hasChildren(const QModelIndex &parent) const
+{
+    if(!_tree || (parent.column() > 0))
+        return (false);
+    return (_tree->childCount(nodeFromIndex(parent)) > 0);
+}
+
+bool FileTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    if(!_tree || (parent.column() > 0))
+        return (false);
+
+    const int node = nodeFromIndex(parent);
+    return (!_fetched.testBit(node) && (_tree->childCount(node) > 0));
+}
+
+void FileTreeModel::fetchMore(const QModelIndex &parent)
+{
+    // Bail (if applicable).
+    if(!canFetchMore(parent))
+        return;
+
+    const int node = nodeFromIndex(parent);
+    beginInsertRows(parent, 0, _tree->childCount(node) - 1);
+    _fetched.setBit(node);
+    endInsertRows();
+}
+
+QVariant FileTreeModel::data(const QModelIndex &index, int role) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || !_tree)
+        return (QVariant());
+
+    const int node = nodeFromIndex(index);
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        switch(index.column())
+        {
+        case NAME:
+            return (_tree->name(node));
+        case SIZE:
+            return (humanBytes(_tree->totalSize(node)));
+        case FILES:
+            // Only count the files in directories.
+            if(_tree->isDir(node))
+                return (_tree->fileCount(node));
+            return (QVariant());
+        }
+        break;
+    case Qt::DecorationRole:
+        if(index.column() == NAME)
+            return (_tree->isDir(node) ? _dirIcon : _fileIcon);
+        break;
+    case Qt::ToolTipRole:
+        return (path(index));
+    case Qt::TextAlignmentRole:
+        if(index.column() != NAME)
+            return (static_cast<int>(Qt::AlignRight | Qt::AlignVCenter));
+        break;
+    }
+    return (QVariant());
+}
+
+QVariant FileTreeModel::headerData(int section, Qt::Orientation orientation,
+                                   int role) const
+{
+    if((role != Qt::DisplayRole) || (orientation != Qt::Horizontal))
+        return (QVariant());
+
+    switch(section)
+    {
+    case NAME:
+        return (tr("NAME"));
+    case SIZE:
+        return (tr("SIZE"));
+    case FILES:
+        return (tr("FILES"));
+    }
+    return (QVariant());
+}
+
+QString FileTreeModel::path(const QModelIndex &index) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || !_tree)
+        return (QString());
+
+    // Use the name from the listing, which tarsnap will recognize.
+    const int node = nodeFromIndex(index);
+    const int line = _tree->line(node);
+    if(line != -1)
+        return (QString::fromUtf8(_listing->path(line)));
+    return (_tree->path(node));
+}
+
+void FileTreeModel::setListing(const ArchiveListingPtr &listing)
+{
+    // Bail (if applicable).
+    if(listing == _listing)
+        return;
+
+    // Discard the tree of the previous listing.
+    _listing = listing;
+    _generation++;
+    stopTask();
+    beginResetModel();
+    _tree.clear();
+    _fetched.clear();
+    endResetModel();
+
+    // Bail (if applicable).
+    if(!_listing)
+        return;
+
+    FileTreeTask *task = new FileTreeTask(_listing, _generation);
+    connect(task, &FileTreeTask::result, this, &FileTreeModel::setTree,
+            Qt::QueuedConnection);
+    // The task is deleted by the TaskQueuer once it is done or canceled.
+    const auto forget = [this, task]() {
+        if(_task == task)
+            _task = nullptr;
+    };
+    connect(task, &BaseTask::dequeue, this, forget, Qt::QueuedConnection);
+    connect(task, &BaseTask::canceled, this, forget, Qt::QueuedConnection);
+
+    _task = task;
+    emit taskRequested(task);
+}
+
+bool FileTreeModel::isBusy() const
+{
+    return (_listing && !_tree);
+}
+
+void FileTreeModel::setTree(quint64 generation, FileTreePtr tree)
+{
+    // Bail (if applicable).
+    if(generation != _generation)
+        return;
+
+    beginResetModel();
+    _tree    = tree;
+    _fetched = QBitArray(_tree->count());
+    // The top level is always shown.
+    _fetched.setBit(0);
+    endResetModel();
+
+    emit ready();
+}
+
+int FileTreeModel::nodeFromIndex(const QModelIndex &index) const
+{
+    // The root has no index.
+    if(!index.isValid())
+        return (0);
+    return (static_cast<int>(index.internalId()));
+}
+
+void FileTreeModel::stopTask()
+{
+    // Bail (if applicable).
+    if(!_task)
+        return;
+
+    disconnect(_task, nullptr, this, nullptr);
+    emit cancelTaskRequested(_task, _task->uuid());
+    _task = nullptr;
+}
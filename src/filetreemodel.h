@@ -0,0 +1,113 @@
+#ifndef FILETREEMODEL_H
+#define FILETREEMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractItemModel>
+#include <QBitArray>
+#include <QIcon>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QUuid>
+#include <QVariant>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/archivelistingptr.h"
+#include "messages/filetreeptr.h"
+
+/* Forward declaration(s). */
+class BaseTask;
+class FileTreeTask;
+
+/*!
+ * \ingroup data
+ * \brief The FileTreeModel is a QAbstractItemModel which shows the files
+ * in an archive by directory.
+ *
+ * The \ref FileTree is built by a \ref FileTreeTask in the background.  A
+ * directory only reports its children once a view expands it, so a view
+ * never sees more than the expanded directories.  The size and number of
+ * files of each directory include everything below it.
+ */
+class FileTreeModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    //! The columns of the tree.
+    enum TreeColumns
+    {
+        NAME,
+        SIZE,
+        FILES
+    };
+
+    //! Constructor.
+    explicit FileTreeModel(QObject *parent = nullptr);
+    ~FileTreeModel() override;
+
+    //! Returns the index of a child of \c parent.
+    QModelIndex index(int row, int column,
+                      const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the directory which contains \c child.
+    QModelIndex parent(const QModelIndex &child) const override;
+    //! Returns the number of (fetched) children.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the number of columns (3).
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns whether \c parent is a non-empty directory.
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns whether the children of \c parent have not been shown yet.
+    bool canFetchMore(const QModelIndex &parent) const override;
+    //! Shows the children of \c parent.
+    void fetchMore(const QModelIndex &parent) override;
+
+    //! Returns the name, total size, or number of files of a node.
+    QVariant data(const QModelIndex &index,
+                  int                role = Qt::DisplayRole) const override;
+    //! Returns the text for a header field.
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    //! Returns the name of a file or directory in the listing (for a
+    //! symlink, without its target), or its path in the archive if it is
+    //! not in the listing itself.
+    QString path(const QModelIndex &index) const;
+
+    //! Starts building the tree of \c listing (if it is not already
+    //! shown); a null ArchiveListingPtr clears the tree.
+    void setListing(const ArchiveListingPtr &listing);
+    //! Returns whether the tree is still being built.
+    bool isBusy() const;
+
+signals:
+    //! The tree of the current listing is shown.
+    void ready();
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
+private slots:
+    void setTree(quint64 generation, FileTreePtr tree);
+
+private:
+    ArchiveListingPtr _listing;
+    FileTreePtr       _tree;
+    FileTreeTask     *_task;
+    // Whether the children of each node have been shown.
+    QBitArray _fetched;
+    // Incremented by every listing; only the latest tree is used.
+    quint64 _generation;
+
+    QIcon _dirIcon;
+    QIcon _fileIcon;
+
+    int  nodeFromIndex(const QModelIndex &index) const;
+    void stopTask();
+};
+
+#endif /* !FILETREEMODEL_H */
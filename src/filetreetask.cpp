@@ -0,0 +1,29 @@
+#include "filetreetask.h"
+
+#include "archivelisting.h"
+#include "filetree.h"
+
+FileTreeTask::FileTreeTask(const ArchiveListingPtr &listing,
+                           quint64                  generation)
+    : _listing(listing), _generation(generation)
+{
+}
+
+void FileTreeTask::run()
+{
+    FileTreePtr tree(new FileTree(*_listing));
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+        emit canceled();
+    else
+        emit result(_generation, tree);
+
+    // We're finished.
+    emit dequeue();
+}
+
+void FileTreeTask::stop()
+{
+    _stopRequested = 1;
+}
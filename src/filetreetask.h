@@ -0,0 +1,47 @@
+#ifndef FILETREETASK_H
+#define FILETREETASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QObject>
+WARNINGS_ENABLE
+
+#include "messages/archivelistingptr.h"
+#include "messages/filetreeptr.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The FileTreeTask builds a FileTree from an ArchiveListing.
+ */
+class FileTreeTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    //! \param listing the files.
+    //! \param generation returned with the \ref result.
+    FileTreeTask(const ArchiveListingPtr &listing, quint64 generation);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task; the tree is still built, but not sent.
+    void stop() override;
+
+signals:
+    //! The tree of files.
+    void result(quint64 generation, FileTreePtr tree);
+
+private:
+    ArchiveListingPtr _listing;
+    quint64           _generation;
+
+    QAtomicInt _stopRequested;
+};
+
+#endif /* !FILETREETASK_H */
@@ -0,0 +1,30 @@
+#include "fingerprinttask.h"
+
+#include "persistentmodel/job.h"
+
+FingerprintTask::FingerprintTask(const JobPtr &job)
+    : _urls(job->urls()),
+      _followSymLinks(job->optionFollowSymLinks()),
+      _options(job->fingerprintOptions())
+{
+}
+
+void FingerprintTask::run()
+{
+    QString fingerprint = Job::computeFingerprint(_urls, _followSymLinks,
+                                                  _options, &_stopRequested);
+
+    // Send appropriate notification.
+    if(static_cast<int>(_stopRequested) == 1)
+        emit canceled();
+    else
+        emit result(fingerprint);
+
+    // We're finished.
+    emit dequeue();
+}
+
+void FingerprintTask::stop()
+{
+    _stopRequested = 1;
+}
@@ -0,0 +1,50 @@
+#ifndef FINGERPRINTTASK_H
+#define FINGERPRINTTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+WARNINGS_ENABLE
+
+#include "messages/jobptr.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The FingerprintTask computes the same fingerprint as
+ * Job::computeFingerprint(), from a copy of the Job's settings.
+ */
+class FingerprintTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit FingerprintTask(const JobPtr &job);
+
+    //! Execute the task.
+    void run() override;
+
+    //! We want to stop the task.
+    void stop() override;
+
+signals:
+    //! The fingerprint of the Job.
+    void result(const QString &fingerprint);
+
+private:
+    QList<QUrl> _urls;
+    bool        _followSymLinks;
+    QByteArray  _options;
+
+    QAtomicInt _stopRequested;
+};
+
+#endif /* !FINGERPRINTTASK_H */
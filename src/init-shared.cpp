@@ -30,17 +30,23 @@ WARNINGS_ENABLE
 #include "LogEntry.h"
 #include "TSettings.h"
 
-#include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
 #include "messages/backuptaskdataptr.h"
+#include "messages/changeset.h"
+#include "messages/fileversion.h"
+#include "messages/filetreeptr.h"
 #include "messages/jobptr.h"
 #include "messages/notification_info.h"
 #include "messages/tarsnaperror.h"
+#include "messages/taskoutput.h"
 #include "messages/taskstatus.h"
 
+#include "archivelisting.h"
 #include "backuptask.h"
 #include "debug.h"
+#include "filetree.h"
 #include "persistentmodel/archive.h"
 #include "persistentmodel/job.h"
 #include "persistentmodel/persistentstore.h"
@@ -64,10 +70,15 @@ static void init_no_app()
     qRegisterMetaType<QSqlQuery>("QSqlQuery");
     qRegisterMetaType<JobPtr>("JobPtr");
     qRegisterMetaType<QMap<QString, JobPtr>>("QMap<QString, JobPtr>");
+    qRegisterMetaType<ArchiveChanges>("ArchiveChanges");
+    qRegisterMetaType<JobChanges>("JobChanges");
     qRegisterMetaType<TarsnapError>("TarsnapError");
+    qRegisterMetaType<TaskOutput>("TaskOutput");
     qRegisterMetaType<LogEntry>("LogEntry");
     qRegisterMetaType<QVector<LogEntry>>("QVector<LogEntry>");
-    qRegisterMetaType<QVector<FileStat>>("QVector<FileStat>");
+    qRegisterMetaType<ArchiveListingPtr>("ArchiveListingPtr");
+    qRegisterMetaType<FileTreePtr>("FileTreePtr");
+    qRegisterMetaType<QVector<FileVersion>>("QVector<FileVersion>");
     qRegisterMetaType<enum message_type>("enum message_type");
 }
 
@@ -0,0 +1,368 @@
+#include "joblistmodel.h"
+
+WARNINGS_DISABLE
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+#include "messages/archiveptr.h"
+
+#include "debug.h"
+#include "humanbytes.h"
+#include "persistentmodel/archive.h"
+#include "persistentmodel/job.h"
+
+JobListModel::JobListModel(QObject *parent)
+    : QAbstractListModel(parent), _version(0)
+{
+    // Set up filtering job names.
+    _filter.setCaseSensitivity(Qt::CaseInsensitive);
+    _filter.setPatternSyntax(QRegExp::Wildcard);
+}
+
+int JobListModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return (0);
+    return (_rows.size());
+}
+
+QVariant JobListModel::data(const QModelIndex &index, int role) const
+{
+    // Bail (if applicable).
+    if(!index.isValid() || (index.row() >= _rows.size()))
+        return (QVariant());
+
+    const JobPtr  &job     = _rows.at(index.row());
+    const Summary &summary = *_summaries.constFind(job.data());
+    switch(role)
+    {
+    case Qt::DisplayRole:
+    case Qt::ToolTipRole:
+        return (job->name());
+    case JobRole:
+        return (QVariant::fromValue(job));
+    case DetailRole:
+    {
+        const int count = summary.archives.size();
+        return (tr("%1 %2 totaling ")
+                    .arg(count)
+                    .arg(count == 1 ? tr("archive") : tr("archives"))
+                + humanBytes(summary.sizeTotal));
+    }
+    case LastBackupRole:
+        // Display the datetime of the most recent archive, or "No backups".
+        if(summary.archives.isEmpty())
+            return (tr("No backups"));
+        return (summary.lastBackup.toString(Qt::DefaultLocaleShortDate));
+    case StatsRole:
+        return (tr("Total size: %1\nUnique compressed size: %2")
+                    .arg(humanBytes(summary.sizeTotal))
+                    .arg(humanBytes(summary.sizeUnique)));
+    case ArchiveCountRole:
+        return (summary.archives.size());
+    default:
+        return (QVariant());
+    }
+}
+
+JobPtr JobListModel::job(int row) const
+{
+    return (_rows.value(row));
+}
+
+int JobListModel::rowOf(const Job *job) const
+{
+    return (indexOf(_rows, job));
+}
+
+int JobListModel::count() const
+{
+    return (_jobs.size());
+}
+
+JobPtr JobListModel::findJobByRef(const QString &jobRef) const
+{
+    for(const JobPtr &job : _jobs)
+    {
+        if(job->objectKey() == jobRef)
+            return (job);
+    }
+
+    // We couldn't find the job.
+    return (JobPtr());
+}
+
+QList<JobPtr> JobListModel::jobs() const
+{
+    return (_jobs.toList());
+}
+
+void JobListModel::setJobs(const QMap<QString, JobPtr> &jobs)
+{
+    beginResetModel();
+    for(const JobPtr &job : _jobs)
+        unwatch(job);
+    _jobs.clear();
+    _rows.clear();
+    for(const JobPtr &job : jobs)
+    {
+        // Bail (if applicable).
+        if(!job)
+        {
+            DEBUG << "Null JobPtr passed.";
+            continue;
+        }
+        if(_summaries.contains(job.data()))
+            continue;
+        watch(job);
+        _jobs.append(job);
+        if(matches(job))
+            _rows.append(job);
+    }
+    endResetModel();
+
+    notifyCount();
+}
+
+void JobListModel::addJob(const JobPtr &job)
+{
+    if(insertJob(job))
+        notifyCount();
+}
+
+void JobListModel::removeJob(const JobPtr &job)
+{
+    if(eraseJob(job))
+        notifyCount();
+}
+
+void JobListModel::applyChanges(const JobChanges &changes)
+{
+    // Bail (if applicable).
+    if(!changes.isNewerThan(_version))
+        return;
+    _version = changes.version;
+
+    // Remove the Jobs which are gone; a snapshot keeps the Jobs which are
+    // in it.  The GUI removes (and adds) its own Jobs, so some of the
+    // changes might already be here.
+    QList<JobPtr> removed;
+    if(changes.reset)
+    {
+        for(const JobPtr &job : _jobs)
+        {
+            if(!changes.added.contains(job))
+                removed.append(job);
+        }
+    }
+    else
+    {
+        removed = changes.removed.values();
+    }
+    bool changed = false;
+    for(const JobPtr &job : removed)
+        changed = eraseJob(job) || changed;
+
+    // Add the new Jobs, sorted by name.  Updated Jobs notify the model
+    // themselves.
+    QMap<QString, JobPtr> added;
+    for(const JobPtr &job : changes.added)
+    {
+        if(job && !_summaries.contains(job.data()))
+            added.insert(job->name(), job);
+    }
+    for(const JobPtr &job : added)
+        changed = insertJob(job) || changed;
+
+    // Notify once for the whole set.
+    if(changed)
+        notifyCount();
+}
+
+void JobListModel::setFilter(const QString &regex)
+{
+    // Bail (if applicable).
+    if(regex == _filter.pattern())
+        return;
+
+    // Typing more characters can only hide jobs, so only the rows need to
+    // be checked.  An invalid pattern (e.g. an unclosed "[") matches
+    // nothing, so it does not count.
+    const bool narrowing = !_filter.pattern().isEmpty() && _filter.isValid()
+                           && regex.startsWith(_filter.pattern());
+    const QVector<JobPtr> jobs = narrowing ? _rows : _jobs;
+
+    beginResetModel();
+    _filter.setPattern(regex);
+    _rows.clear();
+    for(const JobPtr &job : jobs)
+    {
+        if(matches(job))
+            _rows.append(job);
+    }
+    endResetModel();
+
+    notifyCount();
+}
+
+void JobListModel::refresh()
+{
+    if(!_rows.isEmpty())
+        emit dataChanged(index(0), index(_rows.size() - 1));
+}
+
+void JobListModel::jobChanged()
+{
+    const Job *job = qobject_cast<Job *>(sender());
+
+    // Bail (if applicable).
+    QHash<const Job *, Summary>::iterator summary = _summaries.find(job);
+    if(summary == _summaries.end())
+        return;
+
+    // Only repaint the row if the totals changed.
+    const JobPtr &stored = _jobs.at(indexOf(_jobs, job));
+    if(!updateSummary(summary.value(), stored))
+        return;
+    const int row = rowOf(job);
+    if(row != -1)
+        emit dataChanged(index(row), index(row));
+}
+
+bool JobListModel::insertJob(const JobPtr &job)
+{
+    // Bail (if applicable).
+    if(!job)
+    {
+        DEBUG << "Null JobPtr passed.";
+        return (false);
+    }
+    if(_summaries.contains(job.data()))
+        return (false);
+
+    watch(job);
+    _jobs.append(job);
+
+    // Check it against the name filter.
+    if(matches(job))
+    {
+        beginInsertRows(QModelIndex(), _rows.size(), _rows.size());
+        _rows.append(job);
+        endInsertRows();
+    }
+    return (true);
+}
+
+bool JobListModel::eraseJob(const JobPtr &job)
+{
+    // Bail (if applicable).
+    if(!job || !_summaries.contains(job.data()))
+        return (false);
+
+    // Keep a reference while the job is removed from the lists.
+    const JobPtr erased = job;
+    const int    row    = rowOf(erased.data());
+    if(row != -1)
+    {
+        beginRemoveRows(QModelIndex(), row, row);
+        _rows.remove(row);
+        endRemoveRows();
+    }
+    _jobs.remove(indexOf(_jobs, erased.data()));
+    unwatch(erased);
+    return (true);
+}
+
+bool JobListModel::matches(const JobPtr &job) const
+{
+    return (job->name().contains(_filter));
+}
+
+void JobListModel::watch(const JobPtr &job)
+{
+    Summary summary;
+    summary.sizeTotal  = 0;
+    summary.sizeUnique = 0;
+    updateSummary(summary, job);
+    _summaries.insert(job.data(), summary);
+
+    // Connection for any modifications: the list of Archives belonging to
+    // this Job has been updated.
+    connect(job.data(), &Job::changed, this, &JobListModel::jobChanged,
+            Qt::QueuedConnection);
+}
+
+void JobListModel::unwatch(const JobPtr &job)
+{
+    _summaries.remove(job.data());
+    disconnect(job.data(), &Job::changed, this, &JobListModel::jobChanged);
+}
+
+void JobListModel::notifyCount()
+{
+    emit countChanged(_jobs.size(), _rows.size());
+}
+
+bool JobListModel::updateSummary(Summary &summary, const JobPtr &job)
+{
+    const QList<ArchivePtr> archives = job->archives();
+    bool                    changed  = false;
+
+    // Adjust the totals by the archives which are new, or whose sizes
+    // changed, and take the ones which are still there out of the old set.
+    QHash<const Archive *, Sizes> previous;
+    previous.swap(summary.archives);
+    summary.archives.reserve(archives.size());
+    for(const ArchivePtr &archive : archives)
+    {
+        const Sizes sizes = {archive->sizeTotal(),
+                             archive->sizeUniqueCompressed()};
+        Sizes       old   = {0, 0};
+        QHash<const Archive *, Sizes>::iterator it =
+            previous.find(archive.data());
+        if(it != previous.end())
+        {
+            old = it.value();
+            previous.erase(it);
+        }
+        else
+        {
+            changed = true;
+        }
+        if((sizes.total != old.total) || (sizes.unique != old.unique))
+        {
+            summary.sizeTotal += sizes.total - old.total;
+            summary.sizeUnique += sizes.unique - old.unique;
+            changed = true;
+        }
+        summary.archives.insert(archive.data(), sizes);
+    }
+
+    // Whatever is left has been removed.
+    for(const Sizes &old : previous)
+    {
+        summary.sizeTotal -= old.total;
+        summary.sizeUnique -= old.unique;
+        changed = true;
+    }
+
+    // The archives are sorted newest first.
+    const QDateTime lastBackup =
+        archives.isEmpty() ? QDateTime() : archives.first()->timestamp();
+    if(lastBackup != summary.lastBackup)
+    {
+        summary.lastBackup = lastBackup;
+        changed            = true;
+    }
+    return (changed);
+}
+
+int JobListModel::indexOf(const QVector<JobPtr> &list, const Job *job)
+{
+    for(int i = 0; i < list.size(); i++)
+    {
+        if(list.at(i).data() == job)
+            return (i);
+    }
+    return (-1);
+}
@@ -0,0 +1,147 @@
+#ifndef JOBLISTMODEL_H
+#define JOBLISTMODEL_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QModelIndex>
+#include <QObject>
+#include <QRegExp>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/changeset.h"
+#include "messages/jobptr.h"
+
+/* Forward declaration(s). */
+class Archive;
+class Job;
+
+/*!
+ * \ingroup data
+ * \brief The JobListModel is a QAbstractListModel which lists jobs.
+ *
+ * For each job, the model caches the number of archives, the date of the
+ * most recent one, and their total and unique sizes.  When a job's list of
+ * archives changes, only the archives which were added or removed (or
+ * whose sizes changed) update these totals, and the row is only repainted
+ * if they changed.  The rows can be restricted to jobs whose name matches
+ * a filter; \ref count() includes the jobs which are filtered out.
+ */
+class JobListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    //! Data roles (in addition to Qt::DisplayRole and Qt::ToolTipRole,
+    //! which give the job name).
+    enum Role
+    {
+        //! The JobPtr.
+        JobRole = Qt::UserRole + 1,
+        //! The number of archives and their total size.
+        DetailRole,
+        //! The date of the most recent archive, or "No backups".
+        LastBackupRole,
+        //! The total and unique sizes of the archives.
+        StatsRole,
+        //! The number of archives.
+        ArchiveCountRole
+    };
+
+    //! Constructor.
+    explicit JobListModel(QObject *parent = nullptr);
+
+    //! Returns the number of (matching) jobs.
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    //! Returns the data for one of the \ref Role values, or the name.
+    QVariant data(const QModelIndex &index,
+                  int                role = Qt::DisplayRole) const override;
+
+    //! Returns the job shown in a row.
+    JobPtr job(int row) const;
+    //! Returns the row of the job, or -1 if it is not shown.
+    int rowOf(const Job *job) const;
+    //! Returns the number of jobs, including those which are filtered out.
+    int count() const;
+    //! Returns the (first) job with this objectKey, or a null JobPtr.
+    JobPtr findJobByRef(const QString &jobRef) const;
+    //! Returns all jobs (including those which are filtered out), in the
+    //! order of the list.
+    QList<JobPtr> jobs() const;
+
+    //! Replaces the jobs, sorted by name.
+    void setJobs(const QMap<QString, JobPtr> &jobs);
+    //! Adds a job at the end of the list (unless it is already in the
+    //! model).
+    void addJob(const JobPtr &job);
+    //! Removes a job.
+    void removeJob(const JobPtr &job);
+    //! Updates the jobs with the changes (or snapshot) from the
+    //! \ref BackendData, with a single \ref countChanged() signal.  New
+    //! jobs are added at the end, sorted by name.  Sets which are not newer
+    //! than the model are ignored.
+    void applyChanges(const JobChanges &changes);
+
+    //! Only show jobs whose name matches \c regex (a case-insensitive
+    //! wildcard pattern).  If \c regex extends the previous filter, only
+    //! the jobs which are shown are checked.
+    void setFilter(const QString &regex);
+
+    //! Notifies views that every row changed (e.g. the size format).
+    void refresh();
+
+signals:
+    //! The total and visible (not filtered out) number of jobs changed.
+    void countChanged(int countTotal, int countVisible);
+
+private slots:
+    void jobChanged();
+
+private:
+    // The sizes which an archive contributes to the totals of its job.
+    struct Sizes
+    {
+        quint64 total;
+        quint64 unique;
+    };
+    // The cached totals of a job's archives.
+    struct Summary
+    {
+        QHash<const Archive *, Sizes> archives;
+        quint64                       sizeTotal;
+        quint64                       sizeUnique;
+        QDateTime                     lastBackup;
+    };
+
+    // All jobs, and the ones which match the filter, in list order.
+    QVector<JobPtr>             _jobs;
+    QVector<JobPtr>             _rows;
+    QHash<const Job *, Summary> _summaries;
+
+    QRegExp _filter;
+    // The version of the last change set.
+    quint64 _version;
+
+    // Update the jobs and rows, without notifying about the count.
+    bool insertJob(const JobPtr &job);
+    bool eraseJob(const JobPtr &job);
+
+    bool matches(const JobPtr &job) const;
+    void watch(const JobPtr &job);
+    void unwatch(const JobPtr &job);
+    void notifyCount();
+
+    static bool updateSummary(Summary &summary, const JobPtr &job);
+    static int  indexOf(const QVector<JobPtr> &list, const Job *job);
+};
+
+#endif /* !JOBLISTMODEL_H */
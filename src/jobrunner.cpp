@@ -19,6 +19,7 @@ WARNINGS_ENABLE
 #include "tasks/tasks-defs.h"
 
 JobRunner::JobRunner()
+    : _pendingFingerprints(0), _nothingToDo(true), _offline(false)
 {
 }
 
@@ -101,7 +102,9 @@ void JobRunner::runScheduledJobs(const QMap<QString, JobPtr> &jobMap)
     DEBUG
         << "Next monthly: "
         << settings.value("app/next_monthly_timestamp", "").toDate().toString();
-    bool nothingToDo = true;
+    bool skipUnchanged =
+        settings.value("app/skip_unchanged_jobs", DEFAULT_SKIP_UNCHANGED_JOBS)
+            .toBool();
     for(const JobPtr &job : jobMap)
     {
         // Do we need to run any jobs?
@@ -111,18 +114,82 @@ void JobRunner::runScheduledJobs(const QMap<QString, JobPtr> &jobMap)
            || (doMonthly
                && (job->optionScheduledEnabled() == JobSchedule::Monthly)))
         {
-            // Before the first job...
-            if(nothingToDo)
+            // Has anything changed since the last backup?  If the
+            // ChangeTracker was watching the whole tree since then, it
+            // knows.
+            if(skipUnchanged && job->isChangeTracking() && !job->hasChanges()
+               && !job->archives().isEmpty())
             {
-                // ... we have a job now
-                nothingToDo = false;
-                // ... check & wait for an internet connection
-                if(!waitForOnline())
-                    return;
+                emit message(tr("Skipped scheduled backup of Job <i>%1</i>:"
+                                " nothing changed since the last backup.")
+                                 .arg(job->name()));
+                continue;
             }
-            emit backup(BackupTaskData::createBackupTaskFromJob(job));
+
+            // Otherwise, compare file sizes and modification times.  This
+            // reads the whole tree, so it can't happen in this thread.  The
+            // fingerprint is kept for the next time, too.
+            if(skipUnchanged)
+            {
+                _pendingFingerprints++;
+                emit fingerprintRequested(job);
+                continue;
+            }
+            runJob(job, QString());
+        }
+    }
+    finishIfDone();
+}
+
+void JobRunner::fingerprintFinished(const JobPtr &job,
+                                    const QString &fingerprint)
+{
+    _pendingFingerprints--;
+    if(!fingerprint.isEmpty() && !job->archives().isEmpty()
+       && (fingerprint == job->lastBackupFingerprint()))
+    {
+        emit message(tr("Skipped scheduled backup of Job <i>%1</i>:"
+                        " nothing changed since the last backup.")
+                         .arg(job->name()));
+    }
+    else
+    {
+        runJob(job, fingerprint);
+    }
+    finishIfDone();
+}
+
+void JobRunner::runJob(const JobPtr &job, const QString &fingerprint)
+{
+    // Bail (if applicable).
+    if(_offline)
+        return;
+
+    // Before the first job...
+    if(_nothingToDo)
+    {
+        // ... we have a job now
+        _nothingToDo = false;
+        // ... check & wait for an internet connection
+        if(!waitForOnline())
+        {
+            _offline = true;
+            return;
         }
     }
-    if(nothingToDo)
+    BackupTaskDataPtr backupTaskData =
+        BackupTaskData::createBackupTaskFromJob(job);
+    backupTaskData->setJobFingerprint(fingerprint);
+    emit backup(backupTaskData);
+}
+
+void JobRunner::finishIfDone()
+{
+    // Bail (if applicable).
+    if(_pendingFingerprints > 0)
+        return;
+
+    if(_nothingToDo)
         qApp->quit();
+    emit finished();
 }
@@ -27,7 +27,13 @@ public:
 
     //! Checks if any scheduled jobs need to run now; if so, adds them to
     //! the queue.  If there are no scheduled jobs, quit the app immediately.
+    //! A job which might be unchanged is only added (or skipped) once its
+    //! fingerprint is passed to fingerprintFinished().
     void runScheduledJobs(const QMap<QString, JobPtr> &jobMap);
+    //! Adds \p job to the queue, unless \p fingerprint shows that nothing
+    //! changed since its last backup.  An empty fingerprint means that it
+    //! could not be computed.
+    void fingerprintFinished(const JobPtr &job, const QString &fingerprint);
 
 signals:
     //! A status message should be shown to the user.
@@ -39,10 +45,21 @@ signals:
                              const QString &data);
     //! Create a backup
     void backup(BackupTaskDataPtr backupTaskData);
+    //! The fingerprint of \p job is needed; it is computed in the background
+    //! (with a \ref FingerprintTask), then passed to fingerprintFinished().
+    void fingerprintRequested(const JobPtr &job);
+    //! Every scheduled job was added or skipped.
+    void finished();
 
 private:
     bool waitForOnline();
     void warnNotOnline();
+    void runJob(const JobPtr &job, const QString &fingerprint);
+    void finishIfDone();
+
+    int  _pendingFingerprints;
+    bool _nothingToDo;
+    bool _offline;
 };
 
 #endif /* !JOBRUNNER_H */
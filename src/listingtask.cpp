@@ -0,0 +1,52 @@
+#include "listingtask.h"
+
+#include "debug.h"
+
+#include "persistentmodel/listingstore.h"
+#include "persistentmodel/persistentstore.h"
+
+ListingTask::ListingTask(const QString &archive, const TaskOutput &listing)
+    : _action(Save), _archive(archive), _listing(listing)
+{
+}
+
+ListingTask::ListingTask(Action action) : _action(action)
+{
+}
+
+void ListingTask::run()
+{
+    // Queries from this thread need a connection of their own.
+    StoreConnection connection;
+
+    bool ok = false;
+    switch(_action)
+    {
+    case Save:
+        ok = ListingStore::save(_archive, _listing.bytes());
+        if(!ok)
+            DEBUG << "Failed to save the contents of" << _archive;
+        // Release the output (which might be a memory-mapped file).
+        _listing = TaskOutput();
+        break;
+    case ConvertLegacyContents:
+        ok = ListingStore::convertLegacyContents();
+        if(!ok)
+            DEBUG << "Failed to convert the contents of some archives.";
+        break;
+    case DetachRemoved:
+        ok = ListingStore::detachRemoved();
+        break;
+    case CollectGarbage:
+        ok = ListingStore::collectGarbage();
+        break;
+    }
+    emit result(ok);
+
+    // We're finished.
+    emit dequeue();
+}
+
+void ListingTask::stop()
+{
+}
@@ -0,0 +1,60 @@
+#ifndef LISTINGTASK_H
+#define LISTINGTASK_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QObject>
+#include <QString>
+WARNINGS_ENABLE
+
+#include "messages/taskoutput.h"
+
+#include "basetask.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The ListingTask changes the \ref ListingStore, which reads and
+ * writes many rows: it stores the contents of an archive, converts the
+ * contents stored by previous versions, detaches the contents of removed
+ * archives, or collects garbage.
+ */
+class ListingTask : public BaseTask
+{
+    Q_OBJECT
+
+public:
+    //! What the task does.
+    enum Action
+    {
+        Save,
+        ConvertLegacyContents,
+        DetachRemoved,
+        CollectGarbage
+    };
+
+    //! Constructor for storing the contents of an archive.
+    //! \param archive the name of the archive, which must already be in
+    //! the PersistentStore.
+    //! \param listing the output of <tt>tarsnap -tv</tt>.
+    ListingTask(const QString &archive, const TaskOutput &listing);
+    //! Constructor for the actions which do not involve a single archive.
+    explicit ListingTask(Action action);
+
+    //! Execute the task.
+    void run() override;
+
+    //! Does nothing; the ListingStore is not left half-changed.
+    void stop() override;
+
+signals:
+    //! Whether the ListingStore was changed successfully.
+    void result(bool ok);
+
+private:
+    Action     _action;
+    QString    _archive;
+    TaskOutput _listing;
+};
+
+#endif /* !LISTINGTASK_H */
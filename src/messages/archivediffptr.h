@@ -0,0 +1,14 @@
+#ifndef ARCHIVEDIFFPTR_H
+#define ARCHIVEDIFFPTR_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class ArchiveDiff;
+typedef QSharedPointer<ArchiveDiff> ArchiveDiffPtr;
+
+#endif /* !ARCHIVEDIFFPTR_H */
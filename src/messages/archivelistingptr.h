@@ -0,0 +1,14 @@
+#ifndef ARCHIVELISTINGPTR_H
+#define ARCHIVELISTINGPTR_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class ArchiveListing;
+typedef QSharedPointer<ArchiveListing> ArchiveListingPtr;
+
+#endif /* !ARCHIVELISTINGPTR_H */
@@ -0,0 +1,93 @@
+#ifndef CHANGESET_H
+#define CHANGESET_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QMetaType>
+#include <QSet>
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+#include "messages/archiveptr.h"
+#include "messages/jobptr.h"
+
+/*!
+ * \ingroup background-tasks
+ * \brief The ChangeSet describes how a collection (of \ref Archive or
+ * \ref Job objects) changed between two versions.
+ *
+ * The owner of the collection bumps its version every time that it hands
+ * out a ChangeSet, so receivers can tell whether they have already seen a
+ * set.  A \c reset set is a snapshot: \c added holds the whole collection,
+ * and receivers should drop anything which is not in it.  Items in
+ * \c updated were modified in place; receivers which already watch the
+ * objects (e.g. via their \c changed signal) may ignore them.
+ */
+template <class Ptr>
+struct ChangeSet
+{
+    //! The version that this set applies to.
+    quint64 fromVersion = 0;
+    //! The version after applying this set.
+    quint64 version = 0;
+    //! This set is a snapshot of the whole collection.
+    bool reset = false;
+    //! Items which were added.
+    QSet<Ptr> added;
+    //! Items which were removed.
+    QSet<Ptr> removed;
+    //! Items which were modified.
+    QSet<Ptr> updated;
+
+    //! Returns whether nothing changed.
+    bool isEmpty() const
+    {
+        return (!reset && added.isEmpty() && removed.isEmpty()
+                && updated.isEmpty());
+    }
+
+    //! Returns whether a receiver which is at \c current should apply this
+    //! set.  Snapshots are also applied if they are the current version,
+    //! since the receiver might only have seen part of it.
+    bool isNewerThan(quint64 current) const
+    {
+        return (reset ? (version >= current) : (version > current));
+    }
+
+    //! Record that \c item was added.
+    void add(const Ptr &item)
+    {
+        // Removing and re-adding the same object only changes it.
+        if(removed.remove(item))
+            updated.insert(item);
+        else
+            added.insert(item);
+    }
+
+    //! Record that \c item was removed.
+    void remove(const Ptr &item)
+    {
+        updated.remove(item);
+        // Adding and removing the same object changes nothing.
+        if(!added.remove(item))
+            removed.insert(item);
+    }
+
+    //! Record that \c item was modified.
+    void update(const Ptr &item)
+    {
+        if(!added.contains(item))
+            updated.insert(item);
+    }
+};
+
+//! Changes to the \ref Archive collection.
+typedef ChangeSet<ArchivePtr> ArchiveChanges;
+//! Changes to the \ref Job collection.
+typedef ChangeSet<JobPtr> JobChanges;
+
+Q_DECLARE_METATYPE(ArchiveChanges)
+Q_DECLARE_METATYPE(JobChanges)
+
+#endif /* !CHANGESET_H */
@@ -0,0 +1,34 @@
+#ifndef FILEPICKERENTRY_H
+#define FILEPICKERENTRY_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+//! Metadata about a file in a directory being browsed.
+struct FilePickerEntry
+{
+    //! Filename (without the directory)
+    QString name;
+    //! Date-time last modified
+    QDateTime modified;
+    //! Filesize
+    qint64 size;
+    //! Is it a directory (or a symlink to one)?
+    bool isDir;
+    //! Is it a symbolic link?
+    bool isSymLink;
+    //! Is it hidden?
+    bool isHidden;
+    //! Is it a special file (device, fifo, socket)?
+    bool isSystem;
+};
+
+Q_DECLARE_METATYPE(QVector<FilePickerEntry>)
+
+#endif /* !FILEPICKERENTRY_H */
@@ -0,0 +1,14 @@
+#ifndef FILETREEPTR_H
+#define FILETREEPTR_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QSharedPointer>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class FileTree;
+typedef QSharedPointer<FileTree> FileTreePtr;
+
+#endif /* !FILETREEPTR_H */
@@ -0,0 +1,30 @@
+#ifndef FILEVERSION_H
+#define FILEVERSION_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QDateTime>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+//! A file as it was stored in an archive.
+struct FileVersion
+{
+    //! Path in the archive
+    QString path;
+    //! Name of the archive
+    QString archive;
+    //! Date-time the archive was created
+    QDateTime archiveTimestamp;
+    //! Filesize
+    quint64 size;
+    //! Date-time last modified (as listed by tarsnap)
+    QString modified;
+};
+
+Q_DECLARE_METATYPE(QVector<FileVersion>)
+
+#endif /* !FILEVERSION_H */
@@ -0,0 +1,138 @@
+#ifndef TASKOUTPUT_H
+#define TASKOUTPUT_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QFile>
+#include <QMetaType>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSharedPointer>
+#include <QString>
+WARNINGS_ENABLE
+
+#include <ctype.h>
+#include <limits.h>
+
+/*!
+ * \ingroup background-tasks
+ * \brief The TaskOutput is an immutable, reference-counted buffer holding
+ * the stdout or stderr of a CmdlineTask.
+ *
+ * Copies share the same bytes, so passing a TaskOutput through a queued
+ * signal does not copy the output.  The bytes are only decoded (as UTF-8)
+ * the first time that toString() is called, and the decoded QString is
+ * shared by all copies.
+ *
+ * Very large outputs are kept in a (temporary) file instead, which is
+ * memory-mapped read-only; the file is deleted once the last copy is
+ * destroyed.  A QByteArray holds at most INT_MAX bytes, so a larger file
+ * is not used at all; see isTooLarge().
+ */
+class TaskOutput
+{
+public:
+    //! Constructor.
+    TaskOutput() {}
+    //! Constructor.
+    explicit TaskOutput(const QByteArray &bytes) : _d(new Data(bytes)) {}
+    //! Constructor; takes ownership of the (open) \c file, whose contents
+    //! (without leading and trailing whitespace) are the output.  The file
+    //! is deleted along with the last copy of this object.
+    explicit TaskOutput(QFile *file) : _d(new Data(file)) {}
+
+    //! Returns whether there is no output.
+    bool isEmpty() const { return (size() == 0); }
+    //! Returns the size of the output, in bytes.
+    int size() const { return (_d ? _d->bytes.size() : 0); }
+    //! Returns the raw output; this does not copy the bytes.  If the output
+    //! is kept in a file, the QByteArray refers to the mapped file, so it
+    //! must not be used after the last copy of this object is destroyed.
+    QByteArray bytes() const { return (_d ? _d->bytes : QByteArray()); }
+    //! Returns whether the output is kept in a file.
+    bool isFile() const { return (_d && (_d->file != nullptr)); }
+    //! Returns whether the output was a file larger than INT_MAX bytes, in
+    //! which case it is empty.
+    bool isTooLarge() const { return (_d && _d->tooLarge); }
+
+    //! Returns the output as a QString; it is decoded on the first call.
+    QString toString() const
+    {
+        // Bail (if applicable).
+        if(!_d)
+            return (QString());
+
+        QMutexLocker locker(&_d->mutex);
+        if(!_d->decoded)
+        {
+            _d->text    = QString::fromUtf8(_d->bytes);
+            _d->decoded = true;
+        }
+        return (_d->text);
+    }
+
+private:
+    struct Data
+    {
+        explicit Data(const QByteArray &bytes_)
+            : bytes(bytes_), file(nullptr), tooLarge(false), decoded(false)
+        {
+        }
+
+        explicit Data(QFile *file_)
+            : file(file_), tooLarge(false), decoded(false)
+        {
+            file->flush();
+            qint64 size = file->size();
+
+            // Bail (if applicable).  Using only part of the output would
+            // silently lose data.
+            if(size > INT_MAX)
+            {
+                tooLarge = true;
+                return;
+            }
+
+            uchar *map = (size > 0) ? file->map(0, size) : nullptr;
+            if(map == nullptr)
+            {
+                // Fall back to reading the file.
+                file->seek(0);
+                bytes = file->read(size).trimmed();
+                return;
+            }
+
+            // Skip leading and trailing whitespace without copying.
+            const char *start = reinterpret_cast<const char *>(map);
+            const char *end   = start + size;
+            while((start < end) && isspace(static_cast<uchar>(*start)))
+                start++;
+            while((end > start) && isspace(static_cast<uchar>(*(end - 1))))
+                end--;
+            bytes =
+                QByteArray::fromRawData(start, static_cast<int>(end - start));
+        }
+
+        ~Data()
+        {
+            // This also unmaps the file, and removes a QTemporaryFile.
+            bytes.clear();
+            delete file;
+        }
+
+        QByteArray bytes;
+        QFile     *file;
+        bool       tooLarge;
+        QMutex     mutex;
+        QString    text;
+        bool       decoded;
+    };
+
+    QSharedPointer<Data> _d;
+};
+
+Q_DECLARE_METATYPE(TaskOutput)
+
+#endif /* !TASKOUTPUT_H */
@@ -0,0 +1,193 @@
+#include "nameindex.h"
+
+WARNINGS_DISABLE
+#include <algorithm>
+#include <iterator>
+
+#include <QChar>
+WARNINGS_ENABLE
+
+// Length of the indexed substrings.
+#define GRAM_LENGTH 3
+
+NameIndex::NameIndex()
+{
+}
+
+void NameIndex::insert(const QObject *object, const QString &name)
+{
+    // Bail (if applicable).
+    if(_names.contains(object))
+        return;
+
+    const QString lowercase = name.toLower();
+    _names.insert(object, lowercase);
+    for(const Gram gram : grams(lowercase))
+    {
+        Postings &postings = _postings[gram];
+        if(postings.objects.isEmpty())
+            postings.sorted = true;
+        else if(postings.sorted)
+            postings.sorted = (postings.objects.last() < object);
+        postings.objects.append(object);
+    }
+}
+
+void NameIndex::remove(const QSet<const QObject *> &objects)
+{
+    // Find the trigrams of the removed names.
+    QSet<Gram> affected;
+    for(const QObject *object : objects)
+    {
+        auto it = _names.find(object);
+        if(it == _names.end())
+            continue;
+        for(const Gram gram : grams(it.value()))
+            affected.insert(gram);
+        _names.erase(it);
+    }
+
+    // Remove the objects from those trigrams only.
+    for(const Gram gram : affected)
+    {
+        auto it = _postings.find(gram);
+        if(it == _postings.end())
+            continue;
+        QVector<const QObject *> &list = it.value().objects;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&objects](const QObject *object) {
+                                      return (objects.contains(object));
+                                  }),
+                   list.end());
+        if(list.isEmpty())
+            _postings.erase(it);
+    }
+}
+
+void NameIndex::clear()
+{
+    _names.clear();
+    _postings.clear();
+}
+
+int NameIndex::count() const
+{
+    return (_names.size());
+}
+
+bool NameIndex::candidates(const QString         &pattern,
+                           QSet<const QObject *> *found) const
+{
+    QSet<Gram> wanted;
+    for(const QString &literal : literals(pattern))
+    {
+        for(const Gram gram : grams(literal))
+            wanted.insert(gram);
+    }
+
+    // Bail (if applicable).
+    if(wanted.isEmpty())
+        return (false);
+
+    // Intersect the objects of each trigram, starting with the rarest.
+    QVector<Postings *> lists;
+    for(const Gram gram : wanted)
+    {
+        auto it = _postings.find(gram);
+        if(it == _postings.end())
+        {
+            // No name contains this trigram.
+            found->clear();
+            return (true);
+        }
+        sortPostings(it.value());
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const Postings *a, const Postings *b) {
+                  return (a->objects.size() < b->objects.size());
+              });
+    QVector<const QObject *> result = lists.first()->objects;
+    for(int i = 1; (i < lists.size()) && !result.isEmpty(); i++)
+    {
+        QVector<const QObject *> intersection;
+        intersection.reserve(result.size());
+        std::set_intersection(result.constBegin(), result.constEnd(),
+                              lists.at(i)->objects.constBegin(),
+                              lists.at(i)->objects.constEnd(),
+                              std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+
+    found->clear();
+    found->reserve(result.size());
+    for(const QObject *object : result)
+        found->insert(object);
+    return (true);
+}
+
+void NameIndex::sortPostings(Postings &postings)
+{
+    // Bail (if applicable).
+    if(postings.sorted)
+        return;
+
+    std::sort(postings.objects.begin(), postings.objects.end());
+    postings.sorted = true;
+}
+
+QVector<NameIndex::Gram> NameIndex::grams(const QString &lowercase)
+{
+    QVector<Gram> result;
+    for(int i = 0; i + GRAM_LENGTH <= lowercase.size(); i++)
+    {
+        Gram gram = 0;
+        for(int j = 0; j < GRAM_LENGTH; j++)
+            gram = (gram << 16) | lowercase.at(i + j).unicode();
+        result.append(gram);
+    }
+
+    // A name might contain the same trigram more than once.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return (result);
+}
+
+QStringList NameIndex::literals(const QString &pattern)
+{
+    // Split the pattern at '*' and '?', and skip "[...]" sets.
+    QStringList   result;
+    QString       literal;
+    const QString lowercase = pattern.toLower();
+    for(int i = 0; i < lowercase.size(); i++)
+    {
+        const QChar c = lowercase.at(i);
+        if((c == '*') || (c == '?') || (c == '['))
+        {
+            if(literal.size() >= GRAM_LENGTH)
+                result.append(literal);
+            literal.clear();
+            if(c == '[')
+            {
+                // A ']' right after "[" or "[!" is part of the set.
+                int start = i + 1;
+                if((start < lowercase.size()) && (lowercase.at(start) == '!'))
+                    start++;
+                if((start < lowercase.size()) && (lowercase.at(start) == ']'))
+                    start++;
+                // A set without its closing ']' ends the pattern.
+                const int close = lowercase.indexOf(']', start);
+                if(close == -1)
+                    return (result);
+                i = close;
+            }
+        }
+        else
+        {
+            literal.append(c);
+        }
+    }
+    if(literal.size() >= GRAM_LENGTH)
+        result.append(literal);
+    return (result);
+}
@@ -0,0 +1,72 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class QObject;
+
+/*!
+ * \ingroup misc
+ * \brief The NameIndex is a trigram index over the names of objects, which
+ * finds the objects whose name might match a (case-insensitive) wildcard
+ * filter.
+ *
+ * Every literal part of the filter (i.e. the text between wildcards) must
+ * be a substring of a matching name, so the candidates are the objects
+ * which have all trigrams of these parts.  Candidates must still be
+ * checked against the filter, but that is usually a small fraction of the
+ * names.  The objects of each trigram are kept sorted (by address) so that
+ * they can be intersected in linear time; additions are only sorted when
+ * the trigram is next needed.
+ */
+class NameIndex
+{
+public:
+    //! Constructor.
+    NameIndex();
+
+    //! Adds an object with its name.
+    void insert(const QObject *object, const QString &name);
+    //! Removes objects.
+    void remove(const QSet<const QObject *> &objects);
+    //! Removes all objects.
+    void clear();
+    //! Returns the number of objects.
+    int count() const;
+
+    //! Finds the objects whose name might match the wildcard \c pattern
+    //! (when searching anywhere in the name, ignoring the case).  Returns
+    //! false (and leaves \c found untouched) if the pattern has no literal
+    //! part of at least 3 characters, in which case any object might match.
+    bool candidates(const QString &pattern, QSet<const QObject *> *found) const;
+
+private:
+    Q_DISABLE_COPY(NameIndex)
+
+    typedef quint64 Gram;
+
+    struct Postings
+    {
+        QVector<const QObject *> objects;
+        bool                     sorted;
+    };
+
+    // Lowercase names, and the objects which contain each trigram.
+    QHash<const QObject *, QString> _names;
+    mutable QHash<Gram, Postings>   _postings;
+
+    static void          sortPostings(Postings &postings);
+    static QVector<Gram> grams(const QString &lowercase);
+    static QStringList   literals(const QString &pattern);
+};
+
+#endif /* !NAMEINDEX_H */
@@ -2,57 +2,45 @@
 
 WARNINGS_DISABLE
 #include <QAtomicInt>
-#include <QList>
-#include <QRegExp>
+#include <QByteArray>
 #include <QString>
-#include <QStringList>
-#include <QVector>
 WARNINGS_ENABLE
 
-#include "messages/archivefilestat.h"
+#include "messages/taskoutput.h"
 
-#include "compat.h"
+#include "archivelisting.h"
+#include "persistentmodel/listingstore.h"
+#include "persistentmodel/persistentstore.h"
 
-ParseArchiveListingTask::ParseArchiveListingTask(const QString &listing)
-    : _listing(listing)
+ParseArchiveListingTask::ParseArchiveListingTask(const QString &archive,
+                                                 const QString &dirname)
+    : _archive(archive), _dirname(dirname)
 {
     // We don't actually run "tarsnap -tv", because that data is
-    // already stored in the Archive _contents when we created it.
+    // already in the ListingStore.
 }
 
 void ParseArchiveListingTask::run()
 {
-    QVector<FileStat> files;
+    TaskOutput listing;
+    {
+        // Queries from this thread need a connection of their own.
+        StoreConnection  connection;
+        const QByteArray text = ListingStore::load(_archive);
 
-    // Parse a line of output from `tarsnap -tv -f ARCHIVENAME`.
-    QRegExp lineRx("^(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+"
-                   "\\s+\\S+\\s+\\S+)\\s+(.+)$");
+        // Keep the text in a file, so that only the index uses memory.
+        if(!text.isEmpty() && (static_cast<int>(_stopRequested) == 0))
+            listing = ArchiveListing::mapText(text, _dirname);
+    }
 
-    // Check each line.
-    for(const QString &line : _listing.split('\n', SKIP_EMPTY_PARTS))
+    // Bail if requested.
+    if(static_cast<int>(_stopRequested) == 1)
     {
-        // Bail if requested.
-        if(static_cast<int>(_stopRequested) == 1)
-        {
-            emit dequeue();
-            return;
-        }
-
-        // Bail if it doesn't match the expected pattern.
-        if(lineRx.indexIn(line) == -1)
-            continue;
-
-        FileStat stat;
-        stat.mode     = lineRx.capturedTexts()[1];
-        stat.links    = lineRx.capturedTexts()[2].toULongLong();
-        stat.user     = lineRx.capturedTexts()[3];
-        stat.group    = lineRx.capturedTexts()[4];
-        stat.size     = lineRx.capturedTexts()[5].toULongLong();
-        stat.modified = lineRx.capturedTexts()[6];
-        stat.name     = lineRx.capturedTexts()[7];
-        files.append(stat);
+        emit dequeue();
+        return;
     }
-    emit result(files);
+
+    emit result(ArchiveListingPtr(new ArchiveListing(listing)));
     emit dequeue();
 }
 
@@ -7,10 +7,9 @@ WARNINGS_DISABLE
 #include <QAtomicInt>
 #include <QObject>
 #include <QString>
-#include <QVector>
 WARNINGS_ENABLE
 
-#include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
 
 #include "basetask.h"
 
@@ -18,6 +17,10 @@ WARNINGS_ENABLE
  * \ingroup background-tasks
  * \brief The ParseArchiveListingTask extracts the list of files
  * from an archive.
+ *
+ * The listing is loaded from the \ref ListingStore, copied into a
+ * memory-mapped temporary file, and indexed by an ArchiveListing; the lines
+ * themselves are parsed later, when they are displayed.
  */
 class ParseArchiveListingTask : public BaseTask
 {
@@ -25,8 +28,10 @@ class ParseArchiveListingTask : public BaseTask
 
 public:
     //! Constructor.
-    //! \param listing the output of <tt>tarsnap -tv</tt>.
-    explicit ParseArchiveListingTask(const QString &listing);
+    //! \param archive the name of the archive whose contents to load.
+    //! \param dirname directory for the temporary file; if empty, the
+    //! listing is kept in memory.
+    ParseArchiveListingTask(const QString &archive, const QString &dirname);
     //! Run this task in the background; will emit the \ref result
     //! signal when finished.
     void run() override;
@@ -36,10 +41,11 @@ public:
 
 signals:
     //! The list of files.
-    void result(QVector<FileStat> files);
+    void result(ArchiveListingPtr listing);
 
 private:
-    QString _listing;
+    QString _archive;
+    QString _dirname;
 
     QAtomicInt _stopRequested;
 };
@@ -14,6 +14,7 @@ WARNINGS_ENABLE
 
 #include "debug.h"
 
+#include "persistentmodel/listingstore.h"
 #include "persistentmodel/persistentstore.h"
 
 Archive::Archive(QObject *parent)
@@ -24,6 +25,7 @@ Archive::Archive(QObject *parent)
       _sizeCompressed(0),
       _sizeUniqueTotal(0),
       _sizeUniqueCompressed(0),
+      _hasContents(false),
       _deleteScheduled(false)
 {
 }
@@ -39,8 +41,7 @@ void Archive::save()
             QLatin1String("update archives set name=?, timestamp=?,"
                           " truncated=?, truncatedInfo=?, sizeTotal=?,"
                           " sizeCompressed=?, sizeUniqueTotal=?,"
-                          " sizeUniqueCompressed=?, command=?, contents=?,"
-                          " jobRef=?"
+                          " sizeUniqueCompressed=?, command=?, jobRef=?"
                           " where name=?");
     }
     else
@@ -48,8 +49,8 @@ void Archive::save()
         queryString = QLatin1String(
             "insert into archives(name, timestamp, truncated, truncatedInfo,"
             " sizeTotal, sizeCompressed, sizeUniqueTotal,"
-            " sizeUniqueCompressed, command, contents, jobRef)"
-            " values(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            " sizeUniqueCompressed, command, jobRef)"
+            " values(?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
     }
     // Get database instance and create query object.
     QSqlQuery query = global_store->createQuery();
@@ -68,7 +69,6 @@ void Archive::save()
     query.addBindValue(_sizeUniqueTotal);
     query.addBindValue(_sizeUniqueCompressed);
     query.addBindValue(_command);
-    query.addBindValue(_contents);
     query.addBindValue(_jobRef);
     if(exists)
         query.addBindValue(_name);
@@ -115,9 +115,13 @@ void Archive::load()
             query.value(query.record().indexOf("sizeUniqueCompressed"))
                 .toULongLong();
         _command = query.value(query.record().indexOf("command")).toString();
-        _contents =
-            query.value(query.record().indexOf("contents")).toByteArray();
         _jobRef = query.value(query.record().indexOf("jobRef")).toString();
+        // Only check whether there are contents; they are loaded on demand.
+        _hasContents =
+            !query.value(query.record().indexOf("listingIds")).isNull()
+            || !query.value(query.record().indexOf("contents"))
+                    .toByteArray()
+                    .isEmpty();
         setObjectKey(_name);
     }
     else
@@ -139,17 +143,10 @@ void Archive::purge()
         DEBUG << "No Archive object with key " << _name;
         return;
     }
-    // Get database instance and prepare query.
-    QSqlQuery query = global_store->createQuery();
-    if(!query.prepare(QLatin1String("delete from archives where name = ?")))
-    {
-        DEBUG << query.lastError().text();
-        return;
-    }
-    // Fill in missing value in query string.
-    query.addBindValue(_name);
-    // Run query.
-    if(!global_store->runQuery(query))
+    // Other archives might store their contents relative to this one, so
+    // the ListingStore deletes it (or keeps it until they are detached in
+    // the background).
+    if(!ListingStore::remove(_name))
         DEBUG << "Failed to remove Archive entry.";
     setObjectKey("");
     emit purged();
@@ -249,15 +246,25 @@ bool Archive::hasPreservePaths()
 
 QString Archive::contents() const
 {
-    if(!_contents.isEmpty())
-        return (qUncompress(_contents));
+    return (QString::fromUtf8(rawContents()));
+}
+
+QByteArray Archive::rawContents() const
+{
+    if(_hasContents && !_name.isEmpty())
+        return (ListingStore::load(_name));
     else
-        return (QString());
+        return (QByteArray());
+}
+
+bool Archive::hasContents() const
+{
+    return (_hasContents);
 }
 
-void Archive::setContents(const QString &value)
+void Archive::setHasContents(bool hasContents)
 {
-    _contents = qCompress(value.toLatin1());
+    _hasContents = hasContents;
 }
 
 QString Archive::command() const
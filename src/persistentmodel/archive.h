@@ -33,28 +33,30 @@ public:
 
     //! Getter/setter methods
     //! @{
-    QString   name() const;
-    void      setName(const QString &value);
-    QDateTime timestamp() const;
-    void      setTimestamp(const QDateTime &value);
-    bool      truncated() const;
-    void      setTruncated(bool truncated);
-    QString   truncatedInfo() const;
-    void      setTruncatedInfo(const QString &truncatedInfo);
-    quint64   sizeTotal() const;
-    void      setSizeTotal(const quint64 &value);
-    quint64   sizeCompressed() const;
-    void      setSizeCompressed(const quint64 &value);
-    quint64   sizeUniqueTotal() const;
-    void      setSizeUniqueTotal(const quint64 &value);
-    quint64   sizeUniqueCompressed() const;
-    void      setSizeUniqueCompressed(const quint64 &value);
-    QString   command() const;
-    void      setCommand(const QString &value);
-    QString   contents() const;
-    void      setContents(const QString &value);
-    QString   jobRef() const;
-    void      setJobRef(const QString &jobRef);
+    QString    name() const;
+    void       setName(const QString &value);
+    QDateTime  timestamp() const;
+    void       setTimestamp(const QDateTime &value);
+    bool       truncated() const;
+    void       setTruncated(bool truncated);
+    QString    truncatedInfo() const;
+    void       setTruncatedInfo(const QString &truncatedInfo);
+    quint64    sizeTotal() const;
+    void       setSizeTotal(const quint64 &value);
+    quint64    sizeCompressed() const;
+    void       setSizeCompressed(const quint64 &value);
+    quint64    sizeUniqueTotal() const;
+    void       setSizeUniqueTotal(const quint64 &value);
+    quint64    sizeUniqueCompressed() const;
+    void       setSizeUniqueCompressed(const quint64 &value);
+    QString    command() const;
+    void       setCommand(const QString &value);
+    QString    contents() const;
+    QByteArray rawContents() const;
+    bool       hasContents() const;
+    void       setHasContents(bool hasContents);
+    QString    jobRef() const;
+    void       setJobRef(const QString &jobRef);
     //! @}
 
     //! Returns whether the tarsnap command included "-P" (preserve pathnames).
@@ -97,8 +99,10 @@ private:
     quint64    _sizeUniqueTotal;
     quint64    _sizeUniqueCompressed;
     QString    _command;
-    QByteArray _contents;
     QString    _jobRef;
+    // The contents are kept by the ListingStore, and stored by a
+    // ListingTask.
+    bool       _hasContents;
 
     // Properties not saved to the PersistentStore
     bool _deleteScheduled;
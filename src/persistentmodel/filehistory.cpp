@@ -0,0 +1,271 @@
+#include "persistentmodel/filehistory.h"
+
+WARNINGS_DISABLE
+#include <QDateTime>
+#include <QHash>
+#include <QLatin1String>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+WARNINGS_ENABLE
+
+#include <algorithm>
+
+#include "messages/archivefilestat.h"
+
+#include "debug.h"
+
+#include "archivelisting.h"
+#include "persistentmodel/listingstore.h"
+#include "persistentmodel/persistentstore.h"
+
+// Number of lines which are indexed at once.
+#define INDEX_BATCH 10000
+
+// Returns the path in a listing line, or a null QVariant if the line is not
+// a file.
+static QVariant linePath(const QByteArray &line)
+{
+    FileStat stat;
+    if(!ArchiveListing::parseLine(line, stat))
+        return (QVariant());
+
+    // A symlink is listed as "name -> target".
+    QString path = stat.name;
+    if(stat.mode.startsWith('l'))
+    {
+        const int arrow = path.indexOf(QLatin1String(" -> "));
+        if(arrow != -1)
+            path.truncate(arrow);
+    }
+    if((path.size() > 1) && path.endsWith('/'))
+        path.chop(1);
+    if(path.isEmpty())
+        return (QVariant());
+    return (path);
+}
+
+bool FileHistory::indexLines(const QAtomicInt *stop_p)
+{
+    // Each batch starts after the previous one, so a line which cannot be
+    // indexed is not read again.
+    QSqlQuery query = global_store->createQuery();
+    query.setForwardOnly(true);
+    if(!query.prepare(QLatin1String(
+           "select id, line from listingLines where id > ? and not exists"
+           " (select 1 from fileLines where lineRef = listingLines.id)"
+           " order by id limit ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+
+    qint64 last = 0;
+    while(true)
+    {
+        // Bail if requested.
+        if((stop_p != nullptr) && (static_cast<int>(*stop_p) == 1))
+            return (true);
+
+        query.bindValue(0, last);
+        query.bindValue(1, INDEX_BATCH);
+        if(!global_store->runQuery(query))
+        {
+            DEBUG << "Failed to find the lines without a file history.";
+            return (false);
+        }
+        // Each list holds one bound value per line.
+        QVariantList ids;
+        QVariantList paths;
+        QVariantList newPaths;
+        while(query.next())
+        {
+            last                = query.value(0).toLongLong();
+            const QVariant path = linePath(query.value(1).toByteArray());
+            ids << last;
+            paths << path;
+            if(!path.isNull())
+                newPaths << path;
+        }
+        // We're finished.
+        if(ids.isEmpty())
+            return (true);
+
+        // Add the paths which are not in any other line.
+        QSqlQuery insert = global_store->createQuery();
+        if(!newPaths.isEmpty())
+        {
+            if(!insert.prepare(QLatin1String(
+                   "insert or ignore into filePaths(path) values(?)")))
+            {
+                DEBUG << insert.lastError().text();
+                return (false);
+            }
+            insert.addBindValue(newPaths);
+            if(!global_store->runBatchQuery(insert))
+            {
+                DEBUG << "Failed to add paths to the file history.";
+                return (false);
+            }
+        }
+
+        // Add the lines, referring to their paths (if any).  A line which
+        // was collected in the meantime is skipped.
+        if(!insert.prepare(QLatin1String(
+               "insert or ignore into fileLines(lineRef, pathRef)"
+               " select id, (select id from filePaths where path = ?)"
+               " from listingLines where id = ?")))
+        {
+            DEBUG << insert.lastError().text();
+            return (false);
+        }
+        insert.addBindValue(paths);
+        insert.addBindValue(ids);
+        if(!global_store->runBatchQuery(insert))
+        {
+            DEBUG << "Failed to add lines to the file history.";
+            return (false);
+        }
+    }
+}
+
+QVector<FileVersion> FileHistory::find(const QString &pattern, int limit)
+{
+    QVector<FileVersion> versions;
+    const QString        path = pattern.trimmed();
+
+    // Bail (if applicable).
+    if(path.isEmpty())
+        return (versions);
+
+    // A path is looked up both as relative and absolute, since tarsnap
+    // strips the leading slash unless -P was used.
+    const bool glob = path.contains('*') || path.contains('?')
+                      || path.contains('[');
+    QString    where;
+    if(glob)
+        where = QLatin1String("filePaths.path glob ?");
+    else
+        where = QLatin1String("filePaths.path in (?, ?)");
+
+    // Find the paths first; normally, each of them has a version.
+    QSqlQuery query = global_store->createQuery();
+    query.setForwardOnly(true);
+    if(!query.prepare(QLatin1String("select id, path from filePaths where ")
+                      + where
+                      + QLatin1String(" and exists (select 1 from fileLines"
+                                      " where fileLines.pathRef = filePaths.id)"
+                                      " order by path limit ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (versions);
+    }
+    if(glob)
+    {
+        query.addBindValue(path);
+    }
+    else
+    {
+        QString relative = path;
+        while(relative.startsWith('/'))
+            relative.remove(0, 1);
+        query.addBindValue(relative);
+        query.addBindValue(QChar('/') + relative);
+    }
+    query.addBindValue(limit);
+    if(!global_store->runQuery(query))
+    {
+        DEBUG << "Failed to search the file history.";
+        return (versions);
+    }
+    QVector<qint64> pathIds;
+    QStringList     paths;
+    while(query.next())
+    {
+        pathIds << query.value(0).toLongLong();
+        paths << query.value(1).toString();
+    }
+
+    // Each line of a path is a version of the file, in one or more archives.
+    struct Line
+    {
+        qint64  id;
+        int     path;
+        quint64 size;
+        QString modified;
+    };
+    QVector<Line>   lines;
+    QVector<qint64> ids;
+    if(!query.prepare(QLatin1String(
+           "select fileLines.lineRef, listingLines.line from fileLines"
+           " join listingLines on listingLines.id = fileLines.lineRef"
+           " where fileLines.pathRef = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (versions);
+    }
+    for(int i = 0; i < pathIds.size(); i++)
+    {
+        query.bindValue(0, pathIds.at(i));
+        if(!global_store->runQuery(query))
+            return (versions);
+        while(query.next())
+        {
+            FileStat stat;
+            if(!ArchiveListing::parseLine(query.value(1).toByteArray(), stat))
+                continue;
+            const Line line = {query.value(0).toLongLong(), i, stat.size,
+                               stat.modified};
+            lines << line;
+            ids << line.id;
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    const QHash<qint64, QStringList> archives =
+        ListingStore::archivesWithLines(ids);
+
+    QHash<QString, uint> timestamps;
+    if(!query.prepare(QLatin1String("select name, timestamp from archives"))
+       || !global_store->runQuery(query))
+    {
+        DEBUG << query.lastError().text();
+        return (versions);
+    }
+    while(query.next())
+        timestamps.insert(query.value(0).toString(), query.value(1).toUInt());
+
+    // The lines are grouped by path.
+    int first = 0;
+    while((first < lines.size()) && (versions.size() < limit))
+    {
+        QVector<FileVersion> fileVersions;
+        int                  next = first;
+        while((next < lines.size())
+              && (lines.at(next).path == lines.at(first).path))
+        {
+            const Line       &line  = lines.at(next++);
+            const QStringList names = archives.value(line.id);
+            for(const QString &archive : names)
+            {
+                FileVersion version;
+                version.path             = paths.at(line.path);
+                version.archive          = archive;
+                version.archiveTimestamp =
+                    QDateTime::fromTime_t(timestamps.value(archive));
+                version.size             = line.size;
+                version.modified         = line.modified;
+                fileVersions << version;
+            }
+        }
+        std::sort(fileVersions.begin(), fileVersions.end(),
+                  [](const FileVersion &a, const FileVersion &b) {
+                      return (a.archiveTimestamp > b.archiveTimestamp);
+                  });
+        versions << fileVersions;
+        first = next;
+    }
+    versions.resize(qMin(versions.size(), limit));
+    return (versions);
+}
@@ -0,0 +1,40 @@
+#ifndef FILEHISTORY_H
+#define FILEHISTORY_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/fileversion.h"
+
+/*!
+ * \ingroup persistent
+ * \brief The FileHistory is an index of the files in every archive whose
+ * contents have been fetched, so that finding the archives which contain a
+ * file does not require parsing any listings.
+ *
+ * Each distinct path is stored once (in the \c filePaths table), and each
+ * line of the \ref ListingStore has a row of \c fileLines which refers to
+ * the path in that line.  A line is shared by every archive which contains
+ * the same version of a file, so it is only parsed and indexed once; the
+ * archives which contain it are found from the ListingStore.
+ */
+class FileHistory
+{
+public:
+    //! Indexes the lines of the ListingStore which are not in the index
+    //! yet.  Returns early if \p stop_p becomes non-zero.
+    static bool indexLines(const QAtomicInt *stop_p = nullptr);
+
+    //! Returns (at most \c limit) versions of the files matching
+    //! \c pattern, sorted by path and then by archive (newest first).  A
+    //! pattern without wildcards is a path, with or without a leading
+    //! slash; otherwise, it is a shell globbing pattern.
+    static QVector<FileVersion> find(const QString &pattern, int limit);
+};
+
+#endif /* !FILEHISTORY_H */
@@ -1,10 +1,14 @@
 #include "persistentmodel/job.h"
 
 WARNINGS_DISABLE
+#include <QByteArray>
+#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
+#include <QHash>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
@@ -18,6 +22,7 @@ WARNINGS_ENABLE
 
 #include "TSettings.h"
 
+#include "changetracker.h"
 #include "compat.h"
 #include "debug.h"
 #include "persistentmodel/archive.h"
@@ -37,7 +42,10 @@ Job::Job(QObject *parent)
       _settingShowHidden(false),
       _settingShowSystem(false),
       _settingHideSymlinks(false),
-      _fsWatcher(new QFileSystemWatcher(this))
+      _hasUploadEstimate(false),
+      _uploadEstimate(0),
+      _fsWatcher(new QFileSystemWatcher(this)),
+      _changeTracker(nullptr)
 {
     // Load values from settings.
     TSettings settings;
@@ -84,6 +92,10 @@ QList<QUrl> Job::urls() const
 void Job::setUrls(const QList<QUrl> &urls)
 {
     _urls = urls;
+
+    // Track the new urls instead.
+    if(_changeTracker != nullptr)
+        startChangeTracking();
 }
 
 bool Job::validateUrls()
@@ -134,6 +146,89 @@ void Job::removeWatcher()
         _fsWatcher->removePaths(watching);
 }
 
+void Job::startChangeTracking()
+{
+    if(_changeTracker == nullptr)
+    {
+        _changeTracker = new ChangeTracker(this);
+        connect(_changeTracker, &ChangeTracker::changed, this, &Job::fsEvent);
+        connect(_changeTracker, &ChangeTracker::changed, this,
+                &Job::clearUploadEstimate);
+    }
+
+    QStringList roots;
+    for(const QUrl &url : _urls)
+        roots << url.toLocalFile();
+    _changeTracker->setRoots(roots);
+}
+
+void Job::stopChangeTracking()
+{
+    if(_changeTracker == nullptr)
+        return;
+    _changeTracker->deleteLater();
+    _changeTracker = nullptr;
+}
+
+bool Job::isChangeTracking() const
+{
+    return ((_changeTracker != nullptr) && _changeTracker->isTracking());
+}
+
+bool Job::hasChanges() const
+{
+    if(_changeTracker == nullptr)
+        return (true);
+    return (_changeTracker->hasChanges());
+}
+
+void Job::resetChanges()
+{
+    if(_changeTracker != nullptr)
+        _changeTracker->resetChanges();
+}
+
+void Job::markAllChanged()
+{
+    if(_changeTracker != nullptr)
+        _changeTracker->markAllDirty();
+}
+
+bool Job::hasUploadEstimate() const
+{
+    return (_hasUploadEstimate);
+}
+
+quint64 Job::uploadEstimate() const
+{
+    return (_uploadEstimate);
+}
+
+QString Job::uploadEstimateFingerprint() const
+{
+    return (_uploadEstimateFingerprint);
+}
+
+void Job::setUploadEstimate(quint64 uploadEstimate, const QString &fingerprint)
+{
+    _hasUploadEstimate         = true;
+    _uploadEstimate            = uploadEstimate;
+    _uploadEstimateFingerprint = fingerprint;
+    emit uploadEstimateChanged();
+}
+
+void Job::clearUploadEstimate()
+{
+    // Bail (if applicable).
+    if(!_hasUploadEstimate)
+        return;
+
+    _hasUploadEstimate = false;
+    _uploadEstimate    = 0;
+    _uploadEstimateFingerprint.clear();
+    emit uploadEstimateChanged();
+}
+
 QList<ArchivePtr> Job::archives() const
 {
     return (_archives);
@@ -267,10 +362,112 @@ void Job::setSettingHideSymlinks(bool settingHideSymlinks)
     _settingHideSymlinks = settingHideSymlinks;
 }
 
+QString Job::lastBackupFingerprint() const
+{
+    return (_lastBackupFingerprint);
+}
+
+void Job::setLastBackupFingerprint(const QString &lastBackupFingerprint)
+{
+    _lastBackupFingerprint = lastBackupFingerprint;
+}
+
+// Mix the metadata of a single file into 64 bits (splitmix64 finalizer).
+static quint64 mixFileInfo(const QString &path, const QFileInfo &info)
+{
+    quint64 x = qHash(path, 0);
+    x = (x << 32) ^ static_cast<quint64>(info.size());
+    x ^= static_cast<quint64>(info.lastModified().toMSecsSinceEpoch()) << 1;
+#if(QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+    x ^= static_cast<quint64>(info.metadataChangeTime().toMSecsSinceEpoch())
+         << 17;
+#endif
+    x ^= static_cast<quint64>(info.permissions()) << 48;
+    x = (x ^ (x >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+    x = (x ^ (x >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+    return (x ^ (x >> 31));
+}
+
+QString Job::computeFingerprint() const
+{
+    return (computeFingerprint(_urls, _optionFollowSymLinks,
+                               fingerprintOptions()));
+}
+
+QByteArray Job::fingerprintOptions() const
+{
+    // Anything (other than the urls) which changes the archive contents.
+    return (QByteArray::number(_optionPreservePaths)
+            + QByteArray::number(_optionTraverseMount)
+            + QByteArray::number(_optionFollowSymLinks)
+            + QByteArray::number(_optionSkipFilesSize)
+            + QByteArray::number(_optionSkipFiles)
+            + QByteArray::number(_optionSkipNoDump)
+            + _optionSkipFilesPatterns.toUtf8());
+}
+
+QString Job::computeFingerprint(const QList<QUrl> &urls, bool followSymLinks,
+                                const QByteArray &options,
+                                const QAtomicInt *stop_p)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    // Anything which changes the archive contents.
+    for(const QUrl &url : urls)
+        hash.addData(url.toString(QUrl::FullyEncoded).toUtf8());
+    hash.addData(options);
+
+    // The sum doesn't depend on the order in which we see the files.
+    quint64 count = 0;
+    quint64 size  = 0;
+    quint64 sum   = 0;
+
+    QDirIterator::IteratorFlags flags = QDirIterator::Subdirectories;
+    if(followSymLinks)
+        flags |= QDirIterator::FollowSymlinks;
+    for(const QUrl &url : urls)
+    {
+        QString   root = url.toLocalFile();
+        QFileInfo rootInfo(root);
+        count++;
+        sum += mixFileInfo(root, rootInfo);
+        if(!rootInfo.isDir())
+        {
+            size += static_cast<quint64>(rootInfo.size());
+            continue;
+        }
+
+        QDirIterator it(root,
+                        QDir::AllEntries | QDir::NoDotAndDotDot | QDir::Hidden
+                            | QDir::System,
+                        flags);
+        while(it.hasNext())
+        {
+            // Bail (if applicable).
+            if((stop_p != nullptr) && (static_cast<int>(*stop_p) == 1))
+                return (QString());
+
+            QString   path = it.next();
+            QFileInfo info = it.fileInfo();
+            count++;
+            if(!info.isDir())
+                size += static_cast<quint64>(info.size());
+            sum += mixFileInfo(path, info);
+        }
+    }
+    hash.addData(QByteArray::number(count) + ":" + QByteArray::number(size)
+                 + ":" + QByteArray::number(sum));
+
+    return (QString::fromLatin1(hash.result().toHex()));
+}
+
 void Job::save()
 {
     bool exists = doesKeyExist(_name);
 
+    // The options (or a new archive) might change the estimate.
+    clearUploadEstimate();
+
     // Prepare query: either updating or creating an entry.
     QString queryString;
     if(exists)
@@ -280,7 +477,7 @@ void Job::save()
             " optionFollowSymLinks=?, optionSkipFilesSize=?,"
             " optionSkipFiles=?, optionSkipFilesPatterns=?,"
             " optionSkipNoDump=?, settingShowHidden=?, settingShowSystem=?,"
-            " settingHideSymlinks=?"
+            " settingHideSymlinks=?, lastBackupFingerprint=?"
             " where name=?");
     else
         queryString = QLatin1String(
@@ -288,8 +485,8 @@ void Job::save()
             " optionPreservePaths, optionTraverseMount,"
             " optionFollowSymLinks, optionSkipFilesSize, optionSkipFiles,"
             " optionSkipFilesPatterns, optionSkipNoDump, settingShowHidden,"
-            " settingShowSystem, settingHideSymlinks)"
-            " values(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            " settingShowSystem, settingHideSymlinks, lastBackupFingerprint)"
+            " values(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
 
     // Get database instance and create query object.
     QSqlQuery query = global_store->createQuery();
@@ -318,6 +515,7 @@ void Job::save()
     query.addBindValue(_settingShowHidden);
     query.addBindValue(_settingShowSystem);
     query.addBindValue(_settingHideSymlinks);
+    query.addBindValue(_lastBackupFingerprint);
     if(exists)
         query.addBindValue(_name);
 
@@ -375,6 +573,9 @@ void Job::load()
             query.value(query.record().indexOf("settingShowSystem")).toBool();
         _settingHideSymlinks =
             query.value(query.record().indexOf("settingHideSymlinks")).toBool();
+        _lastBackupFingerprint =
+            query.value(query.record().indexOf("lastBackupFingerprint"))
+                .toString();
         setObjectKey(_name);
         emit loadArchives();
     }
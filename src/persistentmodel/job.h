@@ -4,6 +4,8 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QAtomicInt>
+#include <QByteArray>
 #include <QLatin1String>
 #include <QList>
 #include <QMetaType>
@@ -18,6 +20,7 @@ WARNINGS_ENABLE
 #include "persistentmodel/persistentobject.h"
 
 /* Forward declaration(s). */
+class ChangeTracker;
 class QFileSystemWatcher;
 
 #define JOB_NAME_PREFIX QLatin1String("Job_")
@@ -56,6 +59,56 @@ public:
     //! Removes the filesystem watcher.
     void removeWatcher();
 
+    //! Starts tracking changes anywhere below this Job's urls.  This
+    //! continues until stopChangeTracking(), regardless of removeWatcher();
+    //! changing the urls changes what is tracked.  Tracking uses inotify
+    //! watches, so only the GUI starts it, once it needs to know about
+    //! changes (i.e. when estimating the upload of a Job).
+    void startChangeTracking();
+    //! Stops tracking changes below this Job's urls.
+    void stopChangeTracking();
+    //! Returns whether changes below this Job's urls are being tracked.
+    bool isChangeTracking() const;
+    //! Returns whether anything below this Job's urls may have changed since
+    //! the last resetChanges().  Without change tracking, this is always true.
+    bool hasChanges() const;
+    //! Forgets all changes seen so far; call this when a backup starts.
+    void resetChanges();
+    //! Considers everything to have changed; call this if a backup failed.
+    void markAllChanged();
+
+    //! Returns a cheap summary of the files below this Job's urls (and of
+    //! the options which affect an archive).  If two fingerprints are equal,
+    //! a new backup would almost certainly be identical to the old one.
+    //! This reads the whole tree, so the TaskManager uses a
+    //! \ref FingerprintTask.
+    QString computeFingerprint() const;
+    //! Computes the fingerprint of the files below \p urls, combined with
+    //! fingerprintOptions(); safe to call from any thread.  Returns early
+    //! if \p stop_p becomes non-zero.
+    static QString computeFingerprint(const QList<QUrl> &urls,
+                                      bool              followSymLinks,
+                                      const QByteArray &options,
+                                      const QAtomicInt *stop_p = nullptr);
+    //! Returns the options which go into the fingerprint.
+    QByteArray fingerprintOptions() const;
+
+    //! Returns whether there is a cached upload estimate.  It is cleared as
+    //! soon as the ChangeTracker notices a change; without change tracking,
+    //! it is only valid if uploadEstimateFingerprint() is still current.
+    bool hasUploadEstimate() const;
+    //! Returns the estimated amount of new (compressed) data for the next
+    //! backup of this Job.  Only valid if hasUploadEstimate().
+    quint64 uploadEstimate() const;
+    //! Returns the fingerprint taken before the --dry-run which produced the
+    //! estimate (if the Job was not being tracked).
+    QString uploadEstimateFingerprint() const;
+    //! Caches the result of a --dry-run of this Job.
+    void setUploadEstimate(quint64        uploadEstimate,
+                           const QString &fingerprint = QString());
+    //! Forgets the cached upload estimate.
+    void clearUploadEstimate();
+
     //! Getter/setter methods
     //! @{
     QString name() const;
@@ -99,6 +152,9 @@ public:
 
     bool settingHideSymlinks() const;
     void setSettingHideSymlinks(bool settingHideSymlinks);
+
+    QString lastBackupFingerprint() const;
+    void    setLastBackupFingerprint(const QString &lastBackupFingerprint);
     //! @}
 
     // From PersistentObject
@@ -124,6 +180,8 @@ signals:
     void loadArchives();
     //! A file or directory (which is being watched) has changed.
     void fsEvent();
+    //! The upload estimate was set or cleared.
+    void uploadEstimateChanged();
 
 private:
     // Stored in the global_store.
@@ -140,12 +198,19 @@ private:
     bool        _settingShowHidden;
     bool        _settingShowSystem;
     bool        _settingHideSymlinks;
+    QString     _lastBackupFingerprint;
 
     // Calculated by a ParseArchiveListingTask.
     QList<ArchivePtr> _archives;
 
+    // Calculated by a --dry-run.
+    bool    _hasUploadEstimate;
+    quint64 _uploadEstimate;
+    QString _uploadEstimateFingerprint;
+
     // Used internally.
     QFileSystemWatcher *_fsWatcher;
+    ChangeTracker      *_changeTracker;
 };
 
 #endif // JOB_H
@@ -8,6 +8,7 @@ WARNINGS_DISABLE
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QVariant>
+#include <QVariantList>
 WARNINGS_ENABLE
 
 #include "persistentmodel/persistentstore.h"
@@ -34,15 +35,22 @@ static QDateTime epochToDate(const qint64 secs)
 
 Journal::Journal(QObject *parent) : PersistentObject(parent)
 {
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(JOURNAL_FLUSH_MS);
+    connect(&_flushTimer, &QTimer::timeout, this, &Journal::flush);
 }
 
 Journal::~Journal()
 {
     logMessage("==Session end==");
+    flush();
 }
 
 void Journal::load()
 {
+    // Store any pending messages, so that they are read back below.
+    flush();
+
     _log.clear();
     // Get database instance and prepare query.
     QSqlQuery query = global_store->createQuery();
@@ -85,6 +93,8 @@ void Journal::purge()
     // Run "delete" query.
     if(global_store->runQuery(query))
     {
+        _flushTimer.stop();
+        _pending.clear();
         _log.clear();
         emit journal(_log);
     }
@@ -101,7 +111,33 @@ void Journal::logMessage(const QString &message)
     LogEntry log{QDateTime::currentDateTime(),
                  QString(message).remove(QRegExp("<[^>]*>"))};
     _log.push_back(log);
-    emit logEntry(log);
+
+    // Store it (along with any others) later.
+    _pending.push_back(log);
+    if(!_flushTimer.isActive())
+        _flushTimer.start();
+}
+
+void Journal::flush()
+{
+    _flushTimer.stop();
+
+    // Bail (if applicable).
+    if(_pending.isEmpty())
+        return;
+
+    QVector<LogEntry> entries;
+    entries.swap(_pending);
+    emit logEntries(entries);
+
+    // Each list holds one bound value per log entry.
+    QVariantList timestamps;
+    QVariantList messages;
+    for(const LogEntry &log : entries)
+    {
+        timestamps << dateToEpoch(log.timestamp);
+        messages << log.message;
+    }
 
     // Get database instance and prepare query.
     QSqlQuery query = global_store->createQuery();
@@ -112,9 +148,9 @@ void Journal::logMessage(const QString &message)
         return;
     }
     // Fill in missing values in query string.
-    query.addBindValue(dateToEpoch(log.timestamp));
-    query.addBindValue(log.message);
-    // Run query.
-    if(!global_store->runQuery(query))
-        DEBUG << "Failed to add Journal entry.";
+    query.addBindValue(timestamps);
+    query.addBindValue(messages);
+    // Run all insertions in one transaction.
+    if(!global_store->runBatchQuery(query))
+        DEBUG << "Failed to add Journal entries.";
 }
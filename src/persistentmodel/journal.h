@@ -6,6 +6,7 @@
 WARNINGS_DISABLE
 #include <QObject>
 #include <QString>
+#include <QTimer>
 #include <QVector>
 WARNINGS_ENABLE
 
@@ -13,9 +14,16 @@ WARNINGS_ENABLE
 
 #include "persistentmodel/persistentobject.h"
 
+//! Delay (in ms) used to collect log messages before storing them.
+#define JOURNAL_FLUSH_MS 500
+
 /*!
  * \ingroup persistent
  * \brief The Journal stores the user's log messages.
+ *
+ * New messages are collected for JOURNAL_FLUSH_MS, and then stored in a
+ * single transaction and announced with a single \ref logEntries()
+ * signal.
  */
 class Journal : public PersistentObject
 {
@@ -24,14 +32,22 @@ class Journal : public PersistentObject
 public:
     //! Constructor.
     explicit Journal(QObject *parent = nullptr);
+    //! Logs the end of the session, and stores any pending messages.
     ~Journal() override;
 
 public slots:
-    //! Emits the current log.
-    void getJournal() { emit journal(_log); }
+    //! Stores any pending messages, and emits the current log.
+    void getJournal()
+    {
+        flush();
+        emit journal(_log);
+    }
     //! Adds a new log message to the journal (and PersistentStore)
     //! after stripping HTML commands from the string.
     void logMessage(const QString &message);
+    //! Stores the pending log messages in the PersistentStore, and emits
+    //! them.
+    void flush();
 
     // From PersistentObject
     //! Does nothing.
@@ -48,13 +64,17 @@ public slots:
     }
 
 signals:
-    //! A log entry (including time and HTML-stripped message).
-    void logEntry(LogEntry log);
+    //! New log entries (including time and HTML-stripped message), in
+    //! chronological order.
+    void logEntries(QVector<LogEntry> entries);
     //! The complete set of log entries.
     void journal(QVector<LogEntry> _log);
 
 private:
     QVector<LogEntry> _log;
+    // Messages which have not been stored yet.
+    QVector<LogEntry> _pending;
+    QTimer            _flushTimer;
 };
 
 #endif // JOURNAL_H
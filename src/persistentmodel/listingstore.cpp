@@ -0,0 +1,926 @@
+#include "persistentmodel/listingstore.h"
+
+WARNINGS_DISABLE
+#include <QBitArray>
+#include <QCryptographicHash>
+#include <QHash>
+#include <QLatin1String>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <QVariantList>
+
+// Held while changing the lines or the ids of archives, since background
+// tasks store listings while other threads purge archives or collect
+// garbage.
+static QMutex writeMutex;
+WARNINGS_ENABLE
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+
+#include "debug.h"
+
+#include "persistentmodel/persistentstore.h"
+
+// Maximum number of archives in a chain of listingBase references.
+#define MAX_DELTA_DEPTH 16
+
+// Ids which are at most this far apart are read with a single query.
+#define READ_GAP 64
+
+// Removed archives which other archives are relative to are kept under a
+// name which starts with a newline; tarsnap archive names cannot contain
+// one.
+#define REMOVED_PREFIX "\n"
+
+typedef QVector<qint64> IdList;
+
+// The ids of an archive, relative to the ids of its base (if any), and the
+// order of its lines.
+struct Delta
+{
+    QString      base;
+    IdList       removed;
+    IdList       added;
+    QVector<int> order;
+};
+
+static void appendNumber(QByteArray &bytes, quint64 number)
+{
+    // 7 bits per byte; the high bit means that more bytes follow.
+    while(number >= 0x80)
+    {
+        bytes.append(static_cast<char>((number & 0x7f) | 0x80));
+        number >>= 7;
+    }
+    bytes.append(static_cast<char>(number));
+}
+
+static bool readNumber(const char *&pos, const char *end, quint64 &number)
+{
+    number    = 0;
+    int shift = 0;
+    while((pos < end) && (shift < 64))
+    {
+        const quint8 byte = static_cast<quint8>(*pos++);
+        number |= static_cast<quint64>(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+            return (true);
+        shift += 7;
+    }
+    return (false);
+}
+
+static void appendIds(QByteArray &bytes, const IdList &ids)
+{
+    // The differences between sorted ids are mostly 1, so they are short
+    // and compress well.
+    appendNumber(bytes, static_cast<quint64>(ids.size()));
+    qint64 previous = 0;
+    for(qint64 id : ids)
+    {
+        appendNumber(bytes, static_cast<quint64>(id - previous));
+        previous = id;
+    }
+}
+
+static bool readIds(const char *&pos, const char *end, IdList &ids)
+{
+    // Each id takes at least one byte.
+    quint64 count;
+    if(!readNumber(pos, end, count)
+       || (count > static_cast<quint64>(end - pos)))
+        return (false);
+
+    ids.resize(static_cast<int>(count));
+    qint64 previous = 0;
+    for(int i = 0; i < ids.size(); i++)
+    {
+        quint64 difference;
+        if(!readNumber(pos, end, difference))
+            return (false);
+        previous += static_cast<qint64>(difference);
+        ids[i] = previous;
+    }
+    return (true);
+}
+
+static void appendOrder(QByteArray &bytes, const QVector<int> &order)
+{
+    // Each line normally follows the previous one, which is stored as 0;
+    // other differences are zigzag-encoded, so that small ones are short.
+    appendNumber(bytes, static_cast<quint64>(order.size()));
+    qint64 next = 0;
+    for(int index : order)
+    {
+        const qint64 difference = index - next;
+        if(difference < 0)
+            appendNumber(bytes, (static_cast<quint64>(-difference) << 1) - 1);
+        else
+            appendNumber(bytes, static_cast<quint64>(difference) << 1);
+        next = index + 1;
+    }
+}
+
+static bool readOrder(const char *&pos, const char *end, QVector<int> &order)
+{
+    // Listings whose lines are in the order of their ids have none.
+    order.clear();
+    if(pos == end)
+        return (true);
+
+    // Each index takes at least one byte.
+    quint64 count;
+    if(!readNumber(pos, end, count)
+       || (count > static_cast<quint64>(end - pos)))
+        return (false);
+
+    order.resize(static_cast<int>(count));
+    qint64 next = 0;
+    for(int i = 0; i < order.size(); i++)
+    {
+        quint64 number;
+        if(!readNumber(pos, end, number))
+            return (false);
+        if(number & 1)
+            next -= static_cast<qint64>((number + 1) >> 1);
+        else
+            next += static_cast<qint64>(number >> 1);
+        if((next < 0) || (next > INT_MAX))
+            return (false);
+        order[i] = static_cast<int>(next);
+        next++;
+    }
+    return (true);
+}
+
+static bool decodeDelta(const QByteArray &compressed, Delta &delta)
+{
+    const QByteArray bytes = qUncompress(compressed);
+    const char      *pos   = bytes.constData();
+    const char      *end   = pos + bytes.size();
+    return (readIds(pos, end, delta.removed) && readIds(pos, end, delta.added)
+            && readOrder(pos, end, delta.order));
+}
+
+static bool readDelta(const QString &archive, Delta &delta)
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String("select listingBase, listingIds from"
+                                    " archives where name = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query) || !query.next()
+       || query.value(1).isNull())
+        return (false);
+
+    delta.base = query.value(0).toString();
+    if(!decodeDelta(query.value(1).toByteArray(), delta))
+    {
+        DEBUG << "Invalid listing ids for archive" << archive;
+        return (false);
+    }
+    return (true);
+}
+
+static bool readChain(const QString &archive, IdList &ids, int *length)
+{
+    // Read the deltas back to the start of the chain.
+    QList<Delta> chain;
+    QString      name = archive;
+    while(!name.isEmpty())
+    {
+        Delta delta;
+        if(chain.size() == MAX_DELTA_DEPTH)
+        {
+            DEBUG << "Too many listing bases for archive" << archive;
+            return (false);
+        }
+        if(!readDelta(name, delta))
+            return (false);
+        name = delta.base;
+        chain.prepend(delta);
+    }
+
+    ids.clear();
+    for(const Delta &delta : chain)
+    {
+        IdList kept;
+        std::set_difference(ids.begin(), ids.end(), delta.removed.begin(),
+                            delta.removed.end(), std::back_inserter(kept));
+        ids.clear();
+        std::set_union(kept.begin(), kept.end(), delta.added.begin(),
+                       delta.added.end(), std::back_inserter(ids));
+    }
+    if(length)
+        *length = chain.size();
+    return (true);
+}
+
+static bool writeIds(const QString &archive, const IdList &ids,
+                     const QVector<int> &order, const QString &base,
+                     const IdList &baseIds)
+{
+    // Only store the differences from the base, unless there are more
+    // differences than ids.
+    QString usedBase = base;
+    IdList  removed;
+    IdList  added;
+    if(!base.isEmpty())
+    {
+        std::set_difference(baseIds.begin(), baseIds.end(), ids.begin(),
+                            ids.end(), std::back_inserter(removed));
+        std::set_difference(ids.begin(), ids.end(), baseIds.begin(),
+                            baseIds.end(), std::back_inserter(added));
+    }
+    if(base.isEmpty() || (removed.size() + added.size() >= ids.size()))
+    {
+        usedBase.clear();
+        removed.clear();
+        added = ids;
+    }
+
+    // An archive without lines has no ids at all.
+    QByteArray encoded;
+    if(!ids.isEmpty())
+    {
+        appendIds(encoded, removed);
+        appendIds(encoded, added);
+        if(!order.isEmpty())
+            appendOrder(encoded, order);
+        encoded = qCompress(encoded);
+    }
+
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String(
+           "update archives set listingBase = ?, listingIds = ?,"
+           " contents = null where name = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(usedBase);
+    query.addBindValue(encoded);
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query))
+    {
+        DEBUG << "Failed to save the listing ids of" << archive;
+        return (false);
+    }
+    return (true);
+}
+
+template <typename Found>
+static bool readLines(const IdList &ids, const QString &column, Found found)
+{
+    QSqlQuery query = global_store->createQuery();
+    query.setForwardOnly(true);
+    if(!query.prepare(QLatin1String("select id, ") + column
+                      + QLatin1String(" from listingLines"
+                                      " where id >= ? and id <= ?"
+                                      " order by id")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+
+    int i = 0;
+    while(i < ids.size())
+    {
+        // Read the lines whose ids are close together at once.
+        int last = i;
+        while((last + 1 < ids.size())
+              && (ids.at(last + 1) - ids.at(last) <= READ_GAP))
+            last++;
+        query.bindValue(0, ids.at(i));
+        query.bindValue(1, ids.at(last));
+        if(!global_store->runQuery(query))
+            return (false);
+        while(query.next() && (i <= last))
+        {
+            // Skip the lines of other archives.
+            const qint64 id = query.value(0).toLongLong();
+            while((i <= last) && (ids.at(i) < id))
+                i++;
+            if((i <= last) && (ids.at(i) == id))
+                found(id, query.value(1).toByteArray());
+        }
+        i = last + 1;
+    }
+    return (true);
+}
+
+static bool detachListing(const QString &archive)
+{
+    // Find the archives which are relative to this one.
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(
+           QLatin1String("select name from archives where listingBase = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query))
+        return (false);
+    QStringList dependents;
+    while(query.next())
+        dependents << query.value(0).toString();
+
+    // Bail (if applicable).
+    if(dependents.isEmpty())
+        return (true);
+
+    // Make them relative to the base of this archive (if any), which
+    // keeps their chains short.
+    Delta   delta;
+    QString base;
+    IdList  baseIds;
+    if(readDelta(archive, delta))
+        base = delta.base;
+    if(!base.isEmpty() && !readChain(base, baseIds, nullptr))
+        base.clear();
+
+    bool result = true;
+    for(const QString &name : dependents)
+    {
+        // The order of their lines does not change.
+        IdList ids;
+        Delta  own;
+        if(!readChain(name, ids, nullptr) || !readDelta(name, own)
+           || !writeIds(name, ids, own.order, base, baseIds))
+        {
+            DEBUG << "Failed to detach the listing of" << name;
+            result = false;
+        }
+    }
+    return (result);
+}
+
+static bool removeArchive(const QString &archive)
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String(
+           "select rowid from archives where name = ? and exists"
+           " (select 1 from archives as dependents"
+           " where dependents.listingBase = archives.name)")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query))
+        return (false);
+
+    // Nothing is relative to this archive.
+    if(!query.next())
+    {
+        if(!query.prepare(
+               QLatin1String("delete from archives where name = ?")))
+        {
+            DEBUG << query.lastError().text();
+            return (false);
+        }
+        query.addBindValue(archive);
+        return (global_store->runQuery(query));
+    }
+
+    // The rowid keeps the new name unique, and the Job is cleared so that
+    // it is not used as a base.
+    const QString removed =
+        QLatin1String(REMOVED_PREFIX) + query.value(0).toString();
+    if(!query.prepare(QLatin1String(
+           "update archives set listingBase = ? where listingBase = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(removed);
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query))
+        return (false);
+    if(!query.prepare(QLatin1String(
+           "update archives set name = ?, jobRef = null where name = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(removed);
+    query.addBindValue(archive);
+    return (global_store->runQuery(query));
+}
+
+static bool storeListing(const QString &archive, const QByteArray &listing)
+{
+    // The archives which are relative to this one must not change.
+    if(!detachListing(archive))
+        return (false);
+
+    // Split the lines; they refer to the listing, without copying it.
+    QVector<QByteArray> lines;
+    const char         *pos = listing.constData();
+    const char         *end = pos + listing.size();
+    while(pos < end)
+    {
+        const char *newline = std::find(pos, end, '\n');
+        if(newline > pos)
+            lines.append(QByteArray::fromRawData(
+                pos, static_cast<int>(newline - pos)));
+        pos = newline + 1;
+    }
+
+    // Use the most recent other archive of the same Job as a base.
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String(
+           "select name from archives where jobRef = (select jobRef from"
+           " archives where name = ?) and jobRef != '' and name != ?"
+           " and listingIds is not null order by timestamp desc limit 1")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(archive);
+    query.addBindValue(archive);
+    QString base;
+    IdList  baseIds;
+    int     length = 0;
+    if(global_store->runQuery(query) && query.next())
+        base = query.value(0).toString();
+    if(!base.isEmpty()
+       && (!readChain(base, baseIds, &length) || (length >= MAX_DELTA_DEPTH)))
+    {
+        base.clear();
+        baseIds.clear();
+    }
+
+    // Most lines are normally in the base already.
+    QHash<QByteArray, qint64> known;
+    if(!readLines(baseIds, QLatin1String("hash"),
+                  [&known](qint64 id, const QByteArray &hash) {
+                      known.insert(hash, id);
+                  }))
+        return (false);
+    QVector<QByteArray>    hashes;
+    QHash<QByteArray, int> unknown;
+    QVector<int>           newLines;
+    hashes.reserve(lines.size());
+    for(int i = 0; i < lines.size(); i++)
+    {
+        const QByteArray hash =
+            QCryptographicHash::hash(lines.at(i), QCryptographicHash::Sha1);
+        hashes.append(hash);
+        if(!known.contains(hash) && !unknown.contains(hash))
+        {
+            unknown.insert(hash, i);
+            newLines.append(i);
+        }
+    }
+
+    if(!unknown.isEmpty())
+    {
+        // Add the lines which are not stored yet, in the order of the
+        // listing, so that their ids are normally in that order too.
+        qint64 maxId = 0;
+        if(query.prepare(QLatin1String("select max(id) from listingLines"))
+           && global_store->runQuery(query) && query.next())
+            maxId = query.value(0).toLongLong();
+        QVariantList hashValues;
+        QVariantList lineValues;
+        for(int i : newLines)
+        {
+            hashValues << hashes.at(i);
+            lineValues << lines.at(i);
+        }
+        if(!query.prepare(QLatin1String(
+               "insert or ignore into listingLines(hash, line) values(?, ?)")))
+        {
+            DEBUG << query.lastError().text();
+            return (false);
+        }
+        query.addBindValue(hashValues);
+        query.addBindValue(lineValues);
+        if(!global_store->runBatchQuery(query))
+        {
+            DEBUG << "Failed to add listing lines.";
+            return (false);
+        }
+
+        // The new lines come after all the others.
+        query = global_store->createQuery();
+        query.setForwardOnly(true);
+        if(!query.prepare(QLatin1String(
+               "select id, hash from listingLines where id > ?")))
+        {
+            DEBUG << query.lastError().text();
+            return (false);
+        }
+        query.addBindValue(maxId);
+        if(!global_store->runQuery(query))
+            return (false);
+        while(query.next())
+        {
+            const QByteArray hash = query.value(1).toByteArray();
+            if(unknown.remove(hash) > 0)
+                known.insert(hash, query.value(0).toLongLong());
+        }
+
+        // Any others were already stored for other archives.
+        if(!query.prepare(
+               QLatin1String("select id from listingLines where hash = ?")))
+        {
+            DEBUG << query.lastError().text();
+            return (false);
+        }
+        for(auto it = unknown.constBegin(); it != unknown.constEnd(); ++it)
+        {
+            query.bindValue(0, it.key());
+            if(!global_store->runQuery(query) || !query.next())
+            {
+                // The listing would be incomplete.
+                DEBUG << "Failed to find a listing line of" << archive;
+                return (false);
+            }
+            known.insert(it.key(), query.value(0).toLongLong());
+        }
+    }
+
+    // The ids are stored sorted and once each, along with the position of
+    // each line among them (unless that is the order of the ids).
+    IdList lineIds;
+    lineIds.reserve(hashes.size());
+    for(const QByteArray &hash : hashes)
+        lineIds.append(known.value(hash));
+    IdList ids = lineIds;
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    QVector<int> order;
+    bool         sorted = (ids.size() == lineIds.size());
+    order.reserve(lineIds.size());
+    for(qint64 id : lineIds)
+    {
+        const int index = static_cast<int>(
+            std::lower_bound(ids.begin(), ids.end(), id) - ids.begin());
+        sorted = sorted && (index == order.size());
+        order.append(index);
+    }
+    if(sorted)
+        order.clear();
+    return (writeIds(archive, ids, order, base, baseIds));
+}
+
+static bool saveListing(const QString &archive, const QByteArray &listing)
+{
+    // Either all of the changes are kept, or none of them.
+    if(!global_store->transaction())
+        return (false);
+    if(!storeListing(archive, listing))
+    {
+        global_store->rollback();
+        return (false);
+    }
+    return (global_store->commit());
+}
+
+bool ListingStore::save(const QString &archive, const QByteArray &listing)
+{
+    QMutexLocker locker(&writeMutex);
+    return (saveListing(archive, listing));
+}
+
+QByteArray ListingStore::load(const QString &archive)
+{
+    // Contents stored by previous versions are used as-is.
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String("select listingIds, contents from"
+                                    " archives where name = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (QByteArray());
+    }
+    query.addBindValue(archive);
+    if(!global_store->runQuery(query) || !query.next())
+        return (QByteArray());
+    if(query.value(0).isNull())
+    {
+        const QByteArray compressed = query.value(1).toByteArray();
+        if(compressed.isEmpty())
+            return (QByteArray());
+        return (qUncompress(compressed));
+    }
+
+    IdList ids;
+    Delta  delta;
+    if(!readChain(archive, ids, nullptr) || !readDelta(archive, delta))
+        return (QByteArray());
+
+    // Each distinct line is read once, then put in the order of the
+    // listing.
+    QVector<QByteArray> found(ids.size());
+    readLines(ids, QLatin1String("line"),
+              [&ids, &found](qint64 id, const QByteArray &line) {
+                  found[static_cast<int>(
+                      std::lower_bound(ids.constBegin(), ids.constEnd(), id)
+                      - ids.constBegin())] = line;
+              });
+    QByteArray text;
+    if(delta.order.isEmpty())
+    {
+        for(const QByteArray &line : found)
+            text.append(line).append('\n');
+        return (text);
+    }
+    for(int index : delta.order)
+    {
+        if(index >= found.size())
+        {
+            DEBUG << "Invalid listing order for archive" << archive;
+            return (QByteArray());
+        }
+        text.append(found.at(index)).append('\n');
+    }
+    return (text);
+}
+
+QVector<qint64> ListingStore::lineIds(const QString &archive)
+{
+    IdList ids;
+    if(!readChain(archive, ids, nullptr))
+        ids.clear();
+    return (ids);
+}
+
+QByteArray ListingStore::lines(const QVector<qint64> &ids)
+{
+    QByteArray text;
+    readLines(ids, QLatin1String("line"),
+              [&text](qint64 id, const QByteArray &line) {
+                  Q_UNUSED(id)
+                  if(!text.isEmpty())
+                      text.append('\n');
+                  text.append(line);
+              });
+    return (text);
+}
+
+QHash<qint64, QStringList>
+ListingStore::archivesWithLines(const QVector<qint64> &ids)
+{
+    QHash<qint64, QStringList> archives;
+
+    // Bail (if applicable).
+    if(ids.isEmpty())
+        return (archives);
+
+    // Read every delta once.
+    QSqlQuery query = global_store->createQuery();
+    query.setForwardOnly(true);
+    if(!query.prepare(QLatin1String("select name, listingBase, listingIds"
+                                    " from archives"
+                                    " where listingIds is not null")))
+    {
+        DEBUG << query.lastError().text();
+        return (archives);
+    }
+    if(!global_store->runQuery(query))
+        return (archives);
+    QStringList         names;
+    QVector<Delta>      deltas;
+    QHash<QString, int> indexes;
+    while(query.next())
+    {
+        const QString name = query.value(0).toString();
+        Delta         delta;
+        if(!decodeDelta(query.value(2).toByteArray(), delta))
+        {
+            DEBUG << "Invalid listing ids for archive" << name;
+            continue;
+        }
+        delta.base = query.value(1).toString();
+        indexes.insert(name, names.size());
+        names << name;
+        deltas << delta;
+    }
+
+    // Visit each base before the archives which are relative to it.
+    QVector<int> bases(names.size());
+    QVector<int> depths(names.size());
+    QVector<int> order(names.size());
+    for(int i = 0; i < names.size(); i++)
+    {
+        bases[i] = indexes.value(deltas.at(i).base, -1);
+        for(int base = bases.at(i);
+            (base != -1) && (depths.at(i) <= MAX_DELTA_DEPTH);
+            base = indexes.value(deltas.at(base).base, -1))
+            depths[i]++;
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&depths](int a, int b) {
+        return (depths.at(a) < depths.at(b));
+    });
+
+    // Removed archives are only used as bases.
+    QVector<bool> hidden(names.size());
+    for(int i = 0; i < names.size(); i++)
+        hidden[i] = names.at(i).startsWith(QLatin1String(REMOVED_PREFIX));
+
+    // An archive has a line if it added it, or if its base has it and it
+    // did not remove it.
+    QVector<bool> has(names.size());
+    for(qint64 id : ids)
+    {
+        for(int i : order)
+        {
+            const Delta &delta = deltas.at(i);
+            if(std::binary_search(delta.added.begin(), delta.added.end(), id))
+                has[i] = true;
+            else if(std::binary_search(delta.removed.begin(),
+                                       delta.removed.end(), id))
+                has[i] = false;
+            else
+                has[i] = (bases.at(i) != -1) && has.at(bases.at(i));
+            if(has.at(i) && !hidden.at(i))
+                archives[id] << names.at(i);
+        }
+    }
+    return (archives);
+}
+
+bool ListingStore::remove(const QString &archive)
+{
+    if(!global_store->transaction())
+        return (false);
+    if(!removeArchive(archive))
+    {
+        global_store->rollback();
+        return (false);
+    }
+    return (global_store->commit());
+}
+
+bool ListingStore::detachRemoved()
+{
+    QMutexLocker locker(&writeMutex);
+
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String(
+           "select name from archives where substr(name, 1, 1) = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(QLatin1String(REMOVED_PREFIX));
+    if(!global_store->runQuery(query))
+        return (false);
+    QStringList names;
+    while(query.next())
+        names << query.value(0).toString();
+
+    // Each archive is detached and deleted in a single transaction.
+    bool result = true;
+    for(const QString &name : names)
+    {
+        if(!global_store->transaction())
+            return (false);
+        if(!query.prepare(
+               QLatin1String("delete from archives where name = ?")))
+        {
+            DEBUG << query.lastError().text();
+            global_store->rollback();
+            return (false);
+        }
+        query.addBindValue(name);
+        if(!detachListing(name) || !global_store->runQuery(query))
+        {
+            DEBUG << "Failed to detach a removed listing.";
+            global_store->rollback();
+            result = false;
+            continue;
+        }
+        if(!global_store->commit())
+            result = false;
+    }
+    return (result);
+}
+
+bool ListingStore::collectGarbage()
+{
+    // The lines of removed archives are only unused once they are deleted.
+    if(!detachRemoved())
+        return (false);
+
+    QMutexLocker locker(&writeMutex);
+
+    QSqlQuery query = global_store->createQuery();
+    query.setForwardOnly(true);
+    qint64 maxId = 0;
+    if(query.prepare(QLatin1String("select max(id) from listingLines"))
+       && global_store->runQuery(query) && query.next())
+        maxId = query.value(0).toLongLong();
+
+    // Bail (if applicable).
+    if(maxId == 0)
+        return (true);
+
+    // Every id of an archive was added by it, or by one of its bases.
+    QBitArray used(static_cast<int>(maxId + 1));
+    if(!query.prepare(QLatin1String("select listingIds from archives"
+                                    " where listingIds is not null"))
+       || !global_store->runQuery(query))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    while(query.next())
+    {
+        Delta delta;
+        if(!decodeDelta(query.value(0).toByteArray(), delta))
+        {
+            // Better keep some garbage than lose lines.
+            DEBUG << "Invalid listing ids; not collecting garbage.";
+            return (false);
+        }
+        for(qint64 id : delta.added)
+        {
+            if(id <= maxId)
+                used.setBit(static_cast<int>(id));
+        }
+    }
+
+    QVariantList unused;
+    if(!query.prepare(QLatin1String("select id from listingLines"))
+       || !global_store->runQuery(query))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    while(query.next())
+    {
+        const qint64 id = query.value(0).toLongLong();
+        if((id > maxId) || !used.testBit(static_cast<int>(id)))
+            unused << id;
+    }
+    if(unused.isEmpty())
+        return (true);
+
+    if(!query.prepare(QLatin1String("delete from listingLines where id = ?")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    query.addBindValue(unused);
+    if(!global_store->runBatchQuery(query))
+    {
+        DEBUG << "Failed to remove unused listing lines.";
+        return (false);
+    }
+    return (true);
+}
+
+bool ListingStore::convertLegacyContents()
+{
+    // Archives of the same Job are converted in order, so that each one is
+    // relative to the previous one.
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare(QLatin1String(
+           "select name from archives where contents is not null"
+           " and listingIds is null order by jobRef, timestamp")))
+    {
+        DEBUG << query.lastError().text();
+        return (false);
+    }
+    if(!global_store->runQuery(query))
+        return (false);
+    QStringList names;
+    while(query.next())
+        names << query.value(0).toString();
+
+    // Bail (if applicable).
+    if(names.isEmpty())
+        return (true);
+
+    bool result = true;
+    for(const QString &name : names)
+    {
+        const QByteArray listing = load(name);
+        QMutexLocker     locker(&writeMutex);
+        if(!saveListing(name, listing))
+        {
+            DEBUG << "Failed to convert the contents of" << name;
+            result = false;
+        }
+    }
+
+    // Give the space back to the file system.
+    if(query.prepare(QLatin1String("vacuum")))
+        global_store->runQuery(query);
+    return (result);
+}
@@ -0,0 +1,70 @@
+#ifndef LISTINGSTORE_H
+#define LISTINGSTORE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+WARNINGS_ENABLE
+
+/*!
+ * \ingroup persistent
+ * \brief The ListingStore keeps the contents (i.e. the output of
+ * <tt>tarsnap -tv</tt>) of every archive, storing each distinct line once.
+ *
+ * The lines are in the \c listingLines table, addressed by their SHA-1
+ * hash.  An archive refers to the sorted ids of its lines: if there is
+ * another archive of the same Job, only the ids which differ from that
+ * archive (its \c listingBase) are stored.  Such chains are at most 16
+ * archives long, so loading a listing only reads a few rows of
+ * \c archives.  Consecutive archives of a Job are normally almost
+ * identical, so each one costs a few bytes per changed file.
+ *
+ * The position of each line among those ids is stored too (unless the
+ * lines are in the order of their ids), so a listing is loaded in its
+ * original order, with any repeated lines.
+ *
+ * Reading and writing many rows is slow, so these functions are normally
+ * called by background tasks (with a \ref StoreConnection); changes are
+ * made one at a time, each in a single transaction.
+ */
+class ListingStore
+{
+public:
+    //! Stores \c listing as the contents of \c archive, which must already
+    //! be in the \c archives table.  An empty listing removes the contents.
+    static bool save(const QString &archive, const QByteArray &listing);
+    //! Returns the contents of \c archive, in their original order, with a
+    //! newline after each line.
+    static QByteArray load(const QString &archive);
+    //! Returns the sorted ids of the lines of \c archive.
+    static QVector<qint64> lineIds(const QString &archive);
+    //! Returns the lines with the given (sorted) \c ids, separated by
+    //! newlines.
+    static QByteArray lines(const QVector<qint64> &ids);
+    //! Returns the names of the archives which contain each of the
+    //! \c ids.  Every stored listing is read, but only once.
+    static QHash<qint64, QStringList>
+    archivesWithLines(const QVector<qint64> &ids);
+
+    //! Deletes \c archive from the \c archives table.  If other archives
+    //! are relative to it, it is only renamed (which is quick), and kept
+    //! until detachRemoved().
+    static bool remove(const QString &archive);
+    //! Stores the ids of the archives which are relative to removed
+    //! archives relative to their bases instead, then deletes the removed
+    //! archives.
+    static bool detachRemoved();
+    //! Deletes the removed archives, then the lines which are not in any
+    //! archive.
+    static bool collectGarbage();
+    //! Moves the contents stored by previous versions (compressed, in
+    //! \c archives.contents) into the store.
+    static bool convertLegacyContents();
+};
+
+#endif /* !LISTINGSTORE_H */
@@ -6,16 +6,30 @@ WARNINGS_DISABLE
 #include <QFile>
 #include <QFileDevice>
 #include <QFileInfo>
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QString>
 #include <QStringList>
+#include <QList>
+#include <QThread>
 #include <QVariant>
+#include <QVariantList>
 #include <Qt>
 
 static QMutex mutex;
+
+// The connections of the threads with a StoreConnection.
+static QMutex                    connectionsMutex;
+static QHash<QThread *, QString> connections;
+static QString                   connectionsUrl;
+static int                       connectionsCount = 0;
+
+// The connections with a transaction in progress.
+static QSet<QString> transactions;
 WARNINGS_ENABLE
 
 #include "debug.h"
@@ -26,10 +40,73 @@ WARNINGS_ENABLE
 
 #define DEFAULT_DBNAME "tarsnap.db"
 
+// Number of rows which runBatchQuery() runs while holding the lock.
+#define BATCH_ROWS 1000
+
 PersistentStore *global_store = nullptr;
 
 bool PersistentStore::_initialized = false;
 
+// Returns the name of the database connection of the current thread.
+static QString threadConnection()
+{
+    QMutexLocker locker(&connectionsMutex);
+    return (connections.value(QThread::currentThread(), "tarsnap"));
+}
+
+// Returns the database connection of the current thread.
+static QSqlDatabase threadDatabase()
+{
+    return (QSqlDatabase::database(threadConnection()));
+}
+
+// Returns whether the current thread has a transaction in progress.
+static bool inTransaction()
+{
+    const QString name = threadConnection();
+    QMutexLocker  locker(&connectionsMutex);
+    return (transactions.contains(name));
+}
+
+// Runs a batch query, and commits it unless the current thread has a
+// transaction in progress.
+static bool runBatchChunk(QSqlQuery &query)
+{
+    QMutexLocker locker(&mutex);
+
+    // The rows are committed with the rest of the transaction.
+    if(inTransaction())
+    {
+        if(!query.execBatch())
+        {
+            DEBUG << query.lastError().text();
+            return (false);
+        }
+        return (true);
+    }
+
+    // Without a transaction, SQLite syncs the file after every row.
+    QSqlDatabase db = threadDatabase();
+    if(!db.transaction())
+    {
+        DEBUG << db.lastError().text();
+        return (false);
+    }
+    if(!query.execBatch())
+    {
+        DEBUG << query.lastError().text();
+        db.rollback();
+        return (false);
+    }
+    if(!db.commit())
+    {
+        DEBUG << db.lastError().text();
+        db.rollback();
+        return (false);
+    }
+    return (true);
+}
+
 void PersistentStore::initializePersistentStore()
 {
     if(global_store == nullptr)
@@ -149,6 +226,15 @@ bool PersistentStore::init()
             return (false);
         }
     }
+
+    // Let the StoreConnections read while another connection writes.
+    QSqlQuery query(db);
+    if(!query.exec("PRAGMA journal_mode = WAL"))
+        DEBUG << query.lastError().text();
+    {
+        QMutexLocker connectionsLocker(&connectionsMutex);
+        connectionsUrl = dbUrl;
+    }
     return (_initialized = true);
 }
 
@@ -161,13 +247,16 @@ void PersistentStore::deinit()
         QSqlDatabase::removeDatabase("tarsnap");
         _initialized = false;
     }
+    QMutexLocker connectionsLocker(&connectionsMutex);
+    connectionsUrl.clear();
+    transactions.remove("tarsnap");
 }
 
 QSqlQuery PersistentStore::createQuery()
 {
     if(_initialized)
     {
-        QSqlDatabase db = QSqlDatabase::database("tarsnap");
+        QSqlDatabase db = threadDatabase();
         return (QSqlQuery(db));
     }
     else
@@ -192,6 +281,9 @@ void PersistentStore::purge()
             dbFile.remove();
         else
             DEBUG << "DB file not accessible: " << dbUrl;
+        // The write-ahead log goes with the database.
+        QFile::remove(dbUrl + "-wal");
+        QFile::remove(dbUrl + "-shm");
     }
     else
     {
@@ -218,3 +310,131 @@ bool PersistentStore::runQuery(QSqlQuery query)
 
     return (result);
 }
+
+bool PersistentStore::runBatchQuery(QSqlQuery query)
+{
+    // Bail (if applicable).
+    if(!_initialized)
+    {
+        DEBUG << "DB not initialized.";
+        return (false);
+    }
+
+    // Run the rows in chunks, so that other threads can use the store in
+    // between.
+    QList<QVariantList> columns;
+    for(int i = 0; i < query.boundValues().size(); i++)
+        columns << query.boundValue(i).toList();
+    const int rows = columns.isEmpty() ? 0 : columns.first().size();
+    for(int first = 0; first < rows; first += BATCH_ROWS)
+    {
+        for(int i = 0; i < columns.size(); i++)
+            query.bindValue(i, columns.at(i).mid(first, BATCH_ROWS));
+        if(!runBatchChunk(query))
+            return (false);
+    }
+    return (true);
+}
+
+bool PersistentStore::transaction()
+{
+    QMutexLocker locker(&mutex);
+
+    // Bail (if applicable).
+    if(!_initialized)
+    {
+        DEBUG << "DB not initialized.";
+        return (false);
+    }
+    if(inTransaction())
+    {
+        DEBUG << "A transaction is already in progress.";
+        return (false);
+    }
+
+    QSqlDatabase db = threadDatabase();
+    if(!db.transaction())
+    {
+        DEBUG << db.lastError().text();
+        return (false);
+    }
+    QMutexLocker connectionsLocker(&connectionsMutex);
+    transactions.insert(db.connectionName());
+    return (true);
+}
+
+bool PersistentStore::commit()
+{
+    QMutexLocker locker(&mutex);
+
+    // Bail (if applicable).
+    if(!_initialized || !inTransaction())
+    {
+        DEBUG << "No transaction in progress.";
+        return (false);
+    }
+
+    QSqlDatabase db     = threadDatabase();
+    const bool   result = db.commit();
+    if(!result)
+    {
+        DEBUG << db.lastError().text();
+        db.rollback();
+    }
+    QMutexLocker connectionsLocker(&connectionsMutex);
+    transactions.remove(db.connectionName());
+    return (result);
+}
+
+void PersistentStore::rollback()
+{
+    QMutexLocker locker(&mutex);
+
+    // Bail (if applicable).
+    if(!_initialized || !inTransaction())
+    {
+        DEBUG << "No transaction in progress.";
+        return;
+    }
+
+    QSqlDatabase db = threadDatabase();
+    if(!db.rollback())
+        DEBUG << db.lastError().text();
+    QMutexLocker connectionsLocker(&connectionsMutex);
+    transactions.remove(db.connectionName());
+}
+
+StoreConnection::StoreConnection()
+{
+    QMutexLocker locker(&connectionsMutex);
+
+    // Bail (if applicable).
+    if(connectionsUrl.isEmpty())
+    {
+        DEBUG << "PersistentStore not initialized.";
+        return;
+    }
+
+    _name = QString("tarsnap-%1").arg(++connectionsCount);
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", _name);
+    db.setConnectOptions("QSQLITE_OPEN_URI");
+    db.setDatabaseName(connectionsUrl);
+    if(!db.open())
+        DEBUG << "Error opening the PersistentStore DB: "
+              << db.lastError().text();
+    connections.insert(QThread::currentThread(), _name);
+}
+
+StoreConnection::~StoreConnection()
+{
+    // Bail (if applicable).
+    if(_name.isEmpty())
+        return;
+
+    {
+        QMutexLocker locker(&connectionsMutex);
+        connections.remove(QThread::currentThread());
+        transactions.remove(_name);
+    }
+    QSqlDatabase::removeDatabase(_name);
+}
@@ -6,6 +6,7 @@
 WARNINGS_DISABLE
 #include <QObject>
 #include <QSqlQuery>
+#include <QString>
 WARNINGS_ENABLE
 
 /* Set up global PersistentStore. */
@@ -35,7 +36,8 @@ public:
     bool initialized() { return _initialized; }
 
     //! Returns an empty query attached to the database if it is initialized,
-    //! or an unattached query otherwise.
+    //! or an unattached query otherwise.  In a thread with a
+    //! StoreConnection, the query uses that connection.
     QSqlQuery createQuery();
     //! Removes the existing database if it is initialized.  Does not lock.
     void purge();
@@ -50,9 +52,44 @@ public:
 public slots:
     //! Locks the database and runs a query.
     bool runQuery(QSqlQuery query);
+    //! Runs a query once for each row of its bound QVariantLists (see
+    //! QSqlQuery::execBatch()).  The rows are run (and committed, unless the
+    //! current thread has a transaction in progress) in chunks, locking the
+    //! database for each of them.
+    bool runBatchQuery(QSqlQuery query);
+    //! Starts a transaction on the connection of the current thread; the
+    //! queries which follow are only kept if commit() succeeds.
+    bool transaction();
+    //! Commits the transaction of the current thread, or discards it if
+    //! that fails.
+    bool commit();
+    //! Discards the transaction of the current thread.
+    void rollback();
 
 private:
     static bool _initialized;
 };
 
+/*!
+ * \ingroup persistent
+ * \brief A StoreConnection lets a background task use the PersistentStore.
+ *
+ * A database connection can only be used by the thread which opened it, so
+ * while a StoreConnection exists, the queries of its thread use a
+ * connection of their own.  Create one at the start of \c run().
+ */
+class StoreConnection
+{
+public:
+    //! Opens a connection for the current thread.
+    StoreConnection();
+    //! Closes the connection.
+    ~StoreConnection();
+
+private:
+    QString _name;
+
+    Q_DISABLE_COPY(StoreConnection)
+};
+
 #endif // PERSISTENTSTORE_H
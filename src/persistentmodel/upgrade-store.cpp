@@ -19,6 +19,9 @@ static bool upgradeVersion1();
 static bool upgradeVersion2();
 static bool upgradeVersion3();
 static bool upgradeVersion4();
+static bool upgradeVersion5();
+static bool upgradeVersion6();
+static bool upgradeVersion7();
 
 bool upgrade_store(QSqlDatabase db, const QString &appdata)
 {
@@ -68,6 +71,21 @@ bool upgrade_store(QSqlDatabase db, const QString &appdata)
         DEBUG << "DB upgraded to version 4.";
         version = 4;
     }
+    if((version == 4) && upgradeVersion5())
+    {
+        DEBUG << "DB upgraded to version 5.";
+        version = 5;
+    }
+    if((version == 5) && upgradeVersion6())
+    {
+        DEBUG << "DB upgraded to version 6.";
+        version = 6;
+    }
+    if((version == 6) && upgradeVersion7())
+    {
+        DEBUG << "DB upgraded to version 7.";
+        version = 7;
+    }
     (void)version; /* not used beyond this point. */
     return (true);
 }
@@ -176,4 +194,61 @@ static bool upgradeVersion4()
     }
     return (result);
 }
+
+static bool upgradeVersion5()
+{
+    bool      result = false;
+    QSqlDatabase db = QSqlDatabase::database("tarsnap");
+    QSqlQuery query(db);
+
+    if((result = query.exec("ALTER TABLE jobs ADD COLUMN lastBackupFingerprint TEXT;")))
+        result = query.exec("UPDATE version SET version = 5;");
+
+    if(!result)
+    {
+        DEBUG << query.lastError().text();
+        DEBUG << "Failed to upgrade DB to version 5." << db.databaseName();
+    }
+    return (result);
+}
+
+static bool upgradeVersion6()
+{
+    bool      result = false;
+    QSqlDatabase db = QSqlDatabase::database("tarsnap");
+    QSqlQuery query(db);
+
+    if((result = query.exec("CREATE TABLE filePaths (id INTEGER PRIMARY KEY, path TEXT NOT NULL UNIQUE);")))
+    if((result = query.exec("CREATE TABLE fileLines (lineRef INTEGER PRIMARY KEY, pathRef INTEGER, FOREIGN KEY(lineRef) REFERENCES listingLines(id), FOREIGN KEY(pathRef) REFERENCES filePaths(id));")))
+    if((result = query.exec("CREATE INDEX fileLinesPath ON fileLines (pathRef);")))
+        result = query.exec("UPDATE version SET version = 6;");
+
+    if(!result)
+    {
+        DEBUG << query.lastError().text();
+        DEBUG << "Failed to upgrade DB to version 6." << db.databaseName();
+    }
+    return (result);
+}
+
+static bool upgradeVersion7()
+{
+    bool      result = false;
+    QSqlDatabase db = QSqlDatabase::database("tarsnap");
+    QSqlQuery query(db);
+
+    if((result = query.exec("ALTER TABLE archives ADD COLUMN listingBase TEXT;")))
+    if((result = query.exec("ALTER TABLE archives ADD COLUMN listingIds BLOB;")))
+    if((result = query.exec("CREATE TABLE listingLines (id INTEGER PRIMARY KEY, hash BLOB NOT NULL UNIQUE, line BLOB NOT NULL);")))
+    if((result = query.exec("CREATE INDEX archivesListingBase ON archives (listingBase);")))
+    if((result = query.exec("CREATE TRIGGER listingLinesDelete AFTER DELETE ON listingLines BEGIN DELETE FROM fileLines WHERE lineRef = old.id; END;")))
+        result = query.exec("UPDATE version SET version = 7;");
+
+    if(!result)
+    {
+        DEBUG << query.lastError().text();
+        DEBUG << "Failed to upgrade DB to version 7." << db.databaseName();
+    }
+    return (result);
+}
 /* clang-format on */
@@ -0,0 +1,91 @@
+#include "prefixtrie.h"
+
+PrefixTrie::PrefixTrie() : _root(new Node)
+{
+    _root->parent = nullptr;
+    _root->stored = false;
+}
+
+PrefixTrie::~PrefixTrie()
+{
+    deleteChildren(_root);
+    delete _root;
+}
+
+void PrefixTrie::insert(const QString &prefix, const QString &value)
+{
+    Node *node = _root;
+    for(const QChar c : prefix)
+    {
+        Node *child = node->children.value(c, nullptr);
+        if(child == nullptr)
+        {
+            child         = new Node;
+            child->parent = node;
+            child->c      = c;
+            child->stored = false;
+            node->children.insert(c, child);
+        }
+        node = child;
+    }
+    node->value  = value;
+    node->stored = true;
+}
+
+void PrefixTrie::remove(const QString &prefix)
+{
+    Node *node = _root;
+    for(const QChar c : prefix)
+    {
+        node = node->children.value(c, nullptr);
+        // Bail (if applicable).
+        if(node == nullptr)
+            return;
+    }
+    node->value.clear();
+    node->stored = false;
+    prune(node);
+}
+
+QString PrefixTrie::longestPrefixValue(const QString &text) const
+{
+    const Node *node  = _root;
+    const Node *found = _root->stored ? _root : nullptr;
+    for(const QChar c : text)
+    {
+        node = node->children.value(c, nullptr);
+        if(node == nullptr)
+            break;
+        if(node->stored)
+            found = node;
+    }
+    return ((found != nullptr) ? found->value : QString());
+}
+
+void PrefixTrie::clear()
+{
+    deleteChildren(_root);
+    _root->value.clear();
+    _root->stored = false;
+}
+
+void PrefixTrie::prune(Node *node)
+{
+    while((node != _root) && !node->stored && node->children.isEmpty())
+    {
+        Node *parent = node->parent;
+        parent->children.remove(node->c);
+        delete node;
+        node = parent;
+    }
+}
+
+void PrefixTrie::deleteChildren(Node *node)
+{
+    for(Node *child : node->children)
+    {
+        deleteChildren(child);
+        delete child;
+    }
+    node->children.clear();
+}
@@ -0,0 +1,59 @@
+#ifndef PREFIXTRIE_H
+#define PREFIXTRIE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QChar>
+#include <QHash>
+#include <QString>
+WARNINGS_ENABLE
+
+/*!
+ * \ingroup misc
+ * \brief The PrefixTrie is a trie of prefixes (each with a value) which
+ * finds the longest prefix of a string.
+ *
+ * Every query and update is O(length of the string), regardless of the
+ * number of prefixes.
+ */
+class PrefixTrie
+{
+public:
+    //! Constructor.
+    PrefixTrie();
+    ~PrefixTrie();
+
+    //! Stores the prefix, replacing its previous value (if any).
+    void insert(const QString &prefix, const QString &value);
+    //! Removes the prefix (if it was stored).
+    void remove(const QString &prefix);
+
+    //! Returns the value of the longest stored prefix of \c text, or a null
+    //! QString if no stored prefix matches.
+    QString longestPrefixValue(const QString &text) const;
+
+    //! Removes all prefixes.
+    void clear();
+
+private:
+    Q_DISABLE_COPY(PrefixTrie)
+
+    struct Node
+    {
+        Node                *parent;
+        QChar                c;
+        QHash<QChar, Node *> children;
+        QString              value;
+        bool                 stored;
+    };
+
+    Node *_root;
+
+    // Removes unused nodes, starting at node and moving upwards.
+    void prune(Node *node);
+
+    void deleteChildren(Node *node);
+};
+
+#endif /* !PREFIXTRIE_H */
@@ -10,9 +10,11 @@ WARNINGS_DISABLE
 #include <QMetaType>
 #include <QStringList>
 #include <QVariant>
+#include <QVector>
 #include <Qt>
 WARNINGS_ENABLE
 
+#include "ByteScan.h"
 #include "TSettings.h"
 
 #include "messages/archiverestoreoptions.h"
@@ -21,10 +23,12 @@ WARNINGS_ENABLE
 #include "backuptask.h"
 #include "basetask.h"
 #include "cmdlinetask.h"
-#include "compat.h"
 #include "debug.h"
+#include "filehistorytask.h"
+#include "fingerprinttask.h"
 #include "humanbytes.h"
 #include "jobrunner.h"
+#include "listingtask.h"
 #include "persistentmodel/archive.h"
 #include "persistentmodel/job.h"
 #include "taskqueuer.h"
@@ -36,6 +40,9 @@ WARNINGS_ENABLE
 
 #define SUCCESS 0
 
+// Maximum number of file versions returned by a search.
+#define FILE_VERSIONS_LIMIT 1000
+
 Q_DECLARE_METATYPE(CmdlineTask *)
 
 TaskManager::TaskManager() : _tq(new TaskQueuer()), _bd(new BackendData())
@@ -154,14 +161,83 @@ void TaskManager::backupNow(const BackupTaskDataPtr &backupTaskData)
     _tq->queueTask(backupTask, true, true);
 }
 
+void TaskManager::estimateUpload(const JobPtr &job)
+{
+    if(!job)
+    {
+        DEBUG << "Null JobPtr passed.";
+        return;
+    }
+
+    // The ChangeTracker clears the estimate as soon as anything changes.
+    // It starts the first time that an estimate is needed, and is only
+    // used once it watches the whole tree.
+    job->startChangeTracking();
+    if(job->isChangeTracking())
+    {
+        if(job->hasUploadEstimate())
+            reportUploadEstimate(job);
+        else
+            queueUploadEstimate(job, QString());
+        return;
+    }
+
+    // Otherwise, compare file sizes and modification times.  This reads
+    // the whole tree, so it can't happen in this thread.
+    FingerprintTask *fingerprintTask = new FingerprintTask(job);
+    connect(fingerprintTask, &FingerprintTask::result, this,
+            [this, job](const QString &fingerprint) {
+                if(job->hasUploadEstimate()
+                   && (fingerprint == job->uploadEstimateFingerprint()))
+                    reportUploadEstimate(job);
+                else
+                    queueUploadEstimate(job, fingerprint);
+            },
+            Qt::QueuedConnection);
+    _tq->queueTask(fingerprintTask);
+}
+
+void TaskManager::queueUploadEstimate(const JobPtr  &job,
+                                      const QString &fingerprint)
+{
+    // The fingerprint is taken before the --dry-run, so that later changes
+    // make the estimate stale.
+    BackupTaskDataPtr backupTaskData =
+        BackupTaskData::createBackupTaskFromJob(job);
+    backupTaskData->setOptionDryRun(true);
+    backupTaskData->setJobFingerprint(fingerprint);
+
+    CmdlineTask *estimateTask = backupArchiveTask(backupTaskData);
+    estimateTask->setData(QVariant::fromValue(backupTaskData));
+    connect(estimateTask, &CmdlineTask::finished, this,
+            &TaskManager::estimateUploadFinished);
+    connect(estimateTask, &CmdlineTask::started, this, [this, job]() {
+        emit message(tr("Estimating the upload size of Job <i>%1</i>...")
+                         .arg(job->name()));
+    });
+    // This reads the tarsnap cache, so it can't run alongside a backup.
+    _tq->queueTask(estimateTask, true);
+}
+
+void TaskManager::reportUploadEstimate(const JobPtr &job)
+{
+    emit message(tr("Backup of Job <i>%1</i> would add %2 of new data.")
+                     .arg(job->name())
+                     .arg(humanBytes(job->uploadEstimate())));
+}
+
 void TaskManager::getArchives()
 {
     CmdlineTask *listTask = listArchivesTask();
     listTask->setTruncateLogOutput(true);
+    listTask->setStreamStdOut();
+    connect(listTask, &CmdlineTask::stdOutLines, this,
+            &TaskManager::getArchiveListLines);
     connect(listTask, &CmdlineTask::finished, this,
             &TaskManager::getArchiveListFinished);
     connect(listTask, &CmdlineTask::started, this, [this]() {
         emit message(tr("Updating archives list from remote..."));
+        _bd->beginArchivesFromList();
     });
     _tq->queueTask(listTask);
 }
@@ -170,9 +246,19 @@ void TaskManager::loadArchives()
 {
     if(!_bd->loadArchives())
         return;
-    QList<ArchivePtr> archives = _bd->archives().values();
-    // Send update.
-    emit archiveList(archives);
+    // Finish removing the archives which were purged before the last exit.
+    _tq->queueTask(new ListingTask(ListingTask::DetachRemoved));
+    // Move contents which were fetched before the ListingStore existed,
+    // then index the lines which were stored before the FileHistory
+    // existed.
+    ListingTask *convertTask =
+        new ListingTask(ListingTask::ConvertLegacyContents);
+    connect(convertTask, &ListingTask::result, this,
+            [this]() { _tq->queueTask(new FileHistoryTask()); },
+            Qt::QueuedConnection);
+    _tq->queueTask(convertTask);
+    // Send a snapshot, since the receivers might not have seen the changes.
+    emit archiveChanges(_bd->archiveSnapshot());
 }
 
 void TaskManager::getArchiveStats(const ArchivePtr &archive)
@@ -309,15 +395,42 @@ void TaskManager::findMatchingArchives(const QString &jobPrefix)
     emit matchingArchives(matching);
 }
 
+void TaskManager::findFileVersions(const QString &pattern)
+{
+    // Finding the archives of each version reads every stored listing.
+    FileHistoryTask *historyTask =
+        new FileHistoryTask(pattern, FILE_VERSIONS_LIMIT);
+    // Send response.
+    connect(historyTask, &FileHistoryTask::result, this,
+            &TaskManager::fileVersions, Qt::QueuedConnection);
+    _tq->queueTask(historyTask);
+}
+
 void TaskManager::runScheduledJobs()
 {
+    // Jobs need to know their archives to decide whether they can be skipped.
+    _bd->loadArchives();
     loadJobs();
-    JobRunner jr;
-    connect(&jr, &JobRunner::message, this, &TaskManager::message);
-    connect(&jr, &JobRunner::displayNotification, this,
+    JobRunner *jr = new JobRunner();
+    connect(jr, &JobRunner::message, this, &TaskManager::message);
+    connect(jr, &JobRunner::displayNotification, this,
             &TaskManager::displayNotification);
-    connect(&jr, &JobRunner::backup, this, &TaskManager::backupNow);
-    jr.runScheduledJobs(_bd->jobs());
+    connect(jr, &JobRunner::backup, this, &TaskManager::backupNow);
+    connect(jr, &JobRunner::fingerprintRequested, this,
+            [this, jr](const JobPtr &job) {
+                FingerprintTask *fingerprintTask = new FingerprintTask(job);
+                connect(fingerprintTask, &FingerprintTask::result, jr,
+                        [jr, job](const QString &fingerprint) {
+                            jr->fingerprintFinished(job, fingerprint);
+                        },
+                        Qt::QueuedConnection);
+                connect(fingerprintTask, &BaseTask::canceled, jr,
+                        [jr, job]() { jr->fingerprintFinished(job, ""); },
+                        Qt::QueuedConnection);
+                _tq->queueTask(fingerprintTask);
+            });
+    connect(jr, &JobRunner::finished, jr, &QObject::deleteLater);
+    jr->runScheduledJobs(_bd->jobs());
 }
 
 void TaskManager::stopTasks(bool interrupt, bool running, bool queued)
@@ -326,8 +439,8 @@ void TaskManager::stopTasks(bool interrupt, bool running, bool queued)
 }
 
 void TaskManager::backupTaskFinished(const QVariant &data, int exitCode,
-                                     const QString &stdOut,
-                                     const QString &stdErr)
+                                     const TaskOutput &stdOut,
+                                     const TaskOutput &stdErr)
 {
     BackupTaskDataPtr backupTaskData = qvariant_cast<BackupTaskDataPtr>(data);
     if(!backupTaskData)
@@ -335,18 +448,24 @@ void TaskManager::backupTaskFinished(const QVariant &data, int exitCode,
         DEBUG << "Task not found: " << data.toUuid();
         return;
     }
+    const QString errors = stdErr.toString();
     backupTaskData->setExitCode(exitCode);
-    backupTaskData->setOutput(stdOut + stdErr);
+    backupTaskData->setOutput(stdOut.toString() + errors);
     bool truncated = false;
     if(exitCode != SUCCESS)
     {
         int lastIndex =
-            stdErr.lastIndexOf(QLatin1String("tarsnap: Archive truncated"), -1,
+            errors.lastIndexOf(QLatin1String("tarsnap: Archive truncated"), -1,
                                Qt::CaseSensitive);
+        // The next backup of this Job cannot skip anything.
+        JobPtr job = _bd->jobs().value(backupTaskData->jobRef());
+        if(job && !backupTaskData->optionDryRun())
+            job->markAllChanged();
+
         if(lastIndex == -1)
         {
             notifyBackupTaskUpdate(backupTaskData, TaskStatus::Failed);
-            parseError(stdErr);
+            parseError(errors);
             return;
         }
         else
@@ -356,7 +475,7 @@ void TaskManager::backupTaskFinished(const QVariant &data, int exitCode,
     }
 
     ArchivePtr archive = _bd->newArchive(backupTaskData, truncated);
-    parseArchiveStats(stdErr, true, archive);
+    parseArchiveStats(stdErr.bytes(), true, archive);
     // This needs the archive stats.
     notifyBackupTaskUpdate(backupTaskData, TaskStatus::Completed);
 
@@ -367,20 +486,85 @@ void TaskManager::backupTaskFinished(const QVariant &data, int exitCode,
     // Write the Archive data to the PersistentStore.
     archive->save();
 
-    emit archiveAdded(archive);
+    // The new data is in the tarsnap cache now.
+    JobPtr job = _bd->jobs().value(backupTaskData->jobRef());
+    if(job)
+        job->clearUploadEstimate();
+
+    // Remember what the Job looked like for scheduled backups.
+    if(!truncated && !backupTaskData->jobFingerprint().isEmpty())
+    {
+        if(job)
+        {
+            job->setLastBackupFingerprint(backupTaskData->jobFingerprint());
+            job->save();
+        }
+    }
 
-    parseGlobalStats(stdErr);
+    notifyArchiveChanges();
+
+    parseGlobalStats(stdErr.bytes());
 }
 
 void TaskManager::backupTaskStarted(const QVariant &data)
 {
     BackupTaskDataPtr backupTaskData = qvariant_cast<BackupTaskDataPtr>(data);
     notifyBackupTaskUpdate(backupTaskData, TaskStatus::Running);
+
+    // Changes from now on belong to the next backup of this Job.
+    if(backupTaskData && !backupTaskData->optionDryRun())
+    {
+        JobPtr job = _bd->jobs().value(backupTaskData->jobRef());
+        if(job)
+            job->resetChanges();
+    }
+}
+
+void TaskManager::estimateUploadFinished(const QVariant &data, int exitCode,
+                                         const TaskOutput &stdOut,
+                                         const TaskOutput &stdErr)
+{
+    Q_UNUSED(stdOut)
+
+    BackupTaskDataPtr backupTaskData = qvariant_cast<BackupTaskDataPtr>(data);
+    if(!backupTaskData)
+    {
+        DEBUG << "Task not found: " << data.toUuid();
+        return;
+    }
+    JobPtr job = _bd->jobs().value(backupTaskData->jobRef());
+    if(!job)
+    {
+        DEBUG << "Job not found: " << backupTaskData->jobRef();
+        return;
+    }
+
+    const QString errors = stdErr.toString();
+    if(exitCode != SUCCESS)
+    {
+        emit message(tr("Estimating the upload size of Job <i>%1</i> failed.")
+                         .arg(job->name()));
+        parseError(errors);
+        return;
+    }
+
+    // The "New data" line is what a real backup would upload.
+    struct tarsnap_stats stats =
+        printStatsTaskParse(stdErr.bytes(), true, backupTaskData->name());
+    if(stats.parse_error)
+    {
+        DEBUG << "Malformed output from tarsnap CLI:\n" << errors;
+        return;
+    }
+
+    job->setUploadEstimate(stats.unique_compressed,
+                           backupTaskData->jobFingerprint());
+    reportUploadEstimate(job);
 }
 
 void TaskManager::registerMachineFinished(const QVariant &data, int exitCode,
-                                          const QString &stdOut,
-                                          const QString &stdErr)
+                                          const TaskOutput &stdOut,
+                                          const TaskOutput &stdErr)
 {
     // Retrieved the stored ("second") task.
     CmdlineTask *nextTask = data.value<CmdlineTask *>();
@@ -400,7 +584,7 @@ void TaskManager::registerMachineFinished(const QVariant &data, int exitCode,
                 err = "Crash occurred in the command-line program";
         }
         else
-            err = stdErr;
+            err = stdErr.toString();
 
         // Clean up second task (if applicable).
         delete nextTask;
@@ -421,14 +605,48 @@ void TaskManager::registerMachineFinished(const QVariant &data, int exitCode,
     }
 
     // We finished successfully
-    emit registerMachineDone(TaskStatus::Completed, stdOut);
+    emit registerMachineDone(TaskStatus::Completed, stdOut.toString());
+}
+
+void TaskManager::getArchiveListLines(const QVariant &data,
+                                      const QByteArray &lines)
+{
+    Q_UNUSED(data)
+
+    QList<struct archive_list_data> metadatas = listArchivesTaskParse(lines);
+
+    // Add or replace archives; removals wait until the list is complete.
+    QList<ArchivePtr> newArchives = _bd->addArchivesFromList(metadatas);
+
+    // Notify about new archives.
+    notifyArchiveChanges();
+
+    // Update stats.
+    for(const ArchivePtr &archive : newArchives)
+        getArchiveStats(archive);
 }
 
 void TaskManager::getArchiveListFinished(const QVariant &data, int exitCode,
-                                         const QString &stdOut,
-                                         const QString &stdErr)
+                                         const TaskOutput &stdOut,
+                                         const TaskOutput &stdErr)
 {
     Q_UNUSED(data)
+    // The output was passed to getArchiveListLines() as it arrived.
+    Q_UNUSED(stdOut)
+
+    // Archives which are not on the remote are only removed if we received
+    // the whole list.  There was no list if the process did not start.
+    if((exitCode != EXIT_CMD_NOT_FOUND) && (exitCode != EXIT_DID_NOT_START))
+    {
+        // Drop the listing lines which only the purged archives had.
+        // Archives which were replaced by others of the same name still
+        // have to be detached.
+        if(!_bd->endArchivesFromList(exitCode == SUCCESS).isEmpty())
+            _tq->queueTask(new ListingTask(ListingTask::CollectGarbage));
+        else
+            _tq->queueTask(new ListingTask(ListingTask::DetachRemoved));
+        notifyArchiveChanges();
+    }
 
     if(exitCode == SUCCESS)
     {
@@ -437,28 +655,17 @@ void TaskManager::getArchiveListFinished(const QVariant &data, int exitCode,
     else
     {
         emit message(tr("Error: Failed to list archives from remote."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         return;
     }
 
-    QList<struct archive_list_data> metadatas = listArchivesTaskParse(stdOut);
-
-    // Create & fill next archive list
-    QList<ArchivePtr> newArchives = _bd->setArchivesFromList(metadatas);
-
-    // Notify about new archives.
-    for(const ArchivePtr &archive : newArchives)
-        emit archiveAdded(archive);
-
     // Update stats.
-    for(const ArchivePtr &archive : newArchives)
-        getArchiveStats(archive);
     getOverallStats();
 }
 
 void TaskManager::getArchiveStatsFinished(const QVariant &data, int exitCode,
-                                          const QString &stdOut,
-                                          const QString &stdErr)
+                                          const TaskOutput &stdOut,
+                                          const TaskOutput &stdErr)
 {
     ArchivePtr archive = data.value<ArchivePtr>();
     if(!archive)
@@ -474,20 +681,21 @@ void TaskManager::getArchiveStatsFinished(const QVariant &data, int exitCode,
     else
     {
         emit message(tr("Error: Failed to get archive stats from remote."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         return;
     }
 
-    parseArchiveStats(stdOut, false, archive);
+    const QByteArray output = stdOut.bytes();
+    parseArchiveStats(output, false, archive);
     // Write the Archive data to the PersistentStore.
     archive->save();
 
-    parseGlobalStats(stdOut);
+    parseGlobalStats(output);
 }
 
 void TaskManager::getArchiveContentsFinished(const QVariant &data, int exitCode,
-                                             const QString &stdOut,
-                                             const QString &stdErr)
+                                             const TaskOutput &stdOut,
+                                             const TaskOutput &stdErr)
 {
     ArchivePtr archive = data.value<ArchivePtr>();
 
@@ -497,20 +705,27 @@ void TaskManager::getArchiveContentsFinished(const QVariant &data, int exitCode,
         return;
     }
 
+    if(exitCode == EXIT_OUTPUT_TOO_LARGE)
+    {
+        emit message(tr("Error: The contents of archive <i>%1</i> are too"
+                        " large (over 2 GB) to be displayed.")
+                         .arg(archive->name()));
+        return;
+    }
     if(exitCode != SUCCESS)
     {
-        bool truncated = stdErr.contains(QLatin1String("tarsnap: Truncated"
-                                                       " input file"));
+        bool truncated =
+            stdErr.bytes().contains("tarsnap: Truncated input file");
         if(archive->name().endsWith(".part", Qt::CaseSensitive) && truncated)
         {
             archive->setTruncated(true);
-            archive->setTruncatedInfo(stdErr);
+            archive->setTruncatedInfo(stdErr.toString());
         }
         else if(stdOut.isEmpty())
         {
             emit message(
                 tr("Error: Failed to get archive contents from remote."));
-            parseError(stdErr);
+            parseError(stdErr.toString());
             return;
         }
     }
@@ -518,13 +733,28 @@ void TaskManager::getArchiveContentsFinished(const QVariant &data, int exitCode,
     emit message(tr("Fetching contents for archive <i>%1</i>... done.")
                      .arg(archive->name()));
 
-    archive->setContents(stdOut);
-    archive->save();
+    // The listing is stored as-is, without decoding it.
+    ListingTask *saveTask = new ListingTask(archive->name(), stdOut);
+    const bool   empty    = stdOut.isEmpty();
+    connect(saveTask, &ListingTask::result, this,
+            [this, archive, empty](bool ok) {
+                if(!ok)
+                    emit message(tr("Error: Failed to store the contents of"
+                                    " archive <i>%1</i>.")
+                                     .arg(archive->name()));
+                archive->setHasContents(ok && !empty);
+                archive->save();
+                // Only the lines which no other archive has are indexed.
+                if(ok)
+                    _tq->queueTask(new FileHistoryTask());
+            },
+            Qt::QueuedConnection);
+    _tq->queueTask(saveTask);
 }
 
 void TaskManager::deleteArchivesFinished(const QVariant &data, int exitCode,
-                                         const QString &stdOut,
-                                         const QString &stdErr)
+                                         const TaskOutput &stdOut,
+                                         const TaskOutput &stdErr)
 {
     Q_UNUSED(stdOut)
     QList<ArchivePtr> archives = data.value<QList<ArchivePtr>>();
@@ -532,7 +762,7 @@ void TaskManager::deleteArchivesFinished(const QVariant &data, int exitCode,
     if(exitCode != SUCCESS)
     {
         emit message(tr("Error: Failed to delete archive(s) from remote."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         for(const ArchivePtr &archive : archives)
             archive->setDeleteScheduled(false);
         return;
@@ -541,36 +771,43 @@ void TaskManager::deleteArchivesFinished(const QVariant &data, int exitCode,
     if(!archives.empty())
     {
         _bd->removeArchives(archives);
+        _tq->queueTask(new ListingTask(ListingTask::CollectGarbage));
+        notifyArchiveChanges();
         notifyArchivesDeleted(archives, true);
     }
     // We are only interested in the output of the last archive deleted for
     // parsing the final global stats
-    QStringList lines = stdErr.split('\n', SKIP_EMPTY_PARTS);
-    QStringList lastFive;
-    int         count = lines.count();
-    for(int i = 0; i < qMin(5, count); ++i)
-        lastFive.prepend(lines.takeLast());
-    parseGlobalStats(lastFive.join('\n'));
+    const QByteArray               errors = stdErr.bytes();
+    const QVector<ByteScan::Range> lines  = ByteScan::splitLines(errors);
+    QByteArray                     lastFive;
+    if(!lines.isEmpty())
+    {
+        const char *start = lines[qMax(0, lines.count() - 5)].begin;
+        const char *end   = lines.last().end;
+        lastFive          = QByteArray(start, static_cast<int>(end - start));
+    }
+    parseGlobalStats(lastFive);
 }
 
 void TaskManager::overallStatsFinished(const QVariant &data, int exitCode,
-                                       const QString &stdOut,
-                                       const QString &stdErr)
+                                       const TaskOutput &stdOut,
+                                       const TaskOutput &stdErr)
 {
     Q_UNUSED(data);
 
     if(exitCode != SUCCESS)
     {
         emit message(tr("Error: Failed to get stats from remote."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         return;
     }
 
-    parseGlobalStats(stdOut);
+    parseGlobalStats(stdOut.bytes());
 }
 
 void TaskManager::fsckFinished(const QVariant &data, int exitCode,
-                               const QString &stdOut, const QString &stdErr)
+                               const TaskOutput &stdOut,
+                               const TaskOutput &stdErr)
 {
     Q_UNUSED(data)
     Q_UNUSED(stdOut);
@@ -581,13 +818,14 @@ void TaskManager::fsckFinished(const QVariant &data, int exitCode,
     else
     {
         emit message(tr("Cache repair failed."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
     }
     getArchives();
 }
 
 void TaskManager::nukeFinished(const QVariant &data, int exitCode,
-                               const QString &stdOut, const QString &stdErr)
+                               const TaskOutput &stdOut,
+                               const TaskOutput &stdErr)
 {
     Q_UNUSED(data)
     Q_UNUSED(stdOut);
@@ -599,14 +837,14 @@ void TaskManager::nukeFinished(const QVariant &data, int exitCode,
     else
     {
         emit message(tr("Archives nuke failed."));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         return;
     }
 }
 
 void TaskManager::restoreArchiveFinished(const QVariant &data, int exitCode,
-                                         const QString &stdOut,
-                                         const QString &stdErr)
+                                         const TaskOutput &stdOut,
+                                         const TaskOutput &stdErr)
 {
     Q_UNUSED(stdOut)
     ArchivePtr archive = data.value<ArchivePtr>();
@@ -624,7 +862,7 @@ void TaskManager::restoreArchiveFinished(const QVariant &data, int exitCode,
     {
         emit message(tr("Restoring from archive <i>%1</i> failed.")
                          .arg(archive->name()));
-        parseError(stdErr);
+        parseError(stdErr.toString());
         return;
     }
 }
@@ -718,14 +956,15 @@ void TaskManager::notifyArchivesDeleted(QList<ArchivePtr> archives, bool done)
 }
 
 void TaskManager::getKeyIdFinished(const QVariant &data, int exitCode,
-                                   const QString &stdOut, const QString &stdErr)
+                                   const TaskOutput &stdOut,
+                                   const TaskOutput &stdErr)
 {
     QString key_filename = data.toString();
     if(exitCode == SUCCESS)
     {
         bool ok = false;
         // qulonglong is the same as quint64.
-        quint64 id = stdOut.toULongLong(&ok);
+        quint64 id = stdOut.bytes().toULongLong(&ok);
         if(ok)
             emit keyId(key_filename, id);
         else
@@ -735,7 +974,7 @@ void TaskManager::getKeyIdFinished(const QVariant &data, int exitCode,
     else
     {
         DEBUG << "Failed to get the id for key " << key_filename;
-        parseError(stdErr);
+        parseError(stdErr.toString());
     }
 }
 
@@ -777,14 +1016,15 @@ void TaskManager::parseError(const QString &tarsnapOutput)
     }
 }
 
-void TaskManager::parseGlobalStats(const QString &tarsnapOutput)
+void TaskManager::parseGlobalStats(const QByteArray &tarsnapOutput)
 {
     struct tarsnap_stats stats = overallStatsTaskParse(tarsnapOutput);
 
     // Bail if there's any error.
     if(stats.parse_error)
     {
-        DEBUG << "Malformed output from tarsnap CLI:\n" << tarsnapOutput;
+        DEBUG << "Malformed output from tarsnap CLI:\n"
+              << QString::fromUtf8(tarsnapOutput);
         return;
     }
 
@@ -792,7 +1032,7 @@ void TaskManager::parseGlobalStats(const QString &tarsnapOutput)
                       stats.unique_compressed, _bd->numArchives());
 }
 
-void TaskManager::parseArchiveStats(const QString    &tarsnapOutput,
+void TaskManager::parseArchiveStats(const QByteArray &tarsnapOutput,
                                     bool              newArchiveOutput,
                                     const ArchivePtr &archive)
 {
@@ -802,7 +1042,8 @@ void TaskManager::parseArchiveStats(const QString    &tarsnapOutput,
     // Bail if there's any error.
     if(stats.parse_error)
     {
-        DEBUG << "Malformed output from tarsnap CLI:\n" << tarsnapOutput;
+        DEBUG << "Malformed output from tarsnap CLI:\n"
+              << QString::fromUtf8(tarsnapOutput);
         return;
     }
 
@@ -816,7 +1057,8 @@ void TaskManager::loadJobs()
 {
     if(!_bd->loadJobs())
         return;
-    emit jobList(_bd->jobs());
+    // Send a snapshot, since the receivers might not have seen the changes.
+    emit jobChanges(_bd->jobSnapshot());
 }
 
 void TaskManager::deleteJob(const JobPtr &job, bool purgeArchives)
@@ -824,6 +1066,9 @@ void TaskManager::deleteJob(const JobPtr &job, bool purgeArchives)
     if(job)
     {
         _bd->deleteJob(job);
+        notifyJobChanges();
+        // The Job's archives no longer belong to it.
+        notifyArchiveChanges();
 
         if(purgeArchives)
         {
@@ -843,12 +1088,27 @@ void TaskManager::deleteJob(const JobPtr &job, bool purgeArchives)
 void TaskManager::addJob(const JobPtr &job)
 {
     _bd->addJob(job);
+    notifyJobChanges();
     emit message(tr("Job <i>%1</i> added.").arg(job->name()));
 }
 
+void TaskManager::notifyArchiveChanges()
+{
+    ArchiveChanges changes = _bd->takeArchiveChanges();
+    if(!changes.isEmpty())
+        emit archiveChanges(changes);
+}
+
+void TaskManager::notifyJobChanges()
+{
+    JobChanges changes = _bd->takeJobChanges();
+    if(!changes.isEmpty())
+        emit jobChanges(changes);
+}
+
 void TaskManager::getTarsnapVersionFinished(const QVariant &data, int exitCode,
-                                            const QString &stdOut,
-                                            const QString &stdErr)
+                                            const TaskOutput &stdOut,
+                                            const TaskOutput &stdErr)
 {
     Q_UNUSED(data)
     Q_UNUSED(stdErr)
@@ -860,7 +1120,7 @@ void TaskManager::getTarsnapVersionFinished(const QVariant &data, int exitCode,
         return;
     }
 
-    QString version = tarsnapVersionTaskParse(stdOut);
+    QString version = tarsnapVersionTaskParse(stdOut.toString());
     if(versionCompare(version, TARSNAP_MIN_VERSION) < 0)
         emit tarsnapVersionFound(TaskStatus::VersionTooLow, version);
     else
@@ -4,19 +4,24 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QByteArray>
 #include <QList>
 #include <QMap>
 #include <QObject>
 #include <QString>
 #include <QUuid>
 #include <QVariant>
+#include <QVector>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/backuptaskdataptr.h"
+#include "messages/changeset.h"
+#include "messages/fileversion.h"
 #include "messages/jobptr.h"
 #include "messages/notification_info.h"
 #include "messages/tarsnaperror.h"
+#include "messages/taskoutput.h"
 #include "messages/taskstatus.h"
 
 /* Forward declaration(s). */
@@ -83,6 +88,11 @@ public slots:
                            const bool useExistingKeyfile);
     //! tarsnap -c -f \<name\>
     void backupNow(const BackupTaskDataPtr &backupTaskData);
+    //! tarsnap -c --dry-run --print-stats for a Job, to estimate how much
+    //! new data its next backup would upload.  The result is cached in the
+    //! Job until something changes.  If the Job isn't being tracked, its
+    //! fingerprint is taken (by a FingerprintTask) before the --dry-run.
+    void estimateUpload(const JobPtr &job);
     //! tarsnap --list-archives -vv
     void getArchives();
     //! tarsnap --print-stats -f \<name\>
@@ -105,6 +115,9 @@ public slots:
     //! Search for all matching Archive objects which were created by a Job.
     //! \param jobPrefix prefix of the Archive names to match.
     void findMatchingArchives(const QString &jobPrefix);
+    //! Search the fetched archive contents for every version of a file.
+    //! \param pattern path or shell globbing pattern.
+    void findFileVersions(const QString &pattern);
 
     //! Prepare a task, and start it when there's an available thread.
     void queueGuiTask(BaseTask *task);
@@ -126,17 +139,16 @@ signals:
     void registerMachineProgress(const QString &stdOut);
     //! Result of tarsnap-keygen.
     void registerMachineDone(TaskStatus status, const QString &reason);
-    //! A list of all Archive objects.
-    void archiveList(QList<ArchivePtr> archives);
-    //! A new Archive was created by \ref backupNow or discovered via
-    //! \ref getArchives.
-    void archiveAdded(ArchivePtr archive);
+    //! The Archive objects changed; \ref loadArchives sends a snapshot,
+    //! and everything else sends the changes (e.g. an Archive created by
+    //! \ref backupNow or discovered via \ref getArchives).
+    void archiveChanges(ArchiveChanges changes);
     //! Result of tarsnap --print-stats.
     void overallStats(quint64 sizeTotal, quint64 sizeCompressed,
                       quint64 sizeUniqueTotal, quint64 sizeUniqueCompressed,
                       quint64 archiveCount);
-    //! A list of all Jobs.
-    void jobList(QMap<QString, JobPtr> jobs);
+    //! The Jobs changed; \ref loadJobs sends a snapshot.
+    void jobChanges(JobChanges changes);
     //! A status message should be shown to the user.
     //! \param msg main text to display.
     void message(const QString &msg);
@@ -151,47 +163,65 @@ signals:
     void keyId(const QString &key_filename, quint64 id);
     //! Archives which match the previously-given search string.
     void matchingArchives(QList<ArchivePtr> archives);
+    //! Versions of the files which match the previously-given pattern.
+    void fileVersions(const QString &pattern, QVector<FileVersion> versions);
 
 private slots:
     // post Tarsnap task processing
     void getTarsnapVersionFinished(const QVariant &data, int exitCode,
-                                   const QString &stdOut,
-                                   const QString &stdErr);
+                                   const TaskOutput &stdOut,
+                                   const TaskOutput &stdErr);
     void backupTaskFinished(const QVariant &data, int exitCode,
-                            const QString &stdOut, const QString &stdErr);
+                            const TaskOutput &stdOut,
+                            const TaskOutput &stdErr);
     void backupTaskStarted(const QVariant &data);
+    void estimateUploadFinished(const QVariant &data, int exitCode,
+                                const TaskOutput &stdOut,
+                                const TaskOutput &stdErr);
     void registerMachineFinished(const QVariant &data, int exitCode,
-                                 const QString &stdOut, const QString &stdErr);
+                                 const TaskOutput &stdOut,
+                                 const TaskOutput &stdErr);
+    void getArchiveListLines(const QVariant &data, const QByteArray &lines);
     void getArchiveListFinished(const QVariant &data, int exitCode,
-                                const QString &stdOut, const QString &stdErr);
+                                const TaskOutput &stdOut,
+                                const TaskOutput &stdErr);
     void getArchiveStatsFinished(const QVariant &data, int exitCode,
-                                 const QString &stdOut, const QString &stdErr);
+                                 const TaskOutput &stdOut,
+                                 const TaskOutput &stdErr);
     void getArchiveContentsFinished(const QVariant &data, int exitCode,
-                                    const QString &stdOut,
-                                    const QString &stdErr);
+                                    const TaskOutput &stdOut,
+                                    const TaskOutput &stdErr);
     void deleteArchivesFinished(const QVariant &data, int exitCode,
-                                const QString &stdOut, const QString &stdErr);
+                                const TaskOutput &stdOut,
+                                const TaskOutput &stdErr);
     void overallStatsFinished(const QVariant &data, int exitCode,
-                              const QString &stdOut, const QString &stdErr);
-    void fsckFinished(const QVariant &data, int exitCode, const QString &stdOut,
-                      const QString &stdErr);
-    void nukeFinished(const QVariant &data, int exitCode, const QString &stdOut,
-                      const QString &stdErr);
+                              const TaskOutput &stdOut,
+                              const TaskOutput &stdErr);
+    void fsckFinished(const QVariant &data, int exitCode,
+                      const TaskOutput &stdOut, const TaskOutput &stdErr);
+    void nukeFinished(const QVariant &data, int exitCode,
+                      const TaskOutput &stdOut, const TaskOutput &stdErr);
     void restoreArchiveFinished(const QVariant &data, int exitCode,
-                                const QString &stdOut, const QString &stdErr);
+                                const TaskOutput &stdOut,
+                                const TaskOutput &stdErr);
     void notifyBackupTaskUpdate(const BackupTaskDataPtr &backupTaskData,
                                 const TaskStatus        &status);
     void notifyArchivesDeleted(QList<ArchivePtr> archives, bool done);
     void getKeyIdFinished(const QVariant &data, int exitCode,
-                          const QString &stdOut, const QString &stdErr);
+                          const TaskOutput &stdOut, const TaskOutput &stdErr);
 
 private:
     void parseError(const QString &tarsnapOutput);
-    void parseGlobalStats(const QString &tarsnapOutput);
-    void parseArchiveStats(const QString &tarsnapOutput, bool newArchiveOutput,
-                           const ArchivePtr &archive);
+    void parseGlobalStats(const QByteArray &tarsnapOutput);
+    void parseArchiveStats(const QByteArray &tarsnapOutput,
+                           bool newArchiveOutput, const ArchivePtr &archive);
     bool waitForOnline();
     void warnNotOnline();
+    void queueUploadEstimate(const JobPtr &job, const QString &fingerprint);
+    void reportUploadEstimate(const JobPtr &job);
+    // Send the pending changes from the BackendData (if any).
+    void notifyArchiveChanges();
+    void notifyJobChanges();
 
     TaskQueuer *_tq;
 
@@ -33,6 +33,7 @@ WARNINGS_ENABLE
 #define DEFAULT_TRAVERSE_MOUNT true
 #define DEFAULT_FOLLOW_SYMLINKS false
 #define DEFAULT_DRY_RUN false
+#define DEFAULT_SKIP_UNCHANGED_JOBS false
 
 /* Default behaviour for skipping files */
 #define DEFAULT_SKIP_NODUMP false
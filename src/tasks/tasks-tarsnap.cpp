@@ -3,23 +3,128 @@
 WARNINGS_DISABLE
 #include <QChar>
 #include <QList>
-#include <QRegExp>
 #include <QStringList>
 #include <QUrl>
 #include <QVariant>
+#include <QVector>
 #include <Qt>
 WARNINGS_ENABLE
 
+#include "ByteScan.h"
 #include "TSettings.h"
 
 #include "messages/archiverestoreoptions.h"
 
 #include "backuptask.h"
 #include "cmdlinetask.h"
-#include "compat.h"
 #include "tasks/tasks-defs.h"
 #include "tasks/tasks-utils.h"
 
+#include <string.h>
+
+/*
+ * These parse the output of tarsnap without regular expressions.  They
+ * give the same results as the QRegExp patterns mentioned in each comment
+ * (for ASCII whitespace and digits).
+ */
+
+// Splits "<tabs>WORD<blanks>WORD<tabs>COMMAND", i.e. the end of
+// "^(.+)\t+(\S+\s+\S+)\t+(.+)$".
+static bool splitArchiveDetails(const char *pos, const char *end,
+                                ByteScan::Range &timestamp,
+                                ByteScan::Range &command)
+{
+    while((pos < end) && (*pos == '\t'))
+        pos++;
+
+    // Two words separated by blanks.
+    timestamp.begin       = pos;
+    const char *wordEnd   = ByteScan::findBlank(pos, end);
+    const char *wordStart = ByteScan::skipBlanks(wordEnd, end);
+    if((wordEnd == pos) || (wordStart == wordEnd))
+        return (false);
+    timestamp.end = ByteScan::findBlank(wordStart, end);
+    if(timestamp.end == wordStart)
+        return (false);
+
+    // At least one tab, then at least one character.
+    pos = timestamp.end;
+    while((pos < end) && (*pos == '\t'))
+        pos++;
+    if(pos == timestamp.end)
+        return (false);
+    if(pos == end)
+    {
+        // Bail (if applicable); otherwise the command is the last tab.
+        if(pos - timestamp.end < 2)
+            return (false);
+        pos--;
+    }
+    command.begin = pos;
+    command.end   = end;
+    return (true);
+}
+
+// Like "^(.+)\t+(\S+\s+\S+)\t+(.+)$": the name is as long as possible, so
+// it ends at the last tab which is followed by a valid timestamp.
+static bool splitArchiveLine(const ByteScan::Range &line, ByteScan::Range &name,
+                             ByteScan::Range &timestamp,
+                             ByteScan::Range &command)
+{
+    for(const char *tab = line.end - 1; tab > line.begin; tab--)
+    {
+        if((*tab == '\t')
+           && splitArchiveDetails(tab, line.end, timestamp, command))
+        {
+            name.begin = line.begin;
+            name.end   = tab;
+            return (true);
+        }
+    }
+    return (false);
+}
+
+// Like "^PREFIX\s+(\d+)\s+(\d+)$", with PREFIX matched literally.
+static bool parseSizeLine(const char *pos, const char *end,
+                          const QByteArray &prefix, quint64 &total,
+                          quint64 &compressed)
+{
+    // Bail (if applicable).
+    if((end - pos <= prefix.size())
+       || (memcmp(pos, prefix.constData(), static_cast<size_t>(prefix.size()))
+           != 0))
+        return (false);
+    pos += prefix.size();
+    if(!ByteScan::isBlank(*pos))
+        return (false);
+
+    // Exactly two numbers, with nothing after them.
+    ByteScan::Range fields[3];
+    if((ByteScan::splitFields(pos, end, fields, 3) != 2)
+       || (fields[1].end != end))
+        return (false);
+
+    quint64 first;
+    quint64 second;
+    if(!ByteScan::parseNumber(fields[0].begin, fields[0].end, first)
+       || !ByteScan::parseNumber(fields[1].begin, fields[1].end, second))
+        return (false);
+    total      = first;
+    compressed = second;
+    return (true);
+}
+
+// Like "^\s+\(unique data\)\s+(\d+)\s+(\d+)$".
+static bool parseUniqueSizeLine(const ByteScan::Range &line, quint64 &total,
+                                quint64 &compressed)
+{
+    const char *pos = ByteScan::skipBlanks(line.begin, line.end);
+    if(pos == line.begin)
+        return (false);
+    return (parseSizeLine(pos, line.end, QByteArray("(unique data)"),
+                          total, compressed));
+}
+
 CmdlineTask *listArchivesTask()
 {
     CmdlineTask *task = new CmdlineTask();
@@ -36,22 +141,25 @@ CmdlineTask *listArchivesTask()
 }
 
 QList<struct archive_list_data>
-listArchivesTaskParse(const QString &tarsnapOutput)
+listArchivesTaskParse(const QByteArray &tarsnapOutput)
 {
     QList<struct archive_list_data> metadatas;
-    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
-    for(const QString &line : lines)
+
+    const char     *pos = tarsnapOutput.constData();
+    const char     *end = pos + tarsnapOutput.size();
+    ByteScan::Range line;
+    ByteScan::Range name;
+    ByteScan::Range timestamp;
+    ByteScan::Range command;
+    while(ByteScan::nextLine(pos, end, line))
     {
-        QRegExp archiveDetailsRX("^(.+)\\t+(\\S+\\s+\\S+)\\t+(.+)$");
-        if(-1 != archiveDetailsRX.indexIn(line))
+        if(splitArchiveLine(line, name, timestamp, command))
         {
             struct archive_list_data metadata;
-            QStringList archiveDetails = archiveDetailsRX.capturedTexts();
-            archiveDetails.removeFirst();
-            metadata.archiveName = archiveDetails[0];
+            metadata.archiveName = name.toString();
             metadata.timestamp =
-                QDateTime::fromString(archiveDetails[1], Qt::ISODate);
-            metadata.command = archiveDetails[2];
+                QDateTime::fromString(timestamp.toString(), Qt::ISODate);
+            metadata.command = command.toString();
 
             metadata.parse_error = false;
             metadatas.append(metadata);
@@ -77,48 +185,33 @@ CmdlineTask *printStatsTask(const QString &archiveName)
     return (task);
 }
 
-struct tarsnap_stats printStatsTaskParse(const QString &tarsnapOutput,
-                                         bool           newArchiveOutput,
-                                         const QString &archiveName)
+struct tarsnap_stats printStatsTaskParse(const QByteArray &tarsnapOutput,
+                                         bool              newArchiveOutput,
+                                         const QString    &archiveName)
 {
     struct tarsnap_stats stats = {0, 0, 0, 0, true};
 
-    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
+    const QVector<ByteScan::Range> lines = ByteScan::splitLines(tarsnapOutput);
     if(lines.count() < 5)
         return (stats);
 
-    QRegExp sizeRX;
-    QRegExp uniqueSizeRX;
-    if(newArchiveOutput)
-    {
-        sizeRX.setPattern("^This archive\\s+(\\d+)\\s+(\\d+)$");
-        uniqueSizeRX.setPattern("^New data\\s+(\\d+)\\s+(\\d+)$");
-    }
-    else
-    {
-        sizeRX.setPattern(QString("^%1\\s+(\\d+)\\s+(\\d+)$").arg(archiveName));
-        uniqueSizeRX.setPattern("^\\s+\\(unique data\\)\\s+(\\d+)\\s+(\\d+)$");
-    }
-    bool matched = false;
-    for(const QString &line : lines)
+    // The archive name is matched literally, so it may contain any
+    // characters.
+    const QByteArray sizePrefix =
+        newArchiveOutput ? QByteArray("This archive") : archiveName.toUtf8();
+    const QByteArray uniquePrefix("New data");
+    bool             matched = false;
+    for(const ByteScan::Range &line : lines)
     {
-        if(-1 != sizeRX.indexIn(line))
-        {
-            QStringList captured = sizeRX.capturedTexts();
-            captured.removeFirst();
-            stats.total      = captured[0].toULongLong();
-            stats.compressed = captured[1].toULongLong();
-
+        if(parseSizeLine(line.begin, line.end, sizePrefix, stats.total,
+                         stats.compressed))
+            matched = true;
+        if(newArchiveOutput
+               ? parseSizeLine(line.begin, line.end, uniquePrefix,
+                               stats.unique_total, stats.unique_compressed)
+               : parseUniqueSizeLine(line, stats.unique_total,
+                                     stats.unique_compressed))
             matched = true;
-        }
-        if(-1 != uniqueSizeRX.indexIn(line))
-        {
-            QStringList captured = uniqueSizeRX.capturedTexts();
-            captured.removeFirst();
-            stats.unique_total      = captured[0].toULongLong();
-            stats.unique_compressed = captured[1].toULongLong();
-            matched                 = true;
-        }
     }
     if(!matched)
         return (stats);
@@ -144,6 +237,7 @@ CmdlineTask *archiveContentsTask(const QString &archiveName)
     /* Generic setup. */
     task->setCommand(makeTarsnapCommand());
     task->setArguments(args);
+    task->setStdOutSpillDir(makeSpillDir());
     return (task);
 }
 
@@ -179,32 +273,23 @@ CmdlineTask *overallStatsTask()
     return (task);
 }
 
-struct tarsnap_stats overallStatsTaskParse(const QString &tarsnapOutput)
+struct tarsnap_stats overallStatsTaskParse(const QByteArray &tarsnapOutput)
 {
     struct tarsnap_stats stats = {0, 0, 0, 0, true};
 
-    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
+    const QVector<ByteScan::Range> lines = ByteScan::splitLines(tarsnapOutput);
     if(lines.count() < 3)
         return (stats);
 
-    QRegExp sizeRX("^All archives\\s+(\\d+)\\s+(\\d+)$");
-    if(-1 == sizeRX.indexIn(lines[1]))
+    if(!parseSizeLine(lines[1].begin, lines[1].end,
+                      QByteArray("All archives"), stats.total,
+                      stats.compressed))
         return (stats);
 
-    QStringList captured = sizeRX.capturedTexts();
-    captured.removeFirst();
-    stats.total      = captured[0].toULongLong();
-    stats.compressed = captured[1].toULongLong();
-
-    QRegExp uniqueSizeRX("^\\s+\\(unique data\\)\\s+(\\d+)\\s+(\\d+)$");
-    if(-1 == uniqueSizeRX.indexIn(lines[2]))
+    if(!parseUniqueSizeLine(lines[2], stats.unique_total,
+                            stats.unique_compressed))
         return (stats);
 
-    captured = uniqueSizeRX.capturedTexts();
-    captured.removeFirst();
-    stats.unique_total      = captured[0].toULongLong();
-    stats.unique_compressed = captured[1].toULongLong();
-
     // We're ok.
     stats.parse_error = false;
     return (stats);
@@ -4,6 +4,7 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QByteArray>
 #include <QDateTime>
 #include <QList>
 #include <QString>
@@ -64,7 +65,7 @@ CmdlineTask *listArchivesTask();
  * \brief Extract info from `tarsnap --list-archives -vv`
  */
 QList<struct archive_list_data>
-listArchivesTaskParse(const QString &tarsnapOutput);
+listArchivesTaskParse(const QByteArray &tarsnapOutput);
 
 /**
  * \brief Create a task for: `tarsnap --print-stats -f ARCHIVENAME`
@@ -74,9 +75,9 @@ CmdlineTask *printStatsTask(const QString &archiveName);
 /**
  * \brief Extract stats from `tarsnap --print-stats -f ARCHIVENAME`
  */
-struct tarsnap_stats printStatsTaskParse(const QString &tarsnapOutput,
-                                         bool           newArchiveOutput,
-                                         const QString &archiveName);
+struct tarsnap_stats printStatsTaskParse(const QByteArray &tarsnapOutput,
+                                         bool              newArchiveOutput,
+                                         const QString    &archiveName);
 
 /**
  * \brief Create a task for: `tarsnap -tv -f ARCHIVENAME`
@@ -96,7 +97,7 @@ CmdlineTask *overallStatsTask();
 /**
  * \brief Extract stats from `tarsnap --print-stats`
  */
-struct tarsnap_stats overallStatsTaskParse(const QString &tarsnapOutput);
+struct tarsnap_stats overallStatsTaskParse(const QByteArray &tarsnapOutput);
 
 /**
  * \brief Create a task for: `tarsnap --nuke`
@@ -57,6 +57,12 @@ QStringList makeTarsnapArgs()
     return (args);
 }
 
+QString makeSpillDir()
+{
+    TSettings settings;
+    return (settings.value("app/app_data", "").toString());
+}
+
 /*
  * The QVersionNumber class was introduced in Qt 5.6, which is later than
  * our target of Qt 5.2.1.
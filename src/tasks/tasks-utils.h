@@ -35,6 +35,12 @@ QString makeTarsnapCommand(const QString &cmd = "tarsnap");
  */
 QStringList makeTarsnapArgs();
 
+/**
+ * \brief Return the directory in which very large outputs of a command are
+ * kept, i.e. the value of "`app/app_data`" in the TSettings.
+ */
+QString makeSpillDir();
+
 /**
  * \brief Compare two version strings.
  *
@@ -0,0 +1,62 @@
+#include "updatecoalescer.h"
+
+UpdateCoalescer::UpdateCoalescer(QObject *parent)
+    : QObject(parent),
+      _backupRunning(false),
+      _runningTasks(0),
+      _queuedTasks(0),
+      _numTasksPending(false),
+      _numTasksEmitted(false),
+      _messagePending(false)
+{
+    _frameTimer.setSingleShot(true);
+    _frameTimer.setInterval(UPDATECOALESCER_FRAME_MS);
+    connect(&_frameTimer, &QTimer::timeout, this, &UpdateCoalescer::flush);
+}
+
+void UpdateCoalescer::setNumTasks(bool backupRunning, int runningTasks,
+                                  int queuedTasks)
+{
+    // Bail (if applicable).
+    if(_numTasksEmitted && !_numTasksPending
+       && (backupRunning == _backupRunning) && (runningTasks == _runningTasks)
+       && (queuedTasks == _queuedTasks))
+        return;
+
+    _backupRunning   = backupRunning;
+    _runningTasks    = runningTasks;
+    _queuedTasks     = queuedTasks;
+    _numTasksPending = true;
+    schedule();
+}
+
+void UpdateCoalescer::setMessage(const QString &message)
+{
+    _message        = message;
+    _messagePending = true;
+    schedule();
+}
+
+void UpdateCoalescer::flush()
+{
+    _frameTimer.stop();
+
+    // Clear the flags first, in case a receiver sends another update.
+    if(_numTasksPending)
+    {
+        _numTasksPending = false;
+        _numTasksEmitted = true;
+        emit numTasks(_backupRunning, _runningTasks, _queuedTasks);
+    }
+    if(_messagePending)
+    {
+        _messagePending = false;
+        emit message(_message);
+    }
+}
+
+void UpdateCoalescer::schedule()
+{
+    if(!_frameTimer.isActive())
+        _frameTimer.start();
+}
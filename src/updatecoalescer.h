@@ -0,0 +1,62 @@
+#ifndef UPDATECOALESCER_H
+#define UPDATECOALESCER_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QObject>
+#include <QString>
+#include <QTimer>
+WARNINGS_ENABLE
+
+//! Delay (in ms) used to coalesce status updates; roughly one frame.
+#define UPDATECOALESCER_FRAME_MS 16
+
+/*!
+ * \ingroup misc
+ * \brief The UpdateCoalescer passes on the number of tasks and the status
+ * message at most once per frame.
+ *
+ * While many tasks are started and finish (e.g. when fetching the stats
+ * of thousands of archives), the \ref TaskManager notifies about each
+ * one.  The first update starts a timer; when it fires, only the latest
+ * values are emitted, and only if they differ from what was last emitted.
+ */
+class UpdateCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit UpdateCoalescer(QObject *parent = nullptr);
+
+public slots:
+    //! Records the number of tasks, to be emitted with the next frame.
+    void setNumTasks(bool backupRunning, int runningTasks, int queuedTasks);
+    //! Records the status message, to be emitted with the next frame.
+    void setMessage(const QString &message);
+    //! Emits the pending values immediately.
+    void flush();
+
+signals:
+    //! The latest number of tasks; see \ref TaskManager::numTasks().
+    void numTasks(bool backupRunning, int runningTasks, int queuedTasks);
+    //! The latest status message.
+    void message(const QString &message);
+
+private:
+    QTimer _frameTimer;
+
+    // The latest values, and whether they still need to be emitted.
+    bool    _backupRunning;
+    int     _runningTasks;
+    int     _queuedTasks;
+    bool    _numTasksPending;
+    bool    _numTasksEmitted;
+    QString _message;
+    bool    _messagePending;
+
+    void schedule();
+};
+
+#endif /* !UPDATECOALESCER_H */
@@ -0,0 +1,108 @@
+#include "archivediffdialog.h"
+
+WARNINGS_DISABLE
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTableView>
+#include <Qt>
+
+#include "ui_archivediffdialog.h"
+WARNINGS_ENABLE
+
+#include "archivediff.h"
+#include "archivediffmodel.h"
+#include "humanbytes.h"
+#include "persistentmodel/archive.h"
+
+ArchiveDiffDialog::ArchiveDiffDialog(const ArchivePtr &from,
+                                     const ArchivePtr &to, QWidget *parent)
+    : QDialog(parent),
+      _ui(new Ui::ArchiveDiffDialog),
+      _model(new ArchiveDiffModel(this)),
+      _from(from),
+      _to(to),
+      _contentsRequested(false),
+      _started(false)
+{
+    // Ui initialization
+    _ui->setupUi(this);
+    setAttribute(Qt::WA_DeleteOnClose);
+    _ui->archivesLabel->setText(tr("Changes from <b>%1</b> to <b>%2</b>")
+                                    .arg(_from->name().toHtmlEscaped())
+                                    .arg(_to->name().toHtmlEscaped()));
+    _ui->diffTableView->setModel(_model);
+    // Sizing the columns to their contents would measure every row.
+    _ui->diffTableView->horizontalHeader()->setSectionResizeMode(
+        ArchiveDiffModel::PATH, QHeaderView::Stretch);
+
+    // Connect the Close button
+    connect(_ui->buttonBox, &QDialogButtonBox::rejected, this,
+            &QDialog::reject);
+    connect(_model, &ArchiveDiffModel::ready, this,
+            &ArchiveDiffDialog::showSummary);
+    connect(_model, &ArchiveDiffModel::taskRequested, this,
+            &ArchiveDiffDialog::taskRequested);
+    connect(_model, &ArchiveDiffModel::cancelTaskRequested, this,
+            &ArchiveDiffDialog::cancelTaskRequested);
+
+    // Start once the contents have been fetched.
+    connect(_from.data(), &Archive::changed, this, &ArchiveDiffDialog::compare);
+    connect(_to.data(), &Archive::changed, this, &ArchiveDiffDialog::compare);
+}
+
+ArchiveDiffDialog::~ArchiveDiffDialog()
+{
+    // Cancel the comparison while our signals are still connected.
+    delete _model;
+    delete _ui;
+}
+
+void ArchiveDiffDialog::compare()
+{
+    // Bail (if applicable).
+    if(_started)
+        return;
+
+    if(!_from->hasContents() || !_to->hasContents())
+    {
+        _ui->statusLabel->setText(tr("Fetching the contents of the"
+                                     " archives..."));
+        // Only ask once.
+        if(!_contentsRequested)
+        {
+            _contentsRequested = true;
+            if(!_from->hasContents())
+                emit loadArchiveContents(_from);
+            if(!_to->hasContents())
+                emit loadArchiveContents(_to);
+        }
+        return;
+    }
+
+    _started = true;
+    _ui->statusLabel->setText(tr("Comparing..."));
+    _model->setArchives(_from, _to);
+}
+
+void ArchiveDiffDialog::showSummary()
+{
+    const ArchiveDiffPtr diff = _model->diff();
+
+    // Bail (if applicable).
+    if(!diff)
+        return;
+
+    const qint64 delta = diff->sizeDelta();
+    QString      size;
+    if(delta < 0)
+        size = QString("-") + humanBytes(static_cast<quint64>(-delta));
+    else
+        size = QString("+") + humanBytes(static_cast<quint64>(delta));
+    _ui->statusLabel->setText(tr("%1 added, %2 removed, %3 modified;"
+                                 " total size change: %4")
+                                  .arg(diff->addedCount())
+                                  .arg(diff->removedCount())
+                                  .arg(diff->modifiedCount())
+                                  .arg(size));
+}
@@ -0,0 +1,69 @@
+#ifndef ARCHIVEDIFFDIALOG_H
+#define ARCHIVEDIFFDIALOG_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QDialog>
+#include <QObject>
+#include <QUuid>
+WARNINGS_ENABLE
+
+#include "messages/archiveptr.h"
+
+/* Forward declaration(s). */
+namespace Ui
+{
+class ArchiveDiffDialog;
+}
+class ArchiveDiffModel;
+class BaseTask;
+class QWidget;
+
+/*!
+ * \ingroup widgets-main
+ * \brief The ArchiveDiffDialog is a QDialog which shows the files which
+ * were added, removed, or modified between two archives.
+ *
+ * The contents of the archives are fetched first, if necessary.
+ */
+class ArchiveDiffDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    //! \param from the older archive.
+    //! \param to the newer archive.
+    //! \param parent the parent widget.
+    ArchiveDiffDialog(const ArchivePtr &from, const ArchivePtr &to,
+                      QWidget *parent = nullptr);
+    ~ArchiveDiffDialog() override;
+
+public slots:
+    //! Starts the comparison, or fetches the contents of the archives
+    //! which do not have any.
+    void compare();
+
+signals:
+    //! Begin tarsnap -tv -f \<name\>
+    void loadArchiveContents(const ArchivePtr &archive);
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
+private slots:
+    void showSummary();
+
+private:
+    Ui::ArchiveDiffDialog *_ui;
+    ArchiveDiffModel      *_model;
+
+    ArchivePtr _from;
+    ArchivePtr _to;
+    bool       _contentsRequested;
+    bool       _started;
+};
+
+#endif /* !ARCHIVEDIFFDIALOG_H */
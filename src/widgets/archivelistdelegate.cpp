@@ -0,0 +1,330 @@
+#include "archivelistdelegate.h"
+
+WARNINGS_DISABLE
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QColor>
+#include <QCursor>
+#include <QEvent>
+#include <QFontMetrics>
+#include <QHelpEvent>
+#include <QKeySequence>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPalette>
+#include <QStringList>
+#include <QStyle>
+#include <QToolTip>
+#include <QWidget>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "archivelistmodel.h"
+#include "compat.h"
+
+// Layout of a row.
+#define ROW_MIN_WIDTH 300
+#define ROW_HEIGHT 32
+#define MARGIN_H 10
+#define MARGIN_V 2
+#define SPACING 6
+#define BUTTON_SIZE 27
+#define BUTTON_RADIUS 4
+#define ICON_SIZE 16
+#define NAME_FONT_SIZE 12
+#define DETAIL_FONT_SIZE 11
+
+// Background of the buttons, depending on hover and checked states.
+#define BUTTON_COLOR_HOVER QColor(179, 190, 255, 120)
+#define BUTTON_COLOR_CHECKED QColor(179, 190, 255, 180)
+#define BUTTON_COLOR_CHECKED_HOVER QColor(179, 190, 255, 240)
+
+#define ANNOTATION_COLOR QColor("grey")
+
+static QFont monospaceFont(int pixelSize)
+{
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPixelSize(pixelSize);
+    return (font);
+}
+
+ArchiveListDelegate::ArchiveListDelegate(QObject *parent)
+    : QStyledItemDelegate(parent),
+      _nameFont(monospaceFont(NAME_FONT_SIZE)),
+      _detailFont(monospaceFont(DETAIL_FONT_SIZE))
+{
+    _icons[InspectButton] = QIcon(":/icons/info.png");
+    _icons[RestoreButton] = QIcon(":/icons/cloud-download.png");
+    _icons[DeleteButton]  = QIcon(":/icons/trash.png");
+}
+
+void ArchiveListDelegate::paint(QPainter                   *painter,
+                                const QStyleOptionViewItem &option,
+                                const QModelIndex          &index) const
+{
+    // Draw the background (selection, hover, alternating colors).
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    opt.text.clear();
+    const QWidget *widget = opt.widget;
+    QStyle        *style =
+        (widget != nullptr) ? widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
+
+    // Archives which are scheduled for deletion are shown as disabled.
+    const bool enabled =
+        !index.data(ArchiveListModel::DeleteScheduledRole).toBool();
+    const bool checked =
+        index.data(ArchiveListModel::ShowingDetailsRole).toBool();
+    const QPalette::ColorRole role = (opt.state & QStyle::State_Selected)
+                                         ? QPalette::HighlightedText
+                                         : QPalette::Text;
+    const QColor textColor = opt.palette.color(
+        enabled ? QPalette::Normal : QPalette::Disabled, role);
+    const QRect   rowRect = opt.rect;
+    const QString detail =
+        index.data(ArchiveListModel::DetailRole).toString();
+    const QRect detailArea = detailRect(rowRect, detail);
+
+    painter->save();
+
+    // Draw the name, with the "Job_" prefix and the date suffix in grey.
+    const QStringList parts =
+        index.data(ArchiveListModel::NamePartsRole).toStringList();
+    const QFontMetrics nameMetrics(_nameFont);
+    const QRect        nameArea(rowRect.left() + MARGIN_H,
+                                rowRect.top() + MARGIN_V,
+                                detailArea.left() - SPACING - rowRect.left()
+                                    - MARGIN_H,
+                                rowRect.height() - 2 * MARGIN_V);
+    const QString fullName = parts.join(QString());
+    const QString elided =
+        nameMetrics.elidedText(fullName, Qt::ElideRight, nameArea.width());
+    const bool shouldElide = (elided != fullName);
+    // Reserve the last character for the ellipsis.
+    int remaining = shouldElide ? elided.size() - 1 : elided.size();
+    int x         = nameArea.left();
+    painter->setFont(_nameFont);
+    for(int p = 0; (p < parts.size()) && (remaining > 0); p++)
+    {
+        QString text = parts.at(p).left(remaining);
+        remaining -= text.size();
+        if((remaining == 0) && shouldElide)
+            text += QChar(0x2026);
+        painter->setPen((p == 1) ? textColor : ANNOTATION_COLOR);
+        painter->drawText(QRect(x, nameArea.top(), nameArea.right() - x + 1,
+                                nameArea.height()),
+                          Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine,
+                          text);
+        x += TEXT_WIDTH(nameMetrics, text);
+    }
+
+    // Draw the size & date.
+    painter->setFont(_detailFont);
+    painter->setPen(ANNOTATION_COLOR);
+    painter->drawText(detailArea,
+                      Qt::AlignRight | Qt::AlignVCenter | Qt::TextSingleLine,
+                      detail);
+
+    // Draw the separator.
+    const int lineX = buttonRect(rowRect, InspectButton).left() - SPACING;
+    painter->setPen(opt.palette.color(QPalette::Mid));
+    painter->drawLine(lineX, rowRect.top() + MARGIN_V, lineX,
+                      rowRect.bottom() - MARGIN_V);
+
+    // Draw the buttons.
+    const QPoint mouse = hoverPos(opt);
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+    for(int b = InspectButton; b < NoButton; b++)
+    {
+        const Button button  = static_cast<Button>(b);
+        const QRect  rect    = buttonRect(rowRect, button);
+        const bool   hover   = enabled && rect.contains(mouse);
+        const bool   pressed = checked && (button == InspectButton);
+        if(pressed || hover)
+        {
+            if(pressed)
+                painter->setBrush(hover ? BUTTON_COLOR_CHECKED_HOVER
+                                        : BUTTON_COLOR_CHECKED);
+            else
+                painter->setBrush(BUTTON_COLOR_HOVER);
+            painter->drawRoundedRect(rect, BUTTON_RADIUS, BUTTON_RADIUS);
+        }
+        QRect iconRect(0, 0, ICON_SIZE, ICON_SIZE);
+        iconRect.moveCenter(rect.center());
+        _icons[b].paint(painter, iconRect, Qt::AlignCenter,
+                        enabled ? QIcon::Normal : QIcon::Disabled);
+    }
+
+    painter->restore();
+}
+
+QSize ArchiveListDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                    const QModelIndex          &index) const
+{
+    Q_UNUSED(option)
+    Q_UNUSED(index)
+
+    // Every row has the same size, so this does not look at the data.
+    return (QSize(ROW_MIN_WIDTH, ROW_HEIGHT));
+}
+
+bool ArchiveListDelegate::helpEvent(QHelpEvent                 *event,
+                                    QAbstractItemView          *view,
+                                    const QStyleOptionViewItem &option,
+                                    const QModelIndex          &index)
+{
+    // Bail (if applicable).
+    if((event == nullptr) || (view == nullptr) || !index.isValid()
+       || (event->type() != QEvent::ToolTip))
+    {
+        return (QStyledItemDelegate::helpEvent(event, view, option, index));
+    }
+
+    // Show the shortcut of a button, the archive stats for the size &
+    // date, or else the full name.
+    QString      text;
+    const Button button = buttonAt(option.rect, event->pos());
+    if(button != NoButton)
+    {
+        text = buttonToolTip(button);
+    }
+    else
+    {
+        const QString detail =
+            index.data(ArchiveListModel::DetailRole).toString();
+        if(detailRect(option.rect, detail).contains(event->pos()))
+            text = index.data(ArchiveListModel::StatsRole).toString();
+        else
+            text = index.data(Qt::ToolTipRole).toString();
+    }
+
+    if(text.isEmpty())
+        QToolTip::hideText();
+    else
+        QToolTip::showText(event->globalPos(), text, view->viewport(),
+                           option.rect);
+    return (true);
+}
+
+QRect ArchiveListDelegate::buttonRect(const QRect &rowRect, Button button)
+{
+    // Bail (if applicable).
+    if(button == NoButton)
+        return (QRect());
+
+    // The buttons are at the right-hand side, and vertically centered.
+    const int left = rowRect.right() + 1 - MARGIN_H
+                     - (NoButton - button) * BUTTON_SIZE
+                     - (DeleteButton - button) * SPACING;
+    const int top = rowRect.top() + (rowRect.height() - BUTTON_SIZE) / 2;
+    return (QRect(left, top, BUTTON_SIZE, BUTTON_SIZE));
+}
+
+bool ArchiveListDelegate::editorEvent(QEvent                     *event,
+                                      QAbstractItemModel         *model,
+                                      const QStyleOptionViewItem &option,
+                                      const QModelIndex          &index)
+{
+    // Only handle mouse clicks.
+    if((event->type() != QEvent::MouseButtonPress)
+       && (event->type() != QEvent::MouseButtonDblClick)
+       && (event->type() != QEvent::MouseButtonRelease))
+    {
+        return (QStyledItemDelegate::editorEvent(event, model, option, index));
+    }
+
+    // Bail (if applicable).
+    QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+    const Button button     = buttonAt(option.rect, mouseEvent->pos());
+    if((button == NoButton) || (mouseEvent->button() != Qt::LeftButton))
+        return (QStyledItemDelegate::editorEvent(event, model, option, index));
+
+    // Buttons of archives which are being deleted are disabled, but still
+    // don't select the row.
+    if(index.data(ArchiveListModel::DeleteScheduledRole).toBool())
+        return (true);
+
+    // Act on the release, like a QToolButton.
+    if(event->type() == QEvent::MouseButtonRelease)
+    {
+        switch(button)
+        {
+        case InspectButton:
+            emit requestInspect(index);
+            break;
+        case RestoreButton:
+            emit requestRestore(index);
+            break;
+        case DeleteButton:
+            emit requestDelete(index);
+            break;
+        case NoButton:
+            break;
+        }
+    }
+    return (true);
+}
+
+QRect ArchiveListDelegate::detailRect(const QRect   &rowRect,
+                                      const QString &detail) const
+{
+    // The size & date are right-aligned before the separator.
+    const int right = buttonRect(rowRect, InspectButton).left() - 2 * SPACING;
+    const int width = TEXT_WIDTH(QFontMetrics(_detailFont), detail);
+    const int left  = qMax(rowRect.left() + MARGIN_H, right - width);
+    return (QRect(left, rowRect.top() + MARGIN_V, right - left,
+                  rowRect.height() - 2 * MARGIN_V));
+}
+
+QString ArchiveListDelegate::buttonToolTip(Button button) const
+{
+    // Display tooltips using platform-specific strings.
+    QString      toolTip;
+    QKeySequence shortcut;
+    switch(button)
+    {
+    case InspectButton:
+        toolTip  = tr("Display details for this Archive <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+I"));
+        break;
+    case RestoreButton:
+        toolTip  = tr("Restore this Archive <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+S"));
+        break;
+    case DeleteButton:
+        toolTip  = tr("Delete this Archive <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+D"));
+        break;
+    case NoButton:
+        return (QString());
+    }
+    return (toolTip.arg(shortcut.toString(QKeySequence::NativeText)));
+}
+
+ArchiveListDelegate::Button
+ArchiveListDelegate::buttonAt(const QRect &rowRect, const QPoint &pos)
+{
+    for(int b = InspectButton; b < NoButton; b++)
+    {
+        const Button button = static_cast<Button>(b);
+        if(buttonRect(rowRect, button).contains(pos))
+            return (button);
+    }
+    return (NoButton);
+}
+
+QPoint ArchiveListDelegate::hoverPos(const QStyleOptionViewItem &option)
+{
+    // Only the row under the mouse can have a hovered button.
+    const QAbstractItemView *view =
+        qobject_cast<const QAbstractItemView *>(option.widget);
+    if((view == nullptr) || !(option.state & QStyle::State_MouseOver))
+        return (QPoint(-1, -1));
+    return (view->viewport()->mapFromGlobal(QCursor::pos()));
+}
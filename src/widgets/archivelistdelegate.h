@@ -0,0 +1,97 @@
+#ifndef ARCHIVELISTDELEGATE_H
+#define ARCHIVELISTDELEGATE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QFont>
+#include <QIcon>
+#include <QModelIndex>
+#include <QObject>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStyleOptionViewItem>
+#include <QStyledItemDelegate>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class QAbstractItemModel;
+class QAbstractItemView;
+class QEvent;
+class QHelpEvent;
+class QPainter;
+
+/*!
+ * \ingroup widgets-specialized
+ * \brief The ArchiveListDelegate paints the rows of an \ref
+ * ArchiveListModel: the archive name, its size and date, and the inspect,
+ * restore, and delete buttons.
+ *
+ * The buttons are painted rather than being widgets, so a row only costs
+ * anything while it is visible.  Clicking a button emits the matching
+ * request signal; the buttons of archives which are scheduled for deletion
+ * are disabled.
+ */
+class ArchiveListDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    //! The inline buttons, from left to right.
+    enum Button
+    {
+        InspectButton,
+        RestoreButton,
+        DeleteButton,
+        NoButton
+    };
+
+    //! Constructor.
+    explicit ArchiveListDelegate(QObject *parent = nullptr);
+
+    //! Paints the row.
+    void paint(QPainter                   *painter,
+               const QStyleOptionViewItem &option,
+               const QModelIndex          &index) const override;
+    //! Returns the size of a row.
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex          &index) const override;
+    //! Shows the tooltips of the buttons, the name, and the size & date.
+    bool helpEvent(QHelpEvent                 *event,
+                   QAbstractItemView          *view,
+                   const QStyleOptionViewItem &option,
+                   const QModelIndex          &index) override;
+
+    //! Returns the area of \c button in a row which covers \c rowRect.
+    static QRect buttonRect(const QRect &rowRect, Button button);
+
+signals:
+    //! The inspect button of the row was clicked.
+    void requestInspect(const QModelIndex &index);
+    //! The restore button of the row was clicked.
+    void requestRestore(const QModelIndex &index);
+    //! The delete button of the row was clicked.
+    void requestDelete(const QModelIndex &index);
+
+protected:
+    //! Handles clicks on the buttons; passes other events on.
+    bool editorEvent(QEvent                     *event,
+                     QAbstractItemModel         *model,
+                     const QStyleOptionViewItem &option,
+                     const QModelIndex          &index) override;
+
+private:
+    QFont _nameFont;
+    QFont _detailFont;
+    QIcon _icons[NoButton];
+
+    QRect   detailRect(const QRect &rowRect, const QString &detail) const;
+    QString buttonToolTip(Button button) const;
+
+    static Button buttonAt(const QRect &rowRect, const QPoint &pos);
+    static QPoint hoverPos(const QStyleOptionViewItem &option);
+};
+
+#endif /* !ARCHIVELISTDELEGATE_H */
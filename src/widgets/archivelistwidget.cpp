@@ -1,99 +1,124 @@
 #include "archivelistwidget.h"
 
 WARNINGS_DISABLE
-#include <algorithm>
-
 #include <QAbstractItemView>
-#include <QDateTime>
+#include <QEvent>
+#include <QItemSelectionModel>
 #include <QKeyEvent>
-#include <QListWidgetItem>
 #include <QMessageBox>
-#include <QRegExp>
+#include <QMouseEvent>
 #include <QSharedPointer>
 #include <Qt>
 WARNINGS_ENABLE
 
 #include "messages/archiverestoreoptions.h"
 
+#include "archivelistmodel.h"
 #include "debug.h"
 #include "persistentmodel/archive.h"
-#include "widgets/archivelistwidgetitem.h"
+#include "widgets/archivelistdelegate.h"
 #include "widgets/restoredialog.h"
 
 #define DELETE_CONFIRMATION_THRESHOLD 10
 
 ArchiveListWidget::ArchiveListWidget(QWidget *parent)
-    : QListWidget(parent), _filter(new QRegExp), _highlightedItem(nullptr)
+    : QListView(parent),
+      _model(new ArchiveListModel(this)),
+      _delegate(new ArchiveListDelegate(this))
 {
-    // Set up filtering archive names.
-    _filter->setCaseSensitivity(Qt::CaseInsensitive);
-    _filter->setPatternSyntax(QRegExp::Wildcard);
+    setModel(_model);
+    setItemDelegate(_delegate);
+    // All rows have the same height, so the view does not need to ask
+    // the delegate about every row.
+    setUniformItemSizes(true);
+    // Highlight the buttons under the mouse.
+    setMouseTracking(true);
+
+    // Connections from the model and the delegate.
+    connect(_model, &ArchiveListModel::countChanged, this,
+            &ArchiveListWidget::countChanged);
+    connect(_delegate, &ArchiveListDelegate::requestDelete, this,
+            &ArchiveListWidget::deleteItem);
+    connect(_delegate, &ArchiveListDelegate::requestInspect, this,
+            &ArchiveListWidget::inspectItem);
+    connect(_delegate, &ArchiveListDelegate::requestRestore, this,
+            &ArchiveListWidget::restoreItem);
 
     // Connection for showing info about an Archive.
-    connect(this, &QListWidget::itemActivated, this,
+    connect(this, &QAbstractItemView::activated, this,
             &ArchiveListWidget::handleItemActivated);
 }
 
 ArchiveListWidget::~ArchiveListWidget()
 {
-    clear();
-    delete _filter;
 }
 
-static bool cmp_timestamp(const ArchivePtr &a, const ArchivePtr &b)
+void ArchiveListWidget::setArchives(QList<ArchivePtr> archives)
 {
-    return (a->timestamp() > b->timestamp());
+    _model->setArchives(archives);
 }
 
-void ArchiveListWidget::setArchives(QList<ArchivePtr> archives)
+void ArchiveListWidget::addArchive(const ArchivePtr &archive)
 {
-    // Sort archive list.
-    std::sort(archives.begin(), archives.end(), cmp_timestamp);
-
-    // Clear existing list and add archives (in sorted order).
-    setUpdatesEnabled(false);
-    clear();
-    for(const ArchivePtr &archive : archives)
-        insertArchive(archive, count());
-    setUpdatesEnabled(true);
+    _model->addArchive(archive);
 }
 
-void ArchiveListWidget::addArchive(const ArchivePtr &archive)
+void ArchiveListWidget::applyChanges(const ArchiveChanges &changes)
+{
+    _model->applyChanges(changes);
+}
+
+int ArchiveListWidget::count() const
+{
+    return (_model->count());
+}
+
+QList<ArchivePtr> ArchiveListWidget::selectedArchives() const
+{
+    QList<ArchivePtr> archives;
+    for(const QModelIndex &index : selectionModel()->selectedRows())
+        archives.append(archiveAt(index));
+    return (archives);
+}
+
+QList<ArchivePtr> ArchiveListWidget::archivesToCompare() const
 {
+    const QList<ArchivePtr> selected = selectedArchives();
+    QList<ArchivePtr>       archives;
+    if(selected.count() == 1)
+        archives << _model->previousArchive(selected.first())
+                 << selected.first();
+    else if((selected.count() == 2)
+            && (selected.at(0)->timestamp() > selected.at(1)->timestamp()))
+        archives << selected.at(1) << selected.at(0);
+    else if(selected.count() == 2)
+        archives = selected;
+
     // Bail (if applicable).
-    if(!archive)
-    {
-        DEBUG << "Null ArchivePtr passed.";
-        return;
-    }
+    if((archives.count() != 2) || !archives.at(0) || !archives.at(1))
+        return (QList<ArchivePtr>());
 
-    // Find insertion position based on sorted timestamps.
-    int pos = 0;
-    for(; pos < count(); ++pos)
-    {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item(pos));
-        if(archiveItem
-           && (archive->timestamp() > archiveItem->archive()->timestamp()))
-        {
-            break;
-        }
-    }
-    insertArchive(archive, pos);
+    return (archives);
 }
 
-void ArchiveListWidget::deleteItem()
+void ArchiveListWidget::compareSelectedItems()
 {
-    // Get item requesting the deletion.
-    ArchiveListWidgetItem *archiveItem =
-        qobject_cast<ArchiveListWidgetItem *>(sender());
+    const QList<ArchivePtr> archives = archivesToCompare();
 
     // Bail (if applicable).
-    if(!archiveItem)
+    if(archives.isEmpty())
         return;
 
-    // Get archive name.
-    ArchivePtr archive = archiveItem->archive();
+    emit compareArchives(archives.at(0), archives.at(1));
+}
+
+void ArchiveListWidget::deleteItem(const QModelIndex &index)
+{
+    ArchivePtr archive = archiveAt(index);
+
+    // Bail (if applicable).
+    if(!archive)
+        return;
 
     // Confirm deletion.
     QMessageBox::StandardButton confirm =
@@ -112,21 +137,21 @@ void ArchiveListWidget::deleteItem()
 
 void ArchiveListWidget::deleteSelectedItems()
 {
+    const QList<ArchivePtr> selected = selectedArchives();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
     // Any archives pending deletion in the selection? if so deny action
-    for(QListWidgetItem *item : selectedItems())
+    for(const ArchivePtr &archive : selected)
     {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item);
-        if(!archiveItem || archiveItem->archive()->deleteScheduled())
+        if(!archive || archive->deleteScheduled())
             return;
     }
 
     // Confirm deletion.
-    int selectedItemsCount = selectedItems().count();
+    int selectedItemsCount = selected.count();
 
     QMessageBox::StandardButton confirm =
         QMessageBox::question(this, tr("Confirm delete"),
@@ -166,156 +191,69 @@ void ArchiveListWidget::deleteSelectedItems()
         return;
 
     // Schedule archives for deletion.
-    QList<ArchivePtr> archivesToDelete;
-    for(QListWidgetItem *item : selectedItems())
-    {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item);
-        archivesToDelete.append(archiveItem->archive());
-    }
-    if(!archivesToDelete.isEmpty())
-        emit deleteArchives(archivesToDelete);
+    emit deleteArchives(selected);
 }
 
 void ArchiveListWidget::inspectSelectedItem()
 {
+    const QList<ArchivePtr> selected = selectedArchives();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
-    ArchiveListWidgetItem *archiveItem =
-        static_cast<ArchiveListWidgetItem *>(selectedItems().first());
-    if(archiveItem && !archiveItem->archive()->deleteScheduled())
-        goingToInspectItem(archiveItem);
+    ArchivePtr archive = selected.first();
+    if(archive && !archive->deleteScheduled())
+        goingToInspectItem(archive);
 }
 
 void ArchiveListWidget::restoreSelectedItem()
 {
+    const QList<ArchivePtr> selected = selectedArchives();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
-    // Get first selected item.
-    ArchiveListWidgetItem *archiveItem =
-        static_cast<ArchiveListWidgetItem *>(selectedItems().first());
+    // Get first selected archive.
+    ArchivePtr archive = selected.first();
 
     // Bail (if applicable).
-    if(!archiveItem || archiveItem->archive()->deleteScheduled())
+    if(!archive || archive->deleteScheduled())
         return;
 
-    // Launch RestoreDialog.
-    RestoreDialog *restoreDialog =
-        new RestoreDialog(this, archiveItem->archive());
-    connect(restoreDialog, &RestoreDialog::accepted, [this, restoreDialog] {
-        emit restoreArchive(restoreDialog->archive(),
-                            restoreDialog->getOptions());
-    });
-    restoreDialog->show();
+    showRestoreDialog(archive);
 }
 
 void ArchiveListWidget::setFilter(const QString &regex)
 {
-    // Set up filter.
-    setUpdatesEnabled(false);
+    // Check archives against filter; this notifies about the number of
+    // visible items.
     clearSelection();
-    _filter->setPattern(regex);
-
-    // Check archives against filter.
-    for(int i = 0; i < count(); ++i)
-    {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item(i));
-        if(archiveItem)
-        {
-            if(archiveItem->archive()->name().contains(*_filter))
-                archiveItem->setHidden(false);
-            else
-                archiveItem->setHidden(true);
-        }
-    }
-    setUpdatesEnabled(true);
-
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
+    _model->setFilter(regex);
 }
 
-void ArchiveListWidget::removeItem()
+void ArchiveListWidget::inspectItem(const QModelIndex &index)
 {
-    ArchiveListWidgetItem *archiveItem =
-        qobject_cast<ArchiveListWidgetItem *>(sender());
-    // Bail (if applicable).
-    if(!archiveItem)
-        return;
-
-    // Remove item from the list.
-    delete archiveItem;
-
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
+    ArchivePtr archive = archiveAt(index);
+    if(archive)
+        goingToInspectItem(archive);
 }
 
-void ArchiveListWidget::insertArchive(const ArchivePtr &archive, int pos)
+void ArchiveListWidget::restoreItem(const QModelIndex &index)
 {
+    ArchivePtr archive = archiveAt(index);
     // Bail (if applicable).
     if(!archive)
-    {
-        DEBUG << "Null ArchivePtr passed.";
         return;
-    }
-
-    // Create new item.
-    ArchiveListWidgetItem *item = new ArchiveListWidgetItem(archive);
-    connect(item, &ArchiveListWidgetItem::requestDelete, this,
-            &ArchiveListWidget::deleteItem);
-    connect(item, &ArchiveListWidgetItem::requestInspect, this,
-            &ArchiveListWidget::inspectItem);
-    connect(item, &ArchiveListWidgetItem::requestRestore, this,
-            &ArchiveListWidget::restoreItem);
-    connect(item, &ArchiveListWidgetItem::requestGoToJob, this,
-            &ArchiveListWidget::goToJob);
-    connect(item, &ArchiveListWidgetItem::removeItem, this,
-            &ArchiveListWidget::removeItem);
-
-    // Add it to the list at the indicated position.
-    insertItem(pos, item);
-    setItemWidget(item, item->widget());
-
-    // Check it against the name filter.
-    item->setHidden(!archive->name().contains(*_filter));
-
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
-}
 
-int ArchiveListWidget::visibleItemsCount()
-{
-    // Find the number of items which are not hidden.
-    int count = 0;
-    for(QListWidgetItem *item : findItems("*", Qt::MatchWildcard))
-    {
-        if(item && !item->isHidden())
-            count++;
-    }
-    return (count);
-}
-
-void ArchiveListWidget::inspectItem()
-{
-    if(sender())
-        goingToInspectItem(qobject_cast<ArchiveListWidgetItem *>(sender()));
+    showRestoreDialog(archive);
 }
 
-void ArchiveListWidget::restoreItem()
+void ArchiveListWidget::showRestoreDialog(const ArchivePtr &archive)
 {
-    ArchiveListWidgetItem *archiveItem =
-        qobject_cast<ArchiveListWidgetItem *>(sender());
-    // Bail (if applicable).
-    if(!archiveItem)
-        return;
-
     // Launch RestoreDialog.
-    RestoreDialog *restoreDialog =
-        new RestoreDialog(this, archiveItem->archive());
+    RestoreDialog *restoreDialog = new RestoreDialog(this, archive);
     connect(restoreDialog, &RestoreDialog::accepted, [this, restoreDialog] {
         emit restoreArchive(restoreDialog->archive(),
                             restoreDialog->getOptions());
@@ -323,15 +261,6 @@ void ArchiveListWidget::restoreItem()
     restoreDialog->show();
 }
 
-void ArchiveListWidget::goToJob()
-{
-    // Notify that we want to display the Job.
-    if(sender())
-        emit displayJobDetails(qobject_cast<ArchiveListWidgetItem *>(sender())
-                                   ->archive()
-                                   ->jobRef());
-}
-
 void ArchiveListWidget::selectArchive(const ArchivePtr &archive)
 {
     // Bail (if applicable).
@@ -341,23 +270,29 @@ void ArchiveListWidget::selectArchive(const ArchivePtr &archive)
         return;
     }
 
-    // Find the archive in the list.
-    for(int i = 0; i < count(); ++i)
+    // Find the archive in the list; the same archive might be a different
+    // object, e.g. after reloading the archives.
+    int row = _model->rowOf(archive.data());
+    if(row == -1)
     {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item(i));
-        if(archiveItem
-           && (archiveItem->archive()->objectKey() == archive->objectKey()))
+        for(int i = 0; i < _model->rowCount(); ++i)
         {
-            // Select the desired archive.
-            clearSelection();
-            setCurrentItem(archiveItem);
-
-            // Make sure the scroll are includes the archive.
-            scrollToItem(currentItem(), QAbstractItemView::EnsureVisible);
-            break;
+            if(_model->archive(i)->objectKey() == archive->objectKey())
+            {
+                row = i;
+                break;
+            }
         }
     }
+    if(row == -1)
+        return;
+
+    // Select the desired archive.
+    clearSelection();
+    setCurrentIndex(_model->index(row));
+
+    // Make sure the scroll are includes the archive.
+    scrollTo(currentIndex(), QAbstractItemView::EnsureVisible);
 }
 
 void ArchiveListWidget::keyPressEvent(QKeyEvent *event)
@@ -368,96 +303,93 @@ void ArchiveListWidget::keyPressEvent(QKeyEvent *event)
         deleteSelectedItems();
         break;
     case Qt::Key_Escape:
-        if(!selectedItems().isEmpty())
+        if(selectionModel()->hasSelection())
             clearSelection();
         else
-            QListWidget::keyPressEvent(event);
+            QListView::keyPressEvent(event);
         break;
     default:
-        QListWidget::keyPressEvent(event);
+        QListView::keyPressEvent(event);
     }
 }
 
-void ArchiveListWidget::noInspect()
+void ArchiveListWidget::mouseMoveEvent(QMouseEvent *event)
 {
-    // Bail (if applicable).
-    if(_highlightedItem == nullptr)
-        return;
+    QListView::mouseMoveEvent(event);
+
+    // The view only repaints a row when the mouse enters or leaves it.
+    const QModelIndex index = indexAt(event->pos());
+    if(index.isValid())
+        update(index);
+}
 
-    // Indicate to the item that we're not showing it any more.
-    _highlightedItem->setShowingDetails(false);
-    _highlightedItem = nullptr;
+void ArchiveListWidget::changeEvent(QEvent *event)
+{
+    // The rows are translated when they are painted.
+    if(event->type() == QEvent::LanguageChange)
+        viewport()->update();
+    QListView::changeEvent(event);
 }
 
-void ArchiveListWidget::goingToInspectItem(ArchiveListWidgetItem *archiveItem)
+void ArchiveListWidget::noInspect()
 {
-    // Disable previous highlighting
-    if(_highlightedItem != nullptr)
-        _highlightedItem->setShowingDetails(false);
+    // Indicate that we're not showing any archive any more.
+    _model->setShowingDetails(ArchivePtr());
+}
 
+void ArchiveListWidget::goingToInspectItem(const ArchivePtr &archive)
+{
     // Toggle visibility (if already visible)
-    if(_highlightedItem == archiveItem)
+    if(_model->showingDetails() == archive)
     {
-        _highlightedItem = nullptr;
+        _model->setShowingDetails(ArchivePtr());
         emit clearInspectArchive();
         return;
     }
 
     // Highlight new item
-    _highlightedItem = archiveItem;
-    _highlightedItem->setShowingDetails(true);
+    _model->setShowingDetails(archive);
 
-    emit inspectArchive(archiveItem->archive());
+    emit inspectArchive(archive);
 }
 
 void ArchiveListWidget::ensureCurrentItemVisible()
 {
-    scrollToItem(currentItem(), QAbstractItemView::EnsureVisible);
+    scrollTo(currentIndex(), QAbstractItemView::EnsureVisible);
 }
 
-void ArchiveListWidget::handleItemActivated(QListWidgetItem *item)
+void ArchiveListWidget::handleItemActivated(const QModelIndex &index)
 {
-    ArchiveListWidgetItem *archiveItem =
-        static_cast<ArchiveListWidgetItem *>(item);
+    ArchivePtr archive = archiveAt(index);
 
     // Sanity check
-    if(!archiveItem)
+    if(!archive)
     {
-        DEBUG << "ArchiveListWidget::handleItemActivated(nullptr)";
+        DEBUG << "ArchiveListWidget::handleItemActivated(invalid index)";
         return;
     }
 
     // Toggle showing details about the item if it's being deleted
-    if(!archiveItem->archive()->deleteScheduled())
-        goingToInspectItem(archiveItem);
+    if(!archive->deleteScheduled())
+        goingToInspectItem(archive);
 }
 
 ArchivePtr ArchiveListWidget::findArchiveByName(const QString &archiveName)
 {
-    // Find the archive name in the list.
-    for(int i = 0; i < count(); i++)
-    {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item(i));
-        if(archiveName == archiveItem->archive()->name())
-            return (archiveItem->archive());
-    }
-
-    // We couldn't find the name.
-#if(QT_VERSION >= QT_VERSION_CHECK(5, 8, 0))
-    return (nullptr);
-#else
-    return (ArchivePtr(nullptr));
-#endif
+    return (_model->findArchiveByName(archiveName));
 }
 
 void ArchiveListWidget::updateIEC()
 {
-    // Update all items.
-    for(int i = 0; i < count(); i++)
-    {
-        ArchiveListWidgetItem *archiveItem =
-            static_cast<ArchiveListWidgetItem *>(item(i));
-        archiveItem->updateIEC();
-    }
+    // The sizes are formatted when the rows are painted.
+    _model->refresh();
+}
+
+ArchivePtr ArchiveListWidget::archiveAt(const QModelIndex &index) const
+{
+    // Bail (if applicable).
+    if(!index.isValid())
+        return (ArchivePtr());
+
+    return (_model->archive(index.row()));
 }
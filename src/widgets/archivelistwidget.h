@@ -5,24 +5,33 @@
 
 WARNINGS_DISABLE
 #include <QList>
-#include <QListWidget>
+#include <QListView>
+#include <QModelIndex>
 #include <QObject>
 #include <QString>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
+#include "messages/changeset.h"
 
 /* Forward declaration(s). */
-class ArchiveListWidgetItem;
+class ArchiveListDelegate;
+class ArchiveListModel;
+class QEvent;
+class QKeyEvent;
+class QMouseEvent;
 class QWidget;
 
 /*!
  * \ingroup widgets-specialized
- * \brief The ArchiveListWidget is a QListWidget which displays
+ * \brief The ArchiveListWidget is a QListView which displays
  * information about all archives.
+ *
+ * The archives are stored in an \ref ArchiveListModel, and each row is
+ * painted by an \ref ArchiveListDelegate.
  */
-class ArchiveListWidget : public QListWidget
+class ArchiveListWidget : public QListView
 {
     Q_OBJECT
 
@@ -40,11 +49,25 @@ public:
     //! Reload the IEC prefix preference and re-display number(s).
     void updateIEC();
 
+    //! Returns the number of archives, including those which are hidden
+    //! by the filter.
+    int count() const;
+    //! Returns the selected archives.
+    QList<ArchivePtr> selectedArchives() const;
+    //! Returns the older and newer archive to compare: the two selected
+    //! archives, or the selected archive and the previous archive of its
+    //! Job.  The list is empty if there is nothing to compare.
+    QList<ArchivePtr> archivesToCompare() const;
+
 public slots:
     //! Clears the archive list, then sets it to the specified archives
     void setArchives(QList<ArchivePtr> archives);
     //! Adds an archive to the list.
     void addArchive(const ArchivePtr &archive);
+    //! Updates the list with the changes (or snapshot) from the
+    //! \ref BackendData.  Archives which did not change are kept, and sets
+    //! which are not newer than the list are ignored.
+    void applyChanges(const ArchiveChanges &changes);
     //! Sets the current selection in the list view.
     void selectArchive(const ArchivePtr &archive);
     //! Delete the selected archives.
@@ -53,6 +76,9 @@ public slots:
     void inspectSelectedItem();
     //! Restore the first of the selected archives.
     void restoreSelectedItem();
+    //! Compare the contents of the selected archives (see
+    //! \ref archivesToCompare).
+    void compareSelectedItems();
     //! Filter the list of archives.
     void setFilter(const QString &regex);
     //! There are no archive details being shown.
@@ -72,6 +98,9 @@ signals:
     void restoreArchive(ArchivePtr archive, ArchiveRestoreOptions options);
     //! Notify that the job details should be displayed.
     void displayJobDetails(const QString &jobRef);
+    //! Notify that the changes from archive \c from to archive \c to
+    //! should be shown.
+    void compareArchives(ArchivePtr from, ArchivePtr to);
     //! Notify the total and visible (not hidden) items count on list change
     //! (item added, removed or hidden).
     void countChanged(int countTotal, int countVisible);
@@ -79,23 +108,24 @@ signals:
 protected:
     //! Handles the delete and escape keys; passes other events on.
     void keyPressEvent(QKeyEvent *event) override;
+    //! Repaints the row under the mouse, to highlight its buttons.
+    void mouseMoveEvent(QMouseEvent *event) override;
+    //! Handles translation change of language.
+    void changeEvent(QEvent *event) override;
 
 private slots:
-    void deleteItem();
-    void inspectItem();
-    void restoreItem();
-    void goToJob();
-    void removeItem();
-    void handleItemActivated(QListWidgetItem *item);
+    void deleteItem(const QModelIndex &index);
+    void inspectItem(const QModelIndex &index);
+    void restoreItem(const QModelIndex &index);
+    void handleItemActivated(const QModelIndex &index);
 
 private:
-    int  visibleItemsCount();
-    void insertArchive(const ArchivePtr &archive, int pos);
-
-    QRegExp *_filter;
+    ArchiveListModel    *_model;
+    ArchiveListDelegate *_delegate;
 
-    void goingToInspectItem(ArchiveListWidgetItem *archiveItem);
-    ArchiveListWidgetItem *_highlightedItem;
+    ArchivePtr archiveAt(const QModelIndex &index) const;
+    void       showRestoreDialog(const ArchivePtr &archive);
+    void       goingToInspectItem(const ArchivePtr &archive);
 };
 
 #endif // ARCHIVELISTWIDGET_H
@@ -12,6 +12,7 @@ WARNINGS_DISABLE
 #include <QKeySequence>
 #include <QLabel>
 #include <QMenu>
+#include <QTimer>
 #include <QToolButton>
 #include <QWidget>
 #include <Qt>
@@ -21,11 +22,17 @@ WARNINGS_ENABLE
 
 #include "basetask.h"
 #include "persistentmodel/archive.h"
+#include "widgets/archivediffdialog.h"
 #include "widgets/archivelistwidget.h"
 #include "widgets/archivewidget.h"
 
+// Filter the archives once the user has not typed for this long.
+#define FILTER_DELAY_MS 200
+
 ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
-    : QWidget(parent), _ui(new Ui::ArchivesTabWidget)
+    : QWidget(parent),
+      _ui(new Ui::ArchivesTabWidget),
+      _filterUpdate(new QTimer(this))
 {
     // Ui initialization
     _ui->setupUi(this);
@@ -47,6 +54,7 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
     _ui->archiveListWidget->addAction(_ui->actionInspect);
     _ui->archiveListWidget->addAction(_ui->actionDelete);
     _ui->archiveListWidget->addAction(_ui->actionRestore);
+    _ui->archiveListWidget->addAction(_ui->actionCompare);
     connect(_ui->actionRefresh, &QAction::triggered, this,
             &ArchivesTabWidget::getArchives);
     connect(_ui->actionInspect, &QAction::triggered, _ui->archiveListWidget,
@@ -55,6 +63,8 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
             &ArchiveListWidget::deleteSelectedItems);
     connect(_ui->actionRestore, &QAction::triggered, _ui->archiveListWidget,
             &ArchiveListWidget::restoreSelectedItem);
+    connect(_ui->actionCompare, &QAction::triggered, _ui->archiveListWidget,
+            &ArchiveListWidget::compareSelectedItems);
 
     // Connections from the ArchiveListWidget.
     connect(_ui->archiveListWidget, &ArchiveListWidget::inspectArchive, this,
@@ -67,6 +77,8 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
             &ArchivesTabWidget::restoreArchive);
     connect(_ui->archiveListWidget, &ArchiveListWidget::displayJobDetails,
             [this](const QString &jobRef) { emit displayJobDetails(jobRef); });
+    connect(_ui->archiveListWidget, &ArchiveListWidget::compareArchives, this,
+            &ArchivesTabWidget::showArchiveDiff);
     connect(_ui->archiveListWidget, &ArchiveListWidget::countChanged,
             [this](int total, int visible) {
                 _ui->archivesCountLabel->setText(
@@ -74,8 +86,8 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
             });
 
     // Connections to the ArchiveListWidget.
-    connect(this, &ArchivesTabWidget::archiveList, _ui->archiveListWidget,
-            &ArchiveListWidget::setArchives);
+    connect(this, &ArchivesTabWidget::archiveChanges, _ui->archiveListWidget,
+            &ArchiveListWidget::applyChanges);
     connect(this, &ArchivesTabWidget::addArchive, _ui->archiveListWidget,
             &ArchiveListWidget::addArchive);
 
@@ -86,14 +98,22 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
             _ui->archiveListWidget, &ArchiveListWidget::noInspect);
     connect(_ui->archiveDetailsWidget, &ArchiveDetailsWidget::taskRequested,
             this, &ArchivesTabWidget::taskRequested);
+    connect(_ui->archiveDetailsWidget,
+            &ArchiveDetailsWidget::cancelTaskRequested, this,
+            &ArchivesTabWidget::cancelTaskRequested);
     connect(_ui->archiveDetailsWidget, &ArchiveDetailsWidget::jobClicked,
             [this](const QString &jobRef) { emit jobClicked(jobRef); });
 
     // Filtering.
     _ui->archiveListWidget->addAction(_ui->actionFilterArchives);
     _ui->archivesFilterButton->setDefaultAction(_ui->actionFilterArchives);
+    _filterUpdate->setSingleShot(true);
+    _filterUpdate->setInterval(FILTER_DELAY_MS);
+    connect(_filterUpdate, &QTimer::timeout, [this]() {
+        _ui->archiveListWidget->setFilter(_ui->archivesFilter->currentText());
+    });
     connect(_ui->archivesFilter, &QComboBox::editTextChanged,
-            _ui->archiveListWidget, &ArchiveListWidget::setFilter);
+            [this]() { _filterUpdate->start(); });
     connect(_ui->actionFilterArchives, &QAction::triggered, [this]() {
         _ui->archivesFilterFrame->setVisible(
             !_ui->archivesFilterFrame->isVisible());
@@ -102,8 +122,6 @@ ArchivesTabWidget::ArchivesTabWidget(QWidget *parent)
         else
             _ui->archivesFilter->clearEditText();
     });
-    connect(_ui->archivesFilter, &QComboBox::editTextChanged,
-            _ui->archiveListWidget, &ArchiveListWidget::setFilter);
     connect(_ui->archivesFilter,
             static_cast<void (QComboBox::*)(int)>(
                 &QComboBox::currentIndexChanged),
@@ -168,7 +186,7 @@ void ArchivesTabWidget::displayInspectArchive(const ArchivePtr &archive)
         emit loadArchiveStats(archive);
 
     // Get the file list.
-    if(archive->contents().count() == 0)
+    if(!archive->hasContents())
         emit loadArchiveContents(archive);
 
     // Highlight the row in the ArchiveListWidget.
@@ -195,13 +213,15 @@ void ArchivesTabWidget::showArchiveListMenu()
 {
     // Construct menu.
     _archiveListMenu->clear();
-    if(!_ui->archiveListWidget->selectedItems().isEmpty())
+    if(!_ui->archiveListWidget->selectedArchives().isEmpty())
     {
-        if(_ui->archiveListWidget->selectedItems().count() == 1)
+        if(_ui->archiveListWidget->selectedArchives().count() == 1)
         {
             _archiveListMenu->addAction(_ui->actionInspect);
             _archiveListMenu->addAction(_ui->actionRestore);
         }
+        if(!_ui->archiveListWidget->archivesToCompare().isEmpty())
+            _archiveListMenu->addAction(_ui->actionCompare);
         _archiveListMenu->addAction(_ui->actionDelete);
     }
     _archiveListMenu->addAction(_ui->actionRefresh);
@@ -210,6 +230,20 @@ void ArchivesTabWidget::showArchiveListMenu()
     _archiveListMenu->popup(QCursor::pos());
 }
 
+void ArchivesTabWidget::showArchiveDiff(const ArchivePtr &from,
+                                        const ArchivePtr &to)
+{
+    ArchiveDiffDialog *dialog = new ArchiveDiffDialog(from, to, this);
+    connect(dialog, &ArchiveDiffDialog::loadArchiveContents, this,
+            &ArchivesTabWidget::loadArchiveContents);
+    connect(dialog, &ArchiveDiffDialog::taskRequested, this,
+            &ArchivesTabWidget::taskRequested);
+    connect(dialog, &ArchiveDiffDialog::cancelTaskRequested, this,
+            &ArchivesTabWidget::cancelTaskRequested);
+    dialog->show();
+    dialog->compare();
+}
+
 void ArchivesTabWidget::updateKeyboardShortcutInfo()
 {
     _ui->actionFilterArchives->setToolTip(
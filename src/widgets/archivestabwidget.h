@@ -7,11 +7,13 @@ WARNINGS_DISABLE
 #include <QList>
 #include <QObject>
 #include <QString>
+#include <QUuid>
 #include <QWidget>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
+#include "messages/changeset.h"
 
 /* Forward declaration(s). */
 namespace Ui
@@ -21,6 +23,7 @@ class ArchivesTabWidget;
 class BaseTask;
 class QEvent;
 class QMenu;
+class QTimer;
 
 /*!
  * \ingroup widgets-main
@@ -61,8 +64,8 @@ signals:
     void restoreArchive(const ArchivePtr     &archive,
                         ArchiveRestoreOptions options);
 
-    //! Passes the list of all Archive objects to the ArchiveListWidget.
-    void archiveList(QList<ArchivePtr> archives);
+    //! Passes the changes to the Archive objects to the ArchiveListWidget.
+    void archiveChanges(const ArchiveChanges &changes);
     //! Passes the creation of a new Archive to the ArchiveListWidget.
     void addArchive(const ArchivePtr &archive);
 
@@ -79,6 +82,8 @@ signals:
 
     //! We have a task to perform in the background.
     void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
 
 protected:
     //! Handles translation change of language.
@@ -88,11 +93,14 @@ protected:
 
 private slots:
     void showArchiveListMenu();
+    void showArchiveDiff(const ArchivePtr &from, const ArchivePtr &to);
 
 private:
     Ui::ArchivesTabWidget *_ui;
 
     QMenu *_archiveListMenu;
+    // Delays filtering until the user stops typing.
+    QTimer *_filterUpdate;
 
     void updateKeyboardShortcutInfo();
 };
@@ -15,10 +15,10 @@ WARNINGS_DISABLE
 #include <QModelIndexList>
 #include <QPushButton>
 #include <QSharedPointer>
-#include <QSortFilterProxyModel>
 #include <QStringList>
 #include <QTableView>
 #include <QToolButton>
+#include <QTreeView>
 #include <QVariant>
 #include <Qt>
 
@@ -27,10 +27,13 @@ WARNINGS_ENABLE
 
 #include "TElidedLabel.h"
 
+#include "messages/archivelistingptr.h"
 #include "messages/archiverestoreoptions.h"
 
 #include "basetask.h"
 #include "filetablemodel.h"
+#include "filetableproxymodel.h"
+#include "filetreemodel.h"
 #include "humanbytes.h"
 #include "persistentmodel/archive.h"
 #include "widgets/elidedclickablelabel.h"
@@ -43,7 +46,8 @@ ArchiveDetailsWidget::ArchiveDetailsWidget(QWidget *parent)
       _ui(new Ui::ArchiveDetailsWidget),
       _archive(nullptr),
       _contentsModel(new FileTableModel(this)),
-      _proxyModel(new QSortFilterProxyModel(_contentsModel)),
+      _proxyModel(new FileTableProxyModel(_contentsModel)),
+      _treeModel(new FileTreeModel(this)),
       _fileMenu(new QMenu(this))
 {
     _ui->setupUi(this);
@@ -51,12 +55,15 @@ ArchiveDetailsWidget::ArchiveDetailsWidget(QWidget *parent)
 
     // Set up filter UI.
     _ui->filterComboBox->hide();
-    _proxyModel->setDynamicSortFilter(false);
-    _proxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
-    _proxyModel->setSourceModel(_contentsModel);
     _ui->archiveContentsTableView->setModel(_proxyModel);
     _ui->archiveContentsTableView->setContextMenuPolicy(Qt::CustomContextMenu);
 
+    // Set up the contents by directory; the tree is only built when it is
+    // shown.
+    _ui->archiveContentsTreeView->hide();
+    _ui->archiveContentsTreeView->setModel(_treeModel);
+    _ui->archiveContentsTreeView->setContextMenuPolicy(Qt::CustomContextMenu);
+
     // Set up other UI.
     _fileMenu->addAction(_ui->actionRestoreFiles);
 
@@ -68,10 +75,23 @@ ArchiveDetailsWidget::ArchiveDetailsWidget(QWidget *parent)
             &ArchiveDetailsWidget::restoreFiles);
     connect(_ui->archiveContentsTableView, &QTableView::activated, this,
             &ArchiveDetailsWidget::restoreFiles);
+    connect(_ui->archiveContentsTreeView,
+            &QTreeView::customContextMenuRequested, this,
+            &ArchiveDetailsWidget::showContextMenu);
+    connect(_ui->treeButton, &QToolButton::toggled, this,
+            &ArchiveDetailsWidget::showTree);
     connect(_ui->hideButton, &QPushButton::clicked, this,
             &ArchiveDetailsWidget::close);
     connect(_contentsModel, &FileTableModel::taskRequested, this,
             &ArchiveDetailsWidget::taskRequested);
+    connect(_proxyModel, &FileTableProxyModel::taskRequested, this,
+            &ArchiveDetailsWidget::taskRequested);
+    connect(_proxyModel, &FileTableProxyModel::cancelTaskRequested, this,
+            &ArchiveDetailsWidget::cancelTaskRequested);
+    connect(_treeModel, &FileTreeModel::taskRequested, this,
+            &ArchiveDetailsWidget::taskRequested);
+    connect(_treeModel, &FileTreeModel::cancelTaskRequested, this,
+            &ArchiveDetailsWidget::cancelTaskRequested);
     connect(_ui->archiveJobLabel, &ElidedClickableLabel::clicked,
             [this]() { emit jobClicked(_archive->jobRef()); });
 
@@ -80,11 +100,20 @@ ArchiveDetailsWidget::ArchiveDetailsWidget(QWidget *parent)
         _ui->archiveContentsTableView->resizeColumnsToContents();
         _ui->archiveContentsLabel->setText(
             tr("Contents (%1)").arg(_contentsModel->rowCount()));
+        if(_ui->treeButton->isChecked())
+            _treeModel->setListing(_contentsModel->listing());
+        else
+            _treeModel->setListing(ArchiveListingPtr());
+    });
+    connect(_treeModel, &FileTreeModel::modelReset, [this]() {
+        _ui->archiveContentsTreeView->resizeColumnToContents(
+            FileTreeModel::SIZE);
     });
 
-    // Connections for filtering
+    // Connections for filtering; the proxy sorts and filters in the
+    // background.
     connect(_ui->filterComboBox, &QComboBox::editTextChanged, _proxyModel,
-            &QSortFilterProxyModel::setFilterWildcard);
+            &FileTableProxyModel::setFilterWildcard);
     connect(_ui->filterComboBox,
             static_cast<void (QComboBox::*)(int)>(
                 &QComboBox::currentIndexChanged),
@@ -101,6 +130,7 @@ ArchiveDetailsWidget::ArchiveDetailsWidget(QWidget *parent)
 
 ArchiveDetailsWidget::~ArchiveDetailsWidget()
 {
+    delete _treeModel;
     delete _proxyModel;
     delete _contentsModel;
     delete _ui;
@@ -183,7 +213,7 @@ void ArchiveDetailsWidget::updateDetails()
         _ui->infoLabel->setToolTip(_archive->truncatedInfo());
         _ui->infoLabel->show();
     }
-    else if(_archive->contents().isEmpty()
+    else if(!_archive->hasContents()
             && (_archive->sizeTotal() < EMPTY_TAR_ARCHIVE_BYTES))
     {
         // Warn about a potentially empty archive.
@@ -259,15 +289,17 @@ void ArchiveDetailsWidget::showContextMenu()
 void ArchiveDetailsWidget::restoreFiles()
 {
     // Get selected items, and bail if there's none.
+    const bool      tree = _ui->treeButton->isChecked();
     QModelIndexList indexes =
-        _ui->archiveContentsTableView->selectionModel()->selectedRows();
+        tree ? _ui->archiveContentsTreeView->selectionModel()->selectedRows()
+             : _ui->archiveContentsTableView->selectionModel()->selectedRows();
     if(indexes.isEmpty())
         return;
 
-    // Convert items to filenames.
+    // Convert items to filenames; a directory restores everything in it.
     QStringList files;
     for(const QModelIndex &index : indexes)
-        files << index.data().toString();
+        files << (tree ? _treeModel->path(index) : index.data().toString());
 
     // Launch RestoreDialog.
     RestoreDialog *restoreDialog = new RestoreDialog(this, _archive, files);
@@ -279,6 +311,20 @@ void ArchiveDetailsWidget::restoreFiles()
     restoreDialog->show();
 }
 
+void ArchiveDetailsWidget::showTree(bool show)
+{
+    // The filter only applies to the list of files.
+    if(show && _ui->filterButton->isChecked())
+        _ui->filterButton->toggle();
+    _ui->filterButton->setVisible(!show);
+    _ui->archiveContentsTableView->setVisible(!show);
+    _ui->archiveContentsTreeView->setVisible(show);
+
+    // Build the tree when it is first needed, and release it afterwards.
+    _treeModel->setListing(show ? _contentsModel->listing()
+                                : ArchiveListingPtr());
+}
+
 void ArchiveDetailsWidget::updateKeyboardShortcutInfo()
 {
     _ui->hideButton->setToolTip(_ui->hideButton->toolTip().arg(
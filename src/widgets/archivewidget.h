@@ -6,6 +6,7 @@
 WARNINGS_DISABLE
 #include <QObject>
 #include <QString>
+#include <QUuid>
 #include <QWidget>
 WARNINGS_ENABLE
 
@@ -19,11 +20,12 @@ class ArchiveDetailsWidget;
 }
 class BaseTask;
 class FileTableModel;
+class FileTableProxyModel;
+class FileTreeModel;
 class QCloseEvent;
 class QEvent;
 class QKeyEvent;
 class QMenu;
-class QSortFilterProxyModel;
 
 /*!
  * \ingroup widgets-specialized
@@ -63,6 +65,8 @@ signals:
     void hidden();
     //! We have a task to perform in the background.
     void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
 
 protected:
     //! This widget is closing; release memory.
@@ -76,12 +80,14 @@ private slots:
     void showContextMenu();
     void restoreFiles();
     void updateDetails();
+    void showTree(bool show);
 
 private:
     Ui::ArchiveDetailsWidget *_ui;
     ArchivePtr                _archive;
     FileTableModel           *_contentsModel;
-    QSortFilterProxyModel    *_proxyModel;
+    FileTableProxyModel      *_proxyModel;
+    FileTreeModel            *_treeModel;
     QMenu                    *_fileMenu;
 
     void updateKeyboardShortcutInfo();
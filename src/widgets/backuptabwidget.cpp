@@ -94,6 +94,10 @@ BackupTabWidget::BackupTabWidget(QWidget *parent)
             &BackupTabWidget::taskRequested);
     connect(_ui->backupListWidget, &BackupListWidget::cancelTaskRequested, this,
             &BackupTabWidget::cancelTaskRequested);
+    connect(_filePickerDialog, &FilePickerDialog::taskRequested, this,
+            &BackupTabWidget::taskRequested);
+    connect(_filePickerDialog, &FilePickerDialog::cancelTaskRequested, this,
+            &BackupTabWidget::cancelTaskRequested);
 }
 
 BackupTabWidget::~BackupTabWidget()
@@ -1,25 +1,66 @@
 #include "consolelogdialog.h"
 
 WARNINGS_DISABLE
+#include <QAbstractItemModel>
+#include <QAction>
+#include <QApplication>
+#include <QClipboard>
 #include <QDateTime>
 #include <QDialog>
 #include <QDialogButtonBox>
+#include <QItemSelectionModel>
+#include <QKeySequence>
+#include <QLineEdit>
+#include <QListView>
+#include <QModelIndex>
+#include <QModelIndexList>
+#include <QScrollBar>
+#include <QStringList>
+#include <QVariant>
+#include <Qt>
 
 #include "ui_consolelogdialog.h"
 WARNINGS_ENABLE
 
-#include "LogEntry.h"
-#include "TTextView.h"
+#include <algorithm>
+
+#include "consolelogmodel.h"
 
 ConsoleLogDialog::ConsoleLogDialog(QWidget *parent)
-    : QDialog(parent), _ui(new Ui::ConsoleLogDialog)
+    : QDialog(parent),
+      _ui(new Ui::ConsoleLogDialog),
+      _model(new ConsoleLogModel(this)),
+      _followTail(true)
 {
     // Ui initialization
     _ui->setupUi(this);
+    _ui->consoleLogListView->setModel(_model);
+    _ui->consoleLogListView->setLayoutMode(QListView::Batched);
 
     // Connect the Ok button
     connect(_ui->buttonBox, &QDialogButtonBox::accepted, this,
             &QDialog::accept);
+
+    // Filter
+    connect(_ui->filterLineEdit, &QLineEdit::textChanged, _model,
+            &ConsoleLogModel::setFilter);
+
+    // Keep showing the newest lines, unless the user scrolled up.
+    connect(_model, &QAbstractItemModel::rowsAboutToBeInserted, this,
+            &ConsoleLogDialog::aboutToAddLines);
+    connect(_model, &QAbstractItemModel::rowsInserted, this,
+            &ConsoleLogDialog::linesAdded);
+    connect(_model, &QAbstractItemModel::modelReset,
+            _ui->consoleLogListView, &QListView::scrollToBottom);
+
+    // Copy
+    QAction *copyAction = new QAction(tr("Copy"), this);
+    copyAction->setShortcut(QKeySequence::Copy);
+    copyAction->setShortcutContext(Qt::WidgetShortcut);
+    _ui->consoleLogListView->addAction(copyAction);
+    _ui->consoleLogListView->setContextMenuPolicy(Qt::ActionsContextMenu);
+    connect(copyAction, &QAction::triggered, this,
+            &ConsoleLogDialog::copySelectedLines);
 }
 
 ConsoleLogDialog::~ConsoleLogDialog()
@@ -29,6 +70,36 @@ ConsoleLogDialog::~ConsoleLogDialog()
 
 void ConsoleLogDialog::appendLogString(const QString &text)
 {
-    _ui->consoleLogTextView->appendLog(
-        LogEntry{QDateTime::currentDateTime(), text});
+    _model->appendMessage(QDateTime::currentDateTime(), text);
+}
+
+void ConsoleLogDialog::aboutToAddLines()
+{
+    QScrollBar *scrollBar = _ui->consoleLogListView->verticalScrollBar();
+    _followTail           = (scrollBar->value() == scrollBar->maximum());
+}
+
+void ConsoleLogDialog::linesAdded()
+{
+    // Bail (if applicable).
+    if(!_followTail)
+        return;
+
+    _ui->consoleLogListView->scrollToBottom();
+}
+
+void ConsoleLogDialog::copySelectedLines()
+{
+    QModelIndexList selected =
+        _ui->consoleLogListView->selectionModel()->selectedRows();
+
+    // Bail (if applicable).
+    if(selected.isEmpty())
+        return;
+
+    std::sort(selected.begin(), selected.end());
+    QStringList lines;
+    for(const QModelIndex &index : selected)
+        lines << index.data(Qt::DisplayRole).toString();
+    QApplication::clipboard()->setText(lines.join('\n'));
 }
@@ -14,11 +14,15 @@ namespace Ui
 {
 class ConsoleLogDialog;
 }
+class ConsoleLogModel;
 class QWidget;
 
 /*!
  * \ingroup widgets-main
  * \brief The ConsoleLogDialog is a QDialog which shows the console log.
+ *
+ * The lines are kept in a ConsoleLogModel (so only the most recent lines are
+ * kept in memory), and only the visible lines are rendered.
  */
 class ConsoleLogDialog : public QDialog
 {
@@ -33,8 +37,15 @@ public slots:
     //! Append a log message.
     void appendLogString(const QString &text);
 
+private slots:
+    void aboutToAddLines();
+    void linesAdded();
+    void copySelectedLines();
+
 private:
     Ui::ConsoleLogDialog *_ui;
+    ConsoleLogModel      *_model;
+    bool                  _followTail;
 };
 
 #endif // CONSOLELOGDIALOG_H
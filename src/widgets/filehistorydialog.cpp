@@ -0,0 +1,88 @@
+#include "filehistorydialog.h"
+
+WARNINGS_DISABLE
+#include <QDialogButtonBox>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QTableWidget>
+#include <QTableWidgetItem>
+#include <QVector>
+#include <QTimer>
+#include <Qt>
+
+#include "ui_filehistorydialog.h"
+WARNINGS_ENABLE
+
+#include "humanbytes.h"
+
+// Search once the user has not typed for this long.
+#define SEARCH_DELAY_MS 200
+
+FileHistoryDialog::FileHistoryDialog(QWidget *parent)
+    : QDialog(parent),
+      _ui(new Ui::FileHistoryDialog),
+      _searchUpdate(new QTimer(this))
+{
+    // Ui initialization
+    _ui->setupUi(this);
+    _ui->versionsTable->horizontalHeader()->setSectionResizeMode(
+        QHeaderView::ResizeToContents);
+
+    // Connect the Ok button
+    connect(_ui->buttonBox, &QDialogButtonBox::accepted, this,
+            &QDialog::accept);
+
+    // Search
+    _searchUpdate->setSingleShot(true);
+    _searchUpdate->setInterval(SEARCH_DELAY_MS);
+    connect(_searchUpdate, &QTimer::timeout, this, &FileHistoryDialog::search);
+    connect(_ui->searchLineEdit, &QLineEdit::textChanged,
+            [this]() { _searchUpdate->start(); });
+}
+
+FileHistoryDialog::~FileHistoryDialog()
+{
+    delete _ui;
+}
+
+void FileHistoryDialog::setFileVersions(const QString       &pattern,
+                                        QVector<FileVersion> versions)
+{
+    // Bail (if applicable).
+    if(pattern != _ui->searchLineEdit->text().trimmed())
+        return;
+
+    QTableWidget *table = _ui->versionsTable;
+    table->setUpdatesEnabled(false);
+    table->clearContents();
+    table->setRowCount(versions.size());
+    for(int row = 0; row < versions.size(); row++)
+    {
+        const FileVersion &version = versions.at(row);
+        table->setItem(row, 0, new QTableWidgetItem(version.path));
+        table->setItem(row, 1, new QTableWidgetItem(version.archive));
+        table->setItem(row, 2,
+                       new QTableWidgetItem(version.archiveTimestamp.toString(
+                           Qt::DefaultLocaleShortDate)));
+        table->setItem(row, 3, new QTableWidgetItem(humanBytes(version.size)));
+        table->item(row, 3)->setTextAlignment(Qt::AlignRight
+                                              | Qt::AlignVCenter);
+        table->setItem(row, 4, new QTableWidgetItem(version.modified));
+    }
+    table->setUpdatesEnabled(true);
+
+    _ui->resultsLabel->setText(
+        tr("Found %n version(s).", "", versions.size()));
+}
+
+void FileHistoryDialog::search()
+{
+    const QString pattern = _ui->searchLineEdit->text().trimmed();
+    if(pattern.isEmpty())
+    {
+        _ui->versionsTable->setRowCount(0);
+        _ui->resultsLabel->clear();
+        return;
+    }
+    emit findFileVersions(pattern);
+}
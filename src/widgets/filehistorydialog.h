@@ -0,0 +1,57 @@
+#ifndef FILEHISTORYDIALOG_H
+#define FILEHISTORYDIALOG_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QDialog>
+#include <QObject>
+#include <QString>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/fileversion.h"
+
+/* Forward declaration(s). */
+namespace Ui
+{
+class FileHistoryDialog;
+}
+class QTimer;
+class QWidget;
+
+/*!
+ * \ingroup widgets-main
+ * \brief The FileHistoryDialog is a QDialog which searches every archive
+ * for the versions of a file.
+ *
+ * Only the archives whose contents have been fetched are searched (see
+ * \ref FileHistory).  The search starts once the user stops typing.
+ */
+class FileHistoryDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    //! Constructor.
+    explicit FileHistoryDialog(QWidget *parent = nullptr);
+    ~FileHistoryDialog() override;
+
+public slots:
+    //! Shows the versions of the files which match \c pattern (if it is
+    //! still the search text).
+    void setFileVersions(const QString &pattern, QVector<FileVersion> versions);
+
+signals:
+    //! Search for every version of the files which match \c pattern.
+    void findFileVersions(const QString &pattern);
+
+private slots:
+    void search();
+
+private:
+    Ui::FileHistoryDialog *_ui;
+    QTimer                *_searchUpdate;
+};
+
+#endif /* !FILEHISTORYDIALOG_H */
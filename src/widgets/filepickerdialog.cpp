@@ -29,6 +29,12 @@ FilePickerDialog::FilePickerDialog(QWidget *parent)
     connect(_ui->selectButton, &QPushButton::clicked, this,
             &FilePickerDialog::accept);
 
+    // Pass messages about tasks.
+    connect(_ui->filePickerWidget, &FilePickerWidget::taskRequested, this,
+            &FilePickerDialog::taskRequested);
+    connect(_ui->filePickerWidget, &FilePickerWidget::cancelTaskRequested,
+            this, &FilePickerDialog::cancelTaskRequested);
+
     // Load last browsed file url.
     TSettings settings;
     _ui->filePickerWidget->setCurrentPath(
@@ -7,6 +7,7 @@ WARNINGS_DISABLE
 #include <QDialog>
 #include <QList>
 #include <QObject>
+#include <QUuid>
 WARNINGS_ENABLE
 
 /* Forward declaration(s). */
@@ -14,6 +15,7 @@ namespace Ui
 {
 class FilePickerDialog;
 }
+class BaseTask;
 class QUrl;
 class QWidget;
 
@@ -38,6 +40,12 @@ public:
     //! Sets a single URL in the internal FilePickerWidget.
     void selectUrl(const QUrl &url);
 
+signals:
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
 private:
     Ui::FilePickerDialog *_ui;
 };
@@ -5,9 +5,9 @@ WARNINGS_DISABLE
 #include <QCompleter>
 #include <QDir>
 #include <QEvent>
+#include <QFileSystemModel>
 #include <QKeyEvent>
 #include <QLineEdit>
-#include <QPersistentModelIndex>
 #include <QPushButton>
 #include <QStringList>
 #include <QTreeView>
@@ -18,7 +18,7 @@ WARNINGS_DISABLE
 #include "ui_filepickerwidget.h"
 WARNINGS_ENABLE
 
-#include "customfilesystemmodel.h"
+#include "filepickermodel.h"
 
 /* Forward declaration(s). */
 class QModelIndex;
@@ -26,17 +26,17 @@ class QModelIndex;
 FilePickerWidget::FilePickerWidget(QWidget *parent)
     : QWidget(parent),
       _ui(new Ui::FilePickerWidget),
-      _model(new CustomFileSystemModel),
+      _model(new FilePickerModel),
+      _completerModel(new QFileSystemModel),
       _completer(new QCompleter)
 {
     _ui->setupUi(this);
     _ui->optionsContainer->hide();
 
-    // Configure underlying model.
-    _model->setRootPath(QDir::rootPath());
-
-    // Configure file url completions.
-    _completer->setModel(_model);
+    // Configure file url completions.  The completer only needs to read the
+    // directories leading to the typed path.
+    _completerModel->setRootPath(QDir::rootPath());
+    _completer->setModel(_completerModel);
     _completer->setCompletionMode(QCompleter::InlineCompletion);
     _completer->setCaseSensitivity(Qt::CaseSensitive);
     _ui->filterLineEdit->setCompleter(_completer);
@@ -46,11 +46,17 @@ FilePickerWidget::FilePickerWidget(QWidget *parent)
     _ui->treeView->setModel(_model);
     _ui->treeView->setColumnWidth(0, 250);
 
+    // Pass messages about tasks.
+    connect(_model, &FilePickerModel::taskRequested, this,
+            &FilePickerWidget::taskRequested);
+    connect(_model, &FilePickerModel::cancelTaskRequested, this,
+            &FilePickerWidget::cancelTaskRequested);
+
     // Select the home directory in the display.
     setCurrentPath(QDir::homePath());
 
     // Connection for the model's data changing.
-    connect(_model, &CustomFileSystemModel::dataChanged,
+    connect(_model, &FilePickerModel::dataChanged,
             [this](const QModelIndex &topLeft, const QModelIndex &bottomRight,
                    const QVector<int> &roles) {
                 Q_UNUSED(topLeft);
@@ -104,6 +110,7 @@ FilePickerWidget::FilePickerWidget(QWidget *parent)
 FilePickerWidget::~FilePickerWidget()
 {
     delete _completer;
+    delete _completerModel;
     delete _model;
     delete _ui;
 }
@@ -123,11 +130,10 @@ QString FilePickerWidget::getCurrentPath()
 
 QList<QUrl> FilePickerWidget::getSelectedUrls()
 {
-    // Construct a list of urls from the filePath QStrings.
-    QList<QUrl>                  urls;
-    QList<QPersistentModelIndex> indexList = _model->checkedIndexes();
-    for(const QPersistentModelIndex &index : indexList)
-        urls << QUrl::fromUserInput(_model->filePath(index));
+    // Construct a list of urls from the checked paths.
+    QList<QUrl> urls;
+    for(const QString &path : _model->checkedPaths())
+        urls << QUrl::fromUserInput(path);
     return (urls);
 }
 
@@ -135,16 +141,12 @@ void FilePickerWidget::setSelectedUrls(const QList<QUrl> &urls)
 {
     _model->reset();
     for(const QUrl &url : urls)
-    {
-        _model->setData(_model->index(url.toLocalFile()), Qt::Checked,
-                        Qt::CheckStateRole);
-    }
+        _model->setPathChecked(url.toLocalFile(), true);
 }
 
 void FilePickerWidget::selectUrl(const QUrl &url)
 {
-    _model->setData(_model->index(url.toLocalFile()), Qt::Checked,
-                    Qt::CheckStateRole);
+    _model->setPathChecked(url.toLocalFile(), true);
 }
 
 bool FilePickerWidget::settingShowHidden()
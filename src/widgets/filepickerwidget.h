@@ -7,6 +7,7 @@ WARNINGS_DISABLE
 #include <QList>
 #include <QObject>
 #include <QString>
+#include <QUuid>
 #include <QWidget>
 WARNINGS_ENABLE
 
@@ -15,8 +16,10 @@ namespace Ui
 {
 class FilePickerWidget;
 }
-class CustomFileSystemModel;
+class BaseTask;
+class FilePickerModel;
 class QCompleter;
+class QFileSystemModel;
 class QEvent;
 class QKeyEvent;
 class QUrl;
@@ -83,6 +86,11 @@ signals:
     //! One of the setting checkboxes has changed.
     void settingChanged();
 
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
+
 protected:
     //! Used for handling the ESC key.
     void keyPressEvent(QKeyEvent *event) override;
@@ -90,9 +98,10 @@ protected:
     void changeEvent(QEvent *event) override;
 
 private:
-    Ui::FilePickerWidget  *_ui;
-    CustomFileSystemModel *_model;
-    QCompleter            *_completer;
+    Ui::FilePickerWidget *_ui;
+    FilePickerModel      *_model;
+    QFileSystemModel     *_completerModel;
+    QCompleter           *_completer;
 };
 
 #endif // FILEPICKERWIDGET_H
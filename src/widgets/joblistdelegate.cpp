@@ -0,0 +1,332 @@
+#include "joblistdelegate.h"
+
+WARNINGS_DISABLE
+#include <QAbstractItemView>
+#include <QApplication>
+#include <QColor>
+#include <QCursor>
+#include <QEvent>
+#include <QFontMetrics>
+#include <QHelpEvent>
+#include <QKeySequence>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPalette>
+#include <QStyle>
+#include <QToolTip>
+#include <QWidget>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "compat.h"
+#include "joblistmodel.h"
+
+// Layout of a row.
+#define ROW_MIN_WIDTH 300
+#define ROW_HEIGHT 32
+#define MARGIN_H 10
+#define MARGIN_V 2
+#define SPACING 6
+#define NAME_MIN_WIDTH 100
+#define BUTTON_SIZE 27
+#define BUTTON_RADIUS 4
+#define ICON_SIZE 16
+#define NAME_FONT_SIZE 12
+#define DETAIL_FONT_SIZE 11
+
+#define BUTTON_COLOR_HOVER QColor(179, 190, 255, 120)
+
+#define ANNOTATION_COLOR QColor("grey")
+
+static QFont monospaceFont(int pixelSize)
+{
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    font.setPixelSize(pixelSize);
+    return (font);
+}
+
+JobListDelegate::JobListDelegate(QObject *parent)
+    : QStyledItemDelegate(parent),
+      _nameFont(monospaceFont(NAME_FONT_SIZE)),
+      _detailFont(monospaceFont(DETAIL_FONT_SIZE))
+{
+    _icons[BackupButton]  = QIcon(":/icons/cloud-upload.png");
+    _icons[InspectButton] = QIcon(":/icons/info.png");
+    _icons[RestoreButton] = QIcon(":/icons/cloud-download.png");
+    _icons[DeleteButton]  = QIcon(":/icons/trash.png");
+}
+
+void JobListDelegate::paint(QPainter                   *painter,
+                            const QStyleOptionViewItem &option,
+                            const QModelIndex          &index) const
+{
+    // Draw the background (selection, hover, alternating colors).
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    opt.text.clear();
+    const QWidget *widget = opt.widget;
+    QStyle        *style =
+        (widget != nullptr) ? widget->style() : QApplication::style();
+    style->drawPrimitive(QStyle::PE_PanelItemViewItem, &opt, painter, widget);
+
+    const QPalette::ColorRole role = (opt.state & QStyle::State_Selected)
+                                         ? QPalette::HighlightedText
+                                         : QPalette::Text;
+    const QRect   rowRect = opt.rect;
+    const QString name    = index.data(Qt::DisplayRole).toString();
+    const QString detail  = index.data(JobListModel::DetailRole).toString();
+    const QString lastBackup =
+        index.data(JobListModel::LastBackupRole).toString();
+    const QRect lastBackupArea = lastBackupRect(rowRect, lastBackup);
+    const QRect nameArea       = nameRect(rowRect, name, lastBackupArea);
+    const QRect detailArea(nameArea.right() + 1 + SPACING, nameArea.top(),
+                           lastBackupArea.left() - SPACING - nameArea.right()
+                               - 1 - SPACING,
+                           nameArea.height());
+    const int flags = Qt::AlignVCenter | Qt::TextSingleLine;
+
+    painter->save();
+
+    // Draw the name.
+    painter->setFont(_nameFont);
+    painter->setPen(opt.palette.color(QPalette::Normal, role));
+    painter->drawText(nameArea, Qt::AlignLeft | flags,
+                      QFontMetrics(_nameFont).elidedText(name, Qt::ElideRight,
+                                                         nameArea.width()));
+
+    // Draw the number & size of the archives, and the last backup.
+    const QFontMetrics detailMetrics(_detailFont);
+    painter->setFont(_detailFont);
+    painter->setPen(ANNOTATION_COLOR);
+    if(detailArea.width() > 0)
+        painter->drawText(detailArea, Qt::AlignLeft | flags,
+                          detailMetrics.elidedText(detail, Qt::ElideRight,
+                                                   detailArea.width()));
+    painter->drawText(lastBackupArea, Qt::AlignRight | flags,
+                      detailMetrics.elidedText(lastBackup, Qt::ElideRight,
+                                               lastBackupArea.width()));
+
+    // Draw the separator.
+    const int lineX = buttonRect(rowRect, BackupButton).left() - SPACING;
+    painter->setPen(opt.palette.color(QPalette::Mid));
+    painter->drawLine(lineX, rowRect.top() + MARGIN_V, lineX,
+                      rowRect.bottom() - MARGIN_V);
+
+    // Draw the buttons.
+    const QPoint mouse = hoverPos(opt);
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(BUTTON_COLOR_HOVER);
+    for(int b = BackupButton; b < NoButton; b++)
+    {
+        const Button button  = static_cast<Button>(b);
+        const QRect  rect    = buttonRect(rowRect, button);
+        const bool   enabled = isEnabled(index, button);
+        if(enabled && rect.contains(mouse))
+            painter->drawRoundedRect(rect, BUTTON_RADIUS, BUTTON_RADIUS);
+        QRect iconRect(0, 0, ICON_SIZE, ICON_SIZE);
+        iconRect.moveCenter(rect.center());
+        _icons[b].paint(painter, iconRect, Qt::AlignCenter,
+                        enabled ? QIcon::Normal : QIcon::Disabled);
+    }
+
+    painter->restore();
+}
+
+QSize JobListDelegate::sizeHint(const QStyleOptionViewItem &option,
+                                const QModelIndex          &index) const
+{
+    Q_UNUSED(option)
+    Q_UNUSED(index)
+
+    // Every row has the same size, so this does not look at the data.
+    return (QSize(ROW_MIN_WIDTH, ROW_HEIGHT));
+}
+
+bool JobListDelegate::helpEvent(QHelpEvent                 *event,
+                                QAbstractItemView          *view,
+                                const QStyleOptionViewItem &option,
+                                const QModelIndex          &index)
+{
+    // Bail (if applicable).
+    if((event == nullptr) || (view == nullptr) || !index.isValid()
+       || (event->type() != QEvent::ToolTip))
+    {
+        return (QStyledItemDelegate::helpEvent(event, view, option, index));
+    }
+
+    // Show the shortcut of a button, what the last backup date is, the
+    // sizes of the archives, or else the full name.
+    QString      text;
+    const Button button = buttonAt(option.rect, event->pos());
+    const QRect  lastBackup =
+        lastBackupRect(option.rect,
+                       index.data(JobListModel::LastBackupRole).toString());
+    const QRect name = nameRect(option.rect,
+                                index.data(Qt::DisplayRole).toString(),
+                                lastBackup);
+    if(button != NoButton)
+        text = buttonToolTip(button);
+    else if(lastBackup.contains(event->pos()))
+        text = tr("Last backup timestamp");
+    else if((event->pos().x() > name.right())
+            && (event->pos().x() < lastBackup.left()))
+        text = index.data(JobListModel::StatsRole).toString();
+    else
+        text = index.data(Qt::ToolTipRole).toString();
+
+    if(text.isEmpty())
+        QToolTip::hideText();
+    else
+        QToolTip::showText(event->globalPos(), text, view->viewport(),
+                           option.rect);
+    return (true);
+}
+
+QRect JobListDelegate::buttonRect(const QRect &rowRect, Button button)
+{
+    // Bail (if applicable).
+    if(button == NoButton)
+        return (QRect());
+
+    // The buttons are at the right-hand side, and vertically centered.
+    const int left = rowRect.right() + 1 - MARGIN_H
+                     - (NoButton - button) * BUTTON_SIZE
+                     - (DeleteButton - button) * SPACING;
+    const int top = rowRect.top() + (rowRect.height() - BUTTON_SIZE) / 2;
+    return (QRect(left, top, BUTTON_SIZE, BUTTON_SIZE));
+}
+
+bool JobListDelegate::editorEvent(QEvent                     *event,
+                                  QAbstractItemModel         *model,
+                                  const QStyleOptionViewItem &option,
+                                  const QModelIndex          &index)
+{
+    // Only handle mouse clicks.
+    if((event->type() != QEvent::MouseButtonPress)
+       && (event->type() != QEvent::MouseButtonDblClick)
+       && (event->type() != QEvent::MouseButtonRelease))
+    {
+        return (QStyledItemDelegate::editorEvent(event, model, option, index));
+    }
+
+    // Bail (if applicable).
+    QMouseEvent *mouseEvent = static_cast<QMouseEvent *>(event);
+    const Button button     = buttonAt(option.rect, mouseEvent->pos());
+    if((button == NoButton) || (mouseEvent->button() != Qt::LeftButton))
+        return (QStyledItemDelegate::editorEvent(event, model, option, index));
+
+    // Act on the release, like a QToolButton.  Disabled buttons still
+    // don't select the row.
+    if((event->type() == QEvent::MouseButtonRelease)
+       && isEnabled(index, button))
+    {
+        switch(button)
+        {
+        case BackupButton:
+            emit requestBackup(index);
+            break;
+        case InspectButton:
+            emit requestInspect(index);
+            break;
+        case RestoreButton:
+            emit requestRestore(index);
+            break;
+        case DeleteButton:
+            emit requestDelete(index);
+            break;
+        case NoButton:
+            break;
+        }
+    }
+    return (true);
+}
+
+QRect JobListDelegate::lastBackupRect(const QRect   &rowRect,
+                                      const QString &text) const
+{
+    // The last backup is right-aligned before the separator.
+    const int right = buttonRect(rowRect, BackupButton).left() - 2 * SPACING;
+    const int width = TEXT_WIDTH(QFontMetrics(_detailFont), text);
+    const int left  = qMax(rowRect.left() + MARGIN_H, right - width);
+    return (QRect(left, rowRect.top() + MARGIN_V, right - left,
+                  rowRect.height() - 2 * MARGIN_V));
+}
+
+QRect JobListDelegate::nameRect(const QRect &rowRect, const QString &name,
+                                const QRect &lastBackup) const
+{
+    // The name takes as much room as it needs (but at least
+    // NAME_MIN_WIDTH), and the number of archives gets the rest.
+    const int left      = rowRect.left() + MARGIN_H;
+    const int available = qMax(lastBackup.left() - SPACING - left, 0);
+    const int width =
+        qMin(qMax(TEXT_WIDTH(QFontMetrics(_nameFont), name), NAME_MIN_WIDTH),
+             available);
+    return (QRect(left, rowRect.top() + MARGIN_V, width,
+                  rowRect.height() - 2 * MARGIN_V));
+}
+
+QString JobListDelegate::buttonToolTip(Button button) const
+{
+    // Display tooltips using platform-specific strings.
+    QString      toolTip;
+    QKeySequence shortcut;
+    switch(button)
+    {
+    case BackupButton:
+        toolTip  = tr("Initiate a backup for this Job <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+B"));
+        break;
+    case InspectButton:
+        toolTip  = tr("Display details for this Job <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+I"));
+        break;
+    case RestoreButton:
+        toolTip  = tr("Restore latest backup for this Job <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+S"));
+        break;
+    case DeleteButton:
+        toolTip  = tr("Delete this Job <span"
+                      " style=\"color:gray;font-size:small\">%1</span>");
+        shortcut = QKeySequence(tr("Ctrl+D"));
+        break;
+    case NoButton:
+        return (QString());
+    }
+    return (toolTip.arg(shortcut.toString(QKeySequence::NativeText)));
+}
+
+bool JobListDelegate::isEnabled(const QModelIndex &index, Button button)
+{
+    // There is nothing to restore without an archive.
+    if(button == RestoreButton)
+        return (index.data(JobListModel::ArchiveCountRole).toInt() > 0);
+    return (button != NoButton);
+}
+
+JobListDelegate::Button JobListDelegate::buttonAt(const QRect  &rowRect,
+                                                  const QPoint &pos)
+{
+    for(int b = BackupButton; b < NoButton; b++)
+    {
+        const Button button = static_cast<Button>(b);
+        if(buttonRect(rowRect, button).contains(pos))
+            return (button);
+    }
+    return (NoButton);
+}
+
+QPoint JobListDelegate::hoverPos(const QStyleOptionViewItem &option)
+{
+    // Only the row under the mouse can have a hovered button.
+    const QAbstractItemView *view =
+        qobject_cast<const QAbstractItemView *>(option.widget);
+    if((view == nullptr) || !(option.state & QStyle::State_MouseOver))
+        return (QPoint(-1, -1));
+    return (view->viewport()->mapFromGlobal(QCursor::pos()));
+}
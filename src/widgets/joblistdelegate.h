@@ -0,0 +1,103 @@
+#ifndef JOBLISTDELEGATE_H
+#define JOBLISTDELEGATE_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QFont>
+#include <QIcon>
+#include <QModelIndex>
+#include <QObject>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStyleOptionViewItem>
+#include <QStyledItemDelegate>
+WARNINGS_ENABLE
+
+/* Forward declaration(s). */
+class QAbstractItemModel;
+class QAbstractItemView;
+class QEvent;
+class QHelpEvent;
+class QPainter;
+
+/*!
+ * \ingroup widgets-specialized
+ * \brief The JobListDelegate paints the rows of a \ref JobListModel: the
+ * job name, the number and size of its archives, the date of the last
+ * backup, and the backup, inspect, restore, and delete buttons.
+ *
+ * Like the \ref ArchiveListDelegate, the buttons are painted rather than
+ * being widgets.  The restore button is disabled for jobs without
+ * archives.
+ */
+class JobListDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    //! The inline buttons, from left to right.
+    enum Button
+    {
+        BackupButton,
+        InspectButton,
+        RestoreButton,
+        DeleteButton,
+        NoButton
+    };
+
+    //! Constructor.
+    explicit JobListDelegate(QObject *parent = nullptr);
+
+    //! Paints the row.
+    void paint(QPainter                   *painter,
+               const QStyleOptionViewItem &option,
+               const QModelIndex          &index) const override;
+    //! Returns the size of a row.
+    QSize sizeHint(const QStyleOptionViewItem &option,
+                   const QModelIndex          &index) const override;
+    //! Shows the tooltips of the buttons, the sizes, the last backup, and
+    //! the name.
+    bool helpEvent(QHelpEvent                 *event,
+                   QAbstractItemView          *view,
+                   const QStyleOptionViewItem &option,
+                   const QModelIndex          &index) override;
+
+    //! Returns the area of \c button in a row which covers \c rowRect.
+    static QRect buttonRect(const QRect &rowRect, Button button);
+
+signals:
+    //! The backup button of the row was clicked.
+    void requestBackup(const QModelIndex &index);
+    //! The inspect button of the row was clicked.
+    void requestInspect(const QModelIndex &index);
+    //! The restore button of the row was clicked.
+    void requestRestore(const QModelIndex &index);
+    //! The delete button of the row was clicked.
+    void requestDelete(const QModelIndex &index);
+
+protected:
+    //! Handles clicks on the buttons; passes other events on.
+    bool editorEvent(QEvent                     *event,
+                     QAbstractItemModel         *model,
+                     const QStyleOptionViewItem &option,
+                     const QModelIndex          &index) override;
+
+private:
+    QFont _nameFont;
+    QFont _detailFont;
+    QIcon _icons[NoButton];
+
+    QRect   lastBackupRect(const QRect &rowRect, const QString &text) const;
+    QRect   nameRect(const QRect &rowRect, const QString &name,
+                     const QRect &lastBackup) const;
+    QString buttonToolTip(Button button) const;
+
+    static bool   isEnabled(const QModelIndex &index, Button button);
+    static Button buttonAt(const QRect &rowRect, const QPoint &pos);
+    static QPoint hoverPos(const QStyleOptionViewItem &option);
+};
+
+#endif /* !JOBLISTDELEGATE_H */
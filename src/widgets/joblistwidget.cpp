@@ -2,61 +2,97 @@
 
 WARNINGS_DISABLE
 #include <QAbstractItemView>
+#include <QEvent>
+#include <QItemSelectionModel>
 #include <QKeyEvent>
-#include <QList>
-#include <QListWidgetItem>
 #include <QMessageBox>
-#include <QRegExp>
+#include <QMouseEvent>
 #include <QSharedPointer>
 #include <Qt>
 WARNINGS_ENABLE
 
+#include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
 
 #include "debug.h"
-#include "joblistwidgetitem.h"
+#include "joblistmodel.h"
 #include "persistentmodel/job.h"
+#include "widgets/joblistdelegate.h"
 #include "widgets/restoredialog.h"
 
 JobListWidget::JobListWidget(QWidget *parent)
-    : QListWidget(parent), _filter(new QRegExp)
+    : QListView(parent),
+      _model(new JobListModel(this)),
+      _delegate(new JobListDelegate(this))
 {
-    // Set up filtering job names.
-    _filter->setCaseSensitivity(Qt::CaseInsensitive);
-    _filter->setPatternSyntax(QRegExp::Wildcard);
+    setModel(_model);
+    setItemDelegate(_delegate);
+    // All rows have the same height, so the view does not need to ask
+    // the delegate about every row.
+    setUniformItemSizes(true);
+    // Highlight the buttons under the mouse.
+    setMouseTracking(true);
+
+    // Connections from the model and the delegate.
+    connect(_model, &JobListModel::countChanged, this,
+            &JobListWidget::countChanged);
+    connect(_delegate, &JobListDelegate::requestBackup, this,
+            &JobListWidget::backupItem);
+    connect(_delegate, &JobListDelegate::requestInspect, this,
+            &JobListWidget::inspectItem);
+    connect(_delegate, &JobListDelegate::requestRestore, this,
+            &JobListWidget::restoreItem);
+    connect(_delegate, &JobListDelegate::requestDelete, this,
+            &JobListWidget::deleteItem);
 
     // Connection for showing info about a Job.
-    connect(this, &QListWidget::itemActivated, [this](QListWidgetItem *item) {
-        emit displayJobDetails(static_cast<JobListWidgetItem *>(item)->job());
-    });
+    connect(this, &QAbstractItemView::activated, this,
+            &JobListWidget::inspectItem);
 }
 
 JobListWidget::~JobListWidget()
 {
-    clear();
-    delete _filter;
+}
+
+int JobListWidget::count() const
+{
+    return (_model->count());
+}
+
+QList<JobPtr> JobListWidget::selectedJobs() const
+{
+    QList<JobPtr> jobs;
+    for(const QModelIndex &index : selectionModel()->selectedRows())
+        jobs.append(jobAt(index));
+    return (jobs);
 }
 
 void JobListWidget::backupSelectedItems()
 {
+    const QList<JobPtr> selected = selectedJobs();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
     // Confirm that the user wants to create new archive(s).
     QMessageBox::StandardButton confirm =
         QMessageBox::question(this, tr("Confirm action"),
                               tr("Initiate backup for the %1 selected job(s)?")
-                                  .arg(selectedItems().count()));
+                                  .arg(selected.count()));
     if(confirm != QMessageBox::Yes)
         return;
 
     // Create a new archive for each selected Job.
-    for(QListWidgetItem *item : selectedItems())
-    {
-        JobPtr job = static_cast<JobListWidgetItem *>(item)->job();
-        emit   backupJob(job);
-    }
+    for(const JobPtr &job : selected)
+        emit backupJob(job);
+}
+
+void JobListWidget::estimateSelectedItems()
+{
+    // Run a --dry-run for each selected Job.
+    for(const JobPtr &job : selectedJobs())
+        emit estimateUpload(job);
 }
 
 void JobListWidget::selectJob(const JobPtr &job)
@@ -68,18 +104,27 @@ void JobListWidget::selectJob(const JobPtr &job)
         return;
     }
 
-    // Find the item representing the Job, and select it.
-    for(int i = 0; i < count(); ++i)
+    // Find the row representing the Job; the same Job might be a different
+    // object, e.g. after reloading the jobs.
+    int row = _model->rowOf(job.data());
+    if(row == -1)
     {
-        JobListWidgetItem *jobItem = static_cast<JobListWidgetItem *>(item(i));
-        if(jobItem && (jobItem->job()->objectKey() == job->objectKey()))
+        for(int i = 0; i < _model->rowCount(); ++i)
         {
-            clearSelection();
-            setCurrentItem(jobItem);
-            scrollToItem(currentItem(), QAbstractItemView::EnsureVisible);
-            break;
+            if(_model->job(i)->objectKey() == job->objectKey())
+            {
+                row = i;
+                break;
+            }
         }
     }
+    if(row == -1)
+        return;
+
+    // Select the desired Job.
+    clearSelection();
+    setCurrentIndex(_model->index(row));
+    scrollTo(currentIndex(), QAbstractItemView::EnsureVisible);
 }
 
 void JobListWidget::inspectJobByRef(const QString &jobRef)
@@ -88,58 +133,49 @@ void JobListWidget::inspectJobByRef(const QString &jobRef)
     if(jobRef.isEmpty())
         return;
 
-    // Find the item representing the Job, and display its details.
-    for(int i = 0; i < count(); ++i)
-    {
-        JobListWidgetItem *jobItem = static_cast<JobListWidgetItem *>(item(i));
-        if(jobItem && (jobItem->job()->objectKey() == jobRef))
-            emit displayJobDetails(jobItem->job());
-    }
+    // Find the Job, and display its details.
+    JobPtr job = _model->findJobByRef(jobRef);
+    if(job)
+        emit displayJobDetails(job);
 }
 
 void JobListWidget::backupAllJobs()
 {
     // Start a new archive for all jobs.
-    for(int i = 0; i < count(); ++i)
-    {
-        JobPtr job = static_cast<JobListWidgetItem *>(item(i))->job();
-        emit   backupJob(job);
-    }
+    for(const JobPtr &job : _model->jobs())
+        emit backupJob(job);
 }
 
-void JobListWidget::backupItem()
+void JobListWidget::backupItem(const QModelIndex &index)
 {
-    // Bail (if applicable).
-    if(!sender())
-        return;
-
     // Start a new archive for this job.
-    JobPtr job = qobject_cast<JobListWidgetItem *>(sender())->job();
+    JobPtr job = jobAt(index);
     if(job)
         emit backupJob(job);
 }
 
-void JobListWidget::inspectItem()
+void JobListWidget::inspectItem(const QModelIndex &index)
 {
-    // Bail (if applicable).
-    if(!sender())
-        return;
-
     // Display details about the job.
-    emit displayJobDetails(qobject_cast<JobListWidgetItem *>(sender())->job());
+    JobPtr job = jobAt(index);
+    if(job)
+        emit displayJobDetails(job);
 }
 
-void JobListWidget::restoreItem()
+void JobListWidget::restoreItem(const QModelIndex &index)
 {
-    // Bail (if applicable).
-    if(!sender())
-        return;
+    showRestoreDialog(jobAt(index));
+}
 
-    // Get the Job.
-    JobPtr job = qobject_cast<JobListWidgetItem *>(sender())->job();
+void JobListWidget::deleteItem(const QModelIndex &index)
+{
+    execDeleteJob(jobAt(index));
+}
 
+void JobListWidget::showRestoreDialog(const JobPtr &job)
+{
     // Bail (if applicable).
-    if(job->archives().isEmpty())
+    if(!job || job->archives().isEmpty())
         return;
 
     // Get the latest archive belonging to the Job.
@@ -154,23 +190,15 @@ void JobListWidget::restoreItem()
     restoreDialog->show();
 }
 
-void JobListWidget::deleteItem()
-{
-    execDeleteJob(qobject_cast<JobListWidgetItem *>(sender()));
-}
-
-void JobListWidget::execDeleteJob(JobListWidgetItem *jobItem)
+void JobListWidget::execDeleteJob(const JobPtr &job)
 {
     // Bail (if applicable).
-    if(!jobItem)
+    if(!job)
     {
-        DEBUG << "Null JobListWidgetItem passed.";
+        DEBUG << "Null JobPtr passed.";
         return;
     }
 
-    // Get the Job.
-    JobPtr job = jobItem->job();
-
     // Confirm that the user wants to delete the Job.
     QMessageBox::StandardButton confirm =
         QMessageBox::question(this, tr("Confirm action"),
@@ -196,136 +224,69 @@ void JobListWidget::execDeleteJob(JobListWidgetItem *jobItem)
 
     // Begin deleting the job (and possibly archives as well).
     emit deleteJob(job, purgeArchives);
-    delete jobItem;
 
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
+    // Remove it from the list; this notifies about the number of visible
+    // items.
+    _model->removeJob(job);
 }
 
-int JobListWidget::visibleItemsCount()
+void JobListWidget::setJobs(const QMap<QString, JobPtr> &jobs)
 {
-    int count = 0;
-    for(QListWidgetItem *item : findItems("*", Qt::MatchWildcard))
-    {
-        if(item && !item->isHidden())
-            count++;
-    }
-    return (count);
+    _model->setJobs(jobs);
 }
 
-void JobListWidget::setJobs(const QMap<QString, JobPtr> &jobs)
+void JobListWidget::applyChanges(const JobChanges &changes)
 {
-    setUpdatesEnabled(false);
-    clear();
-    for(const JobPtr &job : jobs)
-    {
-        addJob(job);
-    }
-    setUpdatesEnabled(true);
+    _model->applyChanges(changes);
 }
 
 void JobListWidget::addJob(const JobPtr &job)
 {
-    // Bail (if applicable).
-    if(!job)
-    {
-        DEBUG << "Null JobPtr passed.";
-        return;
-    }
-
-    // Create new item.
-    JobListWidgetItem *item = new JobListWidgetItem(job);
-    connect(item, &JobListWidgetItem::requestBackup, this,
-            &JobListWidget::backupItem);
-    connect(item, &JobListWidgetItem::requestInspect, this,
-            &JobListWidget::inspectItem);
-    connect(item, &JobListWidgetItem::requestRestore, this,
-            &JobListWidget::restoreItem);
-    connect(item, &JobListWidgetItem::requestDelete, this,
-            &JobListWidget::deleteItem);
-
-    // Add it to the end of the list.
-    insertItem(count(), item);
-    setItemWidget(item, item->widget());
-
-    // Check it against the name filter.
-    item->setHidden(!job->name().contains(*_filter));
-
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
+    _model->addJob(job);
 }
 
 void JobListWidget::inspectSelectedItem()
 {
+    const QList<JobPtr> selected = selectedJobs();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
     // Display details about the first of the selected items.
-    emit displayJobDetails(
-        static_cast<JobListWidgetItem *>(selectedItems().first())->job());
+    emit displayJobDetails(selected.first());
 }
 
 void JobListWidget::restoreSelectedItem()
 {
-    // Bail (if applicable).
-    if(selectedItems().isEmpty())
-        return;
-
-    // Get the first Job amongst the selected items.
-    JobPtr job =
-        static_cast<JobListWidgetItem *>(selectedItems().first())->job();
+    const QList<JobPtr> selected = selectedJobs();
 
     // Bail (if applicable).
-    if(job->archives().isEmpty())
+    if(selected.isEmpty())
         return;
 
-    // Get the latest archive belonging to the Job.
-    ArchivePtr archive = job->archives().first();
-
-    // Launch the RestoreDialog.
-    RestoreDialog *restoreDialog = new RestoreDialog(this, archive);
-    connect(restoreDialog, &RestoreDialog::accepted, [this, restoreDialog] {
-        emit restoreArchive(restoreDialog->archive(),
-                            restoreDialog->getOptions());
-    });
-    restoreDialog->show();
+    // Restore the latest archive of the first of the selected Jobs.
+    showRestoreDialog(selected.first());
 }
 
 void JobListWidget::deleteSelectedItem()
 {
+    const QList<JobPtr> selected = selectedJobs();
+
     // Bail (if applicable).
-    if(selectedItems().isEmpty())
+    if(selected.isEmpty())
         return;
 
     // Delete the first of the selected items.
-    execDeleteJob(static_cast<JobListWidgetItem *>(selectedItems().first()));
+    execDeleteJob(selected.first());
 }
 
 void JobListWidget::setFilter(const QString &regex)
 {
-    setUpdatesEnabled(false);
-
-    // Set up filter.
+    // Check jobs against filter; this notifies about the number of
+    // visible items.
     clearSelection();
-    _filter->setPattern(regex);
-
-    // Check jobs against filter.
-    for(int i = 0; i < count(); ++i)
-    {
-        JobListWidgetItem *jobItem = static_cast<JobListWidgetItem *>(item(i));
-        if(jobItem)
-        {
-            if(jobItem->job()->name().contains(*_filter))
-                jobItem->setHidden(false);
-            else
-                jobItem->setHidden(true);
-        }
-    }
-    setUpdatesEnabled(true);
-
-    // Notify about the number of visible items.
-    emit countChanged(count(), visibleItemsCount());
+    _model->setFilter(regex);
 }
 
 void JobListWidget::keyPressEvent(QKeyEvent *event)
@@ -336,21 +297,45 @@ void JobListWidget::keyPressEvent(QKeyEvent *event)
         deleteSelectedItem();
         break;
     case Qt::Key_Escape:
-        if(!selectedItems().isEmpty())
+        if(selectionModel()->hasSelection())
             clearSelection();
         else
-            QListWidget::keyPressEvent(event);
+            QListView::keyPressEvent(event);
         break;
     default:
-        QListWidget::keyPressEvent(event);
+        QListView::keyPressEvent(event);
     }
 }
 
+void JobListWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    QListView::mouseMoveEvent(event);
+
+    // The view only repaints a row when the mouse enters or leaves it.
+    const QModelIndex index = indexAt(event->pos());
+    if(index.isValid())
+        update(index);
+}
+
+void JobListWidget::changeEvent(QEvent *event)
+{
+    // The rows are translated when they are painted.
+    if(event->type() == QEvent::LanguageChange)
+        viewport()->update();
+    QListView::changeEvent(event);
+}
+
 void JobListWidget::updateIEC()
 {
-    for(int i = 0; i < count(); ++i)
-    {
-        JobListWidgetItem *jobItem = static_cast<JobListWidgetItem *>(item(i));
-        jobItem->updateIEC();
-    }
+    // The sizes are formatted when the rows are painted.
+    _model->refresh();
+}
+
+JobPtr JobListWidget::jobAt(const QModelIndex &index) const
+{
+    // Bail (if applicable).
+    if(!index.isValid())
+        return (JobPtr());
+
+    return (_model->job(index.row()));
 }
@@ -4,27 +4,36 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
-#include <QListWidget>
+#include <QList>
+#include <QListView>
 #include <QMap>
+#include <QModelIndex>
 #include <QObject>
 #include <QString>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
+#include "messages/changeset.h"
 #include "messages/jobptr.h"
 
 /* Forward declaration(s). */
-class JobListWidgetItem;
+class JobListDelegate;
+class JobListModel;
+class QEvent;
 class QKeyEvent;
+class QMouseEvent;
 class QWidget;
 
 /*!
  * \ingroup widgets-specialized
- * \brief The JobListWidget is a QListWidget which displays
+ * \brief The JobListWidget is a QListView which displays
  * information about all jobs.
+ *
+ * The jobs are stored in a \ref JobListModel, and each row is painted by
+ * a \ref JobListDelegate.
  */
-class JobListWidget : public QListWidget
+class JobListWidget : public QListView
 {
     Q_OBJECT
 
@@ -36,11 +45,23 @@ public:
     //! Reload the IEC prefix preference and re-display number(s).
     void updateIEC();
 
+    //! Returns the number of jobs, including those which are hidden by
+    //! the filter.
+    int count() const;
+    //! Returns the selected jobs.
+    QList<JobPtr> selectedJobs() const;
+
 public slots:
     //! Clears the job list, then sets it to the specified jobs.
     void setJobs(const QMap<QString, JobPtr> &jobs);
+    //! Updates the list with the changes (or snapshot) from the
+    //! \ref BackendData.  Items of Jobs which did not change are kept, and
+    //! sets which are not newer than the list are ignored.
+    void applyChanges(const JobChanges &changes);
     //! Create new archives for the selected jobs.
     void backupSelectedItems();
+    //! Estimate the upload size of the selected jobs.
+    void estimateSelectedItems();
     //! Sets the current selection in the list view.
     void selectJob(const JobPtr &job);
     //! Display detailed information about a specific job.
@@ -56,7 +77,8 @@ public slots:
     void restoreSelectedItem();
     //! Delete the selected job.
     void deleteSelectedItem();
-    //! Filter the list of jobs.
+    //! Filter the list of jobs.  If \c regex extends the previous filter,
+    //! only the visible jobs are checked.
     void setFilter(const QString &regex);
 
 signals:
@@ -64,6 +86,8 @@ signals:
     void displayJobDetails(JobPtr job);
     //! Notify that a new archive should be created for a specific job.
     void backupJob(JobPtr job);
+    //! Notify that the upload size of a specific job should be estimated.
+    void estimateUpload(JobPtr job);
     //! Notify that the specified archive should be restored,
     //! using the user-selected options from the \ref RestoreDialog.
     void restoreArchive(ArchivePtr archive, ArchiveRestoreOptions options);
@@ -80,18 +104,24 @@ signals:
 protected:
     //! Handles the delete and escape keys; passes other events on.
     void keyPressEvent(QKeyEvent *event) override;
+    //! Repaints the row under the mouse, to highlight its buttons.
+    void mouseMoveEvent(QMouseEvent *event) override;
+    //! Handles translation change of language.
+    void changeEvent(QEvent *event) override;
 
 private slots:
-    void backupItem();
-    void inspectItem();
-    void restoreItem();
-    void deleteItem();
+    void backupItem(const QModelIndex &index);
+    void inspectItem(const QModelIndex &index);
+    void restoreItem(const QModelIndex &index);
+    void deleteItem(const QModelIndex &index);
 
 private:
-    int  visibleItemsCount();
-    void execDeleteJob(JobListWidgetItem *jobItem);
+    JobListModel    *_model;
+    JobListDelegate *_delegate;
 
-    QRegExp *_filter;
+    JobPtr jobAt(const QModelIndex &index) const;
+    void   showRestoreDialog(const JobPtr &job);
+    void   execDeleteJob(const JobPtr &job);
 };
 
 #endif // JOBLISTWIDGET_H
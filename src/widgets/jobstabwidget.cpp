@@ -16,6 +16,7 @@ WARNINGS_DISABLE
 #include <QMessageBox>
 #include <QPushButton>
 #include <QSharedPointer>
+#include <QTimer>
 #include <QToolButton>
 #include <QUrl>
 #include <QVariant>
@@ -33,12 +34,17 @@ WARNINGS_ENABLE
 #include "widgets/joblistwidget.h"
 #include "widgets/jobwidget.h"
 
+// Filter the jobs once the user has not typed for this long.
+#define FILTER_DELAY_MS 200
+
 const char *const DEFAULT_JOBS[] = {"Desktop", "Documents", "Pictures",
                                     "Movies",  "Videos",    "Music",
                                     "Work"};
 
 JobsTabWidget::JobsTabWidget(QWidget *parent)
-    : QWidget(parent), _ui(new Ui::JobsTabWidget)
+    : QWidget(parent),
+      _ui(new Ui::JobsTabWidget),
+      _filterUpdate(new QTimer(this))
 {
     // Ui initialization
     _ui->setupUi(this);
@@ -85,6 +91,10 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
             &JobsTabWidget::backupJob);
     connect(_ui->jobDetailsWidget, &JobDetailsWidget::findMatchingArchives,
             this, &JobsTabWidget::findMatchingArchives);
+    connect(_ui->jobDetailsWidget, &JobDetailsWidget::taskRequested, this,
+            &JobsTabWidget::taskRequested);
+    connect(_ui->jobDetailsWidget, &JobDetailsWidget::cancelTaskRequested,
+            this, &JobsTabWidget::cancelTaskRequested);
 
     // Connections to the JobDetailsWidget
     connect(this, &JobsTabWidget::matchingArchives, _ui->jobDetailsWidget,
@@ -95,6 +105,8 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
             &JobsTabWidget::displayJobDetails);
     connect(_ui->jobListWidget, &JobListWidget::backupJob, this,
             &JobsTabWidget::backupJob);
+    connect(_ui->jobListWidget, &JobListWidget::estimateUpload, this,
+            &JobsTabWidget::estimateUpload);
     connect(_ui->jobListWidget, &JobListWidget::restoreArchive, this,
             &JobsTabWidget::restoreArchive);
     connect(_ui->jobListWidget, &JobListWidget::deleteJob, this,
@@ -121,8 +133,13 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
         else
             _ui->jobsFilter->clearEditText();
     });
-    connect(_ui->jobsFilter, &QComboBox::editTextChanged, _ui->jobListWidget,
-            &JobListWidget::setFilter);
+    _filterUpdate->setSingleShot(true);
+    _filterUpdate->setInterval(FILTER_DELAY_MS);
+    connect(_filterUpdate, &QTimer::timeout, [this]() {
+        _ui->jobListWidget->setFilter(_ui->jobsFilter->currentText());
+    });
+    connect(_ui->jobsFilter, &QComboBox::editTextChanged,
+            [this]() { _filterUpdate->start(); });
     connect(_ui->jobsFilter,
             static_cast<void (QComboBox::*)(int)>(
                 &QComboBox::currentIndexChanged),
@@ -137,6 +154,7 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
 
     // Right-click context menu
     _ui->jobListWidget->addAction(_ui->actionJobBackup);
+    _ui->jobListWidget->addAction(_ui->actionJobEstimate);
     _ui->jobListWidget->addAction(_ui->actionJobDelete);
     _ui->jobListWidget->addAction(_ui->actionJobInspect);
     _ui->jobListWidget->addAction(_ui->actionJobRestore);
@@ -145,8 +163,8 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
     _ui->jobListWidget->addAction(_ui->actionAddJob);
 
     // Connections to the JobListWidget
-    connect(this, &JobsTabWidget::jobList, _ui->jobListWidget,
-            &JobListWidget::setJobs);
+    connect(this, &JobsTabWidget::jobChanges, _ui->jobListWidget,
+            &JobListWidget::applyChanges);
     connect(this, &JobsTabWidget::jobAdded, _ui->jobListWidget,
             &JobListWidget::addJob);
     connect(this, &JobsTabWidget::jobInspectByRef, _ui->jobListWidget,
@@ -154,6 +172,8 @@ JobsTabWidget::JobsTabWidget(QWidget *parent)
 
     connect(_ui->actionJobBackup, &QAction::triggered, _ui->jobListWidget,
             &JobListWidget::backupSelectedItems);
+    connect(_ui->actionJobEstimate, &QAction::triggered, _ui->jobListWidget,
+            &JobListWidget::estimateSelectedItems);
     connect(_ui->actionJobDelete, &QAction::triggered, _ui->jobListWidget,
             &JobListWidget::deleteSelectedItem);
     connect(_ui->actionJobRestore, &QAction::triggered, _ui->jobListWidget,
@@ -359,10 +379,11 @@ void JobsTabWidget::showJobsListMenu()
 {
     // Construct menu.
     _jobListMenu->clear();
-    if(!_ui->jobListWidget->selectedItems().isEmpty())
+    if(!_ui->jobListWidget->selectedJobs().isEmpty())
     {
         _jobListMenu->addAction(_ui->actionJobBackup);
-        if(_ui->jobListWidget->selectedItems().count() == 1)
+        _jobListMenu->addAction(_ui->actionJobEstimate);
+        if(_ui->jobListWidget->selectedJobs().count() == 1)
         {
             _jobListMenu->addAction(_ui->actionJobInspect);
             _jobListMenu->addAction(_ui->actionJobRestore);
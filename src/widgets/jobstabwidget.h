@@ -8,12 +8,14 @@ WARNINGS_DISABLE
 #include <QMap>
 #include <QObject>
 #include <QUrl>
+#include <QUuid>
 #include <QWidget>
 WARNINGS_ENABLE
 
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
 #include "messages/backuptaskdataptr.h"
+#include "messages/changeset.h"
 #include "messages/jobptr.h"
 
 /* Forward declaration(s). */
@@ -21,8 +23,10 @@ namespace Ui
 {
 class JobsTabWidget;
 }
+class BaseTask;
 class QEvent;
 class QMenu;
+class QTimer;
 
 /*!
  * \ingroup widgets-main
@@ -79,12 +83,18 @@ signals:
     void restoreSelectedItem();
     //! Display detailed information about the first of the selected items.
     void inspectSelectedItem();
-    //! Passes the list of all Job objects to the JobListWidget.
-    void jobList(const QMap<QString, JobPtr> &jobs);
+    //! Passes the changes to the Job objects to the JobListWidget.
+    void jobChanges(const JobChanges &changes);
     //! Display detailed information about a specific job.
     void jobInspectByRef(const QString &jobRef);
     //! Begin tarsnap -c -f \<name\>
     void backupNow(BackupTaskDataPtr backupTaskData);
+    //! Begin tarsnap -c --dry-run --print-stats for a Job.
+    void estimateUpload(JobPtr job);
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
 
 protected:
     //! Handles translation change of language.
@@ -102,6 +112,8 @@ private:
     Ui::JobsTabWidget *_ui;
 
     QMenu *_jobListMenu;
+    // Delays filtering until the user stops typing.
+    QTimer *_filterUpdate;
 
     void updateKeyboardShortcutInfo();
     void updateStatus();
@@ -78,6 +78,10 @@ JobDetailsWidget::JobDetailsWidget(QWidget *parent)
         if(!_job->objectKey().isEmpty())
             save();
     });
+    connect(_ui->jobTreeWidget, &FilePickerWidget::taskRequested, this,
+            &JobDetailsWidget::taskRequested);
+    connect(_ui->jobTreeWidget, &FilePickerWidget::cancelTaskRequested, this,
+            &JobDetailsWidget::cancelTaskRequested);
     connect(_ui->skipFilesDefaultsButton, &QPushButton::clicked, [this]() {
         TSettings settings;
         _ui->skipFilesLineEdit->setText(
@@ -433,12 +437,12 @@ bool JobDetailsWidget::canSaveNew()
 void JobDetailsWidget::showArchiveListMenu()
 {
     // Bail if not applicable.
-    if(_ui->archiveListWidget->selectedItems().isEmpty())
+    if(_ui->archiveListWidget->selectedArchives().isEmpty())
         return;
 
     // Construct menu.
     _archiveListMenu->clear();
-    if(_ui->archiveListWidget->selectedItems().count() == 1)
+    if(_ui->archiveListWidget->selectedArchives().count() == 1)
     {
         _archiveListMenu->addAction(_ui->actionInspect);
         _archiveListMenu->addAction(_ui->actionRestore);
@@ -7,6 +7,7 @@ WARNINGS_DISABLE
 #include <QList>
 #include <QObject>
 #include <QString>
+#include <QUuid>
 #include <QWidget>
 WARNINGS_ENABLE
 
@@ -19,6 +20,7 @@ namespace Ui
 {
 class JobDetailsWidget;
 }
+class BaseTask;
 class QEvent;
 class QMenu;
 class QTimer;
@@ -77,6 +79,10 @@ signals:
     //! Notify that we should look for archives matching this Job.
     //! \param jobPrefix prefix to match.
     void findMatchingArchives(const QString &jobPrefix);
+    //! We have a task to perform in the background.
+    void taskRequested(BaseTask *task);
+    //! We would like to cancel a task.
+    void cancelTaskRequested(BaseTask *task, const QUuid &uuid);
 
 protected:
     //! Handles translation change of language.
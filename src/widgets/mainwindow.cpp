@@ -30,6 +30,7 @@ WARNINGS_ENABLE
 #include "backuptask.h"
 #include "basetask.h"
 #include "consolelogdialog.h"
+#include "filehistorydialog.h"
 #include "persistentmodel/archive.h"
 #include "persistentmodel/job.h"
 #include "widgets/archivestabwidget.h"
@@ -51,6 +52,7 @@ MainWindow::MainWindow(QWidget *parent)
       _settingsWidget(new SettingsWidget()),
       _aboutWindow(new AboutDialog(this)),
       _consoleWindow(new ConsoleLogDialog(this)),
+      _fileHistoryWindow(new FileHistoryDialog(this)),
       _helpWidget(new HelpWidget()),
       _stopTasksDialog(new StopTasksDialog(this))
 {
@@ -73,6 +75,12 @@ MainWindow::MainWindow(QWidget *parent)
             &ConsoleLogDialog::appendLogString);
     connect(_ui->actionShowConsoleLog, &QAction::triggered, _consoleWindow,
             &ConsoleLogDialog::show);
+    connect(_ui->actionFileHistory, &QAction::triggered, _fileHistoryWindow,
+            &FileHistoryDialog::show);
+    connect(_fileHistoryWindow, &FileHistoryDialog::findFileVersions, this,
+            &MainWindow::findFileVersions);
+    connect(this, &MainWindow::fileVersions, _fileHistoryWindow,
+            &FileHistoryDialog::setFileVersions);
 
     // --
 
@@ -138,8 +146,8 @@ MainWindow::MainWindow(QWidget *parent)
             &MainWindow::getArchives);
 
     // Archives pane
-    connect(this, &MainWindow::archiveList, _ui->archivesTabWidget,
-            &ArchivesTabWidget::archiveList);
+    connect(this, &MainWindow::archiveChanges, _ui->archivesTabWidget,
+            &ArchivesTabWidget::archiveChanges);
     connect(this, &MainWindow::addArchive, _ui->archivesTabWidget,
             &ArchivesTabWidget::addArchive);
 
@@ -160,6 +168,8 @@ MainWindow::MainWindow(QWidget *parent)
 
     connect(_ui->archivesTabWidget, &ArchivesTabWidget::taskRequested, this,
             &MainWindow::taskRequested);
+    connect(_ui->archivesTabWidget, &ArchivesTabWidget::cancelTaskRequested,
+            this, &MainWindow::cancelTaskRequested);
 
     // Jobs pane
 
@@ -190,10 +200,14 @@ MainWindow::MainWindow(QWidget *parent)
             &MainWindow::findMatchingArchives);
     connect(_ui->jobsTabWidget, &JobsTabWidget::deleteJob, this,
             &MainWindow::deleteJob);
+    connect(_ui->jobsTabWidget, &JobsTabWidget::taskRequested, this,
+            &MainWindow::taskRequested);
+    connect(_ui->jobsTabWidget, &JobsTabWidget::cancelTaskRequested, this,
+            &MainWindow::cancelTaskRequested);
 
     // Connections to the JobListWidget
-    connect(this, &MainWindow::jobList, _ui->jobsTabWidget,
-            &JobsTabWidget::jobList);
+    connect(this, &MainWindow::jobChanges, _ui->jobsTabWidget,
+            &JobsTabWidget::jobChanges);
 
     // Handle the Job-related actions
     connect(_ui->actionJobBackup, &QAction::triggered, _ui->jobsTabWidget,
@@ -208,6 +222,8 @@ MainWindow::MainWindow(QWidget *parent)
     // Other
     connect(_ui->jobsTabWidget, &JobsTabWidget::backupNow, this,
             &MainWindow::backupNow);
+    connect(_ui->jobsTabWidget, &JobsTabWidget::estimateUpload, this,
+            &MainWindow::estimateUpload);
 
     // Connections for _stopTasksDialog
     connect(_stopTasksDialog, &StopTasksDialog::stopTasks, this,
@@ -461,9 +477,10 @@ void MainWindow::commitSettings()
     settings.sync();
 }
 
-void MainWindow::appendToJournalLog(const LogEntry &log)
+void MainWindow::appendToJournalLog(const QVector<LogEntry> &log)
 {
-    _ui->journalLog->appendLog(log);
+    for(const LogEntry &entry : log)
+        _ui->journalLog->appendLog(entry);
 }
 
 void MainWindow::setJournal(const QVector<LogEntry> &log)
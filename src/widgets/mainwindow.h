@@ -18,6 +18,8 @@ WARNINGS_ENABLE
 #include "messages/archiveptr.h"
 #include "messages/archiverestoreoptions.h"
 #include "messages/backuptaskdataptr.h"
+#include "messages/changeset.h"
+#include "messages/fileversion.h"
 #include "messages/jobptr.h"
 #include "messages/notification_info.h"
 #include "messages/tarsnaperror.h"
@@ -33,6 +35,7 @@ class ArchivesTabWidget;
 class BackupTabWidget;
 class BaseTask;
 class ConsoleLogDialog;
+class FileHistoryDialog;
 class JobsTabWidget;
 class HelpWidget;
 class QEvent;
@@ -78,8 +81,8 @@ public slots:
     void notificationRaise();
     //! Display an explanation of a tarsnap CLI error.
     void tarsnapError(TarsnapError error);
-    //! Append a new entry to the journal.
-    void appendToJournalLog(const LogEntry &log);
+    //! Append new entries to the journal.
+    void appendToJournalLog(const QVector<LogEntry> &log);
     //! Reset the current Journal using log.
     void setJournal(const QVector<LogEntry> &log);
     //! Save the Tarsnap key ID.
@@ -95,10 +98,12 @@ public slots:
 signals:
     //! Begin tarsnap -c -f \<name\>
     void backupNow(BackupTaskDataPtr backupTaskData);
+    //! Begin tarsnap -c --dry-run --print-stats for a Job.
+    void estimateUpload(JobPtr job);
     //! Begin tarsnap --list-archives
     void getArchives();
-    //! Passes the list of all Archive objects to the ArchiveListWidget.
-    void archiveList(QList<ArchivePtr> archives);
+    //! Passes the changes to the Archive objects to the ArchiveListWidget.
+    void archiveChanges(ArchiveChanges changes);
     //! Passes the creation of a new Archive to the ArchiveListWidget.
     void addArchive(ArchivePtr archive);
     //! Passes info from the ArchiveListWidget or JobDetailsWidget to the
@@ -138,8 +143,8 @@ signals:
     void morphBackupIntoJob(QList<QUrl> urls, const QString &name);
 
     // Job tab
-    //! Passes the list of all Job objects to the JobListWidget.
-    void jobList(QMap<QString, JobPtr>);
+    //! Passes the changes to the Job objects to the JobListWidget.
+    void jobChanges(JobChanges changes);
     //! Notifies about a deleted job from the JobDetailsWidget or JobListWidget.
     void deleteJob(JobPtr job, bool purgeArchives);
     //! Passes info from the JobDetailsWidget to the TaskManager.
@@ -149,6 +154,11 @@ signals:
     void findMatchingArchives(const QString &jobPrefix);
     //! Archives which match the previously-given search string.
     void matchingArchives(QList<ArchivePtr> archives);
+    //! Search the fetched archive contents for every version of a file.
+    //! \param pattern path or shell globbing pattern.
+    void findFileVersions(const QString &pattern);
+    //! Versions of the files which match the previously-given pattern.
+    void fileVersions(const QString &pattern, QVector<FileVersion> versions);
 
     //! Is the Backup tab ready to create an archive?
     void validBackupTab(bool valid);
@@ -191,9 +201,10 @@ private:
 
     SettingsWidget *_settingsWidget;
 
-    AboutDialog      *_aboutWindow;
-    ConsoleLogDialog *_consoleWindow;
-    HelpWidget       *_helpWidget;
+    AboutDialog       *_aboutWindow;
+    ConsoleLogDialog  *_consoleWindow;
+    FileHistoryDialog *_fileHistoryWindow;
+    HelpWidget        *_helpWidget;
 
     StopTasksDialog *_stopTasksDialog;
 
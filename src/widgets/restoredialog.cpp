@@ -104,7 +104,7 @@ RestoreDialog::RestoreDialog(QWidget *parent, ArchivePtr archive,
     }
     else
     {
-        if(_archive->contents().isEmpty())
+        if(!_archive->hasContents())
         {
             // If we have no files to display, hide the list.
             _ui->filesListWidget->hide();
@@ -260,6 +260,10 @@ void SettingsWidget::initSettingsSetValue()
             [&settings](bool checked) {
                 settings.setValue("app/skip_nodump", checked);
             });
+    connect(_ui->skipUnchangedJobsCheckBox, &QCheckBox::toggled,
+            [&settings](bool checked) {
+                settings.setValue("app/skip_unchanged_jobs", checked);
+            });
     connect(_ui->simulationCheckBox, &QCheckBox::toggled,
             [&settings](bool checked) {
                 settings.setValue("tarsnap/dry_run", checked);
@@ -356,6 +360,9 @@ void SettingsWidget::loadSettings()
             .toString());
     _ui->skipNoDumpCheckBox->setChecked(
         settings.value("app/skip_nodump", DEFAULT_SKIP_NODUMP).toBool());
+    _ui->skipUnchangedJobsCheckBox->setChecked(
+        settings.value("app/skip_unchanged_jobs", DEFAULT_SKIP_UNCHANGED_JOBS)
+            .toBool());
     _ui->limitUploadSpinBox->setValue(
         settings.value("app/limit_upload", 0).toInt());
     _ui->limitDownloadSpinBox->setValue(
@@ -8,20 +8,25 @@ VERSION = test
 DEFINES += APP_VERSION=\\\"$$VERSION\\\"
 
 SOURCES += test-app-cmdline.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
 	../../lib/core/TSettings.cpp			\
 	../../lib/util/optparse.c			\
 	../../lib/util/optparse_helper.c		\
 	../../libcperciva/util/getopt.c			\
 	../../libcperciva/util/warnp.c			\
 	../../src/app-cmdline.cpp			\
+	../../src/archivelisting.cpp			\
 	../../src/backuptask.cpp			\
 	../../src/basetask.cpp				\
+	../../src/changetracker.cpp			\
 	../../src/init-shared.cpp			\
 	../../src/parsearchivelistingtask.cpp		\
 	../../src/persistentmodel/archive.cpp		\
 	../../src/persistentmodel/job.cpp		\
 	../../src/persistentmodel/journal.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
 	../../src/persistentmodel/upgrade-store.cpp	\
@@ -30,7 +35,9 @@ SOURCES += test-app-cmdline.cpp				\
 	../../src/translator.cpp
 
 HEADERS +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
 	../../lib/core/LogEntry.h			\
 	../../lib/core/TSettings.h			\
 	../../lib/util/optparse.h			\
@@ -38,20 +45,28 @@ HEADERS +=						\
 	../../libcperciva/util/getopt.h			\
 	../../libcperciva/util/warnp.h			\
 	../../src/app-cmdline.h				\
+	../../src/archivelisting.h			\
 	../../src/backuptask.h				\
 	../../src/basetask.h				\
+	../../src/changetracker.h			\
+	../../src/filetree.h				\
 	../../src/init-shared.h				\
 	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
 	../../src/messages/archiveptr.h			\
 	../../src/messages/archiverestoreoptions.h	\
 	../../src/messages/backuptaskdataptr.h		\
+	../../src/messages/filetreeptr.h		\
+	../../src/messages/fileversion.h		\
 	../../src/messages/jobptr.h			\
 	../../src/messages/tarsnaperror.h		\
+	../../src/messages/taskoutput.h			\
 	../../src/messages/taskstatus.h			\
 	../../src/parsearchivelistingtask.h		\
 	../../src/persistentmodel/archive.h		\
 	../../src/persistentmodel/job.h			\
 	../../src/persistentmodel/journal.h		\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
@@ -17,7 +17,9 @@ FORMS +=						\
 	../../lib/forms/TWizard.ui
 
 SOURCES += test-app-setup.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
 	../../lib/core/TSettings.cpp			\
 	../../lib/util/optparse.c			\
 	../../lib/util/optparse_helper.c		\
@@ -31,6 +33,11 @@ SOURCES += test-app-setup.cpp				\
 	../../libcperciva/util/getopt.c			\
 	../../libcperciva/util/warnp.c			\
 	../../src/app-setup.cpp				\
+	../../src/archivelisting.cpp			\
+	../../src/changetracker.cpp			\
+	../../src/filehistorytask.cpp			\
+	../../src/fingerprinttask.cpp			\
+	../../src/listingtask.cpp			\
 	../../src/messages/archivefilestat.h		\
 	../../src/backenddata.cpp			\
 	../../src/backuptask.cpp			\
@@ -43,11 +50,14 @@ SOURCES += test-app-setup.cpp				\
 	../../src/jobrunner.cpp				\
 	../../src/parsearchivelistingtask.cpp		\
 	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/filehistory.cpp	\
 	../../src/persistentmodel/job.cpp		\
 	../../src/persistentmodel/journal.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
 	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/prefixtrie.cpp			\
 	../../src/scheduling.cpp			\
 	../../src/setupwizard/setupwizard.cpp		\
 	../../src/setupwizard/setupwizard_cli.cpp	\
@@ -63,7 +73,9 @@ SOURCES += test-app-setup.cpp				\
 	../../src/translator.cpp
 
 HEADERS +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
 	../../lib/core/LogEntry.h			\
 	../../lib/core/TSettings.h			\
 	../../lib/util/optparse.h			\
@@ -78,29 +90,43 @@ HEADERS +=						\
 	../../libcperciva/util/getopt.h			\
 	../../libcperciva/util/warnp.h			\
 	../../src/app-setup.h				\
+	../../src/archivelisting.h			\
 	../../src/backenddata.h				\
 	../../src/backuptask.h				\
 	../../src/basetask.h				\
+	../../src/changetracker.h			\
 	../../src/cmdlinetask.h				\
 	../../src/dir-utils.h				\
+	../../src/filehistorytask.h			\
 	../../src/filetablemodel.h			\
+	../../src/filetree.h				\
+	../../src/fingerprinttask.h			\
 	../../src/humanbytes.h				\
 	../../src/init-shared.h				\
 	../../src/jobrunner.h				\
+	../../src/listingtask.h				\
+	../../src/messages/archivelistingptr.h		\
 	../../src/messages/archiveptr.h			\
 	../../src/messages/archiverestoreoptions.h	\
 	../../src/messages/backuptaskdataptr.h		\
+	../../src/messages/changeset.h			\
+	../../src/messages/filetreeptr.h		\
+	../../src/messages/fileversion.h		\
 	../../src/messages/jobptr.h			\
 	../../src/messages/notification_info.h		\
 	../../src/messages/tarsnaperror.h		\
+	../../src/messages/taskoutput.h			\
 	../../src/messages/taskstatus.h			\
 	../../src/parsearchivelistingtask.h		\
 	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/filehistory.h		\
 	../../src/persistentmodel/job.h			\
 	../../src/persistentmodel/journal.h		\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
+	../../src/prefixtrie.h				\
 	../../src/scheduling.h				\
 	../../src/setupwizard/setupwizard.h		\
 	../../src/setupwizard/setupwizard_cli.h		\
@@ -0,0 +1,178 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTest>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+#include "messages/taskoutput.h"
+
+#include "archivediff.h"
+#include "archivelisting.h"
+
+// Number of lines in the large listing; see bench-parsers for the timing.
+#define LARGE_LISTING_LINES 100000
+
+class TestArchiveListing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parseLines();
+    void mappedFile();
+    void largeListing();
+    void diff();
+};
+
+void TestArchiveListing::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+}
+
+void TestArchiveListing::parseLines()
+{
+    QByteArray text("drwxr-xr-x  0 user   group        0 Jan  1  2019 dir\n"
+                    "\n"
+                    "-rw-r--r--  1 user   group     1234 Feb 12 13:14 a  b \n"
+                    "not a listing line\n"
+                    "-rw-r--r--  1 user   group        0 Jan  1  2019 \n"
+                    " -rw-r--r--  1 user  group  0 Jan  1  2019 indented\n"
+                    "-rw-r--r-- 2 user group 5 Mar 3 2020 caf\xc3\xa9");
+    ArchiveListing listing{TaskOutput(text)};
+
+    // Empty lines, and lines which are not in the expected format (like the
+    // old QRegExp parser), are skipped.
+    QVERIFY(listing.count() == 3);
+    QVERIFY(listing.line(2)
+            == "-rw-r--r-- 2 user group 5 Mar 3 2020 caf\xc3\xa9");
+
+    FileStat stat = listing.stat(0);
+    QVERIFY(stat.mode == "drwxr-xr-x");
+    QVERIFY(stat.links == 0);
+    QVERIFY(stat.user == "user");
+    QVERIFY(stat.group == "group");
+    QVERIFY(stat.size == 0);
+    QVERIFY(stat.modified == "Jan  1  2019");
+    QVERIFY(stat.name == "dir");
+
+    // Filenames keep all of their spaces, including trailing spaces.
+    stat = listing.stat(1);
+    QVERIFY(stat.links == 1);
+    QVERIFY(stat.size == 1234);
+    QVERIFY(stat.modified == "Feb 12 13:14");
+    QVERIFY(stat.name == "a  b ");
+    QVERIFY(listing.path(1) == "a  b ");
+
+    QVERIFY(listing.stat(2).name == QString::fromUtf8("caf\xc3\xa9"));
+}
+
+void TestArchiveListing::mappedFile()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+
+    QByteArray text("-rw-r--r-- 1 user group 1 Jan 1 2019 one\n"
+                    "-rw-r--r-- 1 user group 2 Jan 1 2019 two\n");
+    ArchiveListing *listing =
+        new ArchiveListing(ArchiveListing::mapText(text, tmpdir.path()));
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).count() == 1);
+    QVERIFY(listing->count() == 2);
+    QVERIFY(listing->stat(1).name == "two");
+
+    // The file is removed along with the listing.
+    delete listing;
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).isEmpty());
+
+    // A file which does not fit in a QByteArray is not used at all (the
+    // file is sparse, so this does not use any disk space).
+    QFile *large = new QFile(tmpdir.path() + "/large");
+    QVERIFY(large->open(QIODevice::ReadWrite));
+    QVERIFY(large->resize(static_cast<qint64>(INT_MAX) + 1));
+    TaskOutput tooLarge(large);
+    QVERIFY(tooLarge.isTooLarge());
+    QVERIFY(tooLarge.isEmpty());
+    QVERIFY(!TaskOutput(text).isTooLarge());
+}
+
+void TestArchiveListing::largeListing()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+
+    QByteArray text;
+    for(int i = 0; i < LARGE_LISTING_LINES; i++)
+        text.append(QString("-rw-r--r--  1 user   group  %1 Jan  1  2019 "
+                            "dir/file-%2\n")
+                        .arg(i)
+                        .arg(i)
+                        .toLatin1());
+
+    ArchiveListing listing(ArchiveListing::mapText(text, tmpdir.path()));
+    text.clear();
+
+    // Rows can be accessed in any order.
+    QVERIFY(listing.count() == LARGE_LISTING_LINES);
+    QVERIFY(listing.stat(LARGE_LISTING_LINES - 1).name
+            == QString("dir/file-%1").arg(LARGE_LISTING_LINES - 1));
+    QVERIFY(listing.stat(0).size == 0);
+    QVERIFY(listing.stat(12345).size == 12345);
+}
+
+void TestArchiveListing::diff()
+{
+    ArchiveListingPtr from(new ArchiveListing(TaskOutput(QByteArray(
+        "drwxr-xr-x  0 user group   0 Mar  4  2012 etc/\n"
+        "-rw-r--r--  1 user group  10 Mar  4  2012 etc/nginx.conf\n"
+        "-rw-r--r--  1 user group   5 Mar  4  2012 etc/old\n"
+        "lrwxr-xr-x  1 user group   0 Mar  4  2012 etc/link -> a.conf\n"))));
+    ArchiveListingPtr to(new ArchiveListing(TaskOutput(QByteArray(
+        "-rw-r--r--  1 user group  25 Mar  5  2012 etc/nginx.conf\n"
+        "drwxr-xr-x  0 user group   0 Mar  4  2012 etc/\n"
+        "-rw-r--r--  1 user group   7 Mar  5  2012 etc/new\n"
+        "lrwxr-xr-x  1 user group   0 Mar  5  2012 etc/link -> b.conf\n"))));
+
+    // Symlinks are compared without their targets.
+    QVERIFY(to->path(3) == "etc/link");
+    QVERIFY(to->path(1) == "etc/");
+
+    // The changed files are sorted by path; unchanged lines are skipped.
+    ArchiveDiff diff(from, to);
+    QVERIFY(diff.count() == 4);
+    QVERIFY(diff.path(0) == "etc/link");
+    QVERIFY(diff.change(0) == ArchiveDiff::MODIFIED);
+    QVERIFY(diff.path(1) == "etc/new");
+    QVERIFY(diff.change(1) == ArchiveDiff::ADDED);
+    QVERIFY(diff.fromRow(1) == -1);
+    QVERIFY(diff.toSize(1) == 7);
+    QVERIFY(diff.path(2) == "etc/nginx.conf");
+    QVERIFY(diff.change(2) == ArchiveDiff::MODIFIED);
+    QVERIFY(diff.fromSize(2) == 10);
+    QVERIFY(diff.toSize(2) == 25);
+    QVERIFY(diff.path(3) == "etc/old");
+    QVERIFY(diff.change(3) == ArchiveDiff::REMOVED);
+    QVERIFY(diff.toRow(3) == -1);
+
+    QVERIFY(diff.addedCount() == 1);
+    QVERIFY(diff.removedCount() == 1);
+    QVERIFY(diff.modifiedCount() == 2);
+    QVERIFY(diff.sizeDelta() == 17);
+
+    // Identical listings have no changes.
+    QVERIFY(ArchiveDiff(from, from).count() == 0);
+    QVERIFY(ArchiveDiff(ArchiveListingPtr(), to).addedCount() == 4);
+}
+
+QTEST_MAIN(TestArchiveListing)
+WARNINGS_DISABLE
+#include "test-archivelisting.moc"
+WARNINGS_ENABLE
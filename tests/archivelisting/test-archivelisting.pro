@@ -0,0 +1,20 @@
+TARGET = test-archivelisting
+QT = core
+
+VALGRIND = true
+
+HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
+	../../src/archivediff.h				\
+	../../src/archivelisting.h			\
+	../../src/messages/archivediffptr.h		\
+	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
+	../../src/messages/taskoutput.h
+
+SOURCES += test-archivelisting.cpp			\
+	../../lib/core/ByteScan.cpp			\
+	../../src/archivediff.cpp			\
+	../../src/archivelisting.cpp
+
+include(../tests-include.pri)
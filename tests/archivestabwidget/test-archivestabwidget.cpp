@@ -1,34 +1,67 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QAbstractItemModel>
+#include <QByteArray>
 #include <QCoreApplication>
 #include <QDateTime>
+#include <QList>
 #include <QMetaType>
 #include <QModelIndex>
 #include <QObject>
+#include <QPoint>
+#include <QRect>
+#include <QRegExp>
+#include <QSet>
 #include <QSignalSpy>
 #include <QString>
+#include <QStringList>
 #include <QTest>
 #include <QThreadPool>
 #include <QVariant>
-#include <QVector>
 
 #include "ui_archivestabwidget.h"
 WARNINGS_ENABLE
 
 #include "../qtest-platform.h"
 
-#include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
+#include "messages/changeset.h"
+#include "messages/taskoutput.h"
 
+#include "archivelisting.h"
+#include "archivelistmodel.h"
 #include "basetask.h"
 #include "filetablemodel.h"
+#include "filetableproxymodel.h"
+#include "filetree.h"
+#include "filetreemodel.h"
+#include "humanbytes.h"
 #include "persistentmodel/archive.h"
 #include "widgets/archivelistwidget.h"
+#include "widgets/archivelistdelegate.h"
 #include "widgets/archivestabwidget.h"
 #include "widgets/archivewidget.h"
 
 #include "TSettings.h"
 
+// Size of the large archive list.
+#define LARGE_LIST_ARCHIVES 20000
+#define LARGE_LIST_SINGLE 500
+#define LARGE_LIST_RUN 1000
+
+// Size of the list for checking the filter.
+#define FILTER_LIST_ARCHIVES 2000
+
+// Run the tasks which the models request, like the TaskManager would.
+static void runTask(BaseTask *task)
+{
+    QObject::connect(task, &BaseTask::dequeue, task, &QObject::deleteLater,
+                     Qt::QueuedConnection);
+    task->setAutoDelete(false);
+    QThreadPool::globalInstance()->start(task);
+}
+
 class TestArchivesTabWidget : public QObject
 {
     Q_OBJECT
@@ -38,6 +71,12 @@ private slots:
     void cleanupTestCase();
 
     void archiveListWidget();
+    void archiveListWidget_changes();
+    void archiveListWidget_buttons();
+    void archiveListWidget_large();
+    void archiveListWidget_filter();
+    void archiveContentsProxy();
+    void archiveContentsTree();
     void displayArchive();
 };
 
@@ -49,7 +88,9 @@ void TestArchivesTabWidget::initTestCase()
     IF_NOT_VISUAL { qInstallMessageHandler(offscreenMessageOutput); }
 
     // Initialization normally done in init_shared.cpp's init_no_app()
-    qRegisterMetaType<QVector<FileStat>>("QVector<FileStat>");
+    qRegisterMetaType<ArchiveListingPtr>("ArchiveListingPtr");
+    qRegisterMetaType<FileTreePtr>("FileTreePtr");
+    qRegisterMetaType<ArchivePtr>("ArchivePtr");
     qRegisterMetaType<BaseTask *>("BaseTask *");
 }
 
@@ -106,6 +147,429 @@ void TestArchivesTabWidget::archiveListWidget()
     delete alw;
 }
 
+static ArchivePtr archiveAt(ArchiveListWidget *alw, int row)
+{
+    return (alw->model()
+                ->index(row, 0)
+                .data(ArchiveListModel::ArchiveRole)
+                .value<ArchivePtr>());
+}
+
+void TestArchivesTabWidget::archiveListWidget_changes()
+{
+    ArchiveListWidget *alw = new ArchiveListWidget();
+
+    VISUAL_INIT(alw);
+
+    QList<ArchivePtr> archives;
+    for(int i = 0; i < 3; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("changes%1").arg(i));
+        archive->setTimestamp(QDateTime::fromTime_t(1000000 + 60 * i));
+        archives << archive;
+    }
+
+    // A snapshot is sorted by timestamp.
+    ArchiveChanges snapshot;
+    snapshot.version = 1;
+    snapshot.reset   = true;
+    for(const ArchivePtr &archive : archives)
+        snapshot.added.insert(archive);
+    alw->applyChanges(snapshot);
+    VISUAL_WAIT;
+    QVERIFY(alw->count() == 3);
+    QVERIFY(archiveAt(alw, 0) == archives[2]);
+    QVERIFY(archiveAt(alw, 2) == archives[0]);
+
+    // Changes keep the other archives.
+    ArchivePtr newest(new Archive);
+    newest->setName("changes-newest");
+    newest->setTimestamp(QDateTime::fromTime_t(2000000));
+    ArchiveChanges changes;
+    changes.fromVersion = 1;
+    changes.version     = 2;
+    changes.add(newest);
+    changes.remove(archives[0]);
+    alw->applyChanges(changes);
+    VISUAL_WAIT;
+    QVERIFY(alw->count() == 3);
+    QVERIFY(archiveAt(alw, 0) == newest);
+    QVERIFY(archiveAt(alw, 1) == archives[2]);
+    QVERIFY(alw->findArchiveByName("changes0").isNull());
+
+    // Older sets are ignored.
+    alw->applyChanges(snapshot);
+    QVERIFY(alw->count() == 3);
+    QVERIFY(archiveAt(alw, 0) == newest);
+
+    // A snapshot removes the archives which are not in it.
+    snapshot.version = 2;
+    snapshot.added   = QSet<ArchivePtr>() << archives[1];
+    alw->applyChanges(snapshot);
+    VISUAL_WAIT;
+    QVERIFY(alw->count() == 1);
+    QVERIFY(archiveAt(alw, 0) == archives[1]);
+
+    delete alw;
+}
+
+void TestArchivesTabWidget::archiveListWidget_buttons()
+{
+    ArchiveListWidget *alw = new ArchiveListWidget();
+    alw->resize(600, 200);
+
+    VISUAL_INIT(alw);
+
+    ArchivePtr archive(new Archive);
+    archive->setName("buttons");
+    archive->setTimestamp(QDateTime::currentDateTime());
+    alw->addArchive(archive);
+    VISUAL_WAIT;
+
+    QSignalSpy sig_inspect(alw, SIGNAL(inspectArchive(ArchivePtr)));
+    QSignalSpy sig_clear(alw, SIGNAL(clearInspectArchive()));
+    const QModelIndex index   = alw->model()->index(0, 0);
+    const QPoint      inspect =
+        ArchiveListDelegate::buttonRect(alw->visualRect(index),
+                                        ArchiveListDelegate::InspectButton)
+            .center();
+
+    // The inspect button toggles the details.
+    QTest::mouseClick(alw->viewport(), Qt::LeftButton, Qt::NoModifier,
+                      inspect);
+    VISUAL_WAIT;
+    QVERIFY(sig_inspect.count() == 1);
+    QVERIFY(index.data(ArchiveListModel::ShowingDetailsRole).toBool());
+    QTest::mouseClick(alw->viewport(), Qt::LeftButton, Qt::NoModifier,
+                      inspect);
+    VISUAL_WAIT;
+    QVERIFY(sig_clear.count() == 1);
+    QVERIFY(!index.data(ArchiveListModel::ShowingDetailsRole).toBool());
+
+    // Clicking a button does not select the row.
+    QVERIFY(alw->selectedArchives().isEmpty());
+
+    // The buttons of archives which are being deleted are disabled.
+    archive->setDeleteScheduled(true);
+    QTest::mouseClick(alw->viewport(), Qt::LeftButton, Qt::NoModifier,
+                      inspect);
+    VISUAL_WAIT;
+    QVERIFY(sig_inspect.count() == 1);
+
+    delete alw;
+}
+
+void TestArchivesTabWidget::archiveListWidget_large()
+{
+    ArchiveListWidget *alw = new ArchiveListWidget();
+
+    VISUAL_INIT(alw);
+
+    // Two batches with interleaved timestamps, and single archives.
+    const QDateTime   start = QDateTime::fromTime_t(1000000);
+    QList<ArchivePtr> even;
+    QList<ArchivePtr> odd;
+    QList<ArchivePtr> single;
+    for(int i = 0; i < LARGE_LIST_ARCHIVES; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("large%1").arg(i));
+        archive->setTimestamp(start.addSecs(2 * i));
+        if(i % 2 == 0)
+            even << archive;
+        else
+            odd << archive;
+    }
+    for(int i = 0; i < LARGE_LIST_SINGLE; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("single%1").arg(i));
+        archive->setTimestamp(start.addSecs(77 * i + 1));
+        single << archive;
+    }
+
+    QSignalSpy sig_count(alw, SIGNAL(countChanged(int, int)));
+    alw->setArchives(even);
+    ArchiveChanges changes;
+    changes.version = 1;
+    for(const ArchivePtr &archive : odd)
+        changes.add(archive);
+    alw->applyChanges(changes);
+    for(const ArchivePtr &archive : single)
+        alw->addArchive(archive);
+    VISUAL_WAIT;
+
+    // The count is only sent once per batch.
+    const int total = LARGE_LIST_ARCHIVES + LARGE_LIST_SINGLE;
+    QVERIFY(alw->count() == total);
+    QVERIFY(sig_count.count() == 2 + LARGE_LIST_SINGLE);
+    QVERIFY(sig_count.last().at(0).toInt() == total);
+    QVERIFY(sig_count.last().at(1).toInt() == total);
+
+    // The archives are sorted, newest first.
+    QVERIFY(archiveAt(alw, 0) == odd.last());
+    for(int i = 1; i < total; i++)
+    {
+        QVERIFY(archiveAt(alw, i - 1)->timestamp()
+                >= archiveAt(alw, i)->timestamp());
+    }
+
+    // large1, large10-19, large100-199, large1000-1999, large10000-19999.
+    alw->setFilter("large1*");
+    VISUAL_WAIT;
+    QVERIFY(sig_count.last().at(0).toInt() == total);
+    QVERIFY(sig_count.last().at(1).toInt() == 11111);
+
+    // Removing a few archives (not enough to reset the model) removes each
+    // run of adjacent rows at once: the newest archive, and a longer run.
+    alw->setFilter("");
+    VISUAL_WAIT;
+    QAbstractItemModel *model = alw->model();
+    QSignalSpy          sig_removed(model, SIGNAL(rowsRemoved(QModelIndex, int,
+                                                               int)));
+    QSignalSpy          sig_reset(model, SIGNAL(modelReset()));
+    const ArchivePtr    second = archiveAt(alw, 1);
+    const ArchivePtr    before = archiveAt(alw, 99);
+    const ArchivePtr    after  = archiveAt(alw, 100 + LARGE_LIST_RUN);
+    ArchiveChanges      removal;
+    removal.fromVersion = 1;
+    removal.version     = 2;
+    removal.remove(archiveAt(alw, 0));
+    for(int i = 0; i < LARGE_LIST_RUN; i++)
+        removal.remove(archiveAt(alw, 100 + i));
+    alw->applyChanges(removal);
+    VISUAL_WAIT;
+    QVERIFY(sig_reset.count() == 0);
+    QVERIFY(sig_removed.count() == 2);
+    QVERIFY(sig_removed.at(0).at(1).toInt() == 100);
+    QVERIFY(sig_removed.at(0).at(2).toInt() == 100 + LARGE_LIST_RUN - 1);
+    QVERIFY(sig_removed.at(1).at(1).toInt() == 0);
+    QVERIFY(sig_removed.at(1).at(2).toInt() == 0);
+    QVERIFY(alw->count() == total - LARGE_LIST_RUN - 1);
+    QVERIFY(model->rowCount() == total - LARGE_LIST_RUN - 1);
+    QVERIFY(archiveAt(alw, 0) == second);
+    QVERIFY(archiveAt(alw, 98) == before);
+    QVERIFY(archiveAt(alw, 99) == after);
+
+    delete alw;
+}
+
+void TestArchivesTabWidget::archiveListWidget_filter()
+{
+    ArchiveListModel  model;
+    QList<ArchivePtr> archives;
+    const QDateTime   start = QDateTime::currentDateTime();
+    const QStringList words({"Documents", "pictures", "Music", "work"});
+    for(int i = 0; i < FILTER_LIST_ARCHIVES; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("Job_%1_%2").arg(words.at(i % 4)).arg(i));
+        archive->setTimestamp(start.addSecs(i));
+        archives << archive;
+    }
+    model.setArchives(archives);
+
+    // Compare the rows with every archive checked against the filter;
+    // each pattern extends the previous one, or starts over.
+    const QStringList patterns({"doc", "docu", "document", "documents_1",
+                                "documents_1*9", "documents_1?9", "mus",
+                                "music_[12]", "music_[!1]0", "music_[]",
+                                "music_[]1]", "job", "*ict*es_*77", "j",
+                                "", "work_19", "WORK_19", "nothing"});
+    QRegExp           filter;
+    filter.setCaseSensitivity(Qt::CaseInsensitive);
+    filter.setPatternSyntax(QRegExp::Wildcard);
+    for(int round = 0; round < 2; round++)
+    {
+        for(const QString &pattern : patterns)
+        {
+            model.setFilter(pattern);
+            filter.setPattern(pattern);
+            int expected = 0;
+            for(const ArchivePtr &archive : archives)
+            {
+                if(archive->name().contains(filter))
+                    expected++;
+            }
+            QVERIFY2(model.rowCount() == expected,
+                     pattern.toLatin1().constData());
+            for(int i = 0; i < model.rowCount(); i++)
+                QVERIFY(model.archive(i)->name().contains(filter));
+        }
+
+        // Replace some archives, which updates the index.
+        QList<ArchivePtr> removed;
+        for(int i = 0; i < FILTER_LIST_ARCHIVES; i += 3)
+            removed << archives.at(i);
+        model.removeArchives(removed);
+        for(const ArchivePtr &archive : removed)
+        {
+            archives.removeOne(archive);
+            ArchivePtr renamed(new Archive);
+            renamed->setName(archive->name().toUpper() + "_renamed");
+            renamed->setTimestamp(archive->timestamp());
+            archives << renamed;
+            model.addArchive(renamed);
+        }
+        QVERIFY(model.count() == FILTER_LIST_ARCHIVES);
+    }
+}
+
+void TestArchivesTabWidget::archiveContentsProxy()
+{
+    FileTableModel      model(nullptr);
+    FileTableProxyModel proxy(&model);
+    QSignalSpy          sig_ready(&proxy, SIGNAL(ready()));
+    connect(&proxy, &FileTableProxyModel::taskRequested, &runTask);
+
+    // Files "a0" to "a9" and "b0" to "b9", each larger than the previous.
+    QByteArray text;
+    for(int i = 0; i < 20; i++)
+    {
+        const char prefix = (i < 10) ? 'a' : 'b';
+        text += QString("-rw-r--r-- 0 user group %1 Jan 1 2019 %2%3\n")
+                    .arg(100 * i)
+                    .arg(prefix)
+                    .arg(i % 10)
+                    .toLatin1();
+    }
+    model.setListing(ArchiveListingPtr(new ArchiveListing(TaskOutput(text))));
+    QVERIFY(proxy.rowCount() == 20);
+    QVERIFY(!proxy.isBusy());
+
+    // Sort by size, descending; the rows are replaced once it is done.
+    proxy.sort(FileTableModel::SIZE, Qt::DescendingOrder);
+    QVERIFY(proxy.isBusy());
+    WAIT_SIG(sig_ready);
+    QVERIFY(!proxy.isBusy());
+    QVERIFY(proxy.rowCount() == 20);
+    for(int i = 1; i < proxy.rowCount(); i++)
+    {
+        QVERIFY(proxy.index(i - 1, FileTableModel::SIZE).data().toULongLong()
+                > proxy.index(i, FileTableModel::SIZE).data().toULongLong());
+    }
+    QVERIFY(proxy.index(0, FileTableModel::FILE).data().toString() == "b9");
+
+    // Filter the names; the sort order is kept.
+    sig_ready.clear();
+    proxy.setFilterWildcard("A*");
+    WAIT_SIG(sig_ready);
+    QVERIFY(proxy.rowCount() == 10);
+    QVERIFY(proxy.index(0, FileTableModel::FILE).data().toString() == "a9");
+    const QModelIndex source = proxy.mapToSource(proxy.index(0, 0));
+    QVERIFY(source.row() == 9);
+    QVERIFY(proxy.mapFromSource(source).row() == 0);
+    QVERIFY(!proxy.mapFromSource(model.index(19, 0)).isValid());
+
+    // Only the latest request is applied.
+    sig_ready.clear();
+    proxy.setFilterWildcard("b");
+    proxy.setFilterWildcard("b1");
+    WAIT_SIG(sig_ready);
+    QTest::qWait(100);
+    QVERIFY(sig_ready.count() == 1);
+    QVERIFY(proxy.rowCount() == 1);
+    QVERIFY(proxy.index(0, FileTableModel::FILE).data().toString() == "b1");
+
+    // Back to the order of the listing.
+    sig_ready.clear();
+    proxy.setFilterWildcard("");
+    proxy.sort(-1);
+    WAIT_SIG(sig_ready);
+    QVERIFY(proxy.rowCount() == 20);
+    QVERIFY(proxy.index(0, FileTableModel::FILE).data().toString() == "a0");
+
+    // Wait for the tasks to be deleted.
+    QThreadPool::globalInstance()->waitForDone(5000);
+    QCoreApplication::processEvents();
+}
+
+void TestArchivesTabWidget::archiveContentsTree()
+{
+    FileTreeModel model;
+    QSignalSpy    sig_ready(&model, SIGNAL(ready()));
+    connect(&model, &FileTreeModel::taskRequested, &runTask);
+
+    // "docs" is only implied by the paths of its files.
+    const QByteArray text(
+        "drwxr-xr-x 0 user group 0 Jan 1 2019 home/\n"
+        "-rw-r--r-- 0 user group 100 Jan 1 2019 home/a.txt\n"
+        "-rw-r--r-- 0 user group 20 Jan 1 2019 home/docs/b.txt\n"
+        "-rw-r--r-- 0 user group 3 Jan 1 2019 ./home/docs/c.txt\n"
+        "lrwxr-xr-x 0 user group 0 Jan 1 2019 home/link -> docs/b.txt\n"
+        "-rw-r--r-- 0 user group 4000 Jan 1 2019 top.txt\n");
+    model.setListing(ArchiveListingPtr(new ArchiveListing(TaskOutput(text))));
+    QVERIFY(model.isBusy());
+    WAIT_SIG(sig_ready);
+    QVERIFY(!model.isBusy());
+
+    // Directories come first.
+    QVERIFY(model.rowCount() == 2);
+    const QModelIndex home = model.index(0, FileTreeModel::NAME);
+    QVERIFY(home.data().toString() == "home");
+    QVERIFY(model.index(1, FileTreeModel::NAME).data().toString()
+            == "top.txt");
+    QVERIFY(model.index(0, FileTreeModel::FILES).data().toInt() == 4);
+
+    // Children are only shown once they are fetched.
+    QVERIFY(model.hasChildren(home));
+    QVERIFY(model.rowCount(home) == 0);
+    QVERIFY(model.canFetchMore(home));
+    model.fetchMore(home);
+    QVERIFY(!model.canFetchMore(home));
+    QVERIFY(model.rowCount(home) == 3);
+    const QModelIndex docs = model.index(0, FileTreeModel::NAME, home);
+    QVERIFY(docs.data().toString() == "docs");
+    QVERIFY(model.parent(docs) == home);
+    QVERIFY(model.index(2, FileTreeModel::NAME, home).data().toString()
+            == "link");
+    QVERIFY(model.path(docs) == "home/docs");
+
+    // Files are restored by their names in the listing.
+    QVERIFY(model.path(home) == "home/");
+    QVERIFY(model.path(model.index(2, 0, home)) == "home/link");
+
+    // The totals include everything below a directory.
+    model.fetchMore(docs);
+    QVERIFY(model.rowCount(docs) == 2);
+    QVERIFY(model.path(model.index(1, 0, docs)) == "./home/docs/c.txt");
+    QVERIFY(model.index(0, FileTreeModel::FILES, docs).data().isNull());
+    QVERIFY(model.index(0, FileTreeModel::FILES, home).data().toInt() == 2);
+    QVERIFY(model.index(0, FileTreeModel::SIZE, home).data().toString()
+            == humanBytes(23));
+
+    // Absolute paths (from "tarsnap -P") keep the leading "/", even for
+    // directories which are not in the listing.
+    sig_ready.clear();
+    model.setListing(ArchiveListingPtr(new ArchiveListing(TaskOutput(
+        QByteArray("-rw-r--r-- 0 user group 5 Jan 1 2019 /etc/hosts
+"
+                   "-rw-r--r-- 0 user group 6 Jan 1 2019 /etc/ssh/config
+")))));
+    WAIT_SIG(sig_ready);
+    QVERIFY(model.rowCount() == 1);
+    const QModelIndex etc = model.index(0, FileTreeModel::NAME);
+    QVERIFY(etc.data().toString() == "etc");
+    QVERIFY(model.path(etc) == "/etc");
+    model.fetchMore(etc);
+    QVERIFY(model.rowCount(etc) == 2);
+    const QModelIndex ssh = model.index(0, FileTreeModel::NAME, etc);
+    QVERIFY(model.path(ssh) == "/etc/ssh");
+    QVERIFY(model.path(model.index(1, 0, etc)) == "/etc/hosts");
+    model.fetchMore(ssh);
+    QVERIFY(model.path(model.index(0, 0, ssh)) == "/etc/ssh/config");
+
+    // Clearing the listing clears the tree.
+    model.setListing(ArchiveListingPtr());
+    QVERIFY(model.rowCount() == 0);
+    QVERIFY(!model.isBusy());
+
+    // Wait for the task to be deleted.
+    QThreadPool::globalInstance()->waitForDone(5000);
+    QCoreApplication::processEvents();
+}
+
 void TestArchivesTabWidget::displayArchive()
 {
     ArchivesTabWidget     *archivestabwidget = new ArchivesTabWidget();
@@ -120,7 +584,7 @@ void TestArchivesTabWidget::displayArchive()
     Archive   *actual_archive = new Archive();
     ArchivePtr archive(actual_archive);
     archive->setName("archive1");
-    archive->setContents("-rw-r--r-- 0 user group 1234 Jan 1 2019 myfile");
+    archive->setHasContents(true);
 
     alw->addArchive(archive);
     VISUAL_WAIT;
@@ -137,9 +601,9 @@ void TestArchivesTabWidget::displayArchive()
     BaseTask *task = sig_taskRequest.takeFirst().at(0).value<BaseTask *>();
 
     // Fake a reply.
-    FileStat parsed = {"myfile", "Jan 1 2019", 1234, "user", "group", "644", 0};
-    QVector<FileStat> files = {parsed};
-    fm->setFiles(files);
+    ArchiveListingPtr listing(new ArchiveListing(TaskOutput(
+        QByteArray("-rw-r--r-- 0 user group 1234 Jan 1 2019 myfile"))));
+    fm->setListing(listing);
     VISUAL_WAIT;
 
     // Check that we have 1 file, with 7 pieces of info.
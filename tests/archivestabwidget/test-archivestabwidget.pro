@@ -4,7 +4,7 @@ QT = core gui widgets sql
 VALGRIND = true
 
 FORMS +=						\
-	../../forms/archivelistwidgetitem.ui		\
+	../../forms/archivediffdialog.ui		\
 	../../forms/archivestabwidget.ui		\
 	../../forms/archivewidget.ui			\
 	../../forms/restoredialog.ui
@@ -12,46 +12,77 @@ FORMS +=						\
 RESOURCES += ../../resources/resources.qrc
 
 HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/TSettings.h			\
 	../../lib/widgets/TElidedLabel.h		\
+	../../src/archivediff.h				\
+	../../src/archivediffmodel.h			\
+	../../src/archivedifftask.h			\
+	../../src/archivelisting.h			\
+	../../src/archivelistmodel.h			\
 	../../src/basetask.h				\
 	../../src/filetablemodel.h			\
+	../../src/filetableproxymodel.h			\
+	../../src/filetablesorttask.h			\
+	../../src/filetree.h				\
+	../../src/filetreemodel.h			\
+	../../src/filetreetask.h			\
 	../../src/humanbytes.h				\
+	../../src/messages/archivediffptr.h		\
 	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
 	../../src/messages/archiveptr.h			\
 	../../src/messages/archiverestoreoptions.h	\
+	../../src/messages/changeset.h			\
+	../../src/messages/filetreeptr.h		\
+	../../src/messages/taskoutput.h			\
+	../../src/nameindex.h				\
 	../../src/parsearchivelistingtask.h		\
 	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
 	../../src/tasks/tasks-utils.h			\
+	../../src/widgets/archivediffdialog.h		\
+	../../src/widgets/archivelistdelegate.h		\
 	../../src/widgets/archivelistwidget.h		\
-	../../src/widgets/archivelistwidgetitem.h	\
 	../../src/widgets/archivestabwidget.h		\
 	../../src/widgets/archivewidget.h		\
-	../../src/widgets/elidedannotatedlabel.h	\
 	../../src/widgets/elidedclickablelabel.h	\
 	../../src/widgets/restoredialog.h		\
 	../qtest-platform.h
 
 SOURCES += test-archivestabwidget.cpp			\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/TSettings.cpp			\
 	../../lib/widgets/TElidedLabel.cpp		\
+	../../src/archivediff.cpp			\
+	../../src/archivediffmodel.cpp			\
+	../../src/archivedifftask.cpp			\
+	../../src/archivelisting.cpp			\
+	../../src/archivelistmodel.cpp			\
 	../../src/basetask.cpp				\
 	../../src/filetablemodel.cpp			\
+	../../src/filetableproxymodel.cpp		\
+	../../src/filetablesorttask.cpp			\
+	../../src/filetree.cpp				\
+	../../src/filetreemodel.cpp			\
+	../../src/filetreetask.cpp			\
 	../../src/humanbytes.cpp			\
+	../../src/nameindex.cpp				\
 	../../src/parsearchivelistingtask.cpp		\
 	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
 	../../src/persistentmodel/upgrade-store.cpp	\
 	../../src/tasks/tasks-utils.cpp			\
+	../../src/widgets/archivediffdialog.cpp		\
+	../../src/widgets/archivelistdelegate.cpp	\
 	../../src/widgets/archivelistwidget.cpp		\
-	../../src/widgets/archivelistwidgetitem.cpp	\
 	../../src/widgets/archivestabwidget.cpp		\
 	../../src/widgets/archivewidget.cpp		\
-	../../src/widgets/elidedannotatedlabel.cpp	\
 	../../src/widgets/elidedclickablelabel.cpp	\
 	../../src/widgets/restoredialog.cpp
 
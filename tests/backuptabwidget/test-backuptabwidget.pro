@@ -13,11 +13,15 @@ HEADERS  +=						\
 	../../lib/widgets/TElidedLabel.h		\
 	../../src/backuptask.h				\
 	../../src/basetask.h				\
-	../../src/customfilesystemmodel.h		\
+	../../src/changetracker.h			\
+	../../src/checkstatetree.h			\
+	../../src/direnumeratortask.h			\
 	../../src/dirinfotask.h				\
+	../../src/filepickermodel.h			\
 	../../src/humanbytes.h				\
 	../../src/persistentmodel/archive.h		\
 	../../src/persistentmodel/job.h			\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
@@ -38,9 +42,13 @@ SOURCES += test-backuptabwidget.cpp			\
 	../../lib/widgets/TElidedLabel.cpp		\
 	../../src/backuptask.cpp			\
 	../../src/basetask.cpp				\
-	../../src/customfilesystemmodel.cpp		\
+	../../src/changetracker.cpp			\
+	../../src/checkstatetree.cpp			\
+	../../src/direnumeratortask.cpp			\
 	../../src/dirinfotask.cpp			\
+	../../src/filepickermodel.cpp			\
 	../../src/humanbytes.cpp			\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/tasks/tasks-utils.cpp			\
 	../../src/persistentmodel/archive.cpp		\
 	../../src/persistentmodel/job.cpp		\
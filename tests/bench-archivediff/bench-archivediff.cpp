@@ -0,0 +1,164 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTest>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+#include "messages/taskoutput.h"
+
+#include "archivediff.h"
+#include "archivelisting.h"
+
+// Size of the synthetic listings, and how often a file changes.
+#define NUM_FILES 500000
+#define MODIFIED_EVERY 100
+#define REMOVED_EVERY 250
+#define NUM_ADDED 1000
+
+// How the listings are compared.
+#define COMPARE_HASH 0
+#define COMPARE_MERGE 1
+#define COMPARE_CHANGED_LINES 2
+
+/*
+ * Compares two listings of 500k files: by looking up every file of one
+ * listing in a hash of the other (parsing every line), with the streaming
+ * merge of ArchiveDiff, or with ArchiveDiff on the lines which are not in
+ * both listings (which is what the ListingStore provides).  Run with
+ * "make bench" from the top-level directory.
+ */
+class BenchArchiveDiff : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void compare_data();
+    void compare();
+
+private:
+    QByteArray _from;
+    QByteArray _to;
+    QByteArray _fromChanged;
+    QByteArray _toChanged;
+    int        _expected;
+};
+
+static QByteArray line(int file, int size)
+{
+    return (QString("-rw-r--r--  0 user   staff    %1 Jan 17  2019 home/user/"
+                    "documents/projects/project-%2/src/file-%3.cpp\n")
+                .arg(size, 8)
+                .arg(file / 1000)
+                .arg(file)
+                .toUtf8());
+}
+
+void BenchArchiveDiff::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    _expected = NUM_ADDED;
+    for(int i = 0; i < NUM_FILES; i++)
+    {
+        const QByteArray before = line(i, i % 100000);
+        _from.append(before);
+        if((i % REMOVED_EVERY) == 0)
+        {
+            _fromChanged.append(before);
+            _expected++;
+            continue;
+        }
+        if((i % MODIFIED_EVERY) == 0)
+        {
+            const QByteArray after = line(i, i % 100000 + 1);
+            _to.append(after);
+            _fromChanged.append(before);
+            _toChanged.append(after);
+            _expected++;
+            continue;
+        }
+        _to.append(before);
+    }
+    for(int i = NUM_FILES; i < NUM_FILES + NUM_ADDED; i++)
+    {
+        const QByteArray added = line(i, i % 100000);
+        _to.append(added);
+        _toChanged.append(added);
+    }
+
+    qDebug("listings: %d and %d bytes; changed lines: %d and %d bytes",
+           _from.size(), _to.size(), _fromChanged.size(), _toChanged.size());
+}
+
+void BenchArchiveDiff::compare_data()
+{
+    QTest::addColumn<int>("method");
+
+    QTest::newRow("hash") << COMPARE_HASH;
+    QTest::newRow("merge") << COMPARE_MERGE;
+    QTest::newRow("changed-lines") << COMPARE_CHANGED_LINES;
+}
+
+void BenchArchiveDiff::compare()
+{
+    QFETCH(int, method);
+
+    int changes = 0;
+    if(method == COMPARE_HASH)
+    {
+        // Keep every parsed line of one listing, keyed by path.
+        QBENCHMARK
+        {
+            ArchiveListing           from{TaskOutput(_from)};
+            ArchiveListing           to{TaskOutput(_to)};
+            QHash<QString, FileStat> files;
+            files.reserve(from.count());
+            for(int row = 0; row < from.count(); row++)
+            {
+                const FileStat stat = from.stat(row);
+                files.insert(stat.name, stat);
+            }
+            changes = 0;
+            for(int row = 0; row < to.count(); row++)
+            {
+                const FileStat stat = to.stat(row);
+                auto           it   = files.find(stat.name);
+                if(it == files.end())
+                {
+                    changes++;
+                    continue;
+                }
+                if((it->size != stat.size) || (it->modified != stat.modified))
+                    changes++;
+                files.erase(it);
+            }
+            changes += files.count();
+        }
+    }
+    else
+    {
+        const QByteArray &fromText =
+            (method == COMPARE_MERGE) ? _from : _fromChanged;
+        const QByteArray &toText = (method == COMPARE_MERGE) ? _to : _toChanged;
+        QBENCHMARK
+        {
+            ArchiveListingPtr from(new ArchiveListing(TaskOutput(fromText)));
+            ArchiveListingPtr to(new ArchiveListing(TaskOutput(toText)));
+            changes = ArchiveDiff(from, to).count();
+        }
+    }
+    QVERIFY(changes == _expected);
+}
+
+QTEST_MAIN(BenchArchiveDiff)
+WARNINGS_DISABLE
+#include "bench-archivediff.moc"
+WARNINGS_ENABLE
@@ -0,0 +1,22 @@
+TARGET = bench-archivediff
+QT = core
+
+HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
+	../../src/archivediff.h				\
+	../../src/archivelisting.h			\
+	../../src/messages/archivediffptr.h		\
+	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
+	../../src/messages/taskoutput.h
+
+SOURCES += bench-archivediff.cpp			\
+	../../lib/core/ByteScan.cpp			\
+	../../src/archivediff.cpp			\
+	../../src/archivelisting.cpp
+
+include(../tests-include.pri)
+
+# Benchmarks are built with optimizations, unlike the tests.
+CONFIG -= debug
+CONFIG += release
@@ -0,0 +1,185 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTest>
+WARNINGS_ENABLE
+
+#include "../qtest-platform.h"
+
+#include "messages/archiveptr.h"
+#include "messages/changeset.h"
+
+#include "persistentmodel/archive.h"
+#include "widgets/archivelistwidget.h"
+
+#include "TSettings.h"
+
+// Size of the archive list.
+#define NUM_ARCHIVES 10000
+
+// Number of archives which are added one at a time.
+#define NUM_SINGLE 500
+
+// How the list is refreshed.
+#define REFRESH_REPLAY 0
+#define REFRESH_CHANGES 1
+#define REFRESH_SNAPSHOT 2
+
+/*
+ * Refreshes an ArchiveListWidget with 10k archives after 1 archive was
+ * added (or removed): by replaying the whole list (as before change sets),
+ * with the change set, or with a snapshot which only differs by 1 archive.
+ * Also fills an empty ArchiveListWidget with the 10k archives (half of them
+ * at once, the other half in a change set), then with 500 more archives one
+ * at a time.
+ * Run with "make bench" from the top-level directory.
+ */
+class BenchArchiveList : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void refresh_data();
+    void refresh();
+    void fill();
+
+private:
+    QList<ArchivePtr> _archives;
+    QList<ArchivePtr> _single;
+    ArchivePtr        _extra;
+    ArchiveChanges    _snapshot;
+    ArchiveChanges    _snapshotExtra;
+};
+
+void BenchArchiveList::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    // Use a custom message handler to filter out unwanted messages
+    IF_NOT_VISUAL { qInstallMessageHandler(offscreenMessageOutput); }
+
+    const QDateTime start = QDateTime::fromString("2019-01-01T00:00:00",
+                                                  Qt::ISODate);
+    for(int i = 0; i < NUM_ARCHIVES; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("Job_documents_%1").arg(i));
+        archive->setTimestamp(start.addSecs(3600 * i));
+        archive->setSizeTotal(static_cast<quint64>(i) * 1000);
+        _archives << archive;
+        _snapshot.added.insert(archive);
+    }
+    _snapshot.reset = true;
+    for(int i = 0; i < NUM_SINGLE; i++)
+    {
+        ArchivePtr archive(new Archive);
+        archive->setName(QString("Job_single_%1").arg(i));
+        archive->setTimestamp(start.addSecs(77 * i + 1));
+        _single << archive;
+    }
+
+    // A new backup.
+    _extra = ArchivePtr(new Archive);
+    _extra->setName("Job_documents_new");
+    _extra->setTimestamp(start.addSecs(3600 * NUM_ARCHIVES));
+    _snapshotExtra = _snapshot;
+    _snapshotExtra.added.insert(_extra);
+}
+
+void BenchArchiveList::cleanupTestCase()
+{
+    TSettings::destroy();
+}
+
+void BenchArchiveList::refresh_data()
+{
+    QTest::addColumn<int>("refresh");
+
+    QTest::newRow("replay") << REFRESH_REPLAY;
+    QTest::newRow("changes") << REFRESH_CHANGES;
+    QTest::newRow("snapshot") << REFRESH_SNAPSHOT;
+}
+
+void BenchArchiveList::refresh()
+{
+    QFETCH(int, refresh);
+
+    QList<ArchivePtr> archivesExtra = _archives;
+    archivesExtra << _extra;
+
+    ArchiveListWidget alw;
+    quint64           version = 1;
+    _snapshot.version         = version;
+    alw.applyChanges(_snapshot);
+
+    // Every iteration adds or removes the extra archive.
+    bool present = false;
+    QBENCHMARK
+    {
+        present = !present;
+        version++;
+        if(refresh == REFRESH_REPLAY)
+        {
+            alw.setArchives(present ? archivesExtra : _archives);
+        }
+        else if(refresh == REFRESH_CHANGES)
+        {
+            ArchiveChanges changes;
+            changes.fromVersion = version - 1;
+            changes.version     = version;
+            if(present)
+                changes.add(_extra);
+            else
+                changes.remove(_extra);
+            alw.applyChanges(changes);
+        }
+        else
+        {
+            ArchiveChanges snapshot = present ? _snapshotExtra : _snapshot;
+            snapshot.version        = version;
+            alw.applyChanges(snapshot);
+        }
+    }
+    QVERIFY(alw.count() == NUM_ARCHIVES + (present ? 1 : 0));
+    QVERIFY(alw.findArchiveByName(_extra->name()).isNull() != present);
+}
+
+void BenchArchiveList::fill()
+{
+    // Interleaved timestamps for the two halves.
+    QList<ArchivePtr> even;
+    ArchiveChanges    odd;
+    odd.version = 1;
+    for(int i = 0; i < NUM_ARCHIVES; i++)
+    {
+        if(i % 2 == 0)
+            even << _archives.at(i);
+        else
+            odd.add(_archives.at(i));
+    }
+
+    int count = 0;
+    QBENCHMARK
+    {
+        ArchiveListWidget alw;
+        alw.setArchives(even);
+        alw.applyChanges(odd);
+        for(const ArchivePtr &archive : _single)
+            alw.addArchive(archive);
+        count = alw.count();
+    }
+    QVERIFY(count == NUM_ARCHIVES + NUM_SINGLE);
+}
+
+QTEST_MAIN(BenchArchiveList)
+WARNINGS_DISABLE
+#include "bench-archivelist.moc"
+WARNINGS_ENABLE
@@ -0,0 +1,45 @@
+TARGET = bench-archivelist
+QT = core gui widgets sql
+
+FORMS +=						\
+	../../forms/restoredialog.ui
+
+RESOURCES += ../../resources/resources.qrc
+
+HEADERS  +=						\
+	../../lib/core/TSettings.h			\
+	../../src/archivelistmodel.h			\
+	../../src/humanbytes.h				\
+	../../src/messages/archiveptr.h			\
+	../../src/messages/archiverestoreoptions.h	\
+	../../src/messages/changeset.h			\
+	../../src/nameindex.h				\
+	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/listingstore.h	\
+	../../src/persistentmodel/persistentobject.h	\
+	../../src/persistentmodel/persistentstore.h	\
+	../../src/persistentmodel/upgrade-store.h	\
+	../../src/widgets/archivelistdelegate.h		\
+	../../src/widgets/archivelistwidget.h		\
+	../../src/widgets/restoredialog.h		\
+	../qtest-platform.h
+
+SOURCES += bench-archivelist.cpp			\
+	../../lib/core/TSettings.cpp			\
+	../../src/archivelistmodel.cpp			\
+	../../src/humanbytes.cpp			\
+	../../src/nameindex.cpp				\
+	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
+	../../src/persistentmodel/persistentobject.cpp	\
+	../../src/persistentmodel/persistentstore.cpp	\
+	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/widgets/archivelistdelegate.cpp	\
+	../../src/widgets/archivelistwidget.cpp		\
+	../../src/widgets/restoredialog.cpp
+
+include(../tests-include.pri)
+
+# Benchmarks are built with optimizations, unlike the tests.
+CONFIG -= debug
+CONFIG += release
@@ -0,0 +1,133 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIODevice>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include <algorithm>
+
+#include "ConsoleLog.h"
+
+// Number of messages in each iteration.
+#define NUM_MESSAGES 10000
+
+// How the messages are saved.
+#define WRITE_LEGACY 0
+#define WRITE_ASYNC 1
+
+// How ConsoleLog used to save each message: open, append, close.
+static void legacySaveLogMessage(const QString &filename, const QString &msg)
+{
+    QFile logFile(filename);
+    if(!logFile.open(QIODevice::Append | QIODevice::Text)
+       && !logFile.open(QIODevice::WriteOnly | QIODevice::Text))
+        return;
+    logFile.write(QByteArray(msg.toLatin1()));
+    logFile.close();
+}
+
+static int countLines(const QString &filename)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return (-1);
+    return (file.readAll().count('\n'));
+}
+
+/*
+ * Saves 10k messages to the log file: by opening, appending, and closing
+ * the file for each message on the caller's thread (as before the
+ * ConsoleLogWriter), or by queuing them for the ConsoleLogWriter thread.
+ * The latency percentiles show how long the caller is blocked.
+ * Run with "make bench" from the top-level directory.
+ */
+class BenchConsoleLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void write_data();
+    void write();
+};
+
+void BenchConsoleLog::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    LOG.initializeConsoleLog();
+}
+
+void BenchConsoleLog::cleanupTestCase()
+{
+    ConsoleLog::destroy();
+}
+
+void BenchConsoleLog::write_data()
+{
+    QTest::addColumn<int>("write");
+
+    QTest::newRow("legacy") << WRITE_LEGACY;
+    QTest::newRow("async") << WRITE_ASYNC;
+}
+
+void BenchConsoleLog::write()
+{
+    QFETCH(int, write);
+
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    const QString logFile = tmpdir.path() + "/bench.log";
+    const QString msg     = "tarsnap: a typical line of output from a task\n";
+    if(write == WRITE_ASYNC)
+    {
+        LOG.setFilename(logFile);
+        LOG.setWriteToFile(true);
+    }
+
+    // How long the caller waits for each message.
+    QElapsedTimer   each;
+    QVector<qint64> ns;
+    ns.reserve(NUM_MESSAGES);
+    QBENCHMARK
+    {
+        ns.clear();
+        for(int i = 0; i < NUM_MESSAGES; i++)
+        {
+            each.start();
+            if(write == WRITE_LEGACY)
+                legacySaveLogMessage(logFile, msg);
+            else
+                LOG << msg;
+            ns << each.nsecsElapsed();
+        }
+        if(write == WRITE_ASYNC)
+            LOG.flush();
+    }
+    LOG.setWriteToFile(false);
+
+    std::sort(ns.begin(), ns.end());
+    qDebug("latency p50 %.1f us, p99 %.1f us, max %.1f us",
+           ns.at(ns.size() / 2) / 1e3, ns.at(ns.size() * 99 / 100) / 1e3,
+           ns.last() / 1e3);
+
+    // Every message arrived.
+    const int lines = countLines(logFile);
+    QVERIFY((lines > 0) && ((lines % NUM_MESSAGES) == 0));
+}
+
+QTEST_MAIN(BenchConsoleLog)
+WARNINGS_DISABLE
+#include "bench-consolelog.moc"
+WARNINGS_ENABLE
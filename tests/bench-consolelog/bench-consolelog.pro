@@ -0,0 +1,16 @@
+TARGET = bench-consolelog
+QT = core
+
+HEADERS  +=						\
+	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h
+
+SOURCES += bench-consolelog.cpp				\
+	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp
+
+include(../tests-include.pri)
+
+# Benchmarks are built with optimizations, unlike the tests.
+CONFIG -= debug
+CONFIG += release
@@ -0,0 +1,115 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QIODevice>
+#include <QModelIndex>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThreadPool>
+#include <QVariant>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "basetask.h"
+#include "filepickermodel.h"
+
+// Number of files in the large directory.
+#define LARGE_DIR_FILES 10000
+
+// Run the tasks which the model requests, like the TaskManager would.
+static void runTask(BaseTask *task)
+{
+    QObject::connect(task, &BaseTask::dequeue, task, &QObject::deleteLater,
+                     Qt::QueuedConnection);
+    task->setAutoDelete(false);
+    QThreadPool::globalInstance()->start(task);
+}
+
+/*
+ * Reads a directory with 10k files in the background.  Checks and unchecks
+ * every file in that directory, then checks the directory and queries every
+ * file.
+ * Run with "make bench" from the top-level directory.
+ */
+class BenchFilePickerModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void readDirectory();
+    void checkStates();
+
+private:
+    QTemporaryDir _largeDir;
+};
+
+void BenchFilePickerModel::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    // Create a flat directory with many files.
+    QVERIFY(_largeDir.isValid());
+    for(int i = 0; i < LARGE_DIR_FILES; i++)
+    {
+        QFile file(_largeDir.path() + QString("/file-%1").arg(i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+}
+
+void BenchFilePickerModel::readDirectory()
+{
+    int rows = 0;
+    QBENCHMARK
+    {
+        FilePickerModel model;
+        connect(&model, &FilePickerModel::taskRequested, &runTask);
+        QModelIndex dir = model.index(_largeDir.path());
+        model.fetchMore(dir);
+        while(model.isLoading(dir))
+            QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+        rows = model.rowCount(dir);
+    }
+    QVERIFY(rows == LARGE_DIR_FILES);
+}
+
+void BenchFilePickerModel::checkStates()
+{
+    FilePickerModel model;
+    connect(&model, &FilePickerModel::taskRequested, &runTask);
+    QModelIndex dir = model.index(_largeDir.path());
+    model.fetchMore(dir);
+    QTRY_COMPARE_WITH_TIMEOUT(model.isLoading(dir), false, 10000);
+    QVERIFY(model.rowCount(dir) == LARGE_DIR_FILES);
+
+    QBENCHMARK
+    {
+        // Check every file.
+        for(int i = 0; i < LARGE_DIR_FILES; i++)
+            model.setData(model.index(i, 0, dir), Qt::Checked,
+                          Qt::CheckStateRole);
+
+        // Uncheck every file.
+        for(int i = 0; i < LARGE_DIR_FILES; i++)
+            model.setData(model.index(i, 0, dir), Qt::Unchecked,
+                          Qt::CheckStateRole);
+
+        // Check the directory, and query every file.
+        model.setData(dir, Qt::Checked, Qt::CheckStateRole);
+        for(int i = 0; i < LARGE_DIR_FILES; i++)
+            model.data(model.index(i, 0, dir), Qt::CheckStateRole);
+        model.setData(dir, Qt::Unchecked, Qt::CheckStateRole);
+    }
+    QVERIFY(model.checkedPaths().isEmpty());
+}
+
+QTEST_MAIN(BenchFilePickerModel)
+WARNINGS_DISABLE
+#include "bench-filepickermodel.moc"
+WARNINGS_ENABLE
@@ -0,0 +1,24 @@
+TARGET = bench-filepickermodel
+QT = core gui widgets
+
+HEADERS	+=						\
+	../../lib/core/TSettings.h			\
+	../../src/basetask.h				\
+	../../src/checkstatetree.h			\
+	../../src/direnumeratortask.h			\
+	../../src/filepickermodel.h			\
+	../../src/humanbytes.h
+
+SOURCES	+= bench-filepickermodel.cpp			\
+	../../lib/core/TSettings.cpp			\
+	../../src/basetask.cpp				\
+	../../src/checkstatetree.cpp			\
+	../../src/direnumeratortask.cpp			\
+	../../src/filepickermodel.cpp			\
+	../../src/humanbytes.cpp
+
+include(../tests-include.pri)
+
+# Benchmarks are built with optimizations, unlike the tests.
+CONFIG -= debug
+CONFIG += release
@@ -0,0 +1,301 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QChar>
+#include <QCoreApplication>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QVector>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+#include "messages/taskoutput.h"
+
+#include "ByteScan.h"
+#include "archivelisting.h"
+#include "tasks/tasks-tarsnap.h"
+
+#include "../legacy-parsers.h"
+
+// Size of the synthetic outputs.
+#define NUM_ARCHIVES 20000
+#define NUM_LISTING_LINES 200000
+#define NUM_STATS_PARSES 1000
+
+// Passed instead of a ByteScan::Implementation to use the old parsers.
+#define REGEX_PARSER -1
+
+/*
+ * Compares the QRegExp parsers (as they were before ByteScan) with the
+ * current parsers, using each ByteScan implementation which the CPU
+ * supports.  Run with "make bench" from the top-level directory, or
+ * "./bench-parsers -iterations N" for more stable numbers.
+ */
+class BenchParsers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void scanNewlines_data();
+    void scanNewlines();
+    void listArchives_data();
+    void listArchives();
+    void archiveListing_data();
+    void archiveListing();
+    void indexListing_data();
+    void indexListing();
+    void printStats_data();
+    void printStats();
+
+private:
+    ByteScan::Implementation _automatic;
+    QByteArray               _listArchives;
+    QByteArray               _listing;
+    QByteArray               _printStats;
+
+    void addRows(bool withRegex);
+    bool useImplementation(int impl);
+};
+
+void BenchParsers::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+    _automatic = ByteScan::implementation();
+
+    // `tarsnap --list-archives -vv`
+    for(int i = 0; i < NUM_ARCHIVES; i++)
+        _listArchives.append(
+            QString("Job_documents_2019-%1-%2_12-00-00\t2019-%1-%2 12:00:00"
+                    "\ttarsnap -c -f Job_documents_2019-%1-%2_12-00-00 "
+                    "--quiet --no-humanize-numbers /home/user/documents\n")
+                .arg(1 + i % 12, 2, 10, QChar('0'))
+                .arg(1 + i % 28, 2, 10, QChar('0'))
+                .toUtf8());
+
+    // `tarsnap -tv -f ARCHIVENAME`
+    for(int i = 0; i < NUM_LISTING_LINES; i++)
+        _listing.append(
+            QString("-rw-r--r--  0 user   staff    %1 Jan 17  2019 home/user/"
+                    "documents/projects/project-%2/src/file-%3.cpp\n")
+                .arg(i * 37 % 100000, 8)
+                .arg(i / 1000)
+                .arg(i)
+                .toUtf8());
+
+    // `tarsnap --print-stats -f ARCHIVENAME`
+    _printStats = "                                       Total size  "
+                  "Compressed size\n"
+                  "All archives                          104857600000  "
+                  "52428800000\n"
+                  "  (unique data)                        10485760000   "
+                  "5242880000\n"
+                  "This archive                            1048576000    "
+                  "524288000\n"
+                  "New data                                  10485760      "
+                  "5242880\n";
+
+    qDebug("list-archives: %d bytes; listing: %d bytes; using %s",
+           _listArchives.size(), _listing.size(),
+           ByteScan::implementationName(ByteScan::implementation())
+               .toLatin1()
+               .constData());
+}
+
+void BenchParsers::cleanup()
+{
+    // Go back to the automatic choice.
+    ByteScan::setImplementation(_automatic);
+}
+
+void BenchParsers::addRows(bool withRegex)
+{
+    QTest::addColumn<int>("impl");
+
+    if(withRegex)
+        QTest::newRow("regex") << REGEX_PARSER;
+    for(ByteScan::Implementation impl :
+        {ByteScan::Scalar, ByteScan::SSE2, ByteScan::AVX2})
+    {
+        const QString name = ByteScan::implementationName(impl);
+        QTest::newRow(name.toLatin1().constData()) << static_cast<int>(impl);
+    }
+}
+
+bool BenchParsers::useImplementation(int impl)
+{
+    if(impl == REGEX_PARSER)
+        return (true);
+    return (ByteScan::setImplementation(
+        static_cast<ByteScan::Implementation>(impl)));
+}
+
+void BenchParsers::scanNewlines_data()
+{
+    addRows(false);
+}
+
+void BenchParsers::scanNewlines()
+{
+    QFETCH(int, impl);
+    if(!useImplementation(impl))
+        QSKIP("Not supported by this CPU");
+
+    const char *start = _listing.constData();
+    const char *end   = start + _listing.size();
+    int         lines = 0;
+    QBENCHMARK
+    {
+        const char     *pos = start;
+        ByteScan::Range line;
+        lines = 0;
+        while(ByteScan::nextLine(pos, end, line))
+            lines++;
+    }
+    QVERIFY(lines == NUM_LISTING_LINES);
+}
+
+void BenchParsers::listArchives_data()
+{
+    addRows(true);
+}
+
+void BenchParsers::listArchives()
+{
+    QFETCH(int, impl);
+    if(!useImplementation(impl))
+        QSKIP("Not supported by this CPU");
+
+    QList<struct archive_list_data> metadatas;
+    if(impl == REGEX_PARSER)
+    {
+        // The output used to be decoded before parsing it.
+        QBENCHMARK
+        {
+            metadatas =
+                legacyListArchivesTaskParse(QString::fromUtf8(_listArchives));
+        }
+    }
+    else
+    {
+        QBENCHMARK { metadatas = listArchivesTaskParse(_listArchives); }
+    }
+    QVERIFY(metadatas.count() == NUM_ARCHIVES);
+    QVERIFY(metadatas.last().timestamp.isValid());
+}
+
+void BenchParsers::archiveListing_data()
+{
+    addRows(true);
+}
+
+void BenchParsers::archiveListing()
+{
+    QFETCH(int, impl);
+    if(!useImplementation(impl))
+        QSKIP("Not supported by this CPU");
+
+    // Parse every row, as the old ParseArchiveListingTask did.
+    QVector<FileStat> files;
+    if(impl == REGEX_PARSER)
+    {
+        QBENCHMARK
+        {
+            files = legacyArchiveListingParse(QString::fromUtf8(_listing));
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            ArchiveListing listing{TaskOutput(_listing)};
+            files.clear();
+            files.reserve(listing.count());
+            for(int row = 0; row < listing.count(); row++)
+                files.append(listing.stat(row));
+        }
+    }
+    QVERIFY(files.count() == NUM_LISTING_LINES);
+    QVERIFY(files.last().name.endsWith(
+        QString("file-%1.cpp").arg(NUM_LISTING_LINES - 1)));
+}
+
+void BenchParsers::indexListing_data()
+{
+    addRows(false);
+}
+
+void BenchParsers::indexListing()
+{
+    QFETCH(int, impl);
+    if(!useImplementation(impl))
+        QSKIP("Not supported by this CPU");
+
+    // Index a memory-mapped listing without parsing the rows, as the
+    // FileTableModel does.
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    const TaskOutput mapped = ArchiveListing::mapText(_listing, tmpdir.path());
+    QVERIFY(mapped.isFile());
+
+    int count = 0;
+    QBENCHMARK
+    {
+        ArchiveListing listing(mapped);
+        count = listing.count();
+    }
+    QVERIFY(count == NUM_LISTING_LINES);
+}
+
+void BenchParsers::printStats_data()
+{
+    addRows(true);
+}
+
+void BenchParsers::printStats()
+{
+    QFETCH(int, impl);
+    if(!useImplementation(impl))
+        QSKIP("Not supported by this CPU");
+
+    struct tarsnap_stats archive = {0, 0, 0, 0, true};
+    struct tarsnap_stats overall = {0, 0, 0, 0, true};
+    if(impl == REGEX_PARSER)
+    {
+        QBENCHMARK
+        {
+            for(int i = 0; i < NUM_STATS_PARSES; i++)
+            {
+                const QString output = QString::fromUtf8(_printStats);
+                archive = legacyPrintStatsTaskParse(output, true, "");
+                overall = legacyOverallStatsTaskParse(output);
+            }
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            for(int i = 0; i < NUM_STATS_PARSES; i++)
+            {
+                archive = printStatsTaskParse(_printStats, true, "");
+                overall = overallStatsTaskParse(_printStats);
+            }
+        }
+    }
+    QVERIFY(!archive.parse_error);
+    QVERIFY(archive.unique_compressed == 5242880);
+    QVERIFY(!overall.parse_error);
+    QVERIFY(overall.total == 104857600000ULL);
+}
+
+QTEST_MAIN(BenchParsers)
+WARNINGS_DISABLE
+#include "bench-parsers.moc"
+WARNINGS_ENABLE
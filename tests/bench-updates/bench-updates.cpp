@@ -0,0 +1,128 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QCoreApplication>
+#include <QLabel>
+#include <QObject>
+#include <QString>
+#include <QTest>
+WARNINGS_ENABLE
+
+#include "../qtest-platform.h"
+
+#include "persistentmodel/journal.h"
+#include "persistentmodel/persistentstore.h"
+#include "updatecoalescer.h"
+
+#include "TSettings.h"
+
+// Number of notifications, e.g. one per archive while fetching the stats.
+#define NUM_UPDATES 1000
+
+/*
+ * Delivers 1000 task notifications: to a status label, either directly
+ * (with the events processed after each one, as when they arrive over
+ * time) or through an UpdateCoalescer; and to the Journal, either storing
+ * each message as it arrives or storing them all in one batch.
+ * Run with "make bench" from the top-level directory.
+ */
+class BenchUpdates : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void status_data();
+    void status();
+    void journal_data();
+    void journal();
+};
+
+void BenchUpdates::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    // Use a custom message handler to filter out unwanted messages
+    IF_NOT_VISUAL { qInstallMessageHandler(offscreenMessageOutput); }
+
+    PersistentStore::initializePersistentStore();
+    QVERIFY(global_store->init());
+}
+
+void BenchUpdates::cleanupTestCase()
+{
+    TSettings::destroy();
+    PersistentStore::destroy();
+
+    // Wait up to 5 seconds to delete objects scheduled with ->deleteLater()
+    WAIT_FINAL;
+}
+
+void BenchUpdates::status_data()
+{
+    QTest::addColumn<bool>("coalesced");
+
+    QTest::newRow("direct") << false;
+    QTest::newRow("coalesced") << true;
+}
+
+void BenchUpdates::status()
+{
+    QFETCH(bool, coalesced);
+
+    QLabel label;
+    label.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&label));
+
+    UpdateCoalescer updates;
+    connect(&updates, &UpdateCoalescer::message, &label, &QLabel::setText);
+
+    QBENCHMARK
+    {
+        for(int i = 0; i < NUM_UPDATES; i++)
+        {
+            const QString message = QString("Fetched stats %1").arg(i);
+            if(coalesced)
+                updates.setMessage(message);
+            else
+                label.setText(message);
+            QCoreApplication::processEvents();
+        }
+        updates.flush();
+        QCoreApplication::processEvents();
+    }
+    QVERIFY(label.text() == QString("Fetched stats %1").arg(NUM_UPDATES - 1));
+}
+
+void BenchUpdates::journal_data()
+{
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("per-message") << false;
+    QTest::newRow("batched") << true;
+}
+
+void BenchUpdates::journal()
+{
+    QFETCH(bool, batched);
+
+    Journal journal;
+    QBENCHMARK
+    {
+        for(int i = 0; i < NUM_UPDATES; i++)
+        {
+            journal.logMessage(QString("Fetched stats %1").arg(i));
+            if(!batched)
+                journal.flush();
+        }
+        journal.flush();
+    }
+    journal.purge();
+}
+
+QTEST_MAIN(BenchUpdates)
+WARNINGS_DISABLE
+#include "bench-updates.moc"
+WARNINGS_ENABLE
@@ -0,0 +1,32 @@
+TARGET = bench-updates
+QT = core gui widgets sql
+
+# Needed for the database template
+RESOURCES += ../../resources/resources-lite.qrc
+
+HEADERS  +=						\
+	../../lib/core/LogEntry.h			\
+	../../lib/core/TSettings.h			\
+	../../src/persistentmodel/journal.h		\
+	../../src/persistentmodel/persistentobject.h	\
+	../../src/persistentmodel/persistentstore.h	\
+	../../src/persistentmodel/upgrade-store.h	\
+	../../src/updatecoalescer.h			\
+	../qtest-platform.h
+
+SOURCES += bench-updates.cpp				\
+	../../lib/core/TSettings.cpp			\
+	../../src/persistentmodel/journal.cpp		\
+	../../src/persistentmodel/persistentobject.cpp	\
+	../../src/persistentmodel/persistentstore.cpp	\
+	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/updatecoalescer.cpp
+
+include(../tests-include.pri)
+
+test_home_prep.commands += ; mkdir -p "$${TEST_HOME}/$${TARGET}";	\
+	cp confdir/*.conf "$${TEST_HOME}/$${TARGET}"
+
+# Benchmarks are built with optimizations, unlike the tests.
+CONFIG -= debug
+CONFIG += release
@@ -2,15 +2,32 @@
 
 WARNINGS_DISABLE
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
+#include <QIODevice>
 #include <QObject>
 #include <QString>
+#include <QTemporaryDir>
 #include <QTest>
+#include <QUuid>
 #include <QVariant>
 WARNINGS_ENABLE
 
 #include "ConsoleLog.h"
 #include "TSettings.h"
+#include "consolelogmodel.h"
+
+// Number of messages for the writing tests.
+#define NUM_MESSAGES 10000
+
+static int countLines(const QString &filename)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return (-1);
+    return (file.readAll().count('\n'));
+}
 
 class TestConsoleLog : public QObject
 {
@@ -21,6 +38,9 @@ private slots:
     void cleanupTestCase();
 
     void saveMessage();
+    void writeMany();
+    void modelRing();
+    void modelFilter();
 };
 
 void TestConsoleLog::initTestCase()
@@ -56,6 +76,83 @@ void TestConsoleLog::saveMessage()
     LOG << "don't write this\n";
 }
 
+void TestConsoleLog::writeMany()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QString logFile = tmpdir.path() + "/many.log";
+
+    LOG.setFilename(logFile);
+    LOG.setWriteToFile(true);
+    for(int i = 0; i < NUM_MESSAGES; i++)
+        LOG << QString("message %1\n").arg(i);
+
+    // Everything arrives in the file, in order.
+    LOG.flush();
+    QVERIFY(countLines(logFile) == NUM_MESSAGES);
+    QFile file(logFile);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QVERIFY(file.readLine() == "message 0\n");
+
+    // Nothing else is written after disabling.
+    LOG.setWriteToFile(false);
+    LOG << "don't write this\n";
+    QVERIFY(countLines(logFile) == NUM_MESSAGES);
+}
+
+void TestConsoleLog::modelRing()
+{
+    ConsoleLogModel model(nullptr, 10);
+    QDateTime       now = QDateTime::currentDateTime();
+
+    // Multi-line messages are split into lines.
+    model.appendMessage(now, "first\nsecond\n");
+    QVERIFY(model.rowCount() == 2);
+    QVERIFY(model.entry(1).message == "second");
+
+    // Old lines are dropped once the ring is full.
+    for(int i = 0; i < 25; i++)
+        model.appendMessage(now, QString("line %1").arg(i));
+    QVERIFY(model.rowCount() == 10);
+    QVERIFY(model.entry(0).message == "line 15");
+    QVERIFY(model.entry(9).message == "line 24");
+    QVERIFY(model.index(9).data().toString().endsWith("] line 24"));
+
+    model.clear();
+    QVERIFY(model.rowCount() == 0);
+    model.appendMessage(now, "after clear");
+    QVERIFY(model.rowCount() == 1);
+    QVERIFY(model.entry(0).message == "after clear");
+}
+
+void TestConsoleLog::modelFilter()
+{
+    ConsoleLogModel model(nullptr, 10);
+    QDateTime       now  = QDateTime::currentDateTime();
+    QUuid           uuid = QUuid::createUuid();
+
+    model.appendMessage(now, "unrelated");
+    model.appendMessage(now, QString("Task %1 started").arg(uuid.toString()));
+    QVERIFY(model.entry(1).task == uuid);
+    QVERIFY(model.entry(0).task.isNull());
+
+    // Filter by (part of) the UUID, or by text.
+    model.setFilter(uuid.toString().mid(1, 8));
+    QVERIFY(model.rowCount() == 1);
+    QVERIFY(model.entry(0).task == uuid);
+    model.setFilter("UNRELATED");
+    QVERIFY(model.rowCount() == 1);
+
+    // New lines are only added if they match; dropped lines disappear.
+    for(int i = 0; i < 12; i++)
+        model.appendMessage(now, QString("unrelated %1").arg(i));
+    QVERIFY(model.rowCount() == 10);
+    QVERIFY(model.entry(0).message == "unrelated 2");
+
+    model.setFilter("");
+    QVERIFY(model.rowCount() == 10);
+}
+
 QTEST_MAIN(TestConsoleLog)
 WARNINGS_DISABLE
 #include "test-consolelog.moc"
@@ -5,11 +5,17 @@ VALGRIND = true
 
 HEADERS  +=						\
 	../../lib/core/ConsoleLog.h			\
-	../../lib/core/TSettings.h
+	../../lib/core/ConsoleLogWriter.h		\
+	../../lib/core/LogRing.h			\
+	../../lib/core/TSettings.h			\
+	../../src/consolelogmodel.h
 
 SOURCES += test-consolelog.cpp				\
 	../../lib/core/ConsoleLog.cpp			\
-	../../lib/core/TSettings.cpp
+	../../lib/core/ConsoleLogWriter.cpp		\
+	../../lib/core/LogRing.cpp			\
+	../../lib/core/TSettings.cpp			\
+	../../src/consolelogmodel.cpp
 
 include(../tests-include.pri)
 
@@ -1,15 +1,25 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QByteArray>
 #include <QCoreApplication>
 #include <QObject>
 #include <QString>
 #include <QTest>
 #include <QVariant>
+#include <QVector>
 WARNINGS_ENABLE
 
+#include "ByteScan.h"
 #include "TSettings.h"
 
+// Deterministic pseudo-random numbers, so that failures can be reproduced.
+static quint32 nextRandom(quint32 &state)
+{
+    state = state * 1103515245 + 12345;
+    return (state >> 16);
+}
+
 class TestCore : public QObject
 {
     Q_OBJECT
@@ -21,6 +31,10 @@ private slots:
     void settings_default();
     void settings_custom();
     void settings_default_after_custom();
+
+    void bytescan_implementations();
+    void bytescan_lines_fields();
+    void bytescan_numbers();
 };
 
 void TestCore::initTestCase()
@@ -73,6 +87,95 @@ void TestCore::settings_default_after_custom()
     QVERIFY(user == "default_init");
 }
 
+void TestCore::bytescan_implementations()
+{
+    const ByteScan::Implementation automatic = ByteScan::implementation();
+    QVERIFY(ByteScan::isSupported(ByteScan::Scalar));
+    QVERIFY(ByteScan::isSupported(automatic));
+
+    // Random buffers of blanks, newlines, and other bytes; every length up
+    // to a few SIMD registers, starting at every alignment.
+    const char alphabet[] = " \t\n\v\f\rab\x80\xff";
+    quint32    state      = 1;
+    for(int i = 0; i < 2000; i++)
+    {
+        QByteArray buffer(static_cast<int>(nextRandom(state) % 160), '\0');
+        for(int j = 0; j < buffer.size(); j++)
+            buffer[j] = alphabet[nextRandom(state) % (sizeof(alphabet) - 1)];
+        const char *start = buffer.constData() + (nextRandom(state) % 32);
+        const char *end   = buffer.constData() + buffer.size();
+        if(start > end)
+            start = end;
+
+        QVERIFY(ByteScan::setImplementation(ByteScan::Scalar));
+        const char *nl       = ByteScan::findByte(start, end, '\n');
+        const int   newlines = ByteScan::countByte(start, end, '\n');
+        const char *blank    = ByteScan::findBlank(start, end);
+        const char *other    = ByteScan::skipBlanks(start, end);
+
+        for(ByteScan::Implementation impl : {ByteScan::SSE2, ByteScan::AVX2})
+        {
+            if(!ByteScan::setImplementation(impl))
+                continue;
+            QVERIFY(ByteScan::findByte(start, end, '\n') == nl);
+            QVERIFY(ByteScan::countByte(start, end, '\n') == newlines);
+            QVERIFY(ByteScan::findBlank(start, end) == blank);
+            QVERIFY(ByteScan::skipBlanks(start, end) == other);
+        }
+    }
+    QVERIFY(ByteScan::setImplementation(automatic));
+}
+
+void TestCore::bytescan_lines_fields()
+{
+    // Empty lines are skipped, like split('\n', SKIP_EMPTY_PARTS).
+    QByteArray text("\nfirst line\n\n\nsecond\tline\r\nlast");
+    QVector<ByteScan::Range> lines = ByteScan::splitLines(text);
+    QVERIFY(lines.count() == 3);
+    QVERIFY(lines[0].bytes() == "first line");
+    QVERIFY(lines[1].bytes() == "second\tline\r");
+    QVERIFY(lines[2].toString() == "last");
+    QVERIFY(ByteScan::splitLines(QByteArray("\n\n")).isEmpty());
+
+    // Fields are separated by any number of blanks.
+    QByteArray      line("  one\t two   three four ");
+    ByteScan::Range fields[3];
+    int found = ByteScan::splitFields(line.constData(),
+                                      line.constData() + line.size(), fields,
+                                      3);
+    QVERIFY(found == 3);
+    QVERIFY(fields[0].bytes() == "one");
+    QVERIFY(fields[1].bytes() == "two");
+    QVERIFY(fields[2].bytes() == "three");
+    QVERIFY(ByteScan::skipBlanks(fields[2].end, line.constData() + line.size())
+            == line.constData() + line.indexOf("four"));
+
+    line  = "just two";
+    found = ByteScan::splitFields(line.constData(),
+                                  line.constData() + line.size(), fields, 3);
+    QVERIFY(found == 2);
+}
+
+void TestCore::bytescan_numbers()
+{
+    const char *numbers[] = {"0", "0042", "18446744073709551615",
+                             "18446744073709551616", "", "12a", "-1", " 1"};
+    for(const char *number : numbers)
+    {
+        const QByteArray text(number);
+        quint64          value;
+        bool ok = ByteScan::parseNumber(text.constData(),
+                                        text.constData() + text.size(), value);
+
+        // Only digits are accepted; the value matches QByteArray.
+        bool isNumber = !text.isEmpty();
+        for(char c : text)
+            isNumber = isNumber && (c >= '0') && (c <= '9');
+        QVERIFY(ok == isNumber);
+        QVERIFY(value == (ok ? text.toULongLong() : 0));
+    }
+}
+
 QTEST_MAIN(TestCore)
 WARNINGS_DISABLE
 #include "test-core.moc"
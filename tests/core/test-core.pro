@@ -4,9 +4,11 @@ QT = core
 VALGRIND = true
 
 HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/TSettings.h
 
 SOURCES += test-core.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/TSettings.cpp			\
 
 include(../tests-include.pri)
@@ -19,9 +19,6 @@ WARNINGS_ENABLE
 RunScenario::RunScenario()
     : _rootDir(QDir::currentPath() + QDir::separator() + "dirs")
 {
-    // Set up model.
-    _model.setReadOnly(true);
-    _model.setRootPathBlocking(_rootDir);
 }
 
 // The format of these lines in the scenario file is:
@@ -175,7 +172,7 @@ void RunScenario::printDir(const QString &dirname, const int depth)
         // Add indents to show the directory structure.
         for(int j = 0; j < depth; j++)
             console << "\t";
-        console << _model.fileName(index) << endl;
+        console << _model.data(index, Qt::DisplayRole).toString() << endl;
         // Recursively print the subdirectory.
         if(_model.isDir(index))
         {
@@ -186,5 +183,5 @@ void RunScenario::printDir(const QString &dirname, const int depth)
 
 void RunScenario::printModel()
 {
-    printDir(_model.rootPath(), 0);
+    printDir(_rootDir, 0);
 }
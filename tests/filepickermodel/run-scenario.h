@@ -9,7 +9,7 @@ WARNINGS_DISABLE
 #include <QString>
 WARNINGS_ENABLE
 
-#include "customfilesystemmodel.h"
+#include "filepickermodel.h"
 
 /* Forward declaration(s). */
 class QTextStream;
@@ -27,7 +27,7 @@ public slots:
 
 private:
     // The model we are testing.
-    CustomFileSystemModel _model;
+    FilePickerModel _model;
     // The root directory of the model.
     QString _rootDir;
 
@@ -0,0 +1,228 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QChar>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QModelIndex>
+#include <QObject>
+#include <QSignalSpy>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QTestData>
+#include <QThreadPool>
+#include <QVariant>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "run-scenario.h"
+#include "scenario-num.h"
+
+#include "basetask.h"
+#include "filepickermodel.h"
+
+// Number of files in the large directory, and how long to wait for it.
+#define LARGE_DIR_FILES 20000
+#define LARGE_DIR_TIMEOUT_MS 10000
+
+// Run the tasks which the model requests, like the TaskManager would.
+static void runTask(BaseTask *task)
+{
+    QObject::connect(task, &BaseTask::dequeue, task, &QObject::deleteLater,
+                     Qt::QueuedConnection);
+    task->setAutoDelete(false);
+    QThreadPool::globalInstance()->start(task);
+}
+
+class TestFilePickerModel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void largeDirectory();
+    void checkStates();
+    void runScenario();
+    void runScenario_data();
+    void hiddenFiles();
+    void refresh();
+};
+
+void TestFilePickerModel::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+}
+
+void TestFilePickerModel::largeDirectory()
+{
+    // Create a flat directory with many files, plus a few subdirectories.
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    for(int i = 0; i < LARGE_DIR_FILES; i++)
+    {
+        QFile file(tmpdir.path()
+                   + QString("/file-%1").arg(LARGE_DIR_FILES - i, 5, 10,
+                                             QChar('0')));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QVERIFY(QDir(tmpdir.path()).mkdir("zz-dir"));
+    QVERIFY(QDir(tmpdir.path()).mkdir("AA-dir"));
+
+    FilePickerModel *model = new FilePickerModel();
+    connect(model, &FilePickerModel::taskRequested, &runTask);
+    QModelIndex dir = model->index(tmpdir.path());
+    QVERIFY(dir.isValid());
+    QVERIFY(model->filePath(dir) == tmpdir.path());
+    QVERIFY(model->canFetchMore(dir));
+
+    // Rows arrive in batches; the directory is sorted once it is complete.
+    model->fetchMore(dir);
+    QVERIFY(!model->canFetchMore(dir));
+    QTRY_COMPARE_WITH_TIMEOUT(model->isLoading(dir), false,
+                              LARGE_DIR_TIMEOUT_MS);
+    QVERIFY(model->rowCount(dir) == LARGE_DIR_FILES + 2);
+
+    // Directories come first, then case-insensitive names.
+    QVERIFY(model->index(0, 0, dir).data().toString() == "AA-dir");
+    QVERIFY(model->index(1, 0, dir).data().toString() == "zz-dir");
+    QVERIFY(model->index(2, 0, dir).data().toString() == "file-00001");
+    QVERIFY(model->index(LARGE_DIR_FILES + 1, 0, dir).data().toString()
+            == QString("file-%1").arg(LARGE_DIR_FILES));
+    QVERIFY(model->isDir(model->index(0, 0, dir)));
+    QVERIFY(!model->isDir(model->index(2, 0, dir)));
+
+    // Reversing the order keeps the directories first.
+    model->sort(0, Qt::DescendingOrder);
+    QVERIFY(model->index(0, 0, dir).data().toString() == "zz-dir");
+    QVERIFY(model->index(2, 0, dir).data().toString()
+            == QString("file-%1").arg(LARGE_DIR_FILES));
+
+    delete model;
+}
+
+void TestFilePickerModel::checkStates()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QVERIFY(QDir(tmpdir.path()).mkdir("subdir"));
+    QFile file(tmpdir.path() + "/subdir/file");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+
+    // Paths can be checked before they have been read; the change is
+    // reported for the nearest item in the model.
+    FilePickerModel *model = new FilePickerModel();
+    QSignalSpy       sig_changed(model, &FilePickerModel::dataChanged);
+    model->setPathChecked(tmpdir.path() + "/subdir", true);
+    QVERIFY(model->checkedPaths()
+            == QStringList(tmpdir.path() + "/subdir"));
+    QVERIFY(sig_changed.count() == 1);
+    QVERIFY(sig_changed.takeFirst().at(0).value<QModelIndex>().isValid());
+
+    QModelIndex dir = model->index(tmpdir.path());
+    QVERIFY(model->data(dir, Qt::CheckStateRole).toInt()
+            == Qt::PartiallyChecked);
+    QModelIndex subdir = model->index(tmpdir.path() + "/subdir");
+    QVERIFY(model->data(subdir, Qt::CheckStateRole).toInt() == Qt::Checked);
+    QModelIndex child = model->index(tmpdir.path() + "/subdir/file");
+    QVERIFY(model->data(child, Qt::CheckStateRole).toInt()
+            == Qt::PartiallyChecked);
+
+    // Checking the parent replaces the child.
+    QVERIFY(model->setData(dir, Qt::Checked, Qt::CheckStateRole));
+    QVERIFY(model->checkedPaths() == QStringList(tmpdir.path()));
+    QVERIFY(model->setData(dir, Qt::Unchecked, Qt::CheckStateRole));
+    QVERIFY(model->checkedPaths().isEmpty());
+    QVERIFY(model->data(subdir, Qt::CheckStateRole).toInt() == Qt::Unchecked);
+
+    delete model;
+}
+
+void TestFilePickerModel::runScenario()
+{
+    QFETCH(int, scenario_number);
+
+    RunScenario *runner;
+    runner = new RunScenario();
+
+    QVERIFY(runner->runScenario(scenario_number) == 0);
+
+    delete runner;
+}
+
+void TestFilePickerModel::runScenario_data()
+{
+    QTest::addColumn<int>("scenario_number");
+
+    for(int i = 0; i < NUM_SCENARIOS; i++)
+    {
+        QString scenarioFilename =
+            QString("scenario-%1.txt").arg(i, 2, 10, QChar('0'));
+        QTest::newRow(scenarioFilename.toLatin1()) << i;
+    }
+}
+
+void TestFilePickerModel::hiddenFiles()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QFile visible(tmpdir.path() + "/visible");
+    QVERIFY(visible.open(QIODevice::WriteOnly));
+    QFile hidden(tmpdir.path() + "/.hidden");
+    QVERIFY(hidden.open(QIODevice::WriteOnly));
+
+    FilePickerModel *model = new FilePickerModel();
+    connect(model, &FilePickerModel::taskRequested, &runTask);
+    QModelIndex dir = model->index(tmpdir.path());
+    model->fetchMore(dir);
+    QTRY_COMPARE(model->isLoading(dir), false);
+    QVERIFY(model->rowCount(dir) == 1);
+
+    // Show hidden files.
+    model->setFilter(model->filter() | QDir::Hidden);
+    QVERIFY(model->rowCount(dir) == 2);
+    QVERIFY(model->index(0, 0, dir).data().toString() == ".hidden");
+
+    // Name filters disable files, but do not remove them.
+    model->setNameFilters(QStringList("*.txt"));
+    QVERIFY(model->rowCount(dir) == 2);
+    QVERIFY(!(model->flags(model->index(1, 0, dir)) & Qt::ItemIsEnabled));
+
+    delete model;
+}
+
+void TestFilePickerModel::refresh()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QFile before(tmpdir.path() + "/before");
+    QVERIFY(before.open(QIODevice::WriteOnly));
+    before.close();
+
+    FilePickerModel *model = new FilePickerModel();
+    connect(model, &FilePickerModel::taskRequested, &runTask);
+    QModelIndex dir = model->index(tmpdir.path());
+    model->fetchMore(dir);
+    QTRY_COMPARE(model->isLoading(dir), false);
+    QVERIFY(model->rowCount(dir) == 1);
+
+    // The directory is read again when it changes.
+    QVERIFY(before.remove());
+    QFile after(tmpdir.path() + "/after");
+    QVERIFY(after.open(QIODevice::WriteOnly));
+    after.close();
+    QTRY_VERIFY((model->rowCount(dir) == 1)
+                && (model->index(0, 0, dir).data().toString() == "after"));
+    QTRY_COMPARE(model->isLoading(dir), false);
+
+    delete model;
+}
+
+QTEST_MAIN(TestFilePickerModel)
+WARNINGS_DISABLE
+#include "test-filepickermodel.moc"
+WARNINGS_ENABLE
@@ -0,0 +1,28 @@
+TARGET = test-filepickermodel
+QT = core gui widgets
+
+VALGRIND = true
+
+HEADERS	+=						\
+	../../lib/core/TSettings.h			\
+	../../src/basetask.h				\
+	../../src/checkstatetree.h			\
+	../../src/direnumeratortask.h			\
+	../../src/filepickermodel.h			\
+	../../src/humanbytes.h				\
+	scenario-num.h					\
+	run-scenario.h
+
+SOURCES	+= test-filepickermodel.cpp			\
+	../../lib/core/TSettings.cpp			\
+	../../src/basetask.cpp				\
+	../../src/checkstatetree.cpp			\
+	../../src/direnumeratortask.cpp			\
+	../../src/filepickermodel.cpp			\
+	../../src/humanbytes.cpp			\
+	run-scenario.cpp
+
+include(../tests-include.pri)
+
+test_home_prep.commands += ; mkdir -p "$${TEST_HOME}/$${TARGET}";	\
+	cp -r dirs/* "$${TEST_HOME}/$${TARGET}"
@@ -2,12 +2,16 @@
 
 WARNINGS_DISABLE
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QList>
+#include <QMap>
+#include <QModelIndex>
 #include <QObject>
 #include <QSignalSpy>
 #include <QString>
 #include <QTest>
 #include <QUrl>
+#include <QVariant>
 
 #include "ui_jobstabwidget.h"
 #include "ui_jobwidget.h"
@@ -17,10 +21,14 @@ WARNINGS_ENABLE
 
 #include "TSettings.h"
 
+#include "messages/archiveptr.h"
 #include "messages/backuptaskdataptr.h"
 #include "messages/jobptr.h"
 
 #include "backuptask.h"
+#include "humanbytes.h"
+#include "joblistmodel.h"
+#include "persistentmodel/archive.h"
 #include "persistentmodel/job.h"
 #include "persistentmodel/persistentstore.h"
 #include "widgets/elidedclickablelabel.h"
@@ -28,10 +36,6 @@ WARNINGS_ENABLE
 #include "widgets/jobstabwidget.h"
 #include "widgets/jobwidget.h"
 
-#if defined(Q_OS_OSX)
-#include "customfilesystemmodel.h"
-#endif
-
 class TestJobsTabWidget : public QObject
 {
     Q_OBJECT
@@ -47,6 +51,7 @@ private slots:
     void createJob();
     void displayJobDetails();
     void jobListWidget();
+    void jobListModel();
 };
 
 void TestJobsTabWidget::initTestCase()
@@ -121,10 +126,6 @@ void TestJobsTabWidget::createJob()
     QSignalSpy            sig_jobAdded(jobstabwidget, SIGNAL(jobAdded(JobPtr)));
 
     VISUAL_INIT(jobstabwidget);
-#if defined(Q_OS_OSX)
-    jobstabwidget->_ui->jobDetailsWidget->_ui->jobTreeWidget->_model
-        ->setRootPathBlocking(TEST_DIR);
-#endif
 
     // Start out without the button being enabled
     QVERIFY(ui->addJobButton->text() == QString("Add job"));
@@ -172,10 +173,6 @@ void TestJobsTabWidget::displayJobDetails()
                                      SIGNAL(backupNow(BackupTaskDataPtr)));
 
     VISUAL_INIT(jobstabwidget);
-#if defined(Q_OS_OSX)
-    jobstabwidget->_ui->jobDetailsWidget->_ui->jobTreeWidget->_model
-        ->setRootPathBlocking(TEST_DIR);
-#endif
 
     // Create a job
     jobstabwidget->createNewJob(QList<QUrl>() << QUrl("file://" TEST_DIR),
@@ -212,10 +209,6 @@ void TestJobsTabWidget::jobListWidget()
     QSignalSpy sig_deleteJob(jobstabwidget, SIGNAL(deleteJob(JobPtr, bool)));
 
     VISUAL_INIT(jobstabwidget);
-#if defined(Q_OS_OSX)
-    jobstabwidget->_ui->jobDetailsWidget->_ui->jobTreeWidget->_model
-        ->setRootPathBlocking(TEST_DIR);
-#endif
 
     // Create a job
     jobstabwidget->createNewJob(QList<QUrl>() << QUrl("file://" TEST_DIR),
@@ -238,6 +231,76 @@ void TestJobsTabWidget::jobListWidget()
     delete jobstabwidget;
 }
 
+static ArchivePtr newArchive(const QString &name, uint timestamp,
+                             quint64 sizeTotal)
+{
+    ArchivePtr archive(new Archive);
+    archive->setName(name);
+    archive->setTimestamp(QDateTime::fromTime_t(timestamp));
+    archive->setSizeTotal(sizeTotal);
+    archive->setSizeUniqueCompressed(sizeTotal / 10);
+    return (archive);
+}
+
+void TestJobsTabWidget::jobListModel()
+{
+    JobListModel *model   = new JobListModel();
+    int           repaint = 0;
+    connect(model, &JobListModel::dataChanged, [&repaint]() { repaint++; });
+
+    JobPtr first(new Job);
+    first->setName("model-first");
+    JobPtr second(new Job);
+    second->setName("model-second");
+    QMap<QString, JobPtr> jobs;
+    jobs.insert(second->name(), second);
+    jobs.insert(first->name(), first);
+    model->setJobs(jobs);
+    QVERIFY(model->rowCount() == 2);
+    QVERIFY(model->job(0) == first);
+    const QModelIndex index = model->index(0);
+    QVERIFY(index.data(JobListModel::ArchiveCountRole).toInt() == 0);
+    QVERIFY(index.data(JobListModel::LastBackupRole).toString()
+            == "No backups");
+
+    // Adding archives updates the totals.
+    ArchivePtr older = newArchive("model-older", 1000000, 1000);
+    ArchivePtr newer = newArchive("model-newer", 2000000, 3000);
+    first->setArchives(QList<ArchivePtr>() << older << newer);
+    QCoreApplication::processEvents();
+    QVERIFY(repaint == 1);
+    QVERIFY(index.data(JobListModel::ArchiveCountRole).toInt() == 2);
+    QVERIFY(index.data(JobListModel::DetailRole).toString()
+            == "2 archives totaling " + humanBytes(4000));
+    QVERIFY(index.data(JobListModel::LastBackupRole).toString()
+            == newer->timestamp().toString(Qt::DefaultLocaleShortDate));
+
+    // Setting the same archives does not repaint the row.
+    first->setArchives(QList<ArchivePtr>() << newer << older);
+    QCoreApplication::processEvents();
+    QVERIFY(repaint == 1);
+
+    // Removing an archive, or a change of its size, updates the totals.
+    older->setSizeTotal(2000);
+    first->setArchives(QList<ArchivePtr>() << older);
+    QCoreApplication::processEvents();
+    QVERIFY(repaint == 2);
+    QVERIFY(index.data(JobListModel::ArchiveCountRole).toInt() == 1);
+    QVERIFY(index.data(JobListModel::DetailRole).toString()
+            == "1 archive totaling " + humanBytes(2000));
+    QVERIFY(index.data(JobListModel::LastBackupRole).toString()
+            == older->timestamp().toString(Qt::DefaultLocaleShortDate));
+
+    // The filter hides jobs, but they are still counted.
+    QSignalSpy sig_count(model, SIGNAL(countChanged(int, int)));
+    model->setFilter("*second*");
+    QVERIFY(model->rowCount() == 1);
+    QVERIFY(model->count() == 2);
+    QVERIFY(sig_count.takeFirst() == (QList<QVariant>() << 2 << 1));
+
+    delete model;
+}
+
 QTEST_MAIN(TestJobsTabWidget)
 WARNINGS_DISABLE
 #include "test-jobstabwidget.moc"
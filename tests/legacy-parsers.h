@@ -0,0 +1,165 @@
+#ifndef LEGACY_PARSERS_H
+#define LEGACY_PARSERS_H
+
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QDateTime>
+#include <QList>
+#include <QRegExp>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include "messages/archivefilestat.h"
+
+#include "compat.h"
+#include "tasks/tasks-tarsnap.h"
+
+/*
+ * The QRegExp-based parsers which were used before ByteScan, kept as a
+ * reference for benchmarks and for comparing the results.
+ */
+
+static inline QList<struct archive_list_data>
+legacyListArchivesTaskParse(const QString &tarsnapOutput)
+{
+    QList<struct archive_list_data> metadatas;
+    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
+    for(const QString &line : lines)
+    {
+        QRegExp archiveDetailsRX("^(.+)\\t+(\\S+\\s+\\S+)\\t+(.+)$");
+        if(-1 != archiveDetailsRX.indexIn(line))
+        {
+            struct archive_list_data metadata;
+            QStringList archiveDetails = archiveDetailsRX.capturedTexts();
+            archiveDetails.removeFirst();
+            metadata.archiveName = archiveDetails[0];
+            metadata.timestamp =
+                QDateTime::fromString(archiveDetails[1], Qt::ISODate);
+            metadata.command = archiveDetails[2];
+
+            metadata.parse_error = false;
+            metadatas.append(metadata);
+        }
+    }
+
+    return (metadatas);
+}
+
+static inline struct tarsnap_stats
+legacyPrintStatsTaskParse(const QString &tarsnapOutput, bool newArchiveOutput,
+                          const QString &archiveName)
+{
+    struct tarsnap_stats stats = {0, 0, 0, 0, true};
+
+    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
+    if(lines.count() < 5)
+        return (stats);
+
+    QRegExp sizeRX;
+    QRegExp uniqueSizeRX;
+    if(newArchiveOutput)
+    {
+        sizeRX.setPattern("^This archive\\s+(\\d+)\\s+(\\d+)$");
+        uniqueSizeRX.setPattern("^New data\\s+(\\d+)\\s+(\\d+)$");
+    }
+    else
+    {
+        sizeRX.setPattern(QString("^%1\\s+(\\d+)\\s+(\\d+)$").arg(archiveName));
+        uniqueSizeRX.setPattern("^\\s+\\(unique data\\)\\s+(\\d+)\\s+(\\d+)$");
+    }
+    bool matched = false;
+    for(const QString &line : lines)
+    {
+        if(-1 != sizeRX.indexIn(line))
+        {
+            QStringList captured = sizeRX.capturedTexts();
+            captured.removeFirst();
+            stats.total      = captured[0].toULongLong();
+            stats.compressed = captured[1].toULongLong();
+
+            matched = true;
+        }
+        if(-1 != uniqueSizeRX.indexIn(line))
+        {
+            QStringList captured = uniqueSizeRX.capturedTexts();
+            captured.removeFirst();
+            stats.unique_total      = captured[0].toULongLong();
+            stats.unique_compressed = captured[1].toULongLong();
+            matched                 = true;
+        }
+    }
+    if(!matched)
+        return (stats);
+
+    // We're ok.
+    stats.parse_error = false;
+    return (stats);
+}
+
+static inline struct tarsnap_stats
+legacyOverallStatsTaskParse(const QString &tarsnapOutput)
+{
+    struct tarsnap_stats stats = {0, 0, 0, 0, true};
+
+    QStringList lines = tarsnapOutput.split('\n', SKIP_EMPTY_PARTS);
+    if(lines.count() < 3)
+        return (stats);
+
+    QRegExp sizeRX("^All archives\\s+(\\d+)\\s+(\\d+)$");
+    if(-1 == sizeRX.indexIn(lines[1]))
+        return (stats);
+
+    QStringList captured = sizeRX.capturedTexts();
+    captured.removeFirst();
+    stats.total      = captured[0].toULongLong();
+    stats.compressed = captured[1].toULongLong();
+
+    QRegExp uniqueSizeRX("^\\s+\\(unique data\\)\\s+(\\d+)\\s+(\\d+)$");
+    if(-1 == uniqueSizeRX.indexIn(lines[2]))
+        return (stats);
+
+    captured = uniqueSizeRX.capturedTexts();
+    captured.removeFirst();
+    stats.unique_total      = captured[0].toULongLong();
+    stats.unique_compressed = captured[1].toULongLong();
+
+    // We're ok.
+    stats.parse_error = false;
+    return (stats);
+}
+
+// Lines of `tarsnap -tv -f ARCHIVENAME` which do not match are skipped.
+static inline QVector<FileStat>
+legacyArchiveListingParse(const QString &listing)
+{
+    QVector<FileStat> files;
+
+    // Parse a line of output from `tarsnap -tv -f ARCHIVENAME`.
+    QRegExp lineRx("^(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+)\\s+(\\S+"
+                   "\\s+\\S+\\s+\\S+)\\s+(.+)$");
+
+    // Check each line.
+    for(const QString &line : listing.split('\n', SKIP_EMPTY_PARTS))
+    {
+        // Bail if it doesn't match the expected pattern.
+        if(lineRx.indexIn(line) == -1)
+            continue;
+
+        FileStat stat;
+        stat.mode     = lineRx.capturedTexts()[1];
+        stat.links    = lineRx.capturedTexts()[2].toULongLong();
+        stat.user     = lineRx.capturedTexts()[3];
+        stat.group    = lineRx.capturedTexts()[4];
+        stat.size     = lineRx.capturedTexts()[5].toULongLong();
+        stat.modified = lineRx.capturedTexts()[6];
+        stat.name     = lineRx.capturedTexts()[7];
+        files.append(stat);
+    }
+    return (files);
+}
+
+#endif /* !LEGACY_PARSERS_H */
@@ -13,7 +13,6 @@ WARNINGS_DISABLE
 #include <QTest>
 #include <QThreadPool>
 #include <QUrl>
-#include <QVector>
 
 #include "ui_archivestabwidget.h"
 #include "ui_jobstabwidget.h"
@@ -27,9 +26,11 @@ WARNINGS_ENABLE
 
 #include "../qtest-platform.h"
 
-#include "messages/archivefilestat.h"
+#include "messages/archivelistingptr.h"
 
+#include "archivelisting.h"
 #include "basetask.h"
+#include "joblistmodel.h"
 #include "translator.h"
 #include "widgets/aboutdialog.h"
 #include "widgets/archivestabwidget.h"
@@ -45,15 +46,10 @@ WARNINGS_ENABLE
 #include "widgets/archivewidget.h"
 #include "widgets/filepickerdialog.h"
 #include "widgets/joblistwidget.h"
-#include "widgets/joblistwidgetitem.h"
 
 #include "ConsoleLog.h"
 #include "TSettings.h"
 
-#if defined(Q_OS_OSX)
-#include "customfilesystemmodel.h"
-#endif
-
 class TestMainWindow : public QObject
 {
     Q_OBJECT
@@ -84,7 +80,7 @@ void TestMainWindow::initTestCase()
     IF_NOT_VISUAL { qInstallMessageHandler(offscreenMessageOutput); }
 
     // Initialization normally done in init_shared.cpp's init_no_app()
-    qRegisterMetaType<QVector<FileStat>>("QVector<FileStat>");
+    qRegisterMetaType<ArchiveListingPtr>("ArchiveListingPtr");
     qRegisterMetaType<BaseTask *>("BaseTask *");
 
     // Deal with PersistentStore
@@ -289,14 +285,6 @@ void TestMainWindow::other_navigation()
 
     VISUAL_INIT(mainwindow);
 
-#if defined(Q_OS_OSX)
-    // HACK: Load directory that we'll want for creating a Job.  This is
-    // slow to load on OSX (relative to the platform=offscreen test), so we
-    // add an extra delay.
-    jobsTabWidget->_ui->jobDetailsWidget->_ui->jobTreeWidget->_model
-        ->setRootPathBlocking(TEST_DIR);
-#endif
-
     QList<QUrl> testdir_urls({QUrl("file://" TEST_DIR)});
 
     // Switch to a different tab.
@@ -319,10 +307,10 @@ void TestMainWindow::other_navigation()
 
     // Make sure that MainWindow has a job, then get a pointer to it.
     QVERIFY(jui->jobListWidget->count() == 1);
-    QVERIFY(jui->jobListWidget->currentItem() != nullptr);
-    JobPtr job =
-        static_cast<JobListWidgetItem *>(jui->jobListWidget->currentItem())
-            ->job();
+    QVERIFY(jui->jobListWidget->currentIndex().isValid());
+    JobPtr job = jui->jobListWidget->currentIndex()
+                     .data(JobListModel::JobRole)
+                     .value<JobPtr>();
     QVERIFY(job != nullptr);
     VISUAL_WAIT;
 
@@ -331,7 +319,7 @@ void TestMainWindow::other_navigation()
     Archive   *actual_archive = new Archive();
     ArchivePtr archive(actual_archive);
     archive->setName("Job_test-job_archive1");
-    archive->setContents("-rw-r--r-- 0 user group 1234 Jan 1 2019 myfile");
+    archive->setHasContents(true);
     mainwindow->addArchive(archive);
     archive->setJobRef("test-job");
     VISUAL_WAIT;
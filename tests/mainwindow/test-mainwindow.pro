@@ -8,16 +8,16 @@ DEFINES += APP_VERSION=\\\"$$VERSION\\\"
 
 FORMS +=							\
 	../../forms/aboutdialog.ui				\
-	../../forms/archivelistwidgetitem.ui			\
+	../../forms/archivediffdialog.ui			\
 	../../forms/archivestabwidget.ui			\
 	../../forms/archivewidget.ui				\
 	../../forms/backuplistwidgetitem.ui			\
 	../../forms/backuptabwidget.ui				\
 	../../forms/consolelogdialog.ui				\
+	../../forms/filehistorydialog.ui			\
 	../../forms/filepickerdialog.ui				\
 	../../forms/filepickerwidget.ui				\
 	../../forms/helpwidget.ui				\
-	../../forms/joblistwidgetitem.ui			\
 	../../forms/jobstabwidget.ui				\
 	../../forms/jobwidget.ui				\
 	../../forms/logindialog.ui				\
@@ -34,29 +34,55 @@ RESOURCES +=						\
 	../../resources/resources.qrc
 
 HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
+	../../lib/core/LogRing.h			\
 	../../lib/core/TSettings.h			\
 	../../lib/widgets/TBusyLabel.h			\
 	../../lib/widgets/TElidedLabel.h		\
 	../../lib/widgets/TPopupPushButton.h		\
 	../../lib/widgets/TTabWidget.h			\
 	../../lib/widgets/TTextView.h			\
+	../../src/archivediff.h				\
+	../../src/archivediffmodel.h			\
+	../../src/archivedifftask.h			\
+	../../src/archivelisting.h			\
+	../../src/archivelistmodel.h			\
 	../../src/backuptask.h				\
 	../../src/basetask.h				\
-	../../src/customfilesystemmodel.h		\
+	../../src/changetracker.h			\
+	../../src/checkstatetree.h			\
+	../../src/consolelogmodel.h			\
 	../../src/dir-utils.h				\
+	../../src/direnumeratortask.h			\
 	../../src/dirinfotask.h				\
+	../../src/filepickermodel.h			\
 	../../src/filetablemodel.h			\
+	../../src/filetableproxymodel.h			\
+	../../src/filetablesorttask.h			\
+	../../src/filetree.h				\
+	../../src/filetreemodel.h			\
+	../../src/filetreetask.h			\
 	../../src/humanbytes.h				\
+	../../src/joblistmodel.h			\
+	../../src/messages/archivediffptr.h		\
 	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
 	../../src/messages/archiveptr.h			\
 	../../src/messages/archiverestoreoptions.h	\
 	../../src/messages/backuptaskdataptr.h		\
+	../../src/messages/changeset.h			\
+	../../src/messages/filetreeptr.h		\
+	../../src/messages/fileversion.h		\
 	../../src/messages/jobptr.h			\
 	../../src/messages/notification_info.h		\
+	../../src/messages/taskoutput.h			\
+	../../src/nameindex.h				\
 	../../src/parsearchivelistingtask.h		\
 	../../src/persistentmodel/archive.h		\
 	../../src/persistentmodel/job.h			\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
@@ -65,8 +91,9 @@ HEADERS  +=						\
 	../../src/tasks/tasks-utils.h			\
 	../../src/translator.h				\
 	../../src/widgets/aboutdialog.h			\
+	../../src/widgets/archivediffdialog.h		\
+	../../src/widgets/archivelistdelegate.h		\
 	../../src/widgets/archivelistwidget.h		\
-	../../src/widgets/archivelistwidgetitem.h	\
 	../../src/widgets/archivestabwidget.h		\
 	../../src/widgets/archivewidget.h		\
 	../../src/widgets/backuplistwidget.h		\
@@ -74,13 +101,13 @@ HEADERS  +=						\
 	../../src/widgets/backuptabwidget.h		\
 	../../src/widgets/confirmationdialog.h		\
 	../../src/widgets/consolelogdialog.h		\
-	../../src/widgets/elidedannotatedlabel.h	\
 	../../src/widgets/elidedclickablelabel.h	\
+	../../src/widgets/filehistorydialog.h		\
 	../../src/widgets/filepickerdialog.h		\
 	../../src/widgets/filepickerwidget.h		\
 	../../src/widgets/helpwidget.h			\
+	../../src/widgets/joblistdelegate.h		\
 	../../src/widgets/joblistwidget.h		\
-	../../src/widgets/joblistwidgetitem.h		\
 	../../src/widgets/jobstabwidget.h		\
 	../../src/widgets/jobwidget.h			\
 	../../src/widgets/mainwindow.h			\
@@ -94,23 +121,43 @@ HEADERS  +=						\
 	../../tests/qtest-platform.h
 
 SOURCES += test-mainwindow.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
+	../../lib/core/LogRing.cpp			\
 	../../lib/core/TSettings.cpp			\
 	../../lib/widgets/TBusyLabel.cpp		\
 	../../lib/widgets/TElidedLabel.cpp		\
 	../../lib/widgets/TPopupPushButton.cpp		\
 	../../lib/widgets/TTabWidget.cpp		\
 	../../lib/widgets/TTextView.cpp			\
+	../../src/archivediff.cpp			\
+	../../src/archivediffmodel.cpp			\
+	../../src/archivedifftask.cpp			\
+	../../src/archivelisting.cpp			\
+	../../src/archivelistmodel.cpp			\
 	../../src/backuptask.cpp			\
 	../../src/basetask.cpp				\
-	../../src/customfilesystemmodel.cpp		\
+	../../src/changetracker.cpp			\
+	../../src/checkstatetree.cpp			\
+	../../src/consolelogmodel.cpp			\
 	../../src/dir-utils.cpp				\
+	../../src/direnumeratortask.cpp			\
 	../../src/dirinfotask.cpp			\
+	../../src/filepickermodel.cpp			\
 	../../src/filetablemodel.cpp			\
+	../../src/filetableproxymodel.cpp		\
+	../../src/filetablesorttask.cpp			\
+	../../src/filetree.cpp				\
+	../../src/filetreemodel.cpp			\
+	../../src/filetreetask.cpp			\
 	../../src/humanbytes.cpp			\
+	../../src/joblistmodel.cpp			\
+	../../src/nameindex.cpp				\
 	../../src/parsearchivelistingtask.cpp		\
 	../../src/persistentmodel/archive.cpp		\
 	../../src/persistentmodel/job.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
 	../../src/persistentmodel/upgrade-store.cpp	\
@@ -119,8 +166,9 @@ SOURCES += test-mainwindow.cpp				\
 	../../src/tasks/tasks-utils.cpp			\
 	../../src/translator.cpp			\
 	../../src/widgets/aboutdialog.cpp		\
+	../../src/widgets/archivediffdialog.cpp		\
+	../../src/widgets/archivelistdelegate.cpp	\
 	../../src/widgets/archivelistwidget.cpp		\
-	../../src/widgets/archivelistwidgetitem.cpp	\
 	../../src/widgets/archivestabwidget.cpp		\
 	../../src/widgets/archivewidget.cpp		\
 	../../src/widgets/backuplistwidget.cpp		\
@@ -128,13 +176,13 @@ SOURCES += test-mainwindow.cpp				\
 	../../src/widgets/backuptabwidget.cpp		\
 	../../src/widgets/confirmationdialog.cpp	\
 	../../src/widgets/consolelogdialog.cpp		\
-	../../src/widgets/elidedannotatedlabel.cpp	\
 	../../src/widgets/elidedclickablelabel.cpp	\
+	../../src/widgets/filehistorydialog.cpp		\
 	../../src/widgets/filepickerdialog.cpp		\
 	../../src/widgets/filepickerwidget.cpp		\
 	../../src/widgets/helpwidget.cpp		\
+	../../src/widgets/joblistdelegate.cpp		\
 	../../src/widgets/joblistwidget.cpp		\
-	../../src/widgets/joblistwidgetitem.cpp		\
 	../../src/widgets/jobstabwidget.cpp		\
 	../../src/widgets/jobwidget.cpp			\
 	../../src/widgets/mainwindow.cpp		\
@@ -0,0 +1,296 @@
+#include "warnings-disable.h"
+
+WARNINGS_DISABLE
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTest>
+#include <Qt>
+WARNINGS_ENABLE
+
+#include <string.h>
+
+#include "tasks/tasks-tarsnap.h"
+
+#include "../legacy-parsers.h"
+
+// Number of generated outputs for each parser.
+#define NUM_OUTPUTS 2000
+
+/*
+ * Generates tarsnap outputs (with random whitespace, numbers, and damaged
+ * lines), and checks that the parsers give the same results as the old
+ * QRegExp parsers in legacy-parsers.h.  The outputs are ASCII, because the
+ * old parsers also accepted Unicode whitespace and digits.
+ */
+class TestParsers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void listArchives_fuzz();
+    void printStats_fuzz();
+    void overallStats_fuzz();
+    void printStats_archiveName();
+    void listArchives_tabs();
+
+private:
+    quint32 _state;
+
+    quint32    nextRandom(quint32 range);
+    QByteArray randomText(const char *alphabet, int minLength, int maxLength);
+    QByteArray randomBlanks();
+    QByteArray randomNumber();
+    QByteArray damage(QByteArray line);
+    QByteArray makeOutput(const QList<QByteArray> &lines);
+};
+
+void TestParsers::initTestCase()
+{
+    QCoreApplication::setOrganizationName(TEST_NAME);
+
+    // Deterministic, so that failures can be reproduced.
+    _state = 1;
+}
+
+quint32 TestParsers::nextRandom(quint32 range)
+{
+    _state = _state * 1103515245 + 12345;
+    return ((_state >> 8) % range);
+}
+
+QByteArray TestParsers::randomText(const char *alphabet, int minLength,
+                                   int maxLength)
+{
+    const quint32 range  = static_cast<quint32>(maxLength - minLength + 1);
+    const int     length = minLength + static_cast<int>(nextRandom(range));
+    const quint32 size   = static_cast<quint32>(strlen(alphabet));
+    QByteArray    text;
+    for(int i = 0; i < length; i++)
+        text.append(alphabet[nextRandom(size)]);
+    return (text);
+}
+
+QByteArray TestParsers::randomBlanks()
+{
+    return (randomText(" \t", 1, 3));
+}
+
+QByteArray TestParsers::randomNumber()
+{
+    // Sometimes too large for a quint64.
+    if(nextRandom(10) == 0)
+        return (randomText("0123456789", 20, 25));
+    return (randomText("0123456789", 1, 12));
+}
+
+QByteArray TestParsers::damage(QByteArray line)
+{
+    // Bail (if applicable).
+    if(line.isEmpty() || (nextRandom(4) != 0))
+        return (line);
+
+    const int pos =
+        static_cast<int>(nextRandom(static_cast<quint32>(line.size())));
+    switch(nextRandom(5))
+    {
+    case 0:
+        line.remove(pos, 1);
+        break;
+    case 1:
+        line.insert(pos, line.at(pos));
+        break;
+    case 2:
+        line.insert(pos, randomText("\t a1(", 1, 1));
+        break;
+    case 3:
+        line.truncate(pos);
+        break;
+    default:
+        line.append(randomText(" \t\rx", 1, 2));
+        break;
+    }
+    return (line);
+}
+
+QByteArray TestParsers::makeOutput(const QList<QByteArray> &lines)
+{
+    QByteArray output;
+    for(const QByteArray &line : lines)
+    {
+        output.append(damage(line));
+        output.append(nextRandom(8) == 0 ? "\n\n" : "\n");
+    }
+    return (output);
+}
+
+void TestParsers::listArchives_fuzz()
+{
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+    {
+        QList<QByteArray> lines;
+        const int         count = static_cast<int>(nextRandom(6));
+        for(int j = 0; j < count; j++)
+        {
+            QByteArray line = randomText("abcXYZ019_-.() ", 1, 20);
+            line += QByteArray(1 + static_cast<int>(nextRandom(2)), '\t');
+            line += "2019-0" + randomText("123456789", 1, 1) + "-1"
+                    + randomText("0123456789", 1, 1);
+            line += randomBlanks();
+            line += "1" + randomText("0123", 1, 1) + ":00:00";
+            line += QByteArray(1 + static_cast<int>(nextRandom(2)), '\t');
+            line += "tarsnap -c -f " + randomText("abc\t ", 0, 10);
+            lines << line;
+        }
+        const QByteArray output = makeOutput(lines);
+
+        QList<struct archive_list_data> expected =
+            legacyListArchivesTaskParse(QString::fromUtf8(output));
+        QList<struct archive_list_data> actual = listArchivesTaskParse(output);
+        QVERIFY2(actual.count() == expected.count(), output.constData());
+        for(int j = 0; j < expected.count(); j++)
+        {
+            QVERIFY2(actual[j].archiveName == expected[j].archiveName,
+                     output.constData());
+            QVERIFY2(actual[j].timestamp.toString(Qt::ISODate)
+                         == expected[j].timestamp.toString(Qt::ISODate),
+                     output.constData());
+            QVERIFY2(actual[j].command == expected[j].command,
+                     output.constData());
+            QVERIFY(!actual[j].parse_error);
+        }
+    }
+}
+
+void TestParsers::printStats_fuzz()
+{
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+    {
+        const QByteArray name = randomText("abcXYZ019_- ", 1, 15);
+        const bool       isNew = (nextRandom(2) == 0);
+
+        QList<QByteArray> lines;
+        lines << "                                       Total size  "
+                 "Compressed size";
+        lines << "All archives" + randomBlanks() + randomNumber()
+                     + randomBlanks() + randomNumber();
+        lines << randomBlanks() + "(unique data)" + randomBlanks()
+                     + randomNumber() + randomBlanks() + randomNumber();
+        if(isNew)
+        {
+            lines << "This archive" + randomBlanks() + randomNumber()
+                         + randomBlanks() + randomNumber();
+            lines << "New data" + randomBlanks() + randomNumber()
+                         + randomBlanks() + randomNumber();
+        }
+        else
+        {
+            lines << name + randomBlanks() + randomNumber() + randomBlanks()
+                         + randomNumber();
+            lines << randomBlanks() + "(unique data)" + randomBlanks()
+                         + randomNumber() + randomBlanks() + randomNumber();
+        }
+        const QByteArray output = makeOutput(lines);
+
+        // Sometimes ask for the wrong kind of output, or the wrong archive.
+        const bool    parseAsNew = (nextRandom(8) == 0) ? !isNew : isNew;
+        const QString archiveName =
+            QString::fromUtf8((nextRandom(8) == 0) ? name + "x" : name);
+
+        struct tarsnap_stats expected =
+            legacyPrintStatsTaskParse(QString::fromUtf8(output), parseAsNew,
+                                      archiveName);
+        struct tarsnap_stats actual =
+            printStatsTaskParse(output, parseAsNew, archiveName);
+        QVERIFY2(actual.parse_error == expected.parse_error,
+                 output.constData());
+        QVERIFY2(actual.total == expected.total, output.constData());
+        QVERIFY2(actual.compressed == expected.compressed, output.constData());
+        QVERIFY2(actual.unique_total == expected.unique_total,
+                 output.constData());
+        QVERIFY2(actual.unique_compressed == expected.unique_compressed,
+                 output.constData());
+    }
+}
+
+void TestParsers::overallStats_fuzz()
+{
+    for(int i = 0; i < NUM_OUTPUTS; i++)
+    {
+        QList<QByteArray> lines;
+        lines << "                                       Total size  "
+                 "Compressed size";
+        lines << "All archives" + randomBlanks() + randomNumber()
+                     + randomBlanks() + randomNumber();
+        lines << randomBlanks() + "(unique data)" + randomBlanks()
+                     + randomNumber() + randomBlanks() + randomNumber();
+        const QByteArray output = makeOutput(lines);
+
+        struct tarsnap_stats expected =
+            legacyOverallStatsTaskParse(QString::fromUtf8(output));
+        struct tarsnap_stats actual = overallStatsTaskParse(output);
+        QVERIFY2(actual.parse_error == expected.parse_error,
+                 output.constData());
+        QVERIFY2(actual.total == expected.total, output.constData());
+        QVERIFY2(actual.compressed == expected.compressed, output.constData());
+        QVERIFY2(actual.unique_total == expected.unique_total,
+                 output.constData());
+        QVERIFY2(actual.unique_compressed == expected.unique_compressed,
+                 output.constData());
+    }
+}
+
+void TestParsers::printStats_archiveName()
+{
+    // Regex metacharacters used to break (or change) the matching.
+    const QStringList names = {"backup (1)", "a.b", "c++", "[2019]*",
+                               "x|y", "^$\\d"};
+    for(const QString &name : names)
+    {
+        QByteArray output("                                       Total size"
+                          "  Compressed size\n"
+                          "All archives                  2000  1000\n"
+                          "  (unique data)                200   100\n");
+        output += name.toUtf8() + "               30    20\n"
+                  "  (unique data)                  3     2\n";
+        output += "aXb                            99    99\n";
+
+        struct tarsnap_stats stats = printStatsTaskParse(output, false, name);
+        QVERIFY(!stats.parse_error);
+        QVERIFY(stats.total == 30);
+        QVERIFY(stats.compressed == 20);
+        QVERIFY(stats.unique_total == 3);
+        QVERIFY(stats.unique_compressed == 2);
+    }
+}
+
+void TestParsers::listArchives_tabs()
+{
+    QByteArray output("name\t2019-01-02 03:04:05\ttarsnap -c -f name dir\n"
+                      "a\tname\t2019-01-02 03:04:05\t\ttarsnap\n"
+                      "bad line\n"
+                      "name\t2019-01-02 03:04:05\t\t\n");
+    QList<struct archive_list_data> metadatas = listArchivesTaskParse(output);
+    QVERIFY(metadatas.count() == 3);
+    QVERIFY(metadatas[0].archiveName == "name");
+    QVERIFY(metadatas[0].timestamp
+            == QDateTime::fromString("2019-01-02 03:04:05", Qt::ISODate));
+    QVERIFY(metadatas[0].command == "tarsnap -c -f name dir");
+    // The name may contain tabs.
+    QVERIFY(metadatas[1].archiveName == "a\tname");
+    QVERIFY(metadatas[1].command == "tarsnap");
+    // The command must not be empty, so it becomes the last tab.
+    QVERIFY(metadatas[2].archiveName == "name");
+    QVERIFY(metadatas[2].command == "\t");
+}
+
+QTEST_MAIN(TestParsers)
+WARNINGS_DISABLE
+#include "test-parsers.moc"
+WARNINGS_ENABLE
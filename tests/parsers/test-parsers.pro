@@ -0,0 +1,54 @@
+TARGET = test-parsers
+QT = core sql
+
+VALGRIND = true
+
+# Needed for the database template
+RESOURCES += ../../resources/resources-lite.qrc
+
+HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
+	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
+	../../lib/core/TSettings.h			\
+	../../src/archivelisting.h			\
+	../../src/backuptask.h				\
+	../../src/basetask.h				\
+	../../src/changetracker.h			\
+	../../src/cmdlinetask.h				\
+	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
+	../../src/messages/archiveptr.h			\
+	../../src/messages/taskoutput.h			\
+	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/job.h			\
+	../../src/persistentmodel/listingstore.h	\
+	../../src/persistentmodel/persistentobject.h	\
+	../../src/persistentmodel/persistentstore.h	\
+	../../src/persistentmodel/upgrade-store.h	\
+	../../src/tasks/tasks-defs.h			\
+	../../src/tasks/tasks-tarsnap.h			\
+	../../src/tasks/tasks-utils.h			\
+	../legacy-parsers.h
+
+SOURCES += test-parsers.cpp				\
+	../../lib/core/ByteScan.cpp			\
+	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
+	../../lib/core/TSettings.cpp			\
+	../../src/archivelisting.cpp			\
+	../../src/backuptask.cpp			\
+	../../src/basetask.cpp				\
+	../../src/changetracker.cpp			\
+	../../src/cmdlinetask.cpp			\
+	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/job.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
+	../../src/persistentmodel/persistentobject.cpp	\
+	../../src/persistentmodel/persistentstore.cpp	\
+	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/tasks/tasks-tarsnap.cpp		\
+	../../src/tasks/tasks-utils.cpp
+
+include(../tests-include.pri)
+
@@ -3,13 +3,20 @@
 WARNINGS_DISABLE
 #include <QCoreApplication>
 #include <QDateTime>
+#include <QDir>
+#include <QFile>
 #include <QList>
 #include <QObject>
+#include <QSet>
 #include <QSignalSpy>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
 #include <QTest>
+#include <QThreadPool>
+#include <QUrl>
 #include <QVariant>
 #include <QVector>
 WARNINGS_ENABLE
@@ -18,10 +25,23 @@ WARNINGS_ENABLE
 
 #include "LogEntry.h"
 
+#include "messages/archiveptr.h"
+#include "messages/changeset.h"
+#include "messages/fileversion.h"
+#include "messages/taskoutput.h"
+
+#include "backenddata.h"
+#include "compat.h"
+#include "changetracker.h"
+#include "filehistorytask.h"
+#include "listingtask.h"
 #include "persistentmodel/archive.h"
+#include "persistentmodel/filehistory.h"
 #include "persistentmodel/job.h"
 #include "persistentmodel/journal.h"
+#include "persistentmodel/listingstore.h"
 #include "persistentmodel/persistentstore.h"
+#include "tasks/tasks-tarsnap.h"
 
 #include "TSettings.h"
 
@@ -49,6 +69,7 @@ private slots:
     void journal_write();
     void journal_read();
     void journal_purge();
+    void journal_batch();
     void journal_year_2106();
 
     void archive_write();
@@ -56,8 +77,76 @@ private slots:
 
     void job_write();
     void job_read();
+    void job_fingerprint();
+    void job_upload_estimate();
+    void changetracker_shared();
+
+    void backenddata_archive_list();
+    void backenddata_job_index();
+    void backenddata_changes();
+
+    void file_history();
+    void listing_store();
+    void listing_order();
 };
 
+static int count_lines()
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare("select count(*) from listingLines")
+       || !global_store->runQuery(query) || !query.next())
+        return (-1);
+    return (query.value(0).toInt());
+}
+
+static int count_file_lines()
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare("select count(*) from fileLines")
+       || !global_store->runQuery(query) || !query.next())
+        return (-1);
+    return (query.value(0).toInt());
+}
+
+static QStringList sorted_lines(const QByteArray &text)
+{
+    QStringList lines = QString::fromUtf8(text).split('\n', SKIP_EMPTY_PARTS);
+    lines.sort();
+    return (lines);
+}
+
+static QString listing_base(const QString &name)
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare("select listingBase from archives where name = ?"))
+        return (QString());
+    query.addBindValue(name);
+    if(!global_store->runQuery(query) || !query.next())
+        return (QString());
+    return (query.value(0).toString());
+}
+
+static int count_journal_rows()
+{
+    QSqlQuery query = global_store->createQuery();
+    if(!query.prepare("select count(*) from journal"))
+        return (-1);
+    if(!global_store->runQuery(query) || !query.next())
+        return (-1);
+    return (query.value(0).toInt());
+}
+
+static struct archive_list_data listed(const QString &name)
+{
+    struct archive_list_data metadata;
+    metadata.archiveName = name;
+    metadata.command     = "tarsnap -c -f " + name;
+    metadata.parse_error = false;
+
+    metadata.timestamp = QDateTime::fromString(SAMPLE_DATE, SAMPLE_DATE_FORMAT);
+    return (metadata);
+}
+
 void TestPersistent::initTestCase()
 {
     QCoreApplication::setOrganizationName(TEST_NAME);
@@ -188,6 +277,34 @@ void TestPersistent::journal_purge()
     delete journal;
 }
 
+void TestPersistent::journal_batch()
+{
+    // Prep
+    Journal   *journal = new Journal();
+    QSignalSpy sig_entries(journal, SIGNAL(logEntries(QVector<LogEntry>)));
+    journal->load();
+    journal->purge();
+
+    // Messages are not stored (or emitted) one at a time.
+    for(int i = 0; i < 100; i++)
+        journal->logMessage(SAMPLE_MESSAGE);
+    QVERIFY(sig_entries.count() == 0);
+    QVERIFY(count_journal_rows() == 0);
+
+    // Store them all at once.
+    journal->flush();
+    QVERIFY(sig_entries.count() == 1);
+    QVector<LogEntry> entries =
+        sig_entries.takeFirst().takeFirst().value<QVector<LogEntry>>();
+    QVERIFY(entries.count() == 100);
+    QVERIFY(count_journal_rows() == 100);
+
+    // Clean up
+    journal->purge();
+    delete journal;
+    QVERIFY(count_journal_rows() == 1);
+}
+
 void TestPersistent::journal_year_2106()
 {
     // Write date & message
@@ -311,6 +428,523 @@ void TestPersistent::job_read()
     QVERIFY(query.next() == false);
 }
 
+void TestPersistent::job_fingerprint()
+{
+    // Initialize the store
+    bool ok = global_store->initialized();
+    QVERIFY(ok);
+
+    // Prep a directory with a file in a subdirectory.
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QDir(tmpdir.path()).mkpath("sub");
+    QFile file(tmpdir.path() + "/sub/file");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("data");
+    file.close();
+
+    Job *job = new Job();
+    job->setName("job-fingerprint");
+    job->setUrls(QList<QUrl>() << QUrl::fromLocalFile(tmpdir.path()));
+
+    // Nothing changed.
+    QString fingerprint = job->computeFingerprint();
+    QVERIFY(!fingerprint.isEmpty());
+    QVERIFY(job->computeFingerprint() == fingerprint);
+
+    // Store and re-load.
+    job->setLastBackupFingerprint(fingerprint);
+    job->save();
+    delete job;
+    job = new Job();
+    job->setName("job-fingerprint");
+    job->load();
+    QVERIFY(job->lastBackupFingerprint() == fingerprint);
+
+    // Change a file deep in the tree.
+    QVERIFY(file.open(QIODevice::Append));
+    file.write("more data");
+    file.close();
+    QVERIFY(job->computeFingerprint() != fingerprint);
+
+    // Clean up
+    job->purge();
+    delete job;
+}
+
+void TestPersistent::job_upload_estimate()
+{
+    // Prep a directory with a file.
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QFile file(tmpdir.path() + "/file");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("data");
+    file.close();
+
+    Job *job = new Job();
+    job->setName("job-upload-estimate");
+    job->setUrls(QList<QUrl>() << QUrl::fromLocalFile(tmpdir.path()));
+    QVERIFY(!job->hasUploadEstimate());
+
+    // The estimate is cached along with the fingerprint taken before it.
+    QString fingerprint = job->computeFingerprint();
+    job->setUploadEstimate(1234, fingerprint);
+    QVERIFY(job->hasUploadEstimate());
+    QVERIFY(job->uploadEstimate() == 1234);
+    QVERIFY(job->uploadEstimateFingerprint() == fingerprint);
+
+    // The same fingerprint can be computed from a copy of the settings.
+    QVERIFY(Job::computeFingerprint(job->urls(), job->optionFollowSymLinks(),
+                                    job->fingerprintOptions())
+            == fingerprint);
+
+    // Without a ChangeTracker, modified files are noticed by the fingerprint.
+    QVERIFY(file.open(QIODevice::Append));
+    file.write("more data");
+    file.close();
+    QVERIFY(job->computeFingerprint() != job->uploadEstimateFingerprint());
+
+    // Explicitly forget it.
+    job->setUploadEstimate(5678);
+    QVERIFY(job->hasUploadEstimate());
+    job->clearUploadEstimate();
+    QVERIFY(!job->hasUploadEstimate());
+
+    delete job;
+}
+
+void TestPersistent::changetracker_shared()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("ChangeTracker only tracks changes on Linux");
+#endif
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+    QDir(tmpdir.path()).mkpath("sub");
+
+    // Two trackers which watch the same directory.
+    ChangeTracker *first  = new ChangeTracker();
+    ChangeTracker *second = new ChangeTracker();
+    first->setRoots(QStringList(tmpdir.path()));
+    second->setRoots(QStringList(tmpdir.path()));
+    WAIT_UNTIL(first->isTracking() && second->isTracking());
+    QVERIFY(first->isTracking() && second->isTracking());
+    first->resetChanges();
+    second->resetChanges();
+    QVERIFY(!first->hasChanges() && !second->hasChanges());
+
+    // Both see a change deep in the tree.
+    QFile file(tmpdir.path() + "/sub/file");
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("data");
+    file.close();
+    WAIT_UNTIL(first->hasChanges() && second->hasChanges());
+    QVERIFY(first->changedPaths() == QStringList(tmpdir.path() + "/sub"));
+    QVERIFY(second->changedPaths() == QStringList(tmpdir.path() + "/sub"));
+
+    // Removing one tracker does not remove the other one's watches.
+    delete first;
+    second->resetChanges();
+    QVERIFY(file.open(QIODevice::Append));
+    file.write("more data");
+    file.close();
+    WAIT_UNTIL(second->hasChanges());
+    QVERIFY(second->hasChanges());
+
+    delete second;
+}
+
+void TestPersistent::backenddata_archive_list()
+{
+    BackendData bd;
+
+    // A list which arrives in two parts.
+    bd.beginArchivesFromList();
+    QList<ArchivePtr> added =
+        bd.addArchivesFromList({listed("list-a"), listed("list-b")});
+    QVERIFY(added.count() == 2);
+    QVERIFY(bd.numArchives() == 2);
+    added = bd.addArchivesFromList({listed("list-c")});
+    QVERIFY(added.count() == 1);
+    QVERIFY(bd.numArchives() == 3);
+    QVERIFY(bd.endArchivesFromList(true).isEmpty());
+
+    // Known archives are not added again, and nothing is removed if the
+    // list was incomplete.
+    bd.beginArchivesFromList();
+    QVERIFY(bd.addArchivesFromList({listed("list-a")}).isEmpty());
+    QVERIFY(bd.endArchivesFromList(false).isEmpty());
+    QVERIFY(bd.numArchives() == 3);
+
+    // Archives are only removed after the last overlapping list ends.
+    bd.beginArchivesFromList();
+    bd.beginArchivesFromList();
+    QVERIFY(bd.addArchivesFromList({listed("list-a")}).isEmpty());
+    QVERIFY(bd.endArchivesFromList(true).isEmpty());
+    QVERIFY(bd.numArchives() == 3);
+    QVERIFY(bd.addArchivesFromList({listed("list-b")}).isEmpty());
+    QList<ArchivePtr> removed = bd.endArchivesFromList(true);
+    QVERIFY(removed.count() == 1);
+    QVERIFY(removed.first()->name() == "list-c");
+    QVERIFY(bd.archives().keys() == QStringList({"list-a", "list-b"}));
+
+    // Clean up with an empty list.
+    bd.beginArchivesFromList();
+    QVERIFY(bd.endArchivesFromList(true).count() == 2);
+    QVERIFY(bd.numArchives() == 0);
+}
+
+void TestPersistent::backenddata_job_index()
+{
+    BackendData bd;
+    JobPtr      job(new Job);
+    JobPtr      subJob(new Job);
+    job->setName("idx");
+    job->save();
+    subJob->setName("idx_b");
+    subJob->save();
+    bd.addJob(job);
+    bd.addJob(subJob);
+
+    // New archives belong to the Job with the longest matching prefix.
+    bd.beginArchivesFromList();
+    bd.addArchivesFromList({listed("Job_idx_1"), listed("Job_idx_b_1"),
+                            listed("other")});
+    bd.endArchivesFromList(true);
+    QMap<QString, ArchivePtr> archives = bd.archives();
+    QVERIFY(archives["Job_idx_1"]->jobRef() == "idx");
+    QVERIFY(archives["Job_idx_b_1"]->jobRef() == "idx_b");
+    QVERIFY(archives["other"]->jobRef().isEmpty());
+    QVERIFY(job->archives().count() == 1);
+    QVERIFY(subJob->archives().count() == 1);
+
+    // Saving an archive with a different Job updates the index.
+    archives["other"]->setJobRef("idx");
+    archives["other"]->save();
+    emit job->loadArchives();
+    QVERIFY(job->archives().count() == 2);
+
+    // After deleting a Job, its archives are unassigned, and new ones
+    // belong to the Job with the next-longest prefix.
+    bd.deleteJob(subJob);
+    QList<ArchivePtr> matching = bd.findMatchingArchives(job->archivePrefix());
+    QVERIFY(matching.count() == 1);
+    QVERIFY(matching.first()->name() == "Job_idx_b_1");
+    bd.beginArchivesFromList();
+    bd.addArchivesFromList({listed("Job_idx_1"), listed("Job_idx_b_1"),
+                            listed("Job_idx_b_2"), listed("other")});
+    bd.endArchivesFromList(true);
+    QVERIFY(bd.archives()["Job_idx_b_2"]->jobRef() == "idx");
+    QVERIFY(job->archives().count() == 3);
+
+    // Clean up.
+    bd.beginArchivesFromList();
+    QVERIFY(bd.endArchivesFromList(true).count() == 4);
+    QVERIFY(job->archives().isEmpty());
+    bd.deleteJob(job);
+}
+
+void TestPersistent::backenddata_changes()
+{
+    BackendData bd;
+
+    // Nothing changed, so the version stays the same.
+    ArchiveChanges changes = bd.takeArchiveChanges();
+    QVERIFY(changes.isEmpty());
+    QVERIFY(changes.version == 0);
+
+    // New archives.
+    bd.beginArchivesFromList();
+    bd.addArchivesFromList({listed("chg-a"), listed("chg-b")});
+    changes = bd.takeArchiveChanges();
+    QVERIFY(!changes.reset);
+    QVERIFY(changes.fromVersion == 0);
+    QVERIFY(changes.version == 1);
+    QVERIFY(changes.added.count() == 2);
+    QVERIFY(changes.removed.isEmpty());
+
+    // Saving an archive (e.g. with its stats) changes it.
+    ArchivePtr archive = bd.archives().value("chg-a");
+    archive->setSizeTotal(1234);
+    archive->save();
+    changes = bd.takeArchiveChanges();
+    QVERIFY(changes.fromVersion == 1);
+    QVERIFY(changes.version == 2);
+    QVERIFY(changes.added.isEmpty());
+    QVERIFY(changes.updated == QSet<ArchivePtr>() << archive);
+
+    // Archives which are missing from the remote are removed.
+    bd.addArchivesFromList({listed("chg-c")});
+    bd.endArchivesFromList(true);
+    QVERIFY(bd.takeArchiveChanges().added.count() == 1);
+    bd.beginArchivesFromList();
+    bd.addArchivesFromList({listed("chg-a")});
+    bd.endArchivesFromList(true);
+    changes = bd.takeArchiveChanges();
+    QVERIFY(changes.version == 4);
+    QVERIFY(changes.added.isEmpty());
+    QVERIFY(changes.removed.count() == 2);
+
+    // A snapshot has every archive, and includes pending changes.
+    archive->save();
+    changes = bd.archiveSnapshot();
+    QVERIFY(changes.reset);
+    QVERIFY(changes.version == 5);
+    QVERIFY(changes.added == QSet<ArchivePtr>() << archive);
+    QVERIFY(changes.updated.isEmpty());
+    QVERIFY(bd.takeArchiveChanges().isEmpty());
+
+    // Loading from the store keeps the existing objects.
+    QVERIFY(bd.loadArchives());
+    QVERIFY(bd.archives().value("chg-a") == archive);
+    QVERIFY(!bd.takeArchiveChanges().added.contains(archive));
+
+    // Jobs.
+    JobPtr job(new Job);
+    job->setName("chg");
+    job->save();
+    bd.addJob(job);
+    JobChanges jobChanges = bd.takeJobChanges();
+    QVERIFY(jobChanges.version == 1);
+    QVERIFY(jobChanges.added == QSet<JobPtr>() << job);
+    bd.deleteJob(job);
+    jobChanges = bd.takeJobChanges();
+    QVERIFY(jobChanges.version == 2);
+    QVERIFY(jobChanges.removed == QSet<JobPtr>() << job);
+
+    // Clean up.
+    bd.beginArchivesFromList();
+    bd.endArchivesFromList(true);
+    QVERIFY(bd.numArchives() == 0);
+}
+
+void TestPersistent::file_history()
+{
+    // Initialize the store
+    bool ok = global_store->initialized();
+    QVERIFY(ok);
+    QVERIFY(ListingStore::collectGarbage());
+    const int fileLines = count_file_lines();
+
+    // Two archives with different versions of a file.
+    const QByteArray olderContents(
+        "drwxr-xr-x  0 user group   0 Mar  4  2012 etc/\n"
+        "-rw-r--r--  1 user group  10 Mar  4  2012 etc/nginx.conf\n");
+    const QByteArray newerContents(
+        "drwxr-xr-x  0 user group   0 Mar  4  2012 etc/\n"
+        "-rw-r--r--  1 user group  20 Mar  5  2012 etc/nginx.conf\n"
+        "lrwxr-xr-x  1 user group   0 Mar  5  2012 etc/link -> nginx.conf\n");
+    const QDateTime date =
+        QDateTime::fromString(SAMPLE_DATE, SAMPLE_DATE_FORMAT);
+    ArchivePtr older(new Archive);
+    older->setName("history_1");
+    older->setTimestamp(date);
+    older->save();
+    QVERIFY(ListingStore::save(older->name(), olderContents));
+    ArchivePtr newer(new Archive);
+    newer->setName("history_2");
+    newer->setTimestamp(date.addDays(1));
+    newer->save();
+    QVERIFY(ListingStore::save(newer->name(), newerContents));
+
+    // The lines are not in the index until a FileHistoryTask adds them,
+    // using a connection of its own.
+    QVERIFY(FileHistory::find("etc/nginx.conf", 10).isEmpty());
+    QThreadPool::globalInstance()->start(new FileHistoryTask());
+    QVERIFY(QThreadPool::globalInstance()->waitForDone(5000));
+    QVERIFY(count_file_lines() == fileLines + 4);
+
+    // Lines which are already indexed are skipped.
+    QVERIFY(FileHistory::indexLines());
+    QVERIFY(count_file_lines() == fileLines + 4);
+
+    // Both versions are found (newest first), with or without a leading
+    // slash.
+    QVector<FileVersion> versions = FileHistory::find("/etc/nginx.conf", 10);
+    QVERIFY(versions.count() == 2);
+    QVERIFY(versions.at(0).path == "etc/nginx.conf");
+    QVERIFY(versions.at(0).archive == "history_2");
+    QVERIFY(versions.at(0).size == 20);
+    QVERIFY(versions.at(0).modified == "Mar  5  2012");
+    QVERIFY(versions.at(1).archive == "history_1");
+    QVERIFY(versions.at(1).size == 10);
+    QVERIFY(FileHistory::find("etc/nginx.conf", 10).count() == 2);
+
+    // Directories and symlinks are found by their own paths; a line which
+    // is in both archives is a version in each of them.
+    versions = FileHistory::find("etc", 10);
+    QVERIFY(versions.count() == 2);
+    QVERIFY(versions.at(0).archive == "history_2");
+    QVERIFY(versions.at(1).archive == "history_1");
+    QVERIFY(FileHistory::find("etc/link", 10).count() == 1);
+
+    // Patterns match every path.
+    QVERIFY(FileHistory::find("etc/*", 10).count() == 3);
+    QVERIFY(FileHistory::find("etc/*", 2).count() == 2);
+    QVERIFY(FileHistory::find("*.conf", 10).count() == 2);
+    QVERIFY(FileHistory::find("etc/none", 10).isEmpty());
+
+    // Storing other contents replaces the files of an archive.
+    QVERIFY(ListingStore::save(newer->name(), olderContents));
+    QVERIFY(FileHistory::find("etc/nginx.conf", 10).count() == 2);
+    QVERIFY(FileHistory::find("etc/link", 10).isEmpty());
+
+    // Purging an archive removes its files; the lines of the index go
+    // with the lines of the ListingStore.
+    older->purge();
+    newer->purge();
+    QVERIFY(FileHistory::find("etc*", 10).isEmpty());
+    QVERIFY(ListingStore::collectGarbage());
+    QVERIFY(count_file_lines() == fileLines);
+}
+
+void TestPersistent::listing_store()
+{
+    // Initialize the store
+    bool ok = global_store->initialized();
+    QVERIFY(ok);
+    QVERIFY(ListingStore::collectGarbage());
+    const int lines = count_lines();
+
+    // Three archives of the same Job, which share most lines.
+    const QByteArray firstContents("one\ntwo\nthree\nfour\n");
+    const QByteArray secondContents("one\ntwo\nthree\nfive\n");
+    const QByteArray thirdContents("two\nfive\nsix\nsix\n");
+    const QDateTime  date =
+        QDateTime::fromString(SAMPLE_DATE, SAMPLE_DATE_FORMAT);
+    ArchivePtr first(new Archive);
+    first->setName("listing_1");
+    first->setTimestamp(date);
+    first->setJobRef("listing_job");
+    first->save();
+    QVERIFY(ListingStore::save(first->name(), firstContents));
+    ArchivePtr second(new Archive);
+    second->setName("listing_2");
+    second->setTimestamp(date.addDays(1));
+    second->setJobRef("listing_job");
+    second->save();
+    QVERIFY(ListingStore::save(second->name(), secondContents));
+    ArchivePtr third(new Archive);
+    third->setName("listing_3");
+    third->setTimestamp(date.addDays(2));
+    third->setJobRef("listing_job");
+    third->save();
+
+    // The contents are stored in the background, like after fetching them.
+    QThreadPool::globalInstance()->start(
+        new ListingTask(third->name(), TaskOutput(thirdContents)));
+    QVERIFY(QThreadPool::globalInstance()->waitForDone(5000));
+
+    // Each line is only stored once, and the second archive only stores
+    // its differences from the first one.
+    QVERIFY(count_lines() == lines + 6);
+    QVERIFY(listing_base("listing_1").isEmpty());
+    QVERIFY(listing_base("listing_2") == "listing_1");
+
+    // The contents are loaded from the store as they were saved.
+    Archive loaded;
+    loaded.setName("listing_2");
+    loaded.load();
+    QVERIFY(loaded.hasContents());
+    QVERIFY(loaded.rawContents() == secondContents);
+    loaded.setName("listing_3");
+    loaded.load();
+    QVERIFY(loaded.rawContents() == thirdContents);
+
+    // Purging a base keeps the archives which depend on it; the base is
+    // only renamed until they are detached in the background.
+    first->purge();
+    QVERIFY(!loaded.doesKeyExist("listing_1"));
+    QVERIFY(listing_base("listing_2").startsWith('\n'));
+    loaded.setName("listing_2");
+    loaded.load();
+    QVERIFY(loaded.rawContents() == secondContents);
+    QThreadPool::globalInstance()->start(
+        new ListingTask(ListingTask::DetachRemoved));
+    QVERIFY(QThreadPool::globalInstance()->waitForDone(5000));
+    QVERIFY(listing_base("listing_2").isEmpty());
+    QVERIFY(loaded.rawContents() == secondContents);
+
+    // Only the lines of purged archives are collected.
+    QVERIFY(ListingStore::collectGarbage());
+    QVERIFY(count_lines() == lines + 5);
+
+    // Contents stored by previous versions are converted.
+    QSqlQuery query = global_store->createQuery();
+    QVERIFY(query.prepare("update archives set listingBase = null,"
+                          " listingIds = null, contents = ? where name = ?"));
+    const QByteArray legacyContents("one\ntwo\nthree\nseven");
+    query.addBindValue(qCompress(legacyContents));
+    query.addBindValue("listing_3");
+    QVERIFY(global_store->runQuery(query));
+    loaded.setName("listing_3");
+    loaded.load();
+    QVERIFY(loaded.hasContents());
+    QVERIFY(sorted_lines(loaded.rawContents()) == sorted_lines(legacyContents));
+    QVERIFY(ListingStore::convertLegacyContents());
+    QVERIFY(listing_base("listing_3") == "listing_2");
+    QVERIFY(sorted_lines(loaded.rawContents()) == sorted_lines(legacyContents));
+
+    // Clean up.
+    second->purge();
+    third->purge();
+    QVERIFY(ListingStore::collectGarbage());
+    QVERIFY(count_lines() == lines);
+}
+
+void TestPersistent::listing_order()
+{
+    // Initialize the store
+    bool ok = global_store->initialized();
+    QVERIFY(ok);
+    QVERIFY(ListingStore::collectGarbage());
+    const int lines = count_lines();
+
+    // Unsorted listings with repeated lines, the second one relative to the
+    // first one.
+    const QByteArray firstContents("c\na\nb\na\nc\n");
+    const QByteArray secondContents("d\nb\na\nd\nc\nb\n");
+    const QDateTime  date =
+        QDateTime::fromString(SAMPLE_DATE, SAMPLE_DATE_FORMAT);
+    ArchivePtr first(new Archive);
+    first->setName("order_1");
+    first->setTimestamp(date);
+    first->setJobRef("order_job");
+    first->save();
+    ArchivePtr second(new Archive);
+    second->setName("order_2");
+    second->setTimestamp(date.addDays(1));
+    second->setJobRef("order_job");
+    second->save();
+
+    // Each listing is loaded as it was saved.
+    QVERIFY(ListingStore::save(first->name(), firstContents));
+    QVERIFY(ListingStore::load(first->name()) == firstContents);
+    QVERIFY(ListingStore::save(second->name(), secondContents));
+    QVERIFY(listing_base("order_2") == "order_1");
+    QVERIFY(ListingStore::load(second->name()) == secondContents);
+    QVERIFY(count_lines() == lines + 4);
+
+    // Listings whose lines are in the order of their ids are kept too.
+    QVERIFY(ListingStore::save(first->name(), QByteArray("e\nf\n")));
+    QVERIFY(ListingStore::load(first->name()) == QByteArray("e\nf\n"));
+
+    // Detaching a listing keeps its order.
+    QVERIFY(ListingStore::save(first->name(), firstContents));
+    QVERIFY(ListingStore::save(second->name(), secondContents));
+    QVERIFY(listing_base("order_2") == "order_1");
+    first->purge();
+    QVERIFY(ListingStore::detachRemoved());
+    QVERIFY(listing_base("order_2").isEmpty());
+    QVERIFY(ListingStore::load(second->name()) == secondContents);
+
+    // Clean up.
+    second->purge();
+    QVERIFY(ListingStore::collectGarbage());
+    QVERIFY(count_lines() == lines);
+}
+
 QTEST_MAIN(TestPersistent)
 WARNINGS_DISABLE
 #include "test-persistent.moc"
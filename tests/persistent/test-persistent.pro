@@ -7,24 +7,50 @@ VALGRIND = true
 RESOURCES += ../../resources/resources-lite.qrc
 
 HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/LogEntry.h			\
 	../../lib/core/TSettings.h			\
+	../../src/archivelisting.h			\
+	../../src/backenddata.h				\
+	../../src/backuptask.h				\
+	../../src/basetask.h				\
+	../../src/changetracker.h			\
+	../../src/filehistorytask.h			\
+	../../src/listingtask.h				\
 	../../src/messages/archiveptr.h			\
+	../../src/messages/backuptaskdataptr.h		\
+	../../src/messages/changeset.h			\
+	../../src/messages/fileversion.h		\
+	../../src/messages/jobptr.h			\
 	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/filehistory.h		\
 	../../src/persistentmodel/job.h			\
 	../../src/persistentmodel/journal.h		\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
-	../../src/persistentmodel/upgrade-store.h
+	../../src/persistentmodel/upgrade-store.h	\
+	../../src/prefixtrie.h
 
 SOURCES += test-persistent.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/TSettings.cpp			\
+	../../src/archivelisting.cpp			\
+	../../src/backenddata.cpp			\
+	../../src/backuptask.cpp			\
+	../../src/basetask.cpp				\
+	../../src/changetracker.cpp			\
+	../../src/filehistorytask.cpp			\
+	../../src/listingtask.cpp			\
 	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/filehistory.cpp	\
 	../../src/persistentmodel/job.cpp		\
 	../../src/persistentmodel/journal.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
-	../../src/persistentmodel/upgrade-store.cpp
+	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/prefixtrie.cpp
 
 include(../tests-include.pri)
 
@@ -10,7 +10,7 @@ DIRS_C="${DIRS_C} app-cmdline cli"
 
 # Gui
 DIRS_G="${DIRS_G} lib-widgets"
-DIRS_G="${DIRS_G} customfilesystemmodel small-widgets setupwizard"
+DIRS_G="${DIRS_G} filepickermodel small-widgets setupwizard"
 DIRS_G="${DIRS_G} backuptabwidget settingswidget"
 DIRS_G="${DIRS_G} archivestabwidget app-setup"
 DIRS_G="${DIRS_G} translations helpwidget"
@@ -148,6 +148,7 @@ void TestSettingsWidget::backup()
     ui->preservePathsCheckBox->setChecked(false);
     ui->skipNoDumpCheckBox->setChecked(true);
     ui->simulationCheckBox->setChecked(true);
+    ui->skipUnchangedJobsCheckBox->setChecked(true);
     VISUAL_WAIT;
 
     // Check saved settings.  These are ready due to not using setText().
@@ -156,6 +157,7 @@ void TestSettingsWidget::backup()
     QVERIFY(settings.value("tarsnap/preserve_pathnames", "").toBool() == false);
     QVERIFY(settings.value("app/skip_nodump", "").toBool() == true);
     QVERIFY(settings.value("tarsnap/dry_run", "").toBool() == true);
+    QVERIFY(settings.value("app/skip_unchanged_jobs", "").toBool() == true);
 
     delete settingsWidget;
 }
@@ -11,6 +11,7 @@ FORMS += ../../forms/settingswidget.ui			\
 
 HEADERS  +=						\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
 	../../lib/core/TSettings.h			\
 	../../lib/widgets/TElidedLabel.h		\
 	../../src/dir-utils.h				\
@@ -26,6 +27,7 @@ HEADERS  +=						\
 
 SOURCES += test-settingswidget.cpp			\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
 	../../lib/core/TSettings.cpp			\
 	../../lib/widgets/TElidedLabel.cpp		\
 	../../src/dir-utils.cpp				\
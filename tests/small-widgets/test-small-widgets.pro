@@ -11,7 +11,11 @@ FORMS +=						\
 HEADERS  +=						\
 	../../lib/core/TSettings.h			\
 	../../lib/widgets/TElidedLabel.h		\
-	../../src/customfilesystemmodel.h		\
+	../../src/basetask.h				\
+	../../src/checkstatetree.h			\
+	../../src/direnumeratortask.h			\
+	../../src/filepickermodel.h			\
+	../../src/humanbytes.h				\
 	../../src/widgets/confirmationdialog.h		\
 	../../src/widgets/elidedannotatedlabel.h	\
 	../../src/widgets/filepickerdialog.h		\
@@ -22,7 +26,11 @@ HEADERS  +=						\
 SOURCES += test-small-widgets.cpp			\
 	../../lib/core/TSettings.cpp			\
 	../../lib/widgets/TElidedLabel.cpp		\
-	../../src/customfilesystemmodel.cpp		\
+	../../src/basetask.cpp				\
+	../../src/checkstatetree.cpp			\
+	../../src/direnumeratortask.cpp			\
+	../../src/filepickermodel.cpp			\
+	../../src/humanbytes.cpp			\
 	../../src/widgets/confirmationdialog.cpp	\
 	../../src/widgets/elidedannotatedlabel.cpp	\
 	../../src/widgets/filepickerdialog.cpp		\
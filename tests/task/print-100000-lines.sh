@@ -0,0 +1,3 @@
+#!/bin/sh
+awk 'BEGIN { for(i = 0; i < 100000; i++) print "line " i }'
+exit 0
@@ -1,13 +1,16 @@
 #include "warnings-disable.h"
 
 WARNINGS_DISABLE
+#include <QByteArray>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
 #include <QList>
 #include <QObject>
 #include <QSignalSpy>
 #include <QString>
 #include <QStringList>
+#include <QTemporaryDir>
 #include <QTest>
 #include <QVariant>
 WARNINGS_ENABLE
@@ -16,6 +19,8 @@ WARNINGS_ENABLE
 
 #include "../qtest-platform.h"
 
+#include "messages/taskoutput.h"
+
 #include "cmdlinetask.h"
 
 class TestTask : public QObject
@@ -33,11 +38,15 @@ private slots:
     void sleep_crash();
     void sleep_filenotfound();
     void cmd_filenotfound();
+    void task_output();
+    void spill_stdout();
+    void stream_stdout();
 };
 
 void TestTask::initTestCase()
 {
     QCoreApplication::setOrganizationName(TEST_NAME);
+    qRegisterMetaType<TaskOutput>("TaskOutput");
 
     ConsoleLog::initializeConsoleLog();
 }
@@ -60,8 +69,8 @@ void TestTask::cleanupTestCase()
     }                                                                          \
                                                                                \
     QSignalSpy sig_started(task, SIGNAL(started(QVariant)));                   \
-    QSignalSpy sig_fin(task,                                                   \
-                       SIGNAL(finished(QVariant, int, QString, QString)));     \
+    QSignalSpy sig_fin(                                                        \
+        task, SIGNAL(finished(QVariant, int, TaskOutput, TaskOutput)));        \
     QSignalSpy sig_dequeue(task, SIGNAL(dequeue()));                           \
                                                                                \
     task->setCommand("/bin/sh");                                               \
@@ -102,7 +111,7 @@ void TestTask::sleep_fail_stderr()
     QVERIFY(sig_fin.count() == 1);
     QList<QVariant> result = sig_fin.takeFirst();
     QVERIFY(result.at(1).toInt() == 1);
-    QVERIFY(result.at(3).toString() == "text on stderr");
+    QVERIFY(result.at(3).value<TaskOutput>().toString() == "text on stderr");
 }
 
 void TestTask::sleep_crash()
@@ -132,7 +141,8 @@ void TestTask::cmd_filenotfound()
 {
     CmdlineTask *task = new CmdlineTask();
     QSignalSpy   sig_started(task, SIGNAL(started(QVariant)));
-    QSignalSpy sig_fin(task, SIGNAL(finished(QVariant, int, QString, QString)));
+    QSignalSpy   sig_fin(task,
+                       SIGNAL(finished(QVariant, int, TaskOutput, TaskOutput)));
     QSignalSpy sig_dequeue(task, SIGNAL(dequeue()));
 
     task->setCommand("/fake/dir/fake-cmd");
@@ -144,6 +154,116 @@ void TestTask::cmd_filenotfound()
     delete task;
 }
 
+void TestTask::task_output()
+{
+    QByteArray bytes("caf\xc3\xa9\nline 2");
+    TaskOutput output(bytes);
+    QVERIFY(output.size() == bytes.size());
+
+    // Copies (including those made by queued signals) share the bytes.
+    TaskOutput copy    = output;
+    QVariant   variant = QVariant::fromValue(output);
+    QVERIFY(copy.bytes().constData() == bytes.constData());
+    QVERIFY(variant.value<TaskOutput>().bytes().constData()
+            == bytes.constData());
+
+    // The decoded text is shared as well.
+    QVERIFY(copy.toString() == QString::fromUtf8(bytes));
+    QVERIFY(output.toString().constData() == copy.toString().constData());
+
+    QVERIFY(TaskOutput().isEmpty());
+    QVERIFY(TaskOutput().toString().isEmpty());
+}
+
+void TestTask::spill_stdout()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+
+    // Continue in a file after the first KiB.
+    CmdlineTask *task = new CmdlineTask();
+    QSignalSpy   sig_fin(task,
+                       SIGNAL(finished(QVariant, int, TaskOutput, TaskOutput)));
+    task->setCommand("/bin/sh");
+    task->setArguments(QStringList(get_script("print-100000-lines.sh")));
+    task->setStdOutSpillDir(tmpdir.path(), 1024);
+    task->run();
+    delete task;
+
+    QVERIFY(sig_fin.count() == 1);
+    QList<QVariant> result = sig_fin.takeFirst();
+    QVERIFY(result.at(1).toInt() == 0);
+    TaskOutput stdOut = result.at(2).value<TaskOutput>();
+    QVERIFY(stdOut.isFile());
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).count() == 1);
+    QVERIFY(stdOut.bytes().startsWith("line 0\n"));
+    QVERIFY(stdOut.bytes().endsWith("\nline 99999"));
+    QVERIFY(stdOut.bytes().count('\n') == 99999);
+
+    // The file is removed along with the last copy of the output.
+    result.clear();
+    stdOut = TaskOutput();
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).isEmpty());
+
+    // Below the threshold, the output stays in memory.
+    task = new CmdlineTask();
+    QSignalSpy sig_mem(task,
+                       SIGNAL(finished(QVariant, int, TaskOutput, TaskOutput)));
+    task->setCommand("/bin/sh");
+    task->setArguments(QStringList(get_script("print-100000-lines.sh")));
+    task->setStdOutSpillDir(tmpdir.path());
+    task->run();
+    delete task;
+
+    QVERIFY(sig_mem.count() == 1);
+    stdOut = sig_mem.takeFirst().at(2).value<TaskOutput>();
+    QVERIFY(!stdOut.isFile());
+    QVERIFY(stdOut.bytes().count('\n') == 99999);
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).isEmpty());
+}
+
+void TestTask::stream_stdout()
+{
+    QTemporaryDir tmpdir;
+    QVERIFY(tmpdir.isValid());
+
+    // Collect every batch of lines.
+    QList<QByteArray> batches;
+    CmdlineTask      *task = new CmdlineTask();
+    connect(task, &CmdlineTask::stdOutLines,
+            [&batches](const QVariant &, const QByteArray &lines) {
+                batches << lines;
+            });
+    QSignalSpy sig_fin(task,
+                       SIGNAL(finished(QVariant, int, TaskOutput, TaskOutput)));
+    task->setCommand("/bin/sh");
+    task->setArguments(QStringList(get_script("print-100000-lines.sh")));
+    // Streaming takes precedence over spilling.
+    task->setStdOutSpillDir(tmpdir.path(), 1024);
+    task->setStreamStdOut(0);
+    task->run();
+    delete task;
+
+    // Every batch consists of complete lines.
+    QVERIFY(batches.count() > 1);
+    QByteArray streamed;
+    for(const QByteArray &lines : batches)
+    {
+        QVERIFY(lines.endsWith('\n'));
+        streamed.append(lines);
+    }
+    QVERIFY(streamed.startsWith("line 0\n"));
+    QVERIFY(streamed.endsWith("\nline 99999\n"));
+    QVERIFY(streamed.count('\n') == 100000);
+
+    // The streamed lines are not repeated.
+    QVERIFY(sig_fin.count() == 1);
+    QList<QVariant> result = sig_fin.takeFirst();
+    QVERIFY(result.at(1).toInt() == 0);
+    QVERIFY(result.at(2).value<TaskOutput>().isEmpty());
+    QVERIFY(QDir(tmpdir.path()).entryList(QDir::Files).isEmpty());
+}
+
 QTEST_MAIN(TestTask)
 WARNINGS_DISABLE
 #include "test-task.moc"
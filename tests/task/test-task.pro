@@ -5,14 +5,17 @@ VALGRIND = true
 
 HEADERS  +=						\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
 	../../lib/core/TSettings.h			\
 	../../src/basetask.h				\
 	../../src/cmdlinetask.h				\
+	../../src/messages/taskoutput.h			\
 	../../src/tasks/tasks-utils.h			\
 	../qtest-platform.h
 
 SOURCES += test-task.cpp				\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
 	../../lib/core/TSettings.cpp			\
 	../../src/basetask.cpp				\
 	../../src/cmdlinetask.cpp			\
@@ -28,6 +28,7 @@ WARNINGS_ENABLE
 #include "cmdlinetask.h"
 #include "taskmanager.h"
 #include "taskqueuer.h"
+#include "updatecoalescer.h"
 
 #include "ConsoleLog.h"
 #include "TSettings.h"
@@ -41,6 +42,7 @@ private slots:
     void cleanupTestCase();
 
     void taskqueuer();
+    void update_coalescer();
     void get_version();
     void fail_registerMachine_command_not_found();
     void fail_registerMachine_empty_key();
@@ -91,6 +93,40 @@ void TestTaskManager::taskqueuer()
     delete tq;
 }
 
+void TestTaskManager::update_coalescer()
+{
+    UpdateCoalescer *updates = new UpdateCoalescer();
+    QSignalSpy       sig_tasks(updates, SIGNAL(numTasks(bool, int, int)));
+    QSignalSpy       sig_message(updates, SIGNAL(message(QString)));
+
+    // Many updates within a frame only emit the latest values.
+    for(int i = 1; i <= 1000; i++)
+    {
+        updates->setNumTasks(false, 1, i);
+        updates->setMessage(QString("message %1").arg(i));
+    }
+    QVERIFY(sig_tasks.count() == 0);
+    QVERIFY(sig_message.count() == 0);
+    WAIT_SIG(sig_tasks);
+    QVERIFY(sig_tasks.count() == 1);
+    QVERIFY(sig_tasks.takeFirst().at(2).toInt() == 1000);
+    QVERIFY(sig_message.count() == 1);
+    QVERIFY(sig_message.takeFirst().at(0).toString() == "message 1000");
+
+    // An unchanged number of tasks is not emitted again.
+    updates->setNumTasks(false, 1, 1000);
+    updates->flush();
+    QVERIFY(sig_tasks.count() == 0);
+
+    // Flushing emits the pending values immediately.
+    updates->setNumTasks(true, 1, 0);
+    updates->flush();
+    QVERIFY(sig_tasks.count() == 1);
+    QVERIFY(sig_tasks.takeFirst().at(0).toBool() == true);
+
+    delete updates;
+}
+
 void TestTaskManager::get_version()
 {
     TARSNAP_CLI_OR_SKIP;
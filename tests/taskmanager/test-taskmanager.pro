@@ -4,27 +4,41 @@ QT = core sql network
 VALGRIND = true
 
 HEADERS  +=						\
+	../../lib/core/ByteScan.h			\
 	../../lib/core/ConsoleLog.h			\
+	../../lib/core/ConsoleLogWriter.h		\
 	../../lib/core/TSettings.h			\
+	../../src/archivelisting.h			\
 	../../src/backenddata.h				\
 	../../src/backuptask.h				\
 	../../src/basetask.h				\
+	../../src/changetracker.h			\
 	../../src/cmdlinetask.h				\
 	../../src/dir-utils.h				\
 	../../src/dirinfotask.h				\
+	../../src/filehistorytask.h			\
+	../../src/fingerprinttask.h			\
 	../../src/humanbytes.h				\
 	../../src/jobrunner.h				\
+	../../src/listingtask.h				\
 	../../src/messages/archivefilestat.h		\
+	../../src/messages/archivelistingptr.h		\
 	../../src/messages/archiveptr.h			\
 	../../src/messages/backuptaskdataptr.h		\
+	../../src/messages/changeset.h			\
+	../../src/messages/fileversion.h		\
 	../../src/messages/jobptr.h			\
 	../../src/messages/notification_info.h		\
+	../../src/messages/taskoutput.h			\
 	../../src/parsearchivelistingtask.h		\
 	../../src/persistentmodel/archive.h		\
+	../../src/persistentmodel/filehistory.h		\
 	../../src/persistentmodel/job.h			\
+	../../src/persistentmodel/listingstore.h	\
 	../../src/persistentmodel/persistentobject.h	\
 	../../src/persistentmodel/persistentstore.h	\
 	../../src/persistentmodel/upgrade-store.h	\
+	../../src/prefixtrie.h				\
 	../../src/taskmanager.h				\
 	../../src/taskqueuer.h				\
 	../../src/tasks/tasks-defs.h			\
@@ -32,31 +46,43 @@ HEADERS  +=						\
 	../../src/tasks/tasks-setup.h			\
 	../../src/tasks/tasks-tarsnap.h			\
 	../../src/tasks/tasks-utils.h			\
+	../../src/updatecoalescer.h			\
 	../qtest-platform.h
 
 SOURCES += test-taskmanager.cpp				\
+	../../lib/core/ByteScan.cpp			\
 	../../lib/core/ConsoleLog.cpp			\
+	../../lib/core/ConsoleLogWriter.cpp		\
 	../../lib/core/TSettings.cpp			\
+	../../src/archivelisting.cpp			\
 	../../src/backenddata.cpp			\
 	../../src/backuptask.cpp			\
 	../../src/basetask.cpp				\
+	../../src/changetracker.cpp			\
 	../../src/cmdlinetask.cpp			\
 	../../src/dir-utils.cpp				\
 	../../src/dirinfotask.cpp			\
+	../../src/filehistorytask.cpp			\
+	../../src/fingerprinttask.cpp			\
 	../../src/humanbytes.cpp			\
 	../../src/jobrunner.cpp				\
+	../../src/listingtask.cpp			\
 	../../src/parsearchivelistingtask.cpp		\
 	../../src/persistentmodel/archive.cpp		\
+	../../src/persistentmodel/filehistory.cpp	\
 	../../src/persistentmodel/job.cpp		\
+	../../src/persistentmodel/listingstore.cpp	\
 	../../src/persistentmodel/persistentobject.cpp	\
 	../../src/persistentmodel/persistentstore.cpp	\
 	../../src/persistentmodel/upgrade-store.cpp	\
+	../../src/prefixtrie.cpp			\
 	../../src/taskmanager.cpp			\
 	../../src/taskqueuer.cpp			\
 	../../src/tasks/tasks-misc.cpp			\
 	../../src/tasks/tasks-setup.cpp			\
 	../../src/tasks/tasks-tarsnap.cpp		\
-	../../src/tasks/tasks-utils.cpp
+	../../src/tasks/tasks-utils.cpp			\
+	../../src/updatecoalescer.cpp
 
 include(../tests-include.pri)
 